@@ -21,7 +21,7 @@ macro(configure_libs)
 
   find_package(Qt6 ${REQUIRED_QT_VERSION} REQUIRED COMPONENTS Core Widgets Network)
   if(UNIX AND NOT APPLE)
-      find_package(Qt6 ${REQUIRED_QT_VERSION} REQUIRED COMPONENTS DBus Xml)
+      find_package(Qt6 ${REQUIRED_QT_VERSION} REQUIRED COMPONENTS DBus)
   endif()
 
   # Define the location of Qt deployment tool
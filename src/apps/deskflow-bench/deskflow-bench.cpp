@@ -0,0 +1,926 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+// End-to-end loopback benchmark.
+//
+// Runs a real server and client connected over TCP (optionally TLS) with
+// headless screens on both ends, generates input storms on the primary
+// screen and measures what arrives on the secondary screen.
+//
+// With --role both (the default) server and client share one process and
+// event queue, so every injected event can be matched to the moment it was
+// generated, giving latency percentiles.  With --role server / --role client
+// the two ends run in separate processes and each reports throughput and
+// CPU cost per message.
+
+#include "arch/Arch.h"
+#include "base/EventQueue.h"
+#include "base/InputTrace.h"
+#include "base/Log.h"
+#include "client/Client.h"
+#include "common/Settings.h"
+#include "deskflow/ArgParser.h"
+#include "deskflow/ClientArgs.h"
+#include "deskflow/Screen.h"
+#include "deskflow/ServerArgs.h"
+#include "net/FingerprintDatabase.h"
+#include "net/NetworkAddress.h"
+#include "net/SecureUtils.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPSocketFactory.h"
+#include "platform/HeadlessAppUtil.h"
+#include "platform/HeadlessKeyState.h"
+#include "platform/HeadlessScreen.h"
+#include "server/ClientListener.h"
+#include "server/ClientProxy.h"
+#include "server/Config.h"
+#include "server/PrimaryClient.h"
+#include "server/Server.h"
+
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using deskflow::HeadlessScreen;
+using Clock = HeadlessScreen::Clock;
+using InjectedType = HeadlessScreen::InjectedType;
+
+namespace {
+
+const auto kServerName = "bench-server";
+const auto kClientName = "bench-client";
+
+// give up if the client hasn't connected and entered by then
+const double kConnectTimeout = 15.0;
+
+// give up waiting for in-flight events after a scenario
+const double kDrainTimeout = 5.0;
+
+// pause between scenarios when the client can't be observed
+const double kSettleTime = 1.0;
+
+// a client role run ends after this long without any input
+const double kClientIdleTime = 3.0;
+
+// how often the bench state machine is polled
+const double kTickPeriod = 0.01;
+
+// mouse storms walk a serpentine raster inside a box on the client so
+// every position is unique for kBoxSize * kBoxSize moves
+const int32_t kBoxSize = 200;
+const int32_t kBoxOffsetX = 50;
+const int32_t kBoxOffsetY = -kBoxSize / 2;
+
+enum class Role
+{
+  Both,
+  Server,
+  Client
+};
+
+struct Options
+{
+  Role m_role = Role::Both;
+  std::string m_host = "127.0.0.1";
+  int m_port = 24850;
+  bool m_tls = false;
+  bool m_latencyTrace = false;
+  bool m_verbose = false;
+  std::vector<std::string> m_scenarios = {"mouse", "keys", "clipboard"};
+  std::uint64_t m_mouseCount = 20000;
+  double m_mouseRate = 5000.0;
+  std::uint64_t m_keyCount = 10000;
+  double m_keyRate = 2000.0;
+  std::uint64_t m_clipboardCount = 20;
+  double m_clipboardRate = 10.0;
+  std::size_t m_clipboardSize = 1024 * 1024;
+};
+
+struct Result
+{
+  std::string m_name;
+  std::uint64_t m_sent = 0;
+  std::uint64_t m_received = 0;
+  std::uint64_t m_mismatched = 0;
+  double m_seconds = 0.0;
+  double m_cpuSeconds = 0.0;
+  std::vector<double> m_latencies; // microseconds
+};
+
+struct Point
+{
+  int32_t m_x = 0;
+  int32_t m_y = 0;
+};
+
+struct PendingMove
+{
+  Point m_pos;
+  Clock::time_point m_time;
+};
+
+struct PendingKey
+{
+  bool m_press = false;
+  KeyID m_id = kKeyNone;
+  KeyButton m_button = 0;
+  Clock::time_point m_time;
+};
+
+double cpuTime()
+{
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+double secondsBetween(Clock::time_point from, Clock::time_point to)
+{
+  return std::chrono::duration<double>(to - from).count();
+}
+
+double microsBetween(Clock::time_point from, Clock::time_point to)
+{
+  return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+double percentile(const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const auto index = std::min(sorted.size() - 1, static_cast<std::size_t>(p * static_cast<double>(sorted.size())));
+  return sorted[index];
+}
+
+Point mouseTarget(std::uint64_t index)
+{
+  const auto col = static_cast<int32_t>(index % kBoxSize);
+  const auto row = static_cast<int32_t>((index / kBoxSize) % kBoxSize);
+  return {kBoxOffsetX + ((row % 2 == 0) ? col : kBoxSize - 1 - col), kBoxOffsetY + row};
+}
+
+void printHeader()
+{
+  std::printf(
+      "%-10s %10s %10s %12s %10s %10s %10s %12s\n", "scenario", "sent", "received", "msgs/sec", "p50 us", "p99 us",
+      "p999 us", "cpu/msg us"
+  );
+}
+
+void printResult(Result &result)
+{
+  std::sort(result.m_latencies.begin(), result.m_latencies.end());
+  const auto count = std::max(result.m_sent, result.m_received);
+  const double rate = result.m_seconds > 0.0 ? static_cast<double>(count) / result.m_seconds : 0.0;
+  const double cpu = count > 0 ? result.m_cpuSeconds * 1e6 / static_cast<double>(count) : 0.0;
+
+  if (result.m_latencies.empty()) {
+    std::printf(
+        "%-10s %10llu %10llu %12.0f %10s %10s %10s %12.2f\n", result.m_name.c_str(),
+        static_cast<unsigned long long>(result.m_sent), static_cast<unsigned long long>(result.m_received), rate, "-",
+        "-", "-", cpu
+    );
+  } else {
+    std::printf(
+        "%-10s %10llu %10llu %12.0f %10.1f %10.1f %10.1f %12.2f\n", result.m_name.c_str(),
+        static_cast<unsigned long long>(result.m_sent), static_cast<unsigned long long>(result.m_received), rate,
+        percentile(result.m_latencies, 0.50), percentile(result.m_latencies, 0.99),
+        percentile(result.m_latencies, 0.999), cpu
+    );
+  }
+  if (result.m_mismatched > 0) {
+    std::printf("%-10s %llu events arrived out of order\n", "", static_cast<unsigned long long>(result.m_mismatched));
+  }
+  std::fflush(stdout);
+}
+
+void printUsage(const char *name)
+{
+  std::printf(
+      "Usage: %s [options]\n"
+      "\n"
+      "Options:\n"
+      "  --role <both|server|client>  run both ends in one process (default), or only one end\n"
+      "  --host <address>             server address (default 127.0.0.1)\n"
+      "  --port <port>                server port (default 24850)\n"
+      "  --tls                        use a TLS connection\n"
+      "  --latency-trace              also report the latency of each step, client side\n"
+      "  --scenarios <list>           comma separated: mouse,keys,clipboard (default all)\n"
+      "  --mouse-count <n>            mouse moves to send (default 20000)\n"
+      "  --mouse-rate <n>             mouse moves per second (default 5000)\n"
+      "  --key-count <n>              key events to send (default 10000)\n"
+      "  --key-rate <n>               key events per second (default 2000)\n"
+      "  --clipboard-count <n>        clipboard transfers (default 20)\n"
+      "  --clipboard-rate <n>         clipboard transfers per second, server role only (default 10)\n"
+      "  --clipboard-size <bytes>     clipboard text size (default 1048576)\n"
+      "  -v, --verbose                show deskflow log output\n"
+      "  -h, --help                   show this help\n",
+      name
+  );
+}
+
+std::vector<std::string> splitList(const std::string &list)
+{
+  std::vector<std::string> items;
+  std::size_t start = 0;
+  while (start <= list.size()) {
+    const auto end = std::min(list.find(',', start), list.size());
+    if (end > start) {
+      items.push_back(list.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+  return items;
+}
+
+bool parseArgs(int argc, char **argv, Options &options)
+{
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+
+    if (arg == "-h" || arg == "--help") {
+      printUsage(argv[0]);
+      return false;
+    } else if (arg == "-v" || arg == "--verbose") {
+      options.m_verbose = true;
+    } else if (arg == "--tls") {
+      options.m_tls = true;
+    } else if (arg == "--latency-trace") {
+      options.m_latencyTrace = true;
+    } else if (arg == "--role" && hasValue) {
+      const std::string role = argv[++i];
+      if (role == "both") {
+        options.m_role = Role::Both;
+      } else if (role == "server") {
+        options.m_role = Role::Server;
+      } else if (role == "client") {
+        options.m_role = Role::Client;
+      } else {
+        std::fprintf(stderr, "unknown role: %s\n", role.c_str());
+        return false;
+      }
+    } else if (arg == "--host" && hasValue) {
+      options.m_host = argv[++i];
+    } else if (arg == "--port" && hasValue) {
+      options.m_port = std::atoi(argv[++i]);
+    } else if (arg == "--scenarios" && hasValue) {
+      options.m_scenarios = splitList(argv[++i]);
+    } else if (arg == "--mouse-count" && hasValue) {
+      options.m_mouseCount = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--mouse-rate" && hasValue) {
+      options.m_mouseRate = std::atof(argv[++i]);
+    } else if (arg == "--key-count" && hasValue) {
+      options.m_keyCount = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--key-rate" && hasValue) {
+      options.m_keyRate = std::atof(argv[++i]);
+    } else if (arg == "--clipboard-count" && hasValue) {
+      options.m_clipboardCount = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--clipboard-rate" && hasValue) {
+      options.m_clipboardRate = std::atof(argv[++i]);
+    } else if (arg == "--clipboard-size" && hasValue) {
+      options.m_clipboardSize = std::strtoull(argv[++i], nullptr, 10);
+    } else {
+      std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+      printUsage(argv[0]);
+      return false;
+    }
+  }
+
+  for (const auto &scenario : options.m_scenarios) {
+    if (scenario != "mouse" && scenario != "keys" && scenario != "clipboard") {
+      std::fprintf(stderr, "unknown scenario: %s\n", scenario.c_str());
+      return false;
+    }
+  }
+  if (options.m_mouseRate <= 0.0 || options.m_keyRate <= 0.0 || options.m_clipboardRate <= 0.0) {
+    std::fprintf(stderr, "rates must be positive\n");
+    return false;
+  }
+  return true;
+}
+
+//! Create a throwaway certificate trusted by both ends of the connection
+/*!
+Settings are moved to a scratch directory so that the user's own
+certificate and fingerprint databases are never touched.  Both roles use
+the same directory so two processes on one machine trust each other.
+*/
+bool setupTls()
+{
+  const QString dir = QDir::temp().filePath(QStringLiteral("deskflow-bench"));
+  Settings::setSettingFile(QStringLiteral("%1/%2.conf").arg(dir, kAppName));
+  QDir().mkpath(Settings::tlsDir());
+
+  const auto certificate = Settings::value(Settings::Security::Certificate).toString();
+  try {
+    if (!QFile::exists(certificate)) {
+      deskflow::generatePemSelfSignedCert(certificate.toStdString());
+    }
+
+    const auto fingerprint = deskflow::pemFileCertFingerprint(certificate.toStdString(), Fingerprint::Type::SHA256);
+    FingerprintDatabase db;
+    db.addTrusted(fingerprint);
+    if (!db.write(Settings::tlsTrustedServersDb()) || !db.write(Settings::tlsTrustedClientsDb())) {
+      std::fprintf(stderr, "failed to write fingerprint databases in %s\n", qPrintable(Settings::tlsDir()));
+      return false;
+    }
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "failed to set up tls: %s\n", e.what());
+    return false;
+  }
+  return true;
+}
+
+class Bench
+{
+public:
+  enum class Phase
+  {
+    Connecting,
+    Running,
+    Draining,
+    Done
+  };
+
+  Bench(IEventQueue *events, const Options &options) : m_events(events), m_options(options)
+  {
+    // do nothing
+  }
+
+  Bench(Bench const &) = delete;
+  Bench &operator=(Bench const &) = delete;
+
+  ~Bench()
+  {
+    if (m_tick != nullptr) {
+      m_events->removeHandler(EventTypes::Timer, m_tick);
+      m_events->deleteTimer(m_tick);
+    }
+
+    delete m_client;
+
+    if (m_server != nullptr) {
+      m_events->removeHandler(EventTypes::ServerConnected, m_primaryScreen->getEventTarget());
+      m_events->removeHandler(EventTypes::ServerScreenSwitched, m_server);
+      delete m_server;
+    }
+    if (m_listener != nullptr) {
+      m_events->removeHandler(EventTypes::ClientListenerAccepted, m_listener);
+      delete m_listener;
+    }
+    delete m_primaryClient;
+    delete m_primaryScreen;
+  }
+
+  bool start()
+  {
+    m_serverArgs.m_name = kServerName;
+    m_serverArgs.m_enableCrypto = m_options.m_tls;
+    m_clientArgs.m_name = kClientName;
+    m_clientArgs.m_enableCrypto = m_options.m_tls;
+
+    // the secure listen socket reads the certificate option from the args
+    if (hasServer()) {
+      ArgParser(nullptr).setArgsBase(m_serverArgs);
+    } else {
+      ArgParser(nullptr).setArgsBase(m_clientArgs);
+    }
+
+    if (hasServer() && !startServer()) {
+      return false;
+    }
+    if (hasClient() && !startClient()) {
+      return false;
+    }
+
+    m_phaseStart = Clock::now();
+    m_tick = m_events->newTimer(kTickPeriod, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_tick, [this](const auto &) { handleTick(); });
+    return true;
+  }
+
+  int exitCode() const
+  {
+    return m_failed ? s_exitFailed : s_exitSuccess;
+  }
+
+private:
+  bool hasServer() const
+  {
+    return m_options.m_role != Role::Client;
+  }
+
+  bool hasClient() const
+  {
+    return m_options.m_role != Role::Server;
+  }
+
+  bool canObserveClient() const
+  {
+    return m_options.m_role == Role::Both;
+  }
+
+  bool startServer()
+  {
+    NetworkAddress address(m_options.m_host, m_options.m_port);
+    try {
+      address.resolve();
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "failed to resolve %s: %s\n", m_options.m_host.c_str(), e.what());
+      return false;
+    }
+
+    auto config = std::make_shared<deskflow::server::Config>(m_events);
+    config->addScreen(kServerName);
+    config->addScreen(kClientName);
+    config->connect(kServerName, Direction::Right, 0.0f, 1.0f, kClientName, 0.0f, 1.0f);
+    config->connect(kClientName, Direction::Left, 0.0f, 1.0f, kServerName, 0.0f, 1.0f);
+    config->addOption("", kOptionProtocol, static_cast<OptionValue>(ENetworkProtocol::kSynergy));
+    config->setDeskflowAddress(address);
+    m_serverArgs.m_config = config;
+
+    m_primary = new HeadlessScreen(true, m_events);
+    m_primaryScreen = new deskflow::Screen(m_primary, m_events);
+    m_primaryClient = new PrimaryClient(kServerName, m_primaryScreen);
+
+    const auto securityLevel = m_options.m_tls ? SecurityLevel::PeerAuth : SecurityLevel::PlainText;
+    try {
+      m_listener = new ClientListener(
+          address, std::make_unique<TCPSocketFactory>(m_events, &m_multiplexer), m_events, securityLevel
+      );
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "failed to listen on port %d: %s\n", m_options.m_port, e.what());
+      return false;
+    }
+
+    m_server = new Server(*config, m_primaryClient, m_primaryScreen, m_events, m_serverArgs);
+    m_listener->setServer(m_server);
+    m_server->setListener(m_listener);
+
+    m_events->addHandler(EventTypes::ClientListenerAccepted, m_listener, [this](const auto &) {
+      if (auto *client = m_listener->getNextClient(); client != nullptr) {
+        m_server->adoptClient(client);
+      }
+    });
+    m_events->addHandler(EventTypes::ServerConnected, m_primaryScreen->getEventTarget(), [this](const auto &) {
+      m_connected = true;
+    });
+    m_events->addHandler(EventTypes::ServerScreenSwitched, m_server, [this](const auto &) {
+      if (m_phase == Phase::Connecting && !canObserveClient()) {
+        beginScenario(0);
+      }
+    });
+    return true;
+  }
+
+  bool startClient()
+  {
+    NetworkAddress address(m_options.m_host, m_options.m_port);
+    try {
+      address.resolve();
+    } catch (const std::exception &e) {
+      std::fprintf(stderr, "failed to resolve %s: %s\n", m_options.m_host.c_str(), e.what());
+      return false;
+    }
+
+    m_secondary = new HeadlessScreen(false, m_events);
+    m_secondary->setRecording(false);
+    m_secondary->setInjectHandler([this](const auto &event) { handleInjected(event); });
+
+    m_client = new Client(
+        m_events, kClientName, address, new TCPSocketFactory(m_events, &m_multiplexer),
+        new deskflow::Screen(m_secondary, m_events), m_clientArgs
+    );
+    m_events->addHandler(EventTypes::ClientConnectionFailed, m_client->getEventTarget(), [this](const auto &) {
+      m_reconnect = true;
+    });
+    m_client->connect();
+    return true;
+  }
+
+  void finish()
+  {
+    m_phase = Phase::Done;
+    m_events->addEvent(Event(EventTypes::Quit));
+  }
+
+  void fail(const char *reason)
+  {
+    std::fprintf(stderr, "%s\n", reason);
+    m_failed = true;
+    finish();
+  }
+
+  //
+  // state machine
+  //
+
+  void handleTick()
+  {
+    const auto now = Clock::now();
+
+    if (m_phase == Phase::Connecting && secondsBetween(m_phaseStart, now) > kConnectTimeout) {
+      fail("timed out waiting for the client to connect");
+      return;
+    }
+    if (m_reconnect && m_client != nullptr) {
+      // the server may not be up yet when running as two processes
+      m_reconnect = false;
+      m_client->connect();
+    }
+    if (m_options.m_role == Role::Client) {
+      handleClientTick(now);
+      return;
+    }
+
+    switch (m_phase) {
+    case Phase::Connecting:
+      if (m_connected && m_primary->isOnScreen()) {
+        // push the cursor off the right edge until the server switches
+        int32_t x;
+        int32_t y;
+        int32_t w;
+        int32_t h;
+        m_primary->getShape(x, y, w, h);
+        m_primary->synthesizeMouseMove(x + w / 2, y + h / 2);
+        m_primary->synthesizeMouseMove(x + w - 1, y + h / 2);
+      }
+      break;
+
+    case Phase::Running:
+      if (m_generated >= m_target) {
+        m_primary->stopSynthesis();
+        m_result.m_sent = m_generated;
+        m_result.m_seconds = secondsBetween(m_phaseStart, m_lastSent);
+        m_phase = Phase::Draining;
+        m_drainStart = now;
+      }
+      break;
+
+    case Phase::Draining:
+      if (!canObserveClient()) {
+        if (secondsBetween(m_drainStart, now) > kSettleTime) {
+          endScenario();
+        }
+      } else if (isDrained() || secondsBetween(m_drainStart, now) > kDrainTimeout) {
+        if (m_lastReceived > m_phaseStart) {
+          m_result.m_seconds = secondsBetween(m_phaseStart, m_lastReceived);
+        }
+        endScenario();
+      }
+      break;
+
+    case Phase::Done:
+      break;
+    }
+  }
+
+  bool isDrained() const
+  {
+    const auto &name = m_options.m_scenarios[m_scenario];
+    if (name == "mouse") {
+      return m_pendingMoves.empty();
+    } else if (name == "keys") {
+      return m_pendingKeys.empty();
+    }
+    return m_result.m_received >= m_result.m_sent;
+  }
+
+  void beginScenario(std::size_t index)
+  {
+    m_scenario = index;
+    if (m_scenario >= m_options.m_scenarios.size()) {
+      finish();
+      return;
+    }
+
+    const auto &name = m_options.m_scenarios[m_scenario];
+    if (m_scenario == 0) {
+      printHeader();
+    }
+
+    m_result = Result();
+    m_result.m_name = name;
+    m_generated = 0;
+    m_pendingMoves.clear();
+    m_pendingKeys.clear();
+    m_phase = Phase::Running;
+    m_phaseStart = Clock::now();
+    m_lastSent = m_phaseStart;
+    m_lastReceived = m_phaseStart;
+    m_cpuStart = cpuTime();
+
+    if (name == "mouse") {
+      m_target = m_options.m_mouseCount;
+      m_lastTarget = {0, 0};
+      m_primary->startSynthesis(m_options.m_mouseRate, [this](auto &screen) { generateMouse(screen); });
+    } else if (name == "keys") {
+      m_target = m_options.m_keyCount;
+      m_primary->startSynthesis(m_options.m_keyRate, [this](auto &screen) { generateKey(screen); });
+    } else {
+      m_target = m_options.m_clipboardCount;
+      if (canObserveClient()) {
+        // transfers are sent back to back, each one when the previous arrived
+        generateClipboard(*m_primary);
+      } else {
+        m_primary->startSynthesis(m_options.m_clipboardRate, [this](auto &screen) { generateClipboard(screen); });
+      }
+    }
+  }
+
+  void endScenario()
+  {
+    m_result.m_cpuSeconds = cpuTime() - m_cpuStart;
+    printResult(m_result);
+    beginScenario(m_scenario + 1);
+  }
+
+  //
+  // generators, called on the primary screen
+  //
+
+  void generateMouse(HeadlessScreen &screen)
+  {
+    if (m_generated >= m_target) {
+      return;
+    }
+
+    const auto target = mouseTarget(m_generated++);
+    screen.synthesizeMouseRelativeMove(target.m_x - m_lastTarget.m_x, target.m_y - m_lastTarget.m_y);
+    m_lastTarget = target;
+    m_lastSent = Clock::now();
+
+    if (canObserveClient()) {
+      m_pendingMoves.push_back({{m_origin.m_x + target.m_x, m_origin.m_y + target.m_y}, m_lastSent});
+    }
+  }
+
+  void generateKey(HeadlessScreen &screen)
+  {
+    if (m_generated >= m_target) {
+      return;
+    }
+
+    const auto id = static_cast<KeyID>('a' + (m_generated / 2) % 26);
+    const bool press = m_generated % 2 == 0;
+    ++m_generated;
+    screen.synthesizeKey(id, 0, press);
+    m_lastSent = Clock::now();
+
+    if (canObserveClient()) {
+      m_pendingKeys.push_back({press, id, deskflow::HeadlessKeyState::buttonForKey(id), m_lastSent});
+    }
+  }
+
+  void generateClipboard(HeadlessScreen &screen)
+  {
+    if (m_generated >= m_target) {
+      return;
+    }
+
+    // the sequence number at the start makes every transfer unique so the
+    // server doesn't skip it as unchanged
+    std::string text(m_options.m_clipboardSize, 'x');
+    const auto prefix = std::to_string(m_generated) + ":";
+    text.replace(0, std::min(prefix.size(), text.size()), prefix.substr(0, text.size()));
+
+    ++m_generated;
+    m_lastSent = Clock::now();
+    screen.synthesizeClipboard(kClipboardClipboard, text);
+  }
+
+  //
+  // observers, called on the secondary screen
+  //
+
+  void handleInjected(const HeadlessScreen::InjectedEvent &event)
+  {
+    if (m_options.m_role == Role::Client) {
+      countClientEvent(event);
+      return;
+    }
+
+    if (event.m_type == InjectedType::Enter && m_phase == Phase::Connecting) {
+      m_origin = {event.m_x, event.m_y};
+      beginScenario(0);
+      return;
+    }
+
+    if (m_phase != Phase::Running && m_phase != Phase::Draining) {
+      return;
+    }
+
+    const auto &name = m_options.m_scenarios[m_scenario];
+    if (name == "mouse" && event.m_type == InjectedType::MouseMove) {
+      matchMove(event);
+    } else if (name == "keys" && (event.m_type == InjectedType::KeyDown || event.m_type == InjectedType::KeyUp)) {
+      matchKey(event);
+    } else if (name == "clipboard" && event.m_type == InjectedType::Clipboard && event.m_size > 0) {
+      ++m_result.m_received;
+      m_lastReceived = event.m_time;
+      m_result.m_latencies.push_back(microsBetween(m_lastSent, event.m_time));
+      generateClipboard(*m_primary);
+    }
+  }
+
+  void matchMove(const HeadlessScreen::InjectedEvent &event)
+  {
+    // the client drops moves that are superseded by queued ones, so a
+    // delivered position also delivers every move generated before it
+    const auto match = std::find_if(m_pendingMoves.begin(), m_pendingMoves.end(), [&event](const auto &move) {
+      return move.m_pos.m_x == event.m_x && move.m_pos.m_y == event.m_y;
+    });
+    if (match == m_pendingMoves.end()) {
+      ++m_result.m_mismatched;
+      return;
+    }
+
+    for (auto it = m_pendingMoves.begin(); it != std::next(match); ++it) {
+      m_result.m_latencies.push_back(microsBetween(it->m_time, event.m_time));
+    }
+    m_pendingMoves.erase(m_pendingMoves.begin(), std::next(match));
+    ++m_result.m_received;
+    m_lastReceived = event.m_time;
+  }
+
+  void matchKey(const HeadlessScreen::InjectedEvent &event)
+  {
+    if (m_pendingKeys.empty()) {
+      ++m_result.m_mismatched;
+      return;
+    }
+
+    const auto key = m_pendingKeys.front();
+    m_pendingKeys.pop_front();
+
+    const bool press = event.m_type == InjectedType::KeyDown;
+    const bool matches =
+        press == key.m_press && (press ? event.m_key == key.m_id : event.m_x == static_cast<int32_t>(key.m_button));
+    if (!matches) {
+      ++m_result.m_mismatched;
+    }
+
+    m_result.m_latencies.push_back(microsBetween(key.m_time, event.m_time));
+    ++m_result.m_received;
+    m_lastReceived = event.m_time;
+  }
+
+  //
+  // client role, the server end is in another process
+  //
+
+  struct ClientCount
+  {
+    std::uint64_t m_count = 0;
+    Clock::time_point m_first;
+    Clock::time_point m_last;
+    double m_cpuFirst = 0.0;
+    double m_cpuLast = 0.0;
+  };
+
+  void countClientEvent(const HeadlessScreen::InjectedEvent &event)
+  {
+    ClientCount *count = nullptr;
+    switch (event.m_type) {
+    case InjectedType::MouseMove:
+      count = &m_clientCounts[0];
+      break;
+    case InjectedType::KeyDown:
+    case InjectedType::KeyUp:
+      count = &m_clientCounts[1];
+      break;
+    case InjectedType::Clipboard:
+      if (event.m_size > 0) {
+        count = &m_clientCounts[2];
+      }
+      break;
+    case InjectedType::Enter:
+      m_phase = Phase::Running;
+      break;
+    default:
+      break;
+    }
+
+    if (count == nullptr) {
+      return;
+    }
+    if (count->m_count++ == 0) {
+      count->m_first = event.m_time;
+      count->m_cpuFirst = cpuTime();
+    }
+    count->m_last = event.m_time;
+    count->m_cpuLast = cpuTime();
+    m_lastReceived = event.m_time;
+  }
+
+  void handleClientTick(Clock::time_point now)
+  {
+    if (m_phase != Phase::Running || secondsBetween(m_lastReceived, now) < kClientIdleTime) {
+      return;
+    }
+    if (m_clientCounts[0].m_count + m_clientCounts[1].m_count + m_clientCounts[2].m_count == 0) {
+      return;
+    }
+
+    const char *names[] = {"mouse", "keys", "clipboard"};
+    printHeader();
+    for (std::size_t i = 0; i < m_clientCounts.size(); ++i) {
+      const auto &count = m_clientCounts[i];
+      if (count.m_count == 0) {
+        continue;
+      }
+      Result result;
+      result.m_name = names[i];
+      result.m_received = count.m_count;
+      result.m_seconds = secondsBetween(count.m_first, count.m_last);
+      result.m_cpuSeconds = count.m_cpuLast - count.m_cpuFirst;
+      printResult(result);
+    }
+    finish();
+  }
+
+  IEventQueue *m_events;
+  Options m_options;
+  SocketMultiplexer m_multiplexer;
+  deskflow::ServerArgs m_serverArgs;
+  deskflow::ClientArgs m_clientArgs;
+
+  HeadlessScreen *m_primary = nullptr;
+  deskflow::Screen *m_primaryScreen = nullptr;
+  PrimaryClient *m_primaryClient = nullptr;
+  ClientListener *m_listener = nullptr;
+  Server *m_server = nullptr;
+  HeadlessScreen *m_secondary = nullptr;
+  Client *m_client = nullptr;
+
+  EventQueueTimer *m_tick = nullptr;
+  Phase m_phase = Phase::Connecting;
+  bool m_connected = false;
+  bool m_reconnect = false;
+  bool m_failed = false;
+
+  std::size_t m_scenario = 0;
+  Result m_result;
+  std::uint64_t m_target = 0;
+  std::uint64_t m_generated = 0;
+  double m_cpuStart = 0.0;
+  Clock::time_point m_phaseStart;
+  Clock::time_point m_drainStart;
+  Clock::time_point m_lastSent;
+  Clock::time_point m_lastReceived;
+
+  Point m_origin;
+  Point m_lastTarget;
+  std::deque<PendingMove> m_pendingMoves;
+  std::deque<PendingKey> m_pendingKeys;
+  std::array<ClientCount, 3> m_clientCounts;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Options options;
+  if (!parseArgs(argc, argv, options)) {
+    return s_exitArgs;
+  }
+
+  Arch arch;
+  arch.init();
+
+  // the client and server look up keyboard languages through the app
+  deskflow::HeadlessAppUtil appUtil;
+
+  Log log;
+  log.setFilter(options.m_verbose ? LogLevel::Debug : LogLevel::Warning);
+
+  if (options.m_tls && !setupTls()) {
+    return s_exitFailed;
+  }
+
+  deskflow::InputTrace::setEnabled(options.m_latencyTrace);
+
+  EventQueue events;
+  Bench bench(&events, options);
+  if (!bench.start()) {
+    return s_exitFailed;
+  }
+
+  events.loop();
+
+  if (options.m_latencyTrace && options.m_role != Role::Server) {
+    std::printf("\n%s", deskflow::InputTrace::report().c_str());
+  }
+  return bench.exitCode();
+}
@@ -0,0 +1,134 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/Clipboard.h"
+#include "deskflow/ClipboardImage.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// a clipboard holding text and the same text as HTML, as most copies do
+void fillClipboard(Clipboard &clipboard, size_t size)
+{
+  clipboard.open(0);
+  clipboard.empty();
+  clipboard.add(IClipboard::kText, std::string(size, 't'));
+  clipboard.add(IClipboard::kHTML, "<p>" + std::string(size, 'h') + "</p>");
+  clipboard.close();
+}
+
+void clipboardMarshall(benchmark::State &state)
+{
+  Clipboard clipboard;
+  fillClipboard(clipboard, static_cast<size_t>(state.range(0)));
+  size_t size = 0;
+  for (auto _ : state) {
+    const auto data = IClipboard::marshall(&clipboard);
+    size = data.size();
+    benchmark::DoNotOptimize(data);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+void clipboardUnmarshall(benchmark::State &state)
+{
+  Clipboard source;
+  fillClipboard(source, static_cast<size_t>(state.range(0)));
+  const auto data = IClipboard::marshall(&source);
+
+  Clipboard clipboard;
+  for (auto _ : state) {
+    IClipboard::unmarshall(&clipboard, data, 0);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+// a 4K 32 bpp screenshot, mostly flat window backgrounds with rows of
+// busy pixels where the text would be
+const std::string &screenshotBitmap()
+{
+  static const auto s_bitmap = [] {
+    const uint32_t width = 3840;
+    const uint32_t height = 2160;
+    std::string bitmap(40 + width * height * 4, '\0');
+    auto *data = reinterpret_cast<uint8_t *>(bitmap.data());
+    const auto writeLE = [data](size_t offset, uint32_t value, int size) {
+      for (int i = 0; i < size; ++i) {
+        data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+      }
+    };
+    writeLE(0, 40, 4);
+    writeLE(4, width, 4);
+    writeLE(8, height, 4);
+    writeLE(12, 1, 2);
+    writeLE(14, 32, 2);
+    writeLE(20, width * height * 4, 4);
+
+    uint32_t noise = 1;
+    for (uint32_t y = 0; y < height; ++y) {
+      const bool textRow = (y % 24) >= 6 && (y % 24) < 18;
+      for (uint32_t x = 0; x < width; ++x) {
+        auto *pixel = data + 40 + (static_cast<size_t>(y) * width + x) * 4;
+        const auto window = static_cast<uint8_t>(((x / 640) + (y / 540)) * 40);
+        noise = noise * 1103515245 + 12345;
+        const bool ink = textRow && (x % 640) > 32 && (noise >> 16) % 4 == 0;
+        pixel[0] = ink ? 0x20 : static_cast<uint8_t>(0xf0 - window / 4);
+        pixel[1] = ink ? 0x20 : static_cast<uint8_t>(0xf0 - window / 2);
+        pixel[2] = ink ? 0x20 : static_cast<uint8_t>(0xf0 - window);
+      }
+    }
+    return bitmap;
+  }();
+  return s_bitmap;
+}
+
+// marshall then unmarshall a screenshot, as copied to a peer.  arg 0 is a
+// bitmap and arg 1 is the same image as PNG, the size counter is what goes
+// over the wire.
+void clipboardScreenshotTransfer(benchmark::State &state)
+{
+  const bool png = state.range(0) != 0;
+  Clipboard source;
+  source.open(0);
+  source.empty();
+  if (png) {
+    source.add(IClipboard::kPNG, ClipboardImage::bitmapToPNG(screenshotBitmap()));
+  } else {
+    source.add(IClipboard::kBitmap, screenshotBitmap());
+  }
+  source.close();
+
+  Clipboard clipboard;
+  size_t size = 0;
+  for (auto _ : state) {
+    const auto data = IClipboard::marshall(&source, png);
+    IClipboard::unmarshall(&clipboard, data, 0);
+    size = data.size();
+  }
+  state.counters["size"] = static_cast<double>(size);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// what an older peer costs, the PNG is decoded to a bitmap for it
+void clipboardScreenshotToBitmap(benchmark::State &state)
+{
+  const auto png = ClipboardImage::bitmapToPNG(screenshotBitmap());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ClipboardImage::pngToBitmap(png));
+  }
+  state.counters["size"] = static_cast<double>(png.size());
+}
+
+BENCHMARK(clipboardMarshall)->Arg(64)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+BENCHMARK(clipboardUnmarshall)->Arg(64)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+BENCHMARK(clipboardScreenshotTransfer)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(clipboardScreenshotToBitmap)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,63 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/EventQueue.h"
+#include "base/String.h"
+#include "server/Config.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+using deskflow::server::Config;
+
+namespace {
+
+// screens in a row, each linked to its neighbours and with a hotkey to
+// switch to it, like a config written by the GUI
+std::string makeConfig(int screens)
+{
+  using deskflow::string::sprintf;
+
+  std::string text = "section: screens\n";
+  for (int i = 0; i < screens; ++i) {
+    text += sprintf("\tscreen%d:\n\t\thalfDuplexCapsLock = false\n\t\tswitchCorners = none\n", i);
+  }
+  text += "end\n\nsection: links\n";
+  for (int i = 0; i < screens; ++i) {
+    text += sprintf("\tscreen%d:\n", i);
+    if (i > 0) {
+      text += sprintf("\t\tleft = screen%d\n", i - 1);
+    }
+    if (i + 1 < screens) {
+      text += sprintf("\t\tright = screen%d\n", i + 1);
+    }
+  }
+  text += "end\n\nsection: options\n\theartbeat = 5000\n\tswitchDelay = 250\n";
+  for (int i = 0; i < screens; ++i) {
+    text += sprintf("\tkeystroke(Control+Alt+F%d) = switchToScreen(screen%d)\n", i % 12 + 1, i);
+  }
+  text += "end\n";
+  return text;
+}
+
+void configParse(benchmark::State &state)
+{
+  const auto text = makeConfig(static_cast<int>(state.range(0)));
+  EventQueue events;
+  for (auto _ : state) {
+    std::istringstream stream(text);
+    Config config(&events);
+    stream >> config;
+    benchmark::DoNotOptimize(config.begin());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK(configParse)->Arg(2)->Arg(16)->Arg(64);
+
+} // namespace
@@ -0,0 +1,69 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/EiClipboardSync.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using deskflow::CompressionAlgorithm;
+using deskflow::DeltaMode;
+using deskflow::EiClipboardSync;
+
+namespace {
+
+// text with enough repetition to compress, as clipboard text usually is
+std::vector<uint8_t> makeText(size_t size)
+{
+  const std::string pattern = "int main(int argc, char **argv) { return run(argc, argv); }\n";
+  std::vector<uint8_t> data;
+  data.reserve(size);
+  while (data.size() < size) {
+    data.push_back(static_cast<uint8_t>(pattern[data.size() % pattern.size()]));
+  }
+  return data;
+}
+
+void eiClipboardSyncCompress(benchmark::State &state)
+{
+  const auto data = makeText(static_cast<size_t>(state.range(0)));
+  EiClipboardSync sync;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sync.compress(data, CompressionAlgorithm::LZ4));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+void eiClipboardSyncDecompress(benchmark::State &state)
+{
+  const auto data = makeText(static_cast<size_t>(state.range(0)));
+  EiClipboardSync sync;
+  const auto compressed = sync.compress(data, CompressionAlgorithm::LZ4);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sync.decompress(compressed, CompressionAlgorithm::LZ4));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+// a small edit in the middle of a copied block, the case deltas are for
+void eiClipboardSyncDelta(benchmark::State &state)
+{
+  const auto oldData = makeText(static_cast<size_t>(state.range(0)));
+  auto newData = oldData;
+  newData[newData.size() / 2] = '#';
+  EiClipboardSync sync;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sync.createDelta(oldData, newData, DeltaMode::Binary));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * newData.size()));
+}
+
+BENCHMARK(eiClipboardSyncCompress)->Arg(4 * 1024)->Arg(256 * 1024);
+BENCHMARK(eiClipboardSyncDecompress)->Arg(4 * 1024)->Arg(256 * 1024);
+BENCHMARK(eiClipboardSyncDelta)->Arg(4 * 1024)->Arg(32 * 1024);
+
+} // namespace
@@ -0,0 +1,64 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/EventQueue.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+// events added in batches then run through the event loop, as happens
+// when input arrives faster than it is handled
+void eventQueueAddDispatch(benchmark::State &state)
+{
+  const auto batch = state.range(0);
+  EventQueue events;
+  int target = 0;
+  int64_t handled = 0;
+  events.addHandler(EventTypes::PrimaryScreenMotionOnPrimary, &target, [&handled](const auto &) { ++handled; });
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < batch; ++i) {
+      events.addEvent(Event(EventTypes::PrimaryScreenMotionOnPrimary, &target));
+    }
+
+    // the loop returns once it reaches the quit event
+    events.addEvent(Event(EventTypes::Quit));
+    events.loop();
+  }
+
+  events.removeHandlers(&target);
+  state.SetItemsProcessed(handled);
+}
+
+// dispatch lookup with many registered targets, as with one per socket
+void eventQueueDispatchLookup(benchmark::State &state)
+{
+  const auto targets = state.range(0);
+  EventQueue events;
+  std::vector<int> target(static_cast<size_t>(targets));
+  for (auto &t : target) {
+    events.addHandler(EventTypes::StreamInputReady, &t, [](const auto &) {});
+  }
+
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(events.dispatchEvent(Event(EventTypes::StreamInputReady, &target[next])));
+    next = (next + 1) % target.size();
+  }
+
+  for (auto &t : target) {
+    events.removeHandlers(&t);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(eventQueueAddDispatch)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(eventQueueDispatchLookup)->Arg(1)->Arg(64)->Arg(1024);
+
+} // namespace
@@ -0,0 +1,100 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/EventQueue.h"
+#include "deskflow/Screen.h"
+#include "platform/HeadlessScreen.h"
+#include "server/InputFilter.h"
+#include "server/PrimaryClient.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+using deskflow::HeadlessScreen;
+
+namespace {
+
+enum class Input
+{
+  Keystroke,   //!< A key press no rule matches
+  Hotkey,      //!< The last hotkey configured
+  MouseButton, //!< The last mouse button configured
+};
+
+// rules configured on the server, three hotkeys for each mouse button
+const int kHotkeyRules = 150;
+const int kButtonRules = 50;
+
+// a server with many hotkeys sending keystrokes and switching screens,
+// offered the input a primary screen sends through the filter
+void inputFilterHandleEvent(benchmark::State &state, Input input)
+{
+  EventQueue events;
+  HeadlessScreen platformScreen(true, &events);
+  deskflow::Screen screen(&platformScreen, &events);
+  PrimaryClient primary("primary", &screen);
+
+  InputFilter filter(&events);
+  for (int i = 0; i < kHotkeyRules; ++i) {
+    InputFilter::Rule rule(new InputFilter::KeystrokeCondition(&events, 'a' + i, KeyModifierControl | KeyModifierAlt));
+    if (i % 2 == 0) {
+      rule.adoptAction(new InputFilter::SwitchToScreenAction(&events, "screen"), true);
+    } else {
+      auto *key = IKeyState::KeyInfo::alloc('a' + i, KeyModifierShift, 0, 1);
+      rule.adoptAction(new InputFilter::KeystrokeAction(&events, key, true), true);
+      rule.adoptAction(new InputFilter::KeystrokeAction(&events, IKeyState::KeyInfo::alloc(*key), false), false);
+    }
+    filter.addFilterRule(rule);
+  }
+  for (int i = 0; i < kButtonRules; ++i) {
+    // each of five buttons with a different combination of modifiers
+    const auto button = static_cast<ButtonID>(i % 5 + 1);
+    const auto mask = static_cast<KeyModifierMask>(i / 5 + 1);
+    InputFilter::Rule rule(new InputFilter::MouseButtonCondition(&events, button, mask));
+    rule.adoptAction(new InputFilter::SwitchToScreenAction(&events, "screen"), true);
+    filter.addFilterRule(rule);
+  }
+  filter.setPrimaryClient(&primary);
+
+  EventTypes type;
+  void *data;
+  switch (input) {
+    using enum Input;
+  case Keystroke:
+    type = EventTypes::KeyStateKeyDown;
+    data = IKeyState::KeyInfo::alloc('z', 0, 0, 1);
+    break;
+
+  case Hotkey: {
+    type = EventTypes::PrimaryScreenHotkeyDown;
+    const auto key = filter.getRule(kHotkeyRules - 1).getCondition()->getMatchKey();
+    data = IPlatformScreen::HotKeyInfo::alloc(static_cast<uint32_t>(key.m_value));
+    break;
+  }
+
+  case MouseButton:
+    type = EventTypes::PrimaryScreenButtonDown;
+    data = IPlatformScreen::ButtonInfo::alloc(5, (kButtonRules - 1) / 5 + 1);
+    break;
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        events.dispatchEvent(Event(type, primary.getEventTarget(), data, Event::EventFlags::DontFreeData))
+    );
+  }
+
+  filter.setPrimaryClient(nullptr);
+  free(data);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(inputFilterHandleEvent, keystroke, Input::Keystroke);
+BENCHMARK_CAPTURE(inputFilterHandleEvent, hotkey, Input::Hotkey);
+BENCHMARK_CAPTURE(inputFilterHandleEvent, mouseButton, Input::MouseButton);
+
+} // namespace
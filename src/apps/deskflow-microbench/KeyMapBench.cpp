@@ -0,0 +1,149 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/KeyMap.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+using deskflow::KeyMap;
+
+namespace {
+
+enum class Layout
+{
+  Us,       //!< ASCII with shift
+  AltGr,    //!< ASCII plus Latin-1 on AltGr, like most European layouts
+  TwoGroups //!< ASCII in the first group, Cyrillic in the second
+};
+
+// modifiers sit above every character button
+const KeyButton kShiftButton = 0x200;
+const KeyButton kControlButton = 0x201;
+const KeyButton kAltGrButton = 0x202;
+
+KeyMap::KeyItem makeItem(KeyID id, int32_t group, KeyButton button)
+{
+  KeyMap::KeyItem item;
+  item.m_id = id;
+  item.m_group = group;
+  item.m_button = button;
+  item.m_required = 0;
+  item.m_sensitive = 0;
+  item.m_generates = 0;
+  item.m_dead = false;
+  item.m_lock = false;
+  item.m_client = 0;
+  return item;
+}
+
+void addModifier(KeyMap &keyMap, KeyID id, int32_t group, KeyButton button, KeyModifierMask mask)
+{
+  auto item = makeItem(id, group, button);
+  item.m_generates = mask;
+  keyMap.addKeyEntry(item);
+}
+
+void addAscii(KeyMap &keyMap, int32_t group)
+{
+  for (KeyID id = 0x20; id < 0x7f; ++id) {
+    auto item = makeItem(id, group, static_cast<KeyButton>(std::tolower(static_cast<int>(id))));
+    if (std::isalpha(static_cast<int>(id))) {
+      item.m_sensitive = KeyModifierShift;
+      item.m_required = std::isupper(static_cast<int>(id)) ? KeyModifierShift : 0;
+    }
+    keyMap.addKeyEntry(item);
+  }
+}
+
+void buildKeyMap(KeyMap &keyMap, Layout layout)
+{
+  const int32_t groups = layout == Layout::TwoGroups ? 2 : 1;
+  for (int32_t group = 0; group < groups; ++group) {
+    addModifier(keyMap, kKeyShift_L, group, kShiftButton, KeyModifierShift);
+    addModifier(keyMap, kKeyControl_L, group, kControlButton, KeyModifierControl);
+  }
+  addAscii(keyMap, 0);
+
+  if (layout == Layout::AltGr) {
+    // Latin-1 characters on the letter keys with AltGr and AltGr+Shift
+    addModifier(keyMap, kKeyAltGr, 0, kAltGrButton, KeyModifierAltGr);
+    for (KeyID id = 0xa1; id <= 0xff; ++id) {
+      const auto offset = (id - 0xa1) % 52;
+      auto item = makeItem(id, 0, static_cast<KeyButton>('a' + offset % 26));
+      item.m_sensitive = KeyModifierShift | KeyModifierAltGr;
+      item.m_required = KeyModifierAltGr | (offset >= 26 ? KeyModifierShift : 0);
+      keyMap.addKeyEntry(item);
+    }
+  }
+
+  if (layout == Layout::TwoGroups) {
+    // Cyrillic on the same buttons as the Latin letters
+    for (KeyID id = 0x410; id < 0x450; ++id) {
+      auto item = makeItem(id, 1, static_cast<KeyButton>('a' + (id - 0x410) % 26));
+      item.m_sensitive = KeyModifierShift;
+      item.m_required = id < 0x430 ? KeyModifierShift : 0;
+      keyMap.addKeyEntry(item);
+    }
+  }
+
+  keyMap.finish();
+}
+
+// the keys typed in each layout, with the modifiers a client would be sent
+std::vector<std::pair<KeyID, KeyModifierMask>> typedKeys(Layout layout)
+{
+  std::vector<std::pair<KeyID, KeyModifierMask>> keys;
+  for (KeyID id = 'a'; id <= 'z'; ++id) {
+    keys.emplace_back(id, 0);
+    keys.emplace_back(std::toupper(static_cast<int>(id)), KeyModifierShift);
+  }
+  keys.emplace_back('c', KeyModifierControl);
+  keys.emplace_back('v', KeyModifierControl);
+
+  if (layout == Layout::AltGr) {
+    for (KeyID id = 0xc0; id <= 0xff; ++id) {
+      keys.emplace_back(id, 0);
+    }
+  }
+
+  if (layout == Layout::TwoGroups) {
+    for (KeyID id = 0x430; id < 0x450; ++id) {
+      keys.emplace_back(id, 0);
+    }
+  }
+  return keys;
+}
+
+void keyMapMapKey(benchmark::State &state, Layout layout)
+{
+  KeyMap keyMap;
+  buildKeyMap(keyMap, layout);
+  const auto keys = typedKeys(layout);
+  const std::string lang;
+
+  KeyMap::Keystrokes keystrokes;
+  KeyMap::ModifierToKeys activeModifiers;
+  size_t next = 0;
+  for (auto _ : state) {
+    const auto &[id, mask] = keys[next];
+    KeyModifierMask currentState = 0;
+    keystrokes.clear();
+    activeModifiers.clear();
+    benchmark::DoNotOptimize(keyMap.mapKey(keystrokes, id, 0, activeModifiers, currentState, mask, false, lang));
+    next = (next + 1) % keys.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(keyMapMapKey, us, Layout::Us);
+BENCHMARK_CAPTURE(keyMapMapKey, altGr, Layout::AltGr);
+BENCHMARK_CAPTURE(keyMapMapKey, twoGroups, Layout::TwoGroups);
+
+} // namespace
@@ -0,0 +1,303 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/EventQueue.h"
+#include "deskflow/PacketStreamFilter.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "deskflow/StreamChunker.h"
+#include "io/BufferStream.h"
+#include "io/StreamBuffer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Message
+{
+  KeyDown,
+  KeyDownLang,
+  MouseMove,
+  Enter,
+  Clipboard,
+  SetOptions
+};
+
+// a clipboard chunk as sent by ClipboardChunk
+const std::string kClipboardData(32 * 1024, 'x');
+
+void writeMessage(deskflow::IStream &stream, Message message)
+{
+  switch (message) {
+    using enum Message;
+
+  case KeyDown:
+    ProtocolUtil::writef(&stream, kMsgDKeyDown, 0x61, 0x0000, 0x26);
+    break;
+
+  case KeyDownLang: {
+    const std::string lang = "en";
+    ProtocolUtil::writef(&stream, kMsgDKeyDownLang, 0x61, 0x0000, 0x26, &lang);
+    break;
+  }
+
+  case MouseMove:
+    ProtocolUtil::writef(&stream, kMsgDMouseMove, 1024, 768);
+    break;
+
+  case Enter:
+    ProtocolUtil::writef(&stream, kMsgCEnter, 0, 384, 1, 0x0000);
+    break;
+
+  case Clipboard:
+    ProtocolUtil::writef(&stream, kMsgDClipboard, 0, 1, 1, &kClipboardData);
+    break;
+
+  case SetOptions: {
+    const std::vector<uint32_t> options{1, 2, 3, 4, 5, 6, 7, 8};
+    ProtocolUtil::writef(&stream, kMsgDSetOptions, &options);
+    break;
+  }
+  }
+}
+
+void readMessage(deskflow::IStream &stream, Message message)
+{
+  uint8_t byte = 0;
+  uint16_t shorts[3] = {};
+  uint32_t integer = 0;
+  std::string string;
+  std::vector<uint32_t> integers;
+
+  switch (message) {
+    using enum Message;
+
+  case KeyDown:
+    ProtocolUtil::readf(&stream, kMsgDKeyDown, &shorts[0], &shorts[1], &shorts[2]);
+    break;
+
+  case KeyDownLang:
+    ProtocolUtil::readf(&stream, kMsgDKeyDownLang, &shorts[0], &shorts[1], &shorts[2], &string);
+    break;
+
+  case MouseMove:
+    ProtocolUtil::readf(&stream, kMsgDMouseMove, &shorts[0], &shorts[1]);
+    break;
+
+  case Enter:
+    ProtocolUtil::readf(&stream, kMsgCEnter, &shorts[0], &shorts[1], &integer, &shorts[2]);
+    break;
+
+  case Clipboard:
+    ProtocolUtil::readf(&stream, kMsgDClipboard, &byte, &integer, &byte, &string);
+    break;
+
+  case SetOptions:
+    ProtocolUtil::readf(&stream, kMsgDSetOptions, &integers);
+    break;
+  }
+
+  benchmark::DoNotOptimize(shorts);
+  benchmark::DoNotOptimize(string);
+}
+
+std::vector<uint8_t> encode(Message message)
+{
+  BufferStream stream;
+  writeMessage(stream, message);
+  std::vector<uint8_t> encoded(stream.getSize());
+  stream.read(encoded.data(), static_cast<uint32_t>(encoded.size()));
+  return encoded;
+}
+
+void protocolWritef(benchmark::State &state, Message message)
+{
+  BufferStream stream;
+  const auto size = encode(message).size();
+  for (auto _ : state) {
+    writeMessage(stream, message);
+    stream.read(nullptr, stream.getSize());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+void protocolReadf(benchmark::State &state, Message message)
+{
+  // encode once, then feed the same bytes back for every read
+  const auto encoded = encode(message);
+  BufferStream stream;
+  for (auto _ : state) {
+    stream.write(encoded.data(), static_cast<uint32_t>(encoded.size()));
+    readMessage(stream, message);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * encoded.size()));
+}
+
+BENCHMARK_CAPTURE(protocolWritef, keyDown, Message::KeyDown);
+BENCHMARK_CAPTURE(protocolWritef, keyDownLang, Message::KeyDownLang);
+BENCHMARK_CAPTURE(protocolWritef, mouseMove, Message::MouseMove);
+BENCHMARK_CAPTURE(protocolWritef, enter, Message::Enter);
+BENCHMARK_CAPTURE(protocolWritef, clipboard, Message::Clipboard);
+BENCHMARK_CAPTURE(protocolWritef, setOptions, Message::SetOptions);
+
+BENCHMARK_CAPTURE(protocolReadf, keyDown, Message::KeyDown);
+BENCHMARK_CAPTURE(protocolReadf, keyDownLang, Message::KeyDownLang);
+BENCHMARK_CAPTURE(protocolReadf, mouseMove, Message::MouseMove);
+BENCHMARK_CAPTURE(protocolReadf, enter, Message::Enter);
+BENCHMARK_CAPTURE(protocolReadf, clipboard, Message::Clipboard);
+BENCHMARK_CAPTURE(protocolReadf, setOptions, Message::SetOptions);
+
+//
+// StreamBuffer
+//
+
+// small messages written and consumed one at a time, like input events
+void streamBufferSmall(benchmark::State &state)
+{
+  const auto size = static_cast<uint32_t>(state.range(0));
+  const std::vector<uint8_t> data(size, 0x55);
+  StreamBuffer buffer;
+  for (auto _ : state) {
+    buffer.write(data.data(), size);
+    benchmark::DoNotOptimize(buffer.peek(size));
+    buffer.pop(size);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// a large write consumed in socket sized pieces, like a clipboard transfer
+void streamBufferBulk(benchmark::State &state)
+{
+  const auto size = static_cast<uint32_t>(state.range(0));
+  const uint32_t kPiece = 4096;
+  const std::vector<uint8_t> data(size, 0x55);
+  StreamBuffer buffer;
+  for (auto _ : state) {
+    buffer.write(data.data(), size);
+    while (buffer.getSize() > 0) {
+      const auto n = std::min(kPiece, buffer.getSize());
+      benchmark::DoNotOptimize(buffer.peek(n));
+      buffer.pop(n);
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// a header read ahead of its payload, which makes peek join chunks
+void streamBufferHeaderPayload(benchmark::State &state)
+{
+  const auto size = static_cast<uint32_t>(state.range(0));
+  const std::vector<uint8_t> data(size + 4, 0x55);
+  StreamBuffer buffer;
+  for (auto _ : state) {
+    buffer.write(data.data(), static_cast<uint32_t>(data.size()));
+    benchmark::DoNotOptimize(buffer.peek(4));
+    buffer.pop(4);
+    benchmark::DoNotOptimize(buffer.peek(size));
+    buffer.pop(size);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+BENCHMARK(streamBufferSmall)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(streamBufferBulk)->Arg(64 * 1024)->Arg(1024 * 1024);
+BENCHMARK(streamBufferHeaderPayload)->Arg(16)->Arg(4096)->Arg(64 * 1024);
+
+//
+// PacketStreamFilter
+//
+
+void packetStreamFilterWrite(benchmark::State &state)
+{
+  const auto size = static_cast<uint32_t>(state.range(0));
+  const std::vector<uint8_t> data(size, 0x55);
+  EventQueue events;
+  BufferStream stream;
+  PacketStreamFilter filter(&events, &stream, false);
+  for (auto _ : state) {
+    filter.write(data.data(), size);
+    stream.read(nullptr, stream.getSize());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+void packetStreamFilterRead(benchmark::State &state)
+{
+  const auto size = static_cast<uint32_t>(state.range(0));
+  const std::vector<uint8_t> data(size, 0x55);
+  std::vector<uint8_t> packet(size);
+  EventQueue events;
+  BufferStream stream;
+  PacketStreamFilter filter(&events, &stream, false);
+  for (auto _ : state) {
+    filter.write(data.data(), size);
+
+    // the filter pulls from the stream when the stream reports input
+    events.dispatchEvent(Event(EventTypes::StreamInputReady, stream.getEventTarget()));
+    filter.read(packet.data(), size);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+BENCHMARK(packetStreamFilterWrite)->Arg(12)->Arg(4096)->Arg(64 * 1024);
+BENCHMARK(packetStreamFilterRead)->Arg(12)->Arg(4096)->Arg(64 * 1024);
+
+//
+// Fan-out
+//
+
+enum class Encoding
+{
+  EachClient, //!< Formatted and copied for every client
+  Once        //!< Formatted once, every client's buffer shares it
+};
+
+// a large clipboard sent to every client, each through its own filter
+void clipboardFanOut(benchmark::State &state, Encoding encoding)
+{
+  const auto clients = static_cast<size_t>(state.range(0));
+  const std::string data(4 * 1024 * 1024, 'x');
+  EventQueue events;
+  std::vector<std::unique_ptr<BufferStream>> streams;
+  std::vector<std::unique_ptr<PacketStreamFilter>> filters;
+  for (size_t i = 0; i < clients; ++i) {
+    streams.push_back(std::make_unique<BufferStream>());
+    filters.push_back(std::make_unique<PacketStreamFilter>(&events, streams.back().get(), false));
+  }
+
+  for (auto _ : state) {
+    if (encoding == Encoding::Once) {
+      const auto packets = StreamChunker::encodeClipboard(data, 0, 0);
+      for (const auto &filter : filters) {
+        for (const auto &packet : packets) {
+          filter->writePacket(packet);
+        }
+      }
+    } else {
+      for (const auto &filter : filters) {
+        for (const auto &packet : StreamChunker::encodeClipboard(data, 0, 0)) {
+          filter->write(packet.getPayload(), packet.getPayloadSize());
+        }
+      }
+    }
+
+    // sent, as far as the server is concerned
+    for (const auto &stream : streams) {
+      stream->read(nullptr, stream->getSize());
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * clients * data.size()));
+}
+
+BENCHMARK_CAPTURE(clipboardFanOut, eachClient, Encoding::EachClient)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_CAPTURE(clipboardFanOut, once, Encoding::Once)->Arg(1)->Arg(4)->Arg(16);
+
+} // namespace
@@ -0,0 +1,220 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/HandshakePool.h"
+#include "net/SecureContext.h"
+#include "net/SecureUtils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <openssl/ssl.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using ContextPtr = std::shared_ptr<const SecureContext>;
+
+// one certificate for both ends, as when a user trusts their own machines
+const std::string &certificate(deskflow::KeyType keyType = deskflow::KeyType::RSA)
+{
+  static const auto s_paths = [] {
+    std::map<deskflow::KeyType, std::string> paths;
+    for (const auto keyType : {deskflow::KeyType::RSA, deskflow::KeyType::ECDSA, deskflow::KeyType::Ed25519}) {
+      const auto name = "deskflow-microbench-" + deskflow::keyTypeToString(keyType).toStdString() + ".pem";
+      const auto path = (std::filesystem::temp_directory_path() / name).string();
+      deskflow::generatePemSelfSignedCert(path, 2048, keyType);
+      paths[keyType] = path;
+    }
+    return paths;
+  }();
+  return s_paths.at(keyType);
+}
+
+// step both ends until neither wants to, returns the time spent in the server
+double handshake(SSL *client, SSL *server)
+{
+  double serverSeconds = 0.0;
+  bool clientDone = false;
+  bool serverDone = false;
+  while (!clientDone || !serverDone) {
+    if (!clientDone) {
+      const auto result = SSL_do_handshake(client);
+      clientDone = result == 1;
+      if (result <= 0 && SSL_get_error(client, result) != SSL_ERROR_WANT_READ) {
+        return -1.0;
+      }
+    }
+    if (!serverDone) {
+      const auto start = Clock::now();
+      const auto result = SSL_do_handshake(server);
+      serverSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+      serverDone = result == 1;
+      if (result <= 0 && SSL_get_error(server, result) != SSL_ERROR_WANT_READ) {
+        return -1.0;
+      }
+    }
+  }
+  return serverSeconds;
+}
+
+struct Connection
+{
+  double m_serverSeconds = -1.0;
+  bool m_resumed = false;
+};
+
+// connect a client over an in-memory pipe
+Connection connect(const SecureContext &client, const SecureContext &server, bool resume)
+{
+  auto *clientSsl = SSL_new(client.context());
+  auto *serverSsl = SSL_new(server.context());
+  BIO *clientBio = nullptr;
+  BIO *serverBio = nullptr;
+  BIO_new_bio_pair(&clientBio, 0, &serverBio, 0);
+  SSL_set_bio(clientSsl, clientBio, clientBio);
+  SSL_set_bio(serverSsl, serverBio, serverBio);
+  SSL_set_connect_state(clientSsl);
+  SSL_set_accept_state(serverSsl);
+
+  if (resume) {
+    client.resumeSession(clientSsl);
+  }
+
+  Connection connection;
+  connection.m_serverSeconds = handshake(clientSsl, serverSsl);
+  connection.m_resumed = SSL_session_reused(serverSsl) == 1;
+  if (connection.m_serverSeconds >= 0.0 && resume) {
+    // a tls 1.3 server sends its tickets after the handshake
+    client.trustSession(clientSsl);
+    char byte;
+    SSL_read(clientSsl, &byte, sizeof(byte));
+  }
+
+  SSL_shutdown(clientSsl);
+  SSL_shutdown(serverSsl);
+  SSL_free(clientSsl);
+  SSL_free(serverSsl);
+  return connection;
+}
+
+// new clients connecting with each key type, timing the server side of the
+// handshake, where signing with the private key is the bulk of the work
+void tlsHandshake(benchmark::State &state, deskflow::KeyType keyType)
+{
+  const auto server = std::make_shared<const SecureContext>(true, SecurityLevel::PeerAuth, certificate(keyType), false);
+  const auto client =
+      std::make_shared<const SecureContext>(false, SecurityLevel::PeerAuth, certificate(keyType), false);
+
+  for (auto _ : state) {
+    const auto connection = connect(*client, *server, false);
+    if (connection.m_serverSeconds < 0.0) {
+      state.SkipWithError("handshake failed");
+      break;
+    }
+    state.SetIterationTime(connection.m_serverSeconds);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// clients reconnecting to one server in turn, timing the server side of
+// each handshake, with and without resuming the previous session
+void tlsReconnect(benchmark::State &state, bool resume)
+{
+  const auto clients = state.range(0);
+  const auto server = std::make_shared<const SecureContext>(true, SecurityLevel::PeerAuth, certificate(), false);
+  std::vector<ContextPtr> client;
+  for (int64_t i = 0; i < clients; ++i) {
+    client.push_back(std::make_shared<const SecureContext>(false, SecurityLevel::PeerAuth, certificate(), false));
+    connect(*client.back(), *server, resume);
+  }
+
+  std::size_t next = 0;
+  int64_t resumed = 0;
+  for (auto _ : state) {
+    const auto connection = connect(*client[next], *server, resume);
+    if (connection.m_serverSeconds < 0.0) {
+      state.SkipWithError("handshake failed");
+      break;
+    }
+    state.SetIterationTime(connection.m_serverSeconds);
+    next = (next + 1) % client.size();
+    resumed += connection.m_resumed ? 1 : 0;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["resumed"] = benchmark::Counter(static_cast<double>(resumed), benchmark::Counter::kAvgIterations);
+}
+
+// an established client sending a message every 250us, the rate of fast
+// mouse motion, while a burst of clients connect at once.  the messages
+// and handshakes share one thread, as on the multiplexer thread, or the
+// handshakes go to the pool.  the time is the longest a message waited,
+// the client end of each handshake stands in for the remote machines
+void tlsHandshakeBurst(benchmark::State &state, bool pool)
+{
+  using namespace std::chrono_literals;
+  const auto interval = 250us;
+  const auto handshakes = state.range(0);
+  const auto server = std::make_shared<const SecureContext>(true, SecurityLevel::PeerAuth, certificate(), false);
+  const auto client = std::make_shared<const SecureContext>(false, SecurityLevel::PeerAuth, certificate(), false);
+  std::vector<int> owners(static_cast<std::size_t>(handshakes));
+
+  double totalWait = 0.0;
+  int64_t messages = 0;
+  for (auto _ : state) {
+    std::atomic<int64_t> done = 0;
+    if (pool) {
+      for (auto &owner : owners) {
+        HandshakePool::instance().add(&owner, [&client, &server, &done] {
+          connect(*client, *server, false);
+          ++done;
+        });
+      }
+    }
+
+    double longestWait = 0.0;
+    auto arrival = Clock::now();
+    while (done < handshakes) {
+      for (const auto now = Clock::now(); arrival <= now; arrival += interval) {
+        const auto wait = std::chrono::duration<double>(now - arrival).count();
+        longestWait = std::max(longestWait, wait);
+        totalWait += wait;
+        ++messages;
+      }
+
+      if (pool) {
+        std::this_thread::yield();
+      } else {
+        connect(*client, *server, false);
+        ++done;
+      }
+    }
+
+    state.SetIterationTime(longestWait);
+  }
+
+  state.counters["handshakes"] = static_cast<double>(handshakes);
+  state.counters["avg_wait_us"] = messages > 0 ? totalWait / static_cast<double>(messages) * 1e6 : 0.0;
+}
+
+BENCHMARK_CAPTURE(tlsHandshake, rsa, deskflow::KeyType::RSA)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(tlsHandshake, ecdsa, deskflow::KeyType::ECDSA)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(tlsHandshake, ed25519, deskflow::KeyType::Ed25519)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(tlsReconnect, full, false)->Arg(50)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(tlsReconnect, resumed, true)->Arg(50)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(tlsHandshakeBurst, multiplexer, false)->Arg(20)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(tlsHandshakeBurst, pool, true)->Arg(20)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace
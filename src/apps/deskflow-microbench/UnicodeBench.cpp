@@ -0,0 +1,118 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Unicode.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+
+enum class Text
+{
+  Ascii, //!< Typical code or English prose
+  Mixed, //!< Latin text with some accented characters
+  Cjk    //!< Three byte UTF-8 sequences throughout
+};
+
+std::string makeUtf8(Text text, size_t size)
+{
+  std::string pattern;
+  switch (text) {
+    using enum Text;
+
+  case Ascii:
+    pattern = "The quick brown fox jumps over the lazy dog. ";
+    break;
+
+  case Mixed:
+    pattern = "Fa\xc3\xa7"
+              "ade na\xc3\xafve r\xc3\xa9sum\xc3\xa9 ";
+    break;
+
+  case Cjk:
+    pattern = "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87\xe7\xab\xa0";
+    break;
+  }
+
+  std::string utf8;
+  while (utf8.size() + pattern.size() <= size) {
+    utf8 += pattern;
+  }
+  return utf8;
+}
+
+void unicodeUtf8ToUtf16(benchmark::State &state, Text text)
+{
+  const auto utf8 = makeUtf8(text, static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Unicode::UTF8ToUTF16(utf8));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utf8.size()));
+}
+
+void unicodeUtf16ToUtf8(benchmark::State &state, Text text)
+{
+  const auto utf16 = Unicode::UTF8ToUTF16(makeUtf8(text, static_cast<size_t>(state.range(0))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Unicode::UTF16ToUTF8(utf16));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utf16.size()));
+}
+
+void unicodeUtf8ToUtf32(benchmark::State &state, Text text)
+{
+  const auto utf8 = makeUtf8(text, static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Unicode::UTF8ToUTF32(utf8));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utf8.size()));
+}
+
+void unicodeUtf32ToUtf8(benchmark::State &state, Text text)
+{
+  const auto utf32 = Unicode::UTF8ToUTF32(makeUtf8(text, static_cast<size_t>(state.range(0))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Unicode::UTF32ToUTF8(utf32));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utf32.size()));
+}
+
+void unicodeIsUtf8(benchmark::State &state, Text text)
+{
+  const auto utf8 = makeUtf8(text, static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Unicode::isUTF8(utf8));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utf8.size()));
+}
+
+// from a short line of text up to a large document pasted from an editor
+void textSizes(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->Arg(64)->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(50 * 1024 * 1024);
+}
+
+BENCHMARK_CAPTURE(unicodeUtf8ToUtf16, ascii, Text::Ascii)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeUtf8ToUtf16, mixed, Text::Mixed)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeUtf8ToUtf16, cjk, Text::Cjk)->Apply(textSizes);
+
+BENCHMARK_CAPTURE(unicodeUtf16ToUtf8, ascii, Text::Ascii)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeUtf16ToUtf8, mixed, Text::Mixed)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeUtf16ToUtf8, cjk, Text::Cjk)->Apply(textSizes);
+
+BENCHMARK_CAPTURE(unicodeUtf8ToUtf32, ascii, Text::Ascii)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeUtf8ToUtf32, cjk, Text::Cjk)->Apply(textSizes);
+
+BENCHMARK_CAPTURE(unicodeUtf32ToUtf8, ascii, Text::Ascii)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeUtf32ToUtf8, cjk, Text::Cjk)->Apply(textSizes);
+
+BENCHMARK_CAPTURE(unicodeIsUtf8, ascii, Text::Ascii)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeIsUtf8, mixed, Text::Mixed)->Apply(textSizes);
+BENCHMARK_CAPTURE(unicodeIsUtf8, cjk, Text::Cjk)->Apply(textSizes);
+
+} // namespace
@@ -0,0 +1,66 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/XWindowsUtil.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+enum class KeySyms
+{
+  Latin1,   //!< Mapped directly
+  Table,    //!< Cyrillic, Greek and the like, looked up in the keysym table
+  Unmapped, //!< Not in the table, so the whole search fails
+};
+
+std::vector<KeySym> makeKeySyms(KeySyms keySyms)
+{
+  std::vector<KeySym> result;
+  switch (keySyms) {
+    using enum KeySyms;
+
+  case Latin1:
+    for (KeySym keysym = 0x20; keysym < 0x100; ++keysym) {
+      result.push_back(keysym);
+    }
+    break;
+
+  case Table:
+    for (KeySym keysym = 0x6a1; keysym < 0x800; ++keysym) {
+      result.push_back(keysym);
+    }
+    break;
+
+  case Unmapped:
+    for (KeySym keysym = 0x1001000; keysym < 0x1001100; ++keysym) {
+      result.push_back(keysym);
+    }
+    break;
+  }
+  return result;
+}
+
+// the lookups made for every key event and for every key when the
+// keyboard map is built
+void xWindowsUtilMapKeySymToKeyID(benchmark::State &state, KeySyms keySyms)
+{
+  const auto keysyms = makeKeySyms(keySyms);
+  for (auto _ : state) {
+    for (const auto keysym : keysyms) {
+      benchmark::DoNotOptimize(XWindowsUtil::mapKeySymToKeyID(keysym));
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keysyms.size()));
+}
+
+BENCHMARK_CAPTURE(xWindowsUtilMapKeySymToKeyID, latin1, KeySyms::Latin1);
+BENCHMARK_CAPTURE(xWindowsUtilMapKeySymToKeyID, table, KeySyms::Table);
+BENCHMARK_CAPTURE(xWindowsUtilMapKeySymToKeyID, unmapped, KeySyms::Unmapped);
+
+} // namespace
@@ -0,0 +1,37 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+// Micro benchmarks for the core hot paths.
+//
+// Takes the usual Google Benchmark arguments, e.g. --benchmark_filter to
+// pick benchmarks, and --benchmark_out=<file> --benchmark_out_format=json
+// to write results that can be compared between commits with compare.py
+// from Google Benchmark.  The run-microbench target does the latter.
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+#include "common/Common.h"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char **argv)
+{
+  Arch arch;
+  arch.init();
+
+  // keep logging out of the measurements
+  Log log;
+  log.setFilter(LogLevel::Warning);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return s_exitArgs;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return s_exitSuccess;
+}
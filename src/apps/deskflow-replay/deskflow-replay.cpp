@@ -0,0 +1,605 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+// Protocol capture replay.
+//
+// Feeds the input side of a stream recorded with --capture-protocol into
+// the real protocol code, with a headless screen standing in for the
+// display.  A stream captured on a client is replayed into a ServerProxy
+// driving a secondary screen; a stream captured on a server is replayed
+// through ClientProxyUnknown into the ClientProxy1_x for the recorded
+// protocol version, attached to a server with a primary screen.
+//
+// Packets are fed one at a time, each once the event queue has handled
+// everything the previous one caused, so a replay is deterministic.  With
+// --speed recorded the packets keep their recorded spacing; with --speed
+// fast (the default) they are fed as fast as they are handled, which
+// gives a repeatable throughput benchmark.
+
+#include "arch/Arch.h"
+#include "base/EventQueue.h"
+#include "base/Log.h"
+#include "client/Client.h"
+#include "client/HelloBack.h"
+#include "client/ServerProxy.h"
+#include "deskflow/ClientArgs.h"
+#include "deskflow/OptionTypes.h"
+#include "deskflow/PacketStreamFilter.h"
+#include "deskflow/ProtocolCapture.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/Screen.h"
+#include "deskflow/ServerArgs.h"
+#include "io/BufferStream.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPSocketFactory.h"
+#include "platform/HeadlessAppUtil.h"
+#include "platform/HeadlessScreen.h"
+#include "server/ClientProxy.h"
+#include "server/ClientProxyUnknown.h"
+#include "server/Config.h"
+#include "server/PrimaryClient.h"
+#include "server/Server.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+using deskflow::HeadlessScreen;
+using deskflow::ProtocolCapture;
+using deskflow::ProtocolCaptureReader;
+using Clock = std::chrono::steady_clock;
+using Peer = ProtocolCapture::Peer;
+using RecordType = ProtocolCapture::RecordType;
+
+namespace {
+
+const auto kServerName = "replay-server";
+const auto kClientName = "replay-client";
+
+// the client proxy gives up on a handshake after this long
+const double kHandshakeTimeout = 30.0;
+
+// offset of the screen name in a hello back message: protocol name,
+// major and minor version
+const std::size_t kHelloBackNameOffset = 11;
+
+struct Options
+{
+  std::string m_filename;
+  std::uint16_t m_stream = 0;
+  bool m_list = false;
+  bool m_recordedSpeed = false;
+  bool m_verbose = false;
+};
+
+double cpuTime()
+{
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+double secondsBetween(Clock::time_point from, Clock::time_point to)
+{
+  return std::chrono::duration<double>(to - from).count();
+}
+
+void printUsage(const char *name)
+{
+  std::printf(
+      "Usage: %s [options] <capture>\n"
+      "\n"
+      "Options:\n"
+      "  --list                 list the streams in the capture and exit\n"
+      "  --stream <id>          stream to replay (default the first)\n"
+      "  --speed <fast|recorded> feed packets as fast as they are handled (default),\n"
+      "                         or with their recorded spacing\n"
+      "  -v, --verbose          show deskflow log output\n"
+      "  -h, --help             show this help\n",
+      name
+  );
+}
+
+bool parseArgs(int argc, char **argv, Options &options)
+{
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+
+    if (arg == "-h" || arg == "--help") {
+      printUsage(argv[0]);
+      return false;
+    } else if (arg == "-v" || arg == "--verbose") {
+      options.m_verbose = true;
+    } else if (arg == "--list") {
+      options.m_list = true;
+    } else if (arg == "--stream" && hasValue) {
+      options.m_stream = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+    } else if (arg == "--speed" && hasValue) {
+      const std::string speed = argv[++i];
+      if (speed == "fast") {
+        options.m_recordedSpeed = false;
+      } else if (speed == "recorded") {
+        options.m_recordedSpeed = true;
+      } else {
+        std::fprintf(stderr, "unknown speed: %s\n", speed.c_str());
+        return false;
+      }
+    } else if (!arg.empty() && arg[0] != '-' && options.m_filename.empty()) {
+      options.m_filename = arg;
+    } else {
+      std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+      printUsage(argv[0]);
+      return false;
+    }
+  }
+
+  if (options.m_filename.empty()) {
+    std::fprintf(stderr, "no capture file given\n");
+    printUsage(argv[0]);
+    return false;
+  }
+  return true;
+}
+
+const char *peerName(Peer peer)
+{
+  return peer == Peer::Server ? "server" : "client";
+}
+
+//! Screen name from a hello back packet, or \p fallback if it isn't one
+std::string helloBackName(const ProtocolCaptureReader::Record &record, const std::string &fallback)
+{
+  if (record.m_size < kHelloBackNameOffset + 4) {
+    return fallback;
+  }
+
+  const auto *length = &record.m_data[kHelloBackNameOffset];
+  const auto size = (static_cast<std::uint32_t>(length[0]) << 24) | (static_cast<std::uint32_t>(length[1]) << 16) |
+                    (static_cast<std::uint32_t>(length[2]) << 8) | static_cast<std::uint32_t>(length[3]);
+  if (size == 0 || size > record.m_size - kHelloBackNameOffset - 4) {
+    return fallback;
+  }
+  return std::string(reinterpret_cast<const char *>(&length[4]), size);
+}
+
+void listStreams(const ProtocolCaptureReader &reader)
+{
+  std::printf("%-8s %-8s %10s %12s %10s %12s %10s\n", "stream", "peer", "in", "in bytes", "out", "out bytes", "seconds");
+  for (const auto stream : reader.streams()) {
+    std::uint64_t counts[2] = {};
+    std::uint64_t bytes[2] = {};
+    const auto records = reader.records(stream);
+    for (const auto &record : records) {
+      if (record.m_type == RecordType::Input || record.m_type == RecordType::Output) {
+        const auto index = record.m_type == RecordType::Input ? 0 : 1;
+        ++counts[index];
+        bytes[index] += record.m_size;
+      }
+    }
+
+    const auto seconds = static_cast<double>(records.back().m_time - records.front().m_time) / 1e9;
+    std::printf(
+        "%-8u %-8s %10llu %12llu %10llu %12llu %10.2f\n", stream, peerName(reader.peer(stream)),
+        static_cast<unsigned long long>(counts[0]), static_cast<unsigned long long>(bytes[0]),
+        static_cast<unsigned long long>(counts[1]), static_cast<unsigned long long>(bytes[1]), seconds
+    );
+  }
+}
+
+//! In-memory stand in for a socket
+/*!
+Reads return the packets fed in, framed as they would arrive from the
+network.  Writes are counted and discarded.
+*/
+class ReplayStream : public BufferStream
+{
+public:
+  explicit ReplayStream(IEventQueue *events) : m_events(events)
+  {
+    // do nothing
+  }
+
+  //! Append a packet and tell the reader about it
+  void feed(const std::uint8_t *data, std::uint32_t size)
+  {
+    const std::uint8_t length[4] = {
+        static_cast<std::uint8_t>(size >> 24), static_cast<std::uint8_t>(size >> 16),
+        static_cast<std::uint8_t>(size >> 8), static_cast<std::uint8_t>(size)
+    };
+    BufferStream::write(length, sizeof(length));
+    BufferStream::write(data, size);
+    m_events->dispatchEvent(Event(EventTypes::StreamInputReady, getEventTarget()));
+  }
+
+  std::uint64_t bytesWritten() const
+  {
+    return m_written;
+  }
+
+  // IStream overrides
+  void write(const void *, uint32_t n) override
+  {
+    m_written += n;
+  }
+
+  void writePacket(const deskflow::SharedPacket &packet) override
+  {
+    IStream::writePacket(packet);
+  }
+
+private:
+  IEventQueue *m_events;
+  std::uint64_t m_written = 0;
+};
+
+class Replay
+{
+public:
+  Replay(IEventQueue *events, const Options &options, Peer peer, std::vector<ProtocolCaptureReader::Record> records)
+      : m_events(events),
+        m_options(options),
+        m_peer(peer),
+        m_records(std::move(records)),
+        m_stream(events)
+  {
+    for (const auto &record : m_records) {
+      if (record.m_type == RecordType::Input) {
+        m_input.push_back(record);
+      } else if (record.m_type == RecordType::Output) {
+        m_recordedOutput += record.m_size + 4;
+      }
+    }
+  }
+
+  Replay(Replay const &) = delete;
+  Replay &operator=(Replay const &) = delete;
+
+  ~Replay()
+  {
+    removeTimer();
+
+    // ServerProxy only borrows the packet filter, the client proxies own it
+    if (m_peer == Peer::Server) {
+      delete m_serverProxy;
+      delete m_filter;
+    }
+    if (m_client != nullptr) {
+      m_events->removeHandler(EventTypes::ClientConnectionFailed, m_client->getEventTarget());
+      m_events->removeHandler(EventTypes::ClientDisconnected, m_client->getEventTarget());
+      delete m_client;
+    }
+
+    if (m_unknown != nullptr) {
+      m_events->removeHandler(EventTypes::ClientProxyUnknownSuccess, m_unknown);
+      m_events->removeHandler(EventTypes::ClientProxyUnknownFailure, m_unknown);
+      delete m_unknown;
+    }
+    delete m_server;
+    delete m_primaryClient;
+    delete m_primaryScreen;
+  }
+
+  bool start()
+  {
+    if (m_input.empty()) {
+      std::fprintf(stderr, "stream has no input to replay\n");
+      return false;
+    }
+
+    m_filter = new PacketStreamFilter(m_events, &m_stream, false);
+    if (m_peer == Peer::Server) {
+      startClient();
+    } else {
+      startServer();
+    }
+
+    m_cpuStart = cpuTime();
+    m_start = Clock::now();
+    scheduleStep(0.0);
+    return true;
+  }
+
+  int exitCode() const
+  {
+    return m_failed ? s_exitFailed : s_exitSuccess;
+  }
+
+private:
+  //! Replay into a ServerProxy, as the client that made the capture
+  void startClient()
+  {
+    // the client's own hello back holds the name it connected with
+    m_clientName = kClientName;
+    for (const auto &record : m_records) {
+      if (record.m_type == RecordType::Output) {
+        m_clientName = helloBackName(record, m_clientName);
+        break;
+      }
+    }
+
+    m_secondary = new HeadlessScreen(false, m_events);
+    m_secondary->setRecording(false);
+    m_secondary->setInjectHandler([this](const auto &) { ++m_injected; });
+
+    m_client = new Client(
+        m_events, m_clientName, NetworkAddress(), new TCPSocketFactory(m_events, &m_multiplexer),
+        new deskflow::Screen(m_secondary, m_events), m_clientArgs
+    );
+    m_events->addHandler(EventTypes::ClientConnectionFailed, m_client->getEventTarget(), [this](const auto &e) {
+      const auto *info = static_cast<const Client::FailInfo *>(e.getData());
+      fail(info != nullptr ? info->m_what.c_str() : "server proxy failed");
+    });
+    m_events->addHandler(EventTypes::ClientDisconnected, m_client->getEventTarget(), [this](const auto &) {
+      m_disconnected = true;
+    });
+
+    // say hello back the way Client does, then hand the stream to the proxy
+    m_helloBack = std::make_unique<deskflow::client::HelloBack>(std::make_shared<deskflow::client::HelloBack::Deps>(
+        [this]() { fail("invalid hello in capture"); },
+        [this](int major, int minor) {
+          fail(("capture protocol version " + std::to_string(major) + "." + std::to_string(minor) + " is too old")
+                   .c_str());
+        }
+    ));
+    m_events->addHandler(EventTypes::StreamInputReady, m_filter->getEventTarget(), [this](const auto &) {
+      handleHello();
+    });
+  }
+
+  void handleHello()
+  {
+    // only the hello goes through here, the proxy reads the rest
+    m_events->removeHandler(EventTypes::StreamInputReady, m_filter->getEventTarget());
+    m_helloBack->handleHello(m_filter, m_clientName);
+    if (m_failed) {
+      return;
+    }
+
+    m_serverProxy = new ServerProxy(m_client, m_filter, m_events, m_helloBack->negotiatedMinorVersion());
+    if (m_filter->isReady()) {
+      m_events->addEvent(Event(EventTypes::StreamInputReady, m_filter->getEventTarget()));
+    }
+  }
+
+  //! Replay through ClientProxyUnknown into a server, as the client that connected
+  void startServer()
+  {
+    const auto name = helloBackName(m_input.front(), kClientName);
+
+    // say hello with the protocol name the recorded server used
+    auto protocol = ENetworkProtocol::kSynergy;
+    for (const auto &record : m_records) {
+      if (record.m_type == RecordType::Output) {
+        const auto length = std::strlen(kBarrierProtocolName);
+        if (record.m_size >= length && std::memcmp(record.m_data, kBarrierProtocolName, length) == 0) {
+          protocol = ENetworkProtocol::kBarrier;
+        }
+        break;
+      }
+    }
+
+    auto config = std::make_shared<deskflow::server::Config>(m_events);
+    config->addScreen(kServerName);
+    config->addScreen(name);
+    config->connect(kServerName, Direction::Right, 0.0f, 1.0f, name, 0.0f, 1.0f);
+    config->connect(name, Direction::Left, 0.0f, 1.0f, kServerName, 0.0f, 1.0f);
+    config->addOption("", kOptionProtocol, static_cast<OptionValue>(protocol));
+    m_serverArgs.m_name = kServerName;
+    m_serverArgs.m_config = config;
+
+    m_primary = new HeadlessScreen(true, m_events);
+    m_primaryScreen = new deskflow::Screen(m_primary, m_events);
+    m_primaryClient = new PrimaryClient(kServerName, m_primaryScreen);
+    m_server = new Server(*config, m_primaryClient, m_primaryScreen, m_events, m_serverArgs);
+
+    m_unknown = new ClientProxyUnknown(m_filter, kHandshakeTimeout, m_server, m_events);
+    m_events->addHandler(EventTypes::ClientProxyUnknownSuccess, m_unknown, [this](const auto &) {
+      handleUnknownClient();
+    });
+    m_events->addHandler(EventTypes::ClientProxyUnknownFailure, m_unknown, [this](const auto &) {
+      fail("client proxy handshake failed");
+    });
+  }
+
+  void handleUnknownClient()
+  {
+    auto *proxy = m_unknown->orphanClientProxy();
+    m_events->removeHandler(EventTypes::ClientProxyUnknownSuccess, m_unknown);
+    m_events->removeHandler(EventTypes::ClientProxyUnknownFailure, m_unknown);
+    delete m_unknown;
+    m_unknown = nullptr;
+    m_server->adoptClient(proxy);
+  }
+
+  void scheduleStep(double delay)
+  {
+    m_timer = m_events->newOneShotTimer(delay, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_timer, [this](const auto &) { handleStep(); });
+  }
+
+  void removeTimer()
+  {
+    if (m_timer != nullptr) {
+      m_events->removeHandler(EventTypes::Timer, m_timer);
+      m_events->deleteTimer(m_timer);
+      m_timer = nullptr;
+    }
+  }
+
+  //! Feed the next packet, timers only fire once the queue is empty
+  void handleStep()
+  {
+    removeTimer();
+    if (m_failed) {
+      return;
+    }
+
+    if (m_next == m_input.size() || m_disconnected) {
+      finish();
+      return;
+    }
+
+    const auto &record = m_input[m_next++];
+    const auto now = Clock::now();
+    if (m_options.m_recordedSpeed) {
+      const auto due = static_cast<double>(record.m_time - m_input.front().m_time) / 1e9;
+      m_maxLag = std::max(m_maxLag, secondsBetween(m_start, now) - due);
+    }
+
+    m_bytes += record.m_size;
+    m_stream.feed(record.m_data, record.m_size);
+
+    double delay = 0.0;
+    if (m_options.m_recordedSpeed && m_next < m_input.size()) {
+      const auto due = static_cast<double>(m_input[m_next].m_time - m_input.front().m_time) / 1e9;
+      delay = std::max(0.0, due - secondsBetween(m_start, Clock::now()));
+    }
+    scheduleStep(delay);
+  }
+
+  void finish()
+  {
+    const auto seconds = secondsBetween(m_start, Clock::now());
+    const auto cpu = cpuTime() - m_cpuStart;
+    const auto packets = static_cast<double>(m_next);
+
+    std::printf(
+        "%-10s %10s %12s %12s %10s %12s %10s\n", "peer", "packets", "packets/sec", "MB/sec", "seconds", "cpu/pkt us",
+        "injected"
+    );
+    std::printf(
+        "%-10s %10llu %12.0f %12.2f %10.3f %12.2f %10llu\n", peerName(m_peer), static_cast<unsigned long long>(m_next),
+        seconds > 0.0 ? packets / seconds : 0.0,
+        seconds > 0.0 ? static_cast<double>(m_bytes) / seconds / (1024.0 * 1024.0) : 0.0, seconds,
+        packets > 0.0 ? cpu * 1e6 / packets : 0.0, static_cast<unsigned long long>(m_injected)
+    );
+    std::printf(
+        "output %llu bytes, %llu bytes in the capture\n", static_cast<unsigned long long>(m_stream.bytesWritten()),
+        static_cast<unsigned long long>(m_recordedOutput)
+    );
+    if (m_options.m_recordedSpeed) {
+      std::printf("fell behind the recording by at most %.3f ms\n", std::max(0.0, m_maxLag) * 1e3);
+    }
+    if (m_next < m_input.size()) {
+      std::printf(
+          "stopped after the connection was closed, %llu packets not replayed\n",
+          static_cast<unsigned long long>(m_input.size() - m_next)
+      );
+    }
+    std::fflush(stdout);
+
+    m_events->addEvent(Event(EventTypes::Quit));
+  }
+
+  void fail(const char *reason)
+  {
+    if (m_failed) {
+      return;
+    }
+    std::fprintf(
+        stderr, "replay failed after %llu of %llu packets: %s\n", static_cast<unsigned long long>(m_next),
+        static_cast<unsigned long long>(m_input.size()), reason
+    );
+    m_failed = true;
+    m_events->addEvent(Event(EventTypes::Quit));
+  }
+
+  IEventQueue *m_events;
+  Options m_options;
+  Peer m_peer;
+  std::vector<ProtocolCaptureReader::Record> m_records;
+  std::vector<ProtocolCaptureReader::Record> m_input;
+
+  ReplayStream m_stream;
+  PacketStreamFilter *m_filter = nullptr;
+  SocketMultiplexer m_multiplexer;
+
+  // client side
+  deskflow::ClientArgs m_clientArgs;
+  std::string m_clientName;
+  HeadlessScreen *m_secondary = nullptr;
+  Client *m_client = nullptr;
+  std::unique_ptr<deskflow::client::HelloBack> m_helloBack;
+  ServerProxy *m_serverProxy = nullptr;
+
+  // server side
+  deskflow::ServerArgs m_serverArgs;
+  HeadlessScreen *m_primary = nullptr;
+  deskflow::Screen *m_primaryScreen = nullptr;
+  PrimaryClient *m_primaryClient = nullptr;
+  Server *m_server = nullptr;
+  ClientProxyUnknown *m_unknown = nullptr;
+
+  EventQueueTimer *m_timer = nullptr;
+  std::size_t m_next = 0;
+  bool m_disconnected = false;
+  bool m_failed = false;
+
+  Clock::time_point m_start;
+  double m_cpuStart = 0.0;
+  double m_maxLag = 0.0;
+  std::uint64_t m_bytes = 0;
+  std::uint64_t m_injected = 0;
+  std::uint64_t m_recordedOutput = 0;
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Options options;
+  if (!parseArgs(argc, argv, options)) {
+    return s_exitArgs;
+  }
+
+  Arch arch;
+  arch.init();
+
+  // the client and server look up keyboard languages through the app
+  deskflow::HeadlessAppUtil appUtil;
+
+  Log log;
+  log.setFilter(options.m_verbose ? LogLevel::Debug : LogLevel::Warning);
+
+  ProtocolCaptureReader reader;
+  if (!reader.open(options.m_filename)) {
+    std::fprintf(stderr, "%s: %s\n", options.m_filename.c_str(), reader.error().c_str());
+    return s_exitFailed;
+  }
+  if (reader.isTruncated()) {
+    std::fprintf(stderr, "capture is truncated, replaying up to the last complete packet\n");
+  }
+
+  const auto streams = reader.streams();
+  if (streams.empty()) {
+    std::fprintf(stderr, "capture has no streams\n");
+    return s_exitFailed;
+  }
+  if (options.m_list) {
+    listStreams(reader);
+    return s_exitSuccess;
+  }
+
+  const auto stream = options.m_stream != 0 ? options.m_stream : streams.front();
+  if (std::find(streams.begin(), streams.end(), stream) == streams.end()) {
+    std::fprintf(stderr, "capture has no stream %u\n", stream);
+    return s_exitArgs;
+  }
+
+  EventQueue events;
+  Replay replay(&events, options, reader.peer(stream), reader.records(stream));
+  if (!replay.start()) {
+    return s_exitFailed;
+  }
+
+  events.loop();
+  return replay.exitCode();
+}
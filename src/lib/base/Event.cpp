@@ -7,6 +7,10 @@
 
 #include "base/Event.h"
 
+#include "base/InputTrace.h"
+
+using deskflow::InputTrace;
+
 //
 // Event
 //
@@ -14,7 +18,8 @@ Event::Event(EventTypes type, void *target, void *data, Flags flags)
     : m_type(type),
       m_target(target),
       m_data(data),
-      m_flags(flags)
+      m_flags(flags),
+      m_time(InputTrace::isEnabled() ? InputTrace::now() : 0)
 {
   // do nothing
 }
@@ -22,7 +27,8 @@ Event::Event(EventTypes type, void *target, void *data, Flags flags)
 Event::Event(EventTypes type, void *target, EventData *dataObject)
     : m_type(type),
       m_target(target),
-      m_dataObject(dataObject)
+      m_dataObject(dataObject),
+      m_time(InputTrace::isEnabled() ? InputTrace::now() : 0)
 {
   // do nothing
 }
@@ -52,6 +58,11 @@ Event::Flags Event::getFlags() const
   return m_flags;
 }
 
+uint64_t Event::getTime() const
+{
+  return m_time;
+}
+
 void Event::deleteData(const Event &event)
 {
   switch (event.getType()) {
@@ -76,3 +87,8 @@ void Event::setDataObject(EventData *dataObject)
   assert(m_dataObject == nullptr);
   m_dataObject = dataObject;
 }
+
+void Event::setTime(uint64_t time)
+{
+  m_time = time;
+}
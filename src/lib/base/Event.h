@@ -71,6 +71,13 @@ public:
   */
   void setDataObject(EventData *dataObject);
 
+  //! Set creation time
+  /*!
+  Overrides the time the event was created, used when an event is
+  forwarded on behalf of another event.
+  */
+  void setTime(uint64_t time);
+
   //@}
   //! @name accessors
   //@{
@@ -107,6 +114,14 @@ public:
   */
   Flags getFlags() const;
 
+  //! Get creation time
+  /*!
+  Returns the time the event was created in microseconds, as returned
+  by \c deskflow::InputTrace::now().  This is 0 unless input latency
+  tracing was enabled when the event was created.
+  */
+  uint64_t getTime() const;
+
   //@}
 
 private:
@@ -115,4 +130,5 @@ private:
   void *m_data = nullptr;
   Flags m_flags = EventFlags::NoFlags;
   EventData *m_dataObject = nullptr;
+  uint64_t m_time = 0;
 };
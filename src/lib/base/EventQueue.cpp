@@ -9,8 +9,10 @@
 #include "base/EventQueue.h"
 
 #include "arch/Arch.h"
+#include "base/InputTrace.h"
 #include "base/Log.h"
 #include "base/SimpleEventQueueBuffer.h"
+#include "base/Trace.h"
 #include "mt/Lock.h"
 #include "mt/Mutex.h"
 
@@ -159,7 +161,16 @@ bool EventQueue::getEvent(Event &event, double timeout)
 
 bool EventQueue::dispatchEvent(const Event &event)
 {
+  if (deskflow::InputTrace::isEnabled()) {
+    deskflow::InputTrace::beginEvent(event.getTime());
+  }
+
   void *target = event.getTarget();
+  TRACE_SCOPE_ARGS(
+      "event", "EventQueue::dispatchEvent", "type", static_cast<std::uint64_t>(event.getType()), "target",
+      reinterpret_cast<std::uintptr_t>(target)
+  );
+
   if (const auto *type_handler = getHandler(event.getType(), target); type_handler) {
     (*type_handler)(event);
     return true;
@@ -152,6 +152,10 @@ enum class EventTypes : uint32_t
   ServerAppForceReconnect,
   ServerAppResetServer,
 
+  /// This event is sent to write the input latency report to the log
+  /// and the event trace to the trace file.
+  AppDumpDiagnostics,
+
   /// This event is sent when key is down. Event data is a pointer to KeyInfo (count == 1)
   KeyStateKeyDown,
   /// This event is sent when key is up. Event data is a pointer to KeyInfo (count == 1)
@@ -0,0 +1,137 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/InputTrace.h"
+
+#include "base/LatencyHistogram.h"
+#include "base/Log.h"
+#include "base/String.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace deskflow {
+
+namespace {
+
+using Stage = InputTrace::Stage;
+
+struct Interval
+{
+  const char *m_name;
+  Stage m_from;
+  Stage m_to;
+  bool m_needsSync; //!< Spans both clocks
+};
+
+// the steps reported, the last one covers the whole path
+const std::array<Interval, 7> kIntervals{{
+    {"queue", Stage::Capture, Stage::Dispatch, false},
+    {"server", Stage::Dispatch, Stage::Server, false},
+    {"proxy", Stage::Server, Stage::Write, false},
+    {"network", Stage::Write, Stage::Read, true},
+    {"client", Stage::Read, Stage::Parse, false},
+    {"inject", Stage::Parse, Stage::Inject, false},
+    {"total", Stage::Capture, Stage::Inject, true},
+}};
+
+std::atomic_bool s_enabled{false};
+std::mutex s_mutex;
+std::array<LatencyHistogram, kIntervals.size()> s_histograms;
+
+// the event queue dispatches and handles an event on the same thread
+thread_local InputTrace::Stamps s_current;
+
+} // namespace
+
+void InputTrace::setEnabled(bool enabled)
+{
+  s_enabled = enabled;
+}
+
+bool InputTrace::isEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+InputTrace::Time InputTrace::now()
+{
+  using namespace std::chrono;
+  return static_cast<Time>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void InputTrace::beginEvent(Time captured)
+{
+  s_current = Stamps{};
+  s_current[Stage::Capture] = captured;
+  s_current[Stage::Dispatch] = now();
+}
+
+void InputTrace::stamp(Stage stage)
+{
+  if (isEnabled()) {
+    s_current[stage] = now();
+  }
+}
+
+const InputTrace::Stamps &InputTrace::current()
+{
+  return s_current;
+}
+
+void InputTrace::record(const Stamps &stamps)
+{
+  std::scoped_lock lock{s_mutex};
+  for (std::size_t i = 0; i < kIntervals.size(); ++i) {
+    const auto &interval = kIntervals[i];
+    const auto from = stamps[interval.m_from];
+    const auto to = stamps[interval.m_to];
+    if (from == 0 || to == 0 || (interval.m_needsSync && !stamps.m_clockSynced)) {
+      continue;
+    }
+
+    // clock offset error can make a short step appear negative
+    s_histograms[i].record(to > from ? to - from : 0);
+  }
+}
+
+void InputTrace::reset()
+{
+  std::scoped_lock lock{s_mutex};
+  for (auto &histogram : s_histograms) {
+    histogram.clear();
+  }
+}
+
+std::string InputTrace::report()
+{
+  std::scoped_lock lock{s_mutex};
+  std::string report = "input latency (us):\n";
+  report += string::sprintf("%-8s %10s %8s %8s %8s %8s %8s\n", "step", "count", "mean", "p50", "p99", "p999", "max");
+  for (std::size_t i = 0; i < kIntervals.size(); ++i) {
+    const auto &histogram = s_histograms[i];
+    report += string::sprintf(
+        "%-8s %10llu %8.0f %8llu %8llu %8llu %8llu\n", kIntervals[i].m_name,
+        static_cast<unsigned long long>(histogram.count()), histogram.mean(),
+        static_cast<unsigned long long>(histogram.percentile(50.0)),
+        static_cast<unsigned long long>(histogram.percentile(99.0)),
+        static_cast<unsigned long long>(histogram.percentile(99.9)), static_cast<unsigned long long>(histogram.max())
+    );
+  }
+  return report;
+}
+
+void InputTrace::dump()
+{
+  if (!isEnabled()) {
+    LOG_WARN("input latency tracing is not enabled");
+    return;
+  }
+  LOG_PRINT("%s", report().c_str());
+}
+
+} // namespace deskflow
@@ -0,0 +1,113 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace deskflow {
+
+//! End-to-end input latency tracing
+/*!
+Collects timestamps for an input event as it travels from the primary
+screen, through the server and the network, to injection on the client,
+and keeps a latency histogram for each step.  Tracing is off by default
+and costs a single atomic load per event when off.
+
+Stamps are taken on a monotonic clock in microseconds.  Stamps taken on
+the server are carried to the client by the input trace message and
+converted to the client clock using the offset estimated from keep
+alive round trips, so the complete trace is recorded on the client.
+*/
+class InputTrace
+{
+public:
+  //! Monotonic time in microseconds
+  using Time = std::uint64_t;
+
+  //! Points along the input path where a stamp is taken
+  enum class Stage
+  {
+    Capture,  //!< Event posted by the primary screen
+    Dispatch, //!< Event dispatched by the server event queue
+    Server,   //!< Event handled by the server
+    Write,    //!< Message written to the client stream
+    Read,     //!< Message readable on the client socket
+    Parse,    //!< Message parsed by the client
+    Inject,   //!< Event injected into the client screen
+    Count
+  };
+
+  static const std::size_t kStages = static_cast<std::size_t>(Stage::Count);
+
+  //! Timestamps for a single input event, 0 when a stage was not seen
+  struct Stamps
+  {
+    std::array<Time, kStages> m_time{};
+    bool m_clockSynced = false; //!< Server stamps are in the client clock
+
+    Time &operator[](Stage stage)
+    {
+      return m_time[static_cast<std::size_t>(stage)];
+    }
+
+    Time operator[](Stage stage) const
+    {
+      return m_time[static_cast<std::size_t>(stage)];
+    }
+  };
+
+  //! @name manipulators
+  //@{
+
+  //! Turn tracing on or off
+  static void setEnabled(bool enabled);
+
+  //! Start stamps for the event being dispatched on this thread
+  /*!
+  Sets the capture stamp to \p captured, which is the time the event
+  was created, and the dispatch stamp to now.
+  */
+  static void beginEvent(Time captured);
+
+  //! Stamp \p stage of the event being dispatched on this thread
+  /*!
+  Does nothing if tracing is off.
+  */
+  static void stamp(Stage stage);
+
+  //! Add the latencies between the stages in \p stamps
+  static void record(const Stamps &stamps);
+
+  //! Forget all recorded latencies
+  static void reset();
+
+  //! Write the latency report to the log
+  static void dump();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns true if tracing is on
+  static bool isEnabled();
+
+  //! Returns the current monotonic time
+  static Time now();
+
+  //! Returns the stamps of the event being dispatched on this thread
+  static const Stamps &current();
+
+  //! Returns a table of latency percentiles for each step
+  static std::string report();
+
+  //@}
+};
+
+} // namespace deskflow
@@ -0,0 +1,95 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace deskflow {
+
+// number of bits used to pick the linear sub-bucket
+static const int kSubBucketBits = 4;
+
+static const std::uint64_t kMaxValue = 0xffffffffu;
+
+void LatencyHistogram::record(std::uint64_t us)
+{
+  us = std::min(us, kMaxValue);
+
+  ++m_counts[bucketFor(us)];
+  if (m_count == 0 || us < m_min) {
+    m_min = us;
+  }
+  m_max = std::max(m_max, us);
+  m_sum += us;
+  ++m_count;
+}
+
+void LatencyHistogram::clear()
+{
+  m_counts.fill(0);
+  m_count = 0;
+  m_sum = 0;
+  m_min = 0;
+  m_max = 0;
+}
+
+double LatencyHistogram::mean() const
+{
+  if (m_count == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(m_sum) / static_cast<double>(m_count);
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  p = std::clamp(p, 0.0, 100.0);
+  auto rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(m_count)));
+  rank = std::max<std::uint64_t>(rank, 1);
+
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      return std::min(bucketUpperBound(i), m_max);
+    }
+  }
+  return m_max;
+}
+
+std::size_t LatencyHistogram::bucketFor(std::uint64_t us)
+{
+  us = std::min(us, kMaxValue);
+  if (us < kSubBuckets) {
+    return static_cast<std::size_t>(us);
+  }
+
+  // the top bit picks the power of two, the next bits the linear bucket
+  const auto msb = static_cast<int>(std::bit_width(us)) - 1;
+  const auto shift = msb - kSubBucketBits;
+  const auto sub = static_cast<std::size_t>((us >> shift) & (kSubBuckets - 1));
+  return static_cast<std::size_t>(shift + 1) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t bucket)
+{
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+
+  const auto shift = static_cast<int>(bucket / kSubBuckets) - 1;
+  const auto sub = static_cast<std::uint64_t>(bucket % kSubBuckets);
+  return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+} // namespace deskflow
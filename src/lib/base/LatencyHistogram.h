@@ -0,0 +1,89 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace deskflow {
+
+//! Histogram of latencies
+/*!
+Records latencies in microseconds into log-linear buckets: values below
+16 are counted exactly and every power of two above that is split into
+16 buckets, so percentiles are reported with at most 1/16 relative error
+using a fixed amount of memory.  Values above 2^32 - 1 are clamped.
+*/
+class LatencyHistogram
+{
+public:
+  //! Number of linear sub-buckets per power of two
+  static const std::size_t kSubBuckets = 16;
+
+  //! Total number of buckets
+  static const std::size_t kBuckets = 29 * kSubBuckets;
+
+  //! @name manipulators
+  //@{
+
+  //! Add a latency of \p us microseconds
+  void record(std::uint64_t us);
+
+  //! Remove all recorded latencies
+  void clear();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns the number of recorded latencies
+  std::uint64_t count() const
+  {
+    return m_count;
+  }
+
+  //! Returns the smallest recorded latency or 0 if none
+  std::uint64_t min() const
+  {
+    return m_count == 0 ? 0 : m_min;
+  }
+
+  //! Returns the largest recorded latency or 0 if none
+  std::uint64_t max() const
+  {
+    return m_max;
+  }
+
+  //! Returns the mean of the recorded latencies or 0 if none
+  double mean() const;
+
+  //! Returns the latency at percentile \p p (0 to 100)
+  /*!
+  Returns the upper bound of the bucket holding the requested rank,
+  limited to the largest recorded latency.  Returns 0 if nothing has
+  been recorded.
+  */
+  std::uint64_t percentile(double p) const;
+
+  //! Returns the bucket a latency of \p us is counted in
+  static std::size_t bucketFor(std::uint64_t us);
+
+  //! Returns the largest latency counted in \p bucket
+  static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+  //@}
+
+private:
+  std::array<std::uint64_t, kBuckets> m_counts{};
+  std::uint64_t m_count = 0;
+  std::uint64_t m_sum = 0;
+  std::uint64_t m_min = 0;
+  std::uint64_t m_max = 0;
+};
+
+} // namespace deskflow
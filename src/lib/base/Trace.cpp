@@ -0,0 +1,269 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/Trace.h"
+
+#include "base/Log.h"
+#include "base/String.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace deskflow {
+
+namespace {
+
+// spans kept for each thread, older spans are overwritten
+const std::size_t kCapacity = 16384;
+
+struct Span
+{
+  const char *m_category;
+  const char *m_name;
+  const char *m_argNames[2];
+  std::uint64_t m_args[2];
+  std::uint64_t m_begin;
+  std::uint64_t m_duration;
+};
+
+// a span in the ring buffer.  the fields are atomic since toJson() copies
+// records while their thread may be overwriting them; it throws away any
+// that were being overwritten, see toJson().
+struct Record
+{
+  std::atomic<const char *> m_category;
+  std::atomic<const char *> m_name;
+  std::atomic<const char *> m_argNames[2];
+  std::atomic<std::uint64_t> m_args[2];
+  std::atomic<std::uint64_t> m_begin;
+  std::atomic<std::uint64_t> m_duration;
+
+  void store(const Span &span)
+  {
+    m_category.store(span.m_category, std::memory_order_relaxed);
+    m_name.store(span.m_name, std::memory_order_relaxed);
+    m_argNames[0].store(span.m_argNames[0], std::memory_order_relaxed);
+    m_argNames[1].store(span.m_argNames[1], std::memory_order_relaxed);
+    m_args[0].store(span.m_args[0], std::memory_order_relaxed);
+    m_args[1].store(span.m_args[1], std::memory_order_relaxed);
+    m_begin.store(span.m_begin, std::memory_order_relaxed);
+    m_duration.store(span.m_duration, std::memory_order_relaxed);
+  }
+
+  Span load() const
+  {
+    return Span{
+        m_category.load(std::memory_order_relaxed),
+        m_name.load(std::memory_order_relaxed),
+        {m_argNames[0].load(std::memory_order_relaxed), m_argNames[1].load(std::memory_order_relaxed)},
+        {m_args[0].load(std::memory_order_relaxed), m_args[1].load(std::memory_order_relaxed)},
+        m_begin.load(std::memory_order_relaxed),
+        m_duration.load(std::memory_order_relaxed)
+    };
+  }
+};
+
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(int id) : m_id(id)
+  {
+    // do nothing
+  }
+
+  const int m_id;
+  std::atomic<std::uint64_t> m_written{0};
+  std::array<Record, kCapacity> m_records{};
+};
+
+std::atomic_bool s_enabled{false};
+std::atomic<std::uint64_t> s_since{0};
+
+// buffers outlive their threads so spans from finished threads are kept
+std::mutex s_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+
+thread_local std::shared_ptr<ThreadBuffer> s_buffer;
+
+std::uint64_t now()
+{
+  using namespace std::chrono;
+  return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+ThreadBuffer &threadBuffer()
+{
+  if (s_buffer == nullptr) {
+    std::scoped_lock lock{s_mutex};
+
+    // reuse the buffer of a finished thread before making a new one
+    for (const auto &buffer : s_buffers) {
+      if (buffer.use_count() == 1) {
+        s_buffer = buffer;
+        break;
+      }
+    }
+
+    if (s_buffer == nullptr) {
+      s_buffer = std::make_shared<ThreadBuffer>(static_cast<int>(s_buffers.size()) + 1);
+      s_buffers.push_back(s_buffer);
+    }
+  }
+  return *s_buffer;
+}
+
+std::string formatRecord(const Span &record, int threadId)
+{
+  auto json = string::sprintf(
+      R"({"name":"%s","cat":"%s","ph":"X","ts":%.3f,"dur":%.3f,"pid":1,"tid":%d)", record.m_name,
+      record.m_category, static_cast<double>(record.m_begin) / 1000.0, static_cast<double>(record.m_duration) / 1000.0,
+      threadId
+  );
+
+  if (record.m_argNames[0] != nullptr) {
+    json += string::sprintf(
+        R"(,"args":{"%s":%llu)", record.m_argNames[0], static_cast<unsigned long long>(record.m_args[0])
+    );
+    if (record.m_argNames[1] != nullptr) {
+      json +=
+          string::sprintf(R"(,"%s":%llu)", record.m_argNames[1], static_cast<unsigned long long>(record.m_args[1]));
+    }
+    json += "}";
+  }
+
+  json += "}";
+  return json;
+}
+
+} // namespace
+
+//
+// Trace::Scope
+//
+
+Trace::Scope::Scope(
+    const char *category, const char *name, const char *argName1, std::uint64_t arg1, const char *argName2,
+    std::uint64_t arg2
+)
+    : m_category(category),
+      m_name(name),
+      m_argNames{argName1, argName2},
+      m_args{arg1, arg2}
+{
+  if (isEnabled()) {
+    m_begin = now();
+  }
+}
+
+Trace::Scope::~Scope()
+{
+  if (m_begin == 0) {
+    return;
+  }
+
+  // only this thread writes to its buffer, so the record can be filled
+  // in place and published by advancing the count.  the fence makes sure
+  // anything that sees the new fields also sees the count from before.
+  auto &buffer = threadBuffer();
+  const auto index = buffer.m_written.load(std::memory_order_relaxed);
+  const Span span{m_category, m_name, {m_argNames[0], m_argNames[1]}, {m_args[0], m_args[1]}, m_begin, now() - m_begin};
+  std::atomic_thread_fence(std::memory_order_release);
+  buffer.m_records[index % kCapacity].store(span);
+  buffer.m_written.store(index + 1, std::memory_order_release);
+}
+
+//
+// Trace
+//
+
+void Trace::start()
+{
+#if !defined(DESKFLOW_EVENT_TRACING)
+  LOG_WARN("event tracing is not compiled in, no spans will be recorded");
+#endif
+
+  s_since = now();
+  s_enabled = true;
+}
+
+void Trace::stop()
+{
+  s_enabled = false;
+}
+
+bool Trace::isEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+std::string Trace::toJson()
+{
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock{s_mutex};
+    buffers = s_buffers;
+  }
+
+  const auto since = s_since.load();
+  std::string json = R"({"traceEvents":[)";
+  bool first = true;
+  for (const auto &buffer : buffers) {
+    // copy the records first, the oldest may be overwritten meanwhile
+    const auto written = buffer->m_written.load(std::memory_order_acquire);
+    const auto oldest = written > kCapacity ? written - kCapacity : 0;
+    std::vector<Span> spans;
+    spans.reserve(written - oldest);
+    for (auto i = oldest; i < written; ++i) {
+      spans.push_back(buffer->m_records[i % kCapacity].load());
+    }
+
+    // then throw away any whose slot the thread has since started writing
+    // again, since they may mix fields from two spans
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto rewritten = buffer->m_written.load(std::memory_order_relaxed);
+    const auto valid = rewritten >= kCapacity ? rewritten - kCapacity + 1 : 0;
+    for (auto i = std::max(oldest, valid); i < written; ++i) {
+      const auto &span = spans[i - oldest];
+      if (span.m_begin < since) {
+        continue;
+      }
+
+      if (!first) {
+        json += ",\n";
+      }
+      json += formatRecord(span, buffer->m_id);
+      first = false;
+    }
+  }
+  json += R"(],"displayTimeUnit":"ms"})";
+  return json;
+}
+
+bool Trace::write(const std::string &filename)
+{
+  std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG_ERR("failed to open trace file: %s", filename.c_str());
+    return false;
+  }
+
+  file << toJson();
+  file.close();
+  if (file.fail()) {
+    LOG_ERR("failed to write trace file: %s", filename.c_str());
+    return false;
+  }
+
+  LOG_INFO("wrote event trace to: %s", filename.c_str());
+  return true;
+}
+
+} // namespace deskflow
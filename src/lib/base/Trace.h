@@ -0,0 +1,94 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace deskflow {
+
+//! Event tracing
+/*!
+Records timed spans into a fixed size ring buffer owned by each thread,
+so a thread never waits on another to record a span and only the most
+recent spans are kept.  Recording is off by default; spans cost a single
+atomic load when it is off, and nothing at all when event tracing is not
+compiled in.  The spans can be written as Chrome trace event JSON, which
+can be opened in a trace viewer such as Perfetto or about:tracing.
+
+Spans are added with the TRACE_SCOPE() and TRACE_SCOPE_ARGS() macros.
+The category, name and argument names must be string literals, since
+only the pointers are recorded.
+*/
+class Trace
+{
+public:
+  //! Span covering the lifetime of the object
+  class Scope
+  {
+  public:
+    Scope(
+        const char *category, const char *name, const char *argName1 = nullptr, std::uint64_t arg1 = 0,
+        const char *argName2 = nullptr, std::uint64_t arg2 = 0
+    );
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    const char *m_category;
+    const char *m_name;
+    const char *m_argNames[2];
+    std::uint64_t m_args[2];
+    std::uint64_t m_begin = 0; //!< 0 when not recording
+  };
+
+  //! @name manipulators
+  //@{
+
+  //! Start recording spans
+  /*!
+  Spans recorded before this call are not written.
+  */
+  static void start();
+
+  //! Stop recording spans
+  static void stop();
+
+  //! Write the recorded spans to \p filename
+  /*!
+  Returns false if the file could not be written.
+  */
+  static bool write(const std::string &filename);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns true if spans are being recorded
+  static bool isEnabled();
+
+  //! Returns the recorded spans as Chrome trace event JSON
+  static std::string toJson();
+
+  //@}
+};
+
+} // namespace deskflow
+
+#if defined(DESKFLOW_EVENT_TRACING)
+#define DESKFLOW_TRACE_CONCAT_(a, b) a##b
+#define DESKFLOW_TRACE_CONCAT(a, b) DESKFLOW_TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(category, name)                                                                                    \
+  const deskflow::Trace::Scope DESKFLOW_TRACE_CONCAT(traceScope, __LINE__)(category, name)
+#define TRACE_SCOPE_ARGS(category, name, ...)                                                                          \
+  const deskflow::Trace::Scope DESKFLOW_TRACE_CONCAT(traceScope, __LINE__)(category, name, __VA_ARGS__)
+#else
+#define TRACE_SCOPE(category, name)
+#define TRACE_SCOPE_ARGS(category, name, ...)
+#endif
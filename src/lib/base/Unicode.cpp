@@ -8,6 +8,21 @@
 #include "base/Unicode.h"
 #include "arch/Arch.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define UNICODE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(UNICODE_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UNICODE_AVX2
+#include <immintrin.h>
+#endif
+
 using enum ArchString::EWideCharEncoding;
 //
 // local utility functions
@@ -67,6 +82,362 @@ inline static void setError(bool *errors)
   }
 }
 
+inline static uint8_t *encode16(uint8_t *dst, uint16_t c)
+{
+  memcpy(dst, &c, 2);
+  return dst + 2;
+}
+
+inline static uint8_t *encode32(uint8_t *dst, uint32_t c)
+{
+  memcpy(dst, &c, 4);
+  return dst + 4;
+}
+
+//
+// ascii kernels
+//
+// most clipboard text is all or nearly all ascii, which converts between
+// UTF-8 and the wide encodings by widening or narrowing each byte.  each
+// kernel converts the ascii characters at the start of its input, stops
+// at the first character that isn't ascii and returns how many it
+// converted.  everything else goes through fromUTF8() and toUTF8() so
+// errors and replacements are the same as they always were.
+//
+// the vector kernels convert a whole block before looking at where the
+// ascii ends, so they may write past the characters they return, though
+// never past room for the n characters they're given.  the next
+// character overwrites whatever they left there.
+//
+// x86 gets SSE2 kernels, which every x86-64 cpu has, and with gcc or
+// clang AVX2 kernels for UTF-8 input, picked at runtime.  other cpus test
+// eight bytes at a time.
+//
+
+static size_t countASCIIScalar(const uint8_t *src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t word;
+    memcpy(&word, src + i, 8);
+    if ((word & 0x8080808080808080) != 0) {
+      break;
+    }
+  }
+  while (i < n && src[i] < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+template <typename Unit> static size_t widenASCIIScalar(const uint8_t *src, size_t n, uint8_t *dst)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint64_t word;
+    memcpy(&word, src + i, 8);
+    if ((word & 0x8080808080808080) != 0) {
+      break;
+    }
+    for (size_t j = i; j < i + 8; ++j) {
+      const auto c = static_cast<Unit>(src[j]);
+      memcpy(dst + sizeof(Unit) * j, &c, sizeof(Unit));
+    }
+  }
+  for (; i < n && src[i] < 0x80; ++i) {
+    const auto c = static_cast<Unit>(src[i]);
+    memcpy(dst + sizeof(Unit) * i, &c, sizeof(Unit));
+  }
+  return i;
+}
+
+#if defined(UNICODE_SSE2)
+
+static size_t countASCIISSE2(const uint8_t *src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(bytes)); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+  return i + countASCIIScalar(src + i, n - i);
+}
+
+static size_t widenASCII16SSE2(const uint8_t *src, size_t n, uint8_t *dst)
+{
+  const auto zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    auto *out = reinterpret_cast<__m128i *>(dst + 2 * i);
+    _mm_storeu_si128(out, _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(bytes, zero));
+    if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(bytes)); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+  return i + widenASCIIScalar<uint16_t>(src + i, n - i, dst + 2 * i);
+}
+
+static size_t widenASCII32SSE2(const uint8_t *src, size_t n, uint8_t *dst)
+{
+  const auto zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const auto lo = _mm_unpacklo_epi8(bytes, zero);
+    const auto hi = _mm_unpackhi_epi8(bytes, zero);
+    auto *out = reinterpret_cast<__m128i *>(dst + 4 * i);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+    if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(bytes)); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+  return i + widenASCIIScalar<uint32_t>(src + i, n - i, dst + 4 * i);
+}
+
+#endif
+
+#if defined(UNICODE_AVX2)
+
+// each AVX2 kernel leaves the last few bytes to the SSE2 kernel, clearing
+// the upper halves of the registers first to save the cost of switching
+// between the two
+
+__attribute__((target("avx2"))) static size_t countASCIIAVX2(const uint8_t *src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(bytes)); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+  _mm256_zeroupper();
+  return i + countASCIISSE2(src + i, n - i);
+}
+
+__attribute__((target("avx2"))) static size_t widenASCII16AVX2(const uint8_t *src, size_t n, uint8_t *dst)
+{
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    auto *out = reinterpret_cast<__m256i *>(dst + 2 * i);
+    _mm256_storeu_si256(out, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+    _mm256_storeu_si256(out + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+    if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(bytes)); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+  _mm256_zeroupper();
+  return i + widenASCII16SSE2(src + i, n - i, dst + 2 * i);
+}
+
+__attribute__((target("avx2"))) static size_t widenASCII32AVX2(const uint8_t *src, size_t n, uint8_t *dst)
+{
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    const auto lo = _mm256_castsi256_si128(bytes);
+    const auto hi = _mm256_extracti128_si256(bytes, 1);
+    auto *out = reinterpret_cast<__m256i *>(dst + 4 * i);
+    _mm256_storeu_si256(out, _mm256_cvtepu8_epi32(lo));
+    _mm256_storeu_si256(out + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+    _mm256_storeu_si256(out + 2, _mm256_cvtepu8_epi32(hi));
+    _mm256_storeu_si256(out + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+    if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(bytes)); mask != 0) {
+      return i + std::countr_zero(mask);
+    }
+  }
+  _mm256_zeroupper();
+  return i + widenASCII32SSE2(src + i, n - i, dst + 4 * i);
+}
+
+static bool hasAVX2()
+{
+  static const bool s_avx2 = __builtin_cpu_supports("avx2");
+  return s_avx2;
+}
+
+#endif
+
+// returns the number of ascii bytes at the start of src
+static size_t countASCII(const uint8_t *src, size_t n)
+{
+#if defined(UNICODE_AVX2)
+  if (hasAVX2()) {
+    return countASCIIAVX2(src, n);
+  }
+#endif
+#if defined(UNICODE_SSE2)
+  return countASCIISSE2(src, n);
+#else
+  return countASCIIScalar(src, n);
+#endif
+}
+
+// widens the ascii bytes at the start of src to 16 bit characters
+static size_t widenASCII16(const uint8_t *src, size_t n, uint8_t *dst)
+{
+#if defined(UNICODE_AVX2)
+  if (hasAVX2()) {
+    return widenASCII16AVX2(src, n, dst);
+  }
+#endif
+#if defined(UNICODE_SSE2)
+  return widenASCII16SSE2(src, n, dst);
+#else
+  return widenASCIIScalar<uint16_t>(src, n, dst);
+#endif
+}
+
+// widens the ascii bytes at the start of src to 32 bit characters
+static size_t widenASCII32(const uint8_t *src, size_t n, uint8_t *dst)
+{
+#if defined(UNICODE_AVX2)
+  if (hasAVX2()) {
+    return widenASCII32AVX2(src, n, dst);
+  }
+#endif
+#if defined(UNICODE_SSE2)
+  return widenASCII32SSE2(src, n, dst);
+#else
+  return widenASCIIScalar<uint32_t>(src, n, dst);
+#endif
+}
+
+// narrows the ascii characters at the start of n 16 bit characters
+static size_t narrowASCII16(const uint8_t *src, size_t n, bool byteSwapped, uint8_t *dst)
+{
+  size_t i = 0;
+#if defined(UNICODE_SSE2)
+  // x86 is little endian, so a byte swapped character is in the high byte
+  const auto mask = _mm_set1_epi16(static_cast<int16_t>(byteSwapped ? 0x80ff : 0xff80));
+  const auto zero = _mm_setzero_si128();
+  for (; i + 16 <= n; i += 16) {
+    const auto *in = reinterpret_cast<const __m128i *>(src + 2 * i);
+    auto lo = _mm_loadu_si128(in);
+    auto hi = _mm_loadu_si128(in + 1);
+    const auto asciiLo = _mm_cmpeq_epi16(_mm_and_si128(lo, mask), zero);
+    const auto asciiHi = _mm_cmpeq_epi16(_mm_and_si128(hi, mask), zero);
+    if (byteSwapped) {
+      lo = _mm_srli_epi16(lo, 8);
+      hi = _mm_srli_epi16(hi, 8);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+    const auto ascii = static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(asciiLo, asciiHi)));
+    if (ascii != 0xffff) {
+      return i + std::countr_one(ascii);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    const auto c = decode16(src + 2 * i, byteSwapped);
+    if (c >= 0x80) {
+      break;
+    }
+    dst[i] = static_cast<uint8_t>(c);
+  }
+  return i;
+}
+
+// narrows the ascii characters at the start of n 32 bit characters
+static size_t narrowASCII32(const uint8_t *src, size_t n, bool byteSwapped, uint8_t *dst)
+{
+  size_t i = 0;
+#if defined(UNICODE_SSE2)
+  const auto mask = _mm_set1_epi32(static_cast<int32_t>(byteSwapped ? 0x80ffffff : 0xffffff80));
+  const auto zero = _mm_setzero_si128();
+  for (; i + 16 <= n; i += 16) {
+    const auto *in = reinterpret_cast<const __m128i *>(src + 4 * i);
+    auto a = _mm_loadu_si128(in);
+    auto b = _mm_loadu_si128(in + 1);
+    auto c = _mm_loadu_si128(in + 2);
+    auto d = _mm_loadu_si128(in + 3);
+    const auto asciiAB = _mm_packs_epi32(
+        _mm_cmpeq_epi32(_mm_and_si128(a, mask), zero), _mm_cmpeq_epi32(_mm_and_si128(b, mask), zero)
+    );
+    const auto asciiCD = _mm_packs_epi32(
+        _mm_cmpeq_epi32(_mm_and_si128(c, mask), zero), _mm_cmpeq_epi32(_mm_and_si128(d, mask), zero)
+    );
+    if (byteSwapped) {
+      a = _mm_srli_epi32(a, 24);
+      b = _mm_srli_epi32(b, 24);
+      c = _mm_srli_epi32(c, 24);
+      d = _mm_srli_epi32(d, 24);
+    }
+    const auto packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    const auto ascii = static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(asciiAB, asciiCD)));
+    if (ascii != 0xffff) {
+      return i + std::countr_one(ascii);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    const auto c = decode32(src + 4 * i, byteSwapped);
+    if (c >= 0x80) {
+      break;
+    }
+    dst[i] = static_cast<uint8_t>(c);
+  }
+  return i;
+}
+
+//
+// Output
+//
+// conversions write into a buffer on the stack and append it to the
+// string a block at a time, rather than appending every character.
+//
+
+class Output
+{
+public:
+  explicit Output(std::string &dst) : m_dst(dst)
+  {
+  }
+
+  Output(const Output &) = delete;
+  Output &operator=(const Output &) = delete;
+
+  // returns where to write, flushing first if there's less than size
+  // bytes of room left
+  uint8_t *reserve(size_t size)
+  {
+    if (room() < size) {
+      flush();
+    }
+    return m_end;
+  }
+
+  size_t room() const
+  {
+    return static_cast<size_t>(m_buffer.data() + m_buffer.size() - m_end);
+  }
+
+  void commit(uint8_t *end)
+  {
+    m_end = end;
+  }
+
+  void flush()
+  {
+    m_dst.append(reinterpret_cast<const char *>(m_buffer.data()), m_end - m_buffer.data());
+    m_end = m_buffer.data();
+  }
+
+private:
+  std::string &m_dst;
+  std::array<uint8_t, 8192> m_buffer;
+  uint8_t *m_end = m_buffer.data();
+};
+
 //
 // Unicode
 //
@@ -79,8 +450,13 @@ bool Unicode::isUTF8(const std::string &src)
   // convert and test each character
   const auto *data = reinterpret_cast<const uint8_t *>(src.c_str());
   for (auto n = (uint32_t)src.size(); n > 0;) {
-    if (fromUTF8(data, n) == s_invalid) {
+    if (const auto c = fromUTF8(data, n); c == s_invalid) {
       return false;
+    } else if (c < 0x80) {
+      // skip the rest of the ascii that follows in one go
+      const auto ascii = static_cast<uint32_t>(countASCII(data, n));
+      data += ascii;
+      n -= ascii;
     }
   }
   return true;
@@ -95,10 +471,19 @@ std::string Unicode::UTF8ToUCS2(const std::string &src, bool *errors)
   auto n = (uint32_t)src.size();
   std::string dst;
   dst.reserve(2 * n);
+  Output out(dst);
 
   // convert each character
   const auto *data = reinterpret_cast<const uint8_t *>(src.c_str());
   while (n > 0) {
+    auto *end = out.reserve(2);
+    if (*data < 0x80) {
+      const auto ascii = static_cast<uint32_t>(widenASCII16(data, std::min<size_t>(n, out.room() / 2), end));
+      data += ascii;
+      n -= ascii;
+      out.commit(end + 2 * ascii);
+      continue;
+    }
     uint32_t c = fromUTF8(data, n);
     if (c == s_invalid) {
       c = s_replacement;
@@ -106,10 +491,10 @@ std::string Unicode::UTF8ToUCS2(const std::string &src, bool *errors)
       setError(errors);
       c = s_replacement;
     }
-    auto ucs2 = static_cast<uint16_t>(c);
-    dst.append(reinterpret_cast<const char *>(&ucs2), 2);
+    out.commit(encode16(end, static_cast<uint16_t>(c)));
   }
 
+  out.flush();
   return dst;
 }
 
@@ -122,17 +507,27 @@ std::string Unicode::UTF8ToUCS4(const std::string &src, bool *errors)
   auto n = (uint32_t)src.size();
   std::string dst;
   dst.reserve(4 * n);
+  Output out(dst);
 
   // convert each character
   const auto *data = reinterpret_cast<const uint8_t *>(src.c_str());
   while (n > 0) {
+    auto *end = out.reserve(4);
+    if (*data < 0x80) {
+      const auto ascii = static_cast<uint32_t>(widenASCII32(data, std::min<size_t>(n, out.room() / 4), end));
+      data += ascii;
+      n -= ascii;
+      out.commit(end + 4 * ascii);
+      continue;
+    }
     uint32_t c = fromUTF8(data, n);
     if (c == s_invalid) {
       c = s_replacement;
     }
-    dst.append(reinterpret_cast<const char *>(&c), 4);
+    out.commit(encode32(end, c));
   }
 
+  out.flush();
   return dst;
 }
 
@@ -145,10 +540,19 @@ std::string Unicode::UTF8ToUTF16(const std::string &src, bool *errors)
   auto n = (uint32_t)src.size();
   std::string dst;
   dst.reserve(2 * n);
+  Output out(dst);
 
   // convert each character
   const auto *data = reinterpret_cast<const uint8_t *>(src.c_str());
   while (n > 0) {
+    auto *end = out.reserve(4);
+    if (*data < 0x80) {
+      const auto ascii = static_cast<uint32_t>(widenASCII16(data, std::min<size_t>(n, out.room() / 2), end));
+      data += ascii;
+      n -= ascii;
+      out.commit(end + 2 * ascii);
+      continue;
+    }
     uint32_t c = fromUTF8(data, n);
     if (c == s_invalid) {
       c = s_replacement;
@@ -157,17 +561,16 @@ std::string Unicode::UTF8ToUTF16(const std::string &src, bool *errors)
       c = s_replacement;
     }
     if (c < 0x00010000) {
-      auto ucs2 = static_cast<uint16_t>(c);
-      dst.append(reinterpret_cast<const char *>(&ucs2), 2);
+      end = encode16(end, static_cast<uint16_t>(c));
     } else {
       c -= 0x00010000;
-      auto utf16h = static_cast<uint16_t>((c >> 10) + 0xd800);
-      auto utf16l = static_cast<uint16_t>((c & 0x03ff) + 0xdc00);
-      dst.append(reinterpret_cast<const char *>(&utf16h), 2);
-      dst.append(reinterpret_cast<const char *>(&utf16l), 2);
+      end = encode16(end, static_cast<uint16_t>((c >> 10) + 0xd800));
+      end = encode16(end, static_cast<uint16_t>((c & 0x03ff) + 0xdc00));
     }
+    out.commit(end);
   }
 
+  out.flush();
   return dst;
 }
 
@@ -180,10 +583,19 @@ std::string Unicode::UTF8ToUTF32(const std::string &src, bool *errors)
   auto n = (uint32_t)src.size();
   std::string dst;
   dst.reserve(4 * n);
+  Output out(dst);
 
   // convert each character
   const auto *data = reinterpret_cast<const uint8_t *>(src.c_str());
   while (n > 0) {
+    auto *end = out.reserve(4);
+    if (*data < 0x80) {
+      const auto ascii = static_cast<uint32_t>(widenASCII32(data, std::min<size_t>(n, out.room() / 4), end));
+      data += ascii;
+      n -= ascii;
+      out.commit(end + 4 * ascii);
+      continue;
+    }
     uint32_t c = fromUTF8(data, n);
     if (c == s_invalid) {
       c = s_replacement;
@@ -191,9 +603,10 @@ std::string Unicode::UTF8ToUTF32(const std::string &src, bool *errors)
       setError(errors);
       c = s_replacement;
     }
-    dst.append(reinterpret_cast<const char *>(&c), 4);
+    out.commit(encode32(end, c));
   }
 
+  out.flush();
   return dst;
 }
 
@@ -347,6 +760,7 @@ std::string Unicode::doUCS2ToUTF8(const uint8_t *data, uint32_t n, bool *errors)
   // make some space
   std::string dst;
   dst.reserve(n);
+  Output out(dst);
 
   // check if first character is 0xfffe or 0xfeff
   bool byteSwapped = false;
@@ -369,12 +783,21 @@ std::string Unicode::doUCS2ToUTF8(const uint8_t *data, uint32_t n, bool *errors)
   }
 
   // convert each character
-  for (; n > 0; --n) {
-    uint32_t c = decode16(data, byteSwapped);
-    toUTF8(dst, c, errors);
-    data += 2;
+  while (n > 0) {
+    auto *end = out.reserve(6);
+    if (uint32_t c = decode16(data, byteSwapped); c >= 0x00000080) {
+      out.commit(toUTF8(end, c, errors));
+      data += 2;
+      --n;
+      continue;
+    }
+    const auto ascii = static_cast<uint32_t>(narrowASCII16(data, std::min<size_t>(n, out.room()), byteSwapped, end));
+    data += 2 * ascii;
+    n -= ascii;
+    out.commit(end + ascii);
   }
 
+  out.flush();
   return dst;
 }
 
@@ -383,6 +806,7 @@ std::string Unicode::doUCS4ToUTF8(const uint8_t *data, uint32_t n, bool *errors)
   // make some space
   std::string dst;
   dst.reserve(n);
+  Output out(dst);
 
   // check if first character is 0xfffe or 0xfeff
   bool byteSwapped = false;
@@ -405,12 +829,21 @@ std::string Unicode::doUCS4ToUTF8(const uint8_t *data, uint32_t n, bool *errors)
   }
 
   // convert each character
-  for (; n > 0; --n) {
-    auto c = decode32(data, byteSwapped);
-    toUTF8(dst, c, errors);
-    data += 4;
+  while (n > 0) {
+    auto *end = out.reserve(6);
+    if (auto c = decode32(data, byteSwapped); c >= 0x00000080) {
+      out.commit(toUTF8(end, c, errors));
+      data += 4;
+      --n;
+      continue;
+    }
+    const auto ascii = static_cast<uint32_t>(narrowASCII32(data, std::min<size_t>(n, out.room()), byteSwapped, end));
+    data += 4 * ascii;
+    n -= ascii;
+    out.commit(end + ascii);
   }
 
+  out.flush();
   return dst;
 }
 
@@ -419,6 +852,7 @@ std::string Unicode::doUTF16ToUTF8(const uint8_t *data, uint32_t n, bool *errors
   // make some space
   std::string dst;
   dst.reserve(n);
+  Output out(dst);
 
   // check if first character is 0xfffe or 0xfeff
   bool byteSwapped = false;
@@ -442,32 +876,42 @@ std::string Unicode::doUTF16ToUTF8(const uint8_t *data, uint32_t n, bool *errors
 
   // convert each character
   while (n > 0) {
-    if (uint32_t c = decode16(data, byteSwapped); c < 0x0000d800 || c > 0x0000dfff) {
-      toUTF8(dst, c, errors);
+    auto *end = out.reserve(6);
+    if (uint32_t c = decode16(data, byteSwapped); c < 0x00000080) {
+      const auto ascii =
+          static_cast<uint32_t>(narrowASCII16(data, std::min<size_t>(n, out.room()), byteSwapped, end));
+      data += 2 * ascii;
+      n -= ascii;
+      out.commit(end + ascii);
+      continue;
+    } else if (c < 0x0000d800 || c > 0x0000dfff) {
+      end = toUTF8(end, c, errors);
     } else if (n == 1) {
       // error -- missing second word
       setError(errors);
-      toUTF8(dst, s_replacement, nullptr);
+      end = toUTF8(end, s_replacement, nullptr);
     } else if (c >= 0x0000d800 && c <= 0x0000dbff) {
       data += 2;
       --n;
       if (uint32_t c2 = decode16(data, byteSwapped); c2 < 0x0000dc00 || c2 > 0x0000dfff) {
         // error -- [d800,dbff] not followed by [dc00,dfff]
         setError(errors);
-        toUTF8(dst, s_replacement, nullptr);
+        end = toUTF8(end, s_replacement, nullptr);
       } else {
         c = (((c - 0x0000d800) << 10) | (c2 - 0x0000dc00)) + 0x00010000;
-        toUTF8(dst, c, errors);
+        end = toUTF8(end, c, errors);
       }
     } else {
       // error -- [dc00,dfff] without leading [d800,dbff]
       setError(errors);
-      toUTF8(dst, s_replacement, nullptr);
+      end = toUTF8(end, s_replacement, nullptr);
     }
+    out.commit(end);
     data += 2;
     --n;
   }
 
+  out.flush();
   return dst;
 }
 
@@ -476,6 +920,7 @@ std::string Unicode::doUTF32ToUTF8(const uint8_t *data, uint32_t n, bool *errors
   // make some space
   std::string dst;
   dst.reserve(n);
+  Output out(dst);
 
   // check if first character is 0xfffe or 0xfeff
   bool byteSwapped = false;
@@ -498,16 +943,27 @@ std::string Unicode::doUTF32ToUTF8(const uint8_t *data, uint32_t n, bool *errors
   }
 
   // convert each character
-  for (; n > 0; --n) {
+  while (n > 0) {
+    auto *end = out.reserve(6);
     auto c = decode32(data, byteSwapped);
+    if (c < 0x00000080) {
+      const auto ascii =
+          static_cast<uint32_t>(narrowASCII32(data, std::min<size_t>(n, out.room()), byteSwapped, end));
+      data += 4 * ascii;
+      n -= ascii;
+      out.commit(end + ascii);
+      continue;
+    }
     if (c >= 0x00110000) {
       setError(errors);
       c = s_replacement;
     }
-    toUTF8(dst, c, errors);
+    out.commit(toUTF8(end, c, errors));
     data += 4;
+    --n;
   }
 
+  out.flush();
   return dst;
 }
 
@@ -664,10 +1120,8 @@ uint32_t Unicode::fromUTF8(const uint8_t *&data, uint32_t &n)
   return c;
 }
 
-void Unicode::toUTF8(std::string &dst, uint32_t c, bool *errors)
+uint8_t *Unicode::toUTF8(uint8_t *dst, uint32_t c, bool *errors)
 {
-  uint8_t data[6];
-
   // handle characters outside the valid range
   if ((c >= 0x0000d800 && c <= 0x0000dfff) || c >= 0x80000000) {
     setError(errors);
@@ -676,39 +1130,40 @@ void Unicode::toUTF8(std::string &dst, uint32_t c, bool *errors)
 
   // convert to UTF-8
   if (c < 0x00000080) {
-    data[0] = static_cast<uint8_t>(c);
-    dst.append(reinterpret_cast<char *>(data), 1);
+    dst[0] = static_cast<uint8_t>(c);
+    return dst + 1;
   } else if (c < 0x00000800) {
-    data[0] = static_cast<uint8_t>(((c >> 6) & 0x0000001f) + 0xc0);
-    data[1] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
-    dst.append(reinterpret_cast<char *>(data), 2);
+    dst[0] = static_cast<uint8_t>(((c >> 6) & 0x0000001f) + 0xc0);
+    dst[1] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
+    return dst + 2;
   } else if (c < 0x00010000) {
-    data[0] = static_cast<uint8_t>(((c >> 12) & 0x0000000f) + 0xe0);
-    data[1] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
-    data[2] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
-    dst.append(reinterpret_cast<char *>(data), 3);
+    dst[0] = static_cast<uint8_t>(((c >> 12) & 0x0000000f) + 0xe0);
+    dst[1] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
+    dst[2] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
+    return dst + 3;
   } else if (c < 0x00200000) {
-    data[0] = static_cast<uint8_t>(((c >> 18) & 0x00000007) + 0xf0);
-    data[1] = static_cast<uint8_t>(((c >> 12) & 0x0000003f) + 0x80);
-    data[2] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
-    data[3] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
-    dst.append(reinterpret_cast<char *>(data), 4);
+    dst[0] = static_cast<uint8_t>(((c >> 18) & 0x00000007) + 0xf0);
+    dst[1] = static_cast<uint8_t>(((c >> 12) & 0x0000003f) + 0x80);
+    dst[2] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
+    dst[3] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
+    return dst + 4;
   } else if (c < 0x04000000) {
-    data[0] = static_cast<uint8_t>(((c >> 24) & 0x00000003) + 0xf8);
-    data[1] = static_cast<uint8_t>(((c >> 18) & 0x0000003f) + 0x80);
-    data[2] = static_cast<uint8_t>(((c >> 12) & 0x0000003f) + 0x80);
-    data[3] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
-    data[4] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
-    dst.append(reinterpret_cast<char *>(data), 5);
+    dst[0] = static_cast<uint8_t>(((c >> 24) & 0x00000003) + 0xf8);
+    dst[1] = static_cast<uint8_t>(((c >> 18) & 0x0000003f) + 0x80);
+    dst[2] = static_cast<uint8_t>(((c >> 12) & 0x0000003f) + 0x80);
+    dst[3] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
+    dst[4] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
+    return dst + 5;
   } else if (c < 0x80000000) {
-    data[0] = static_cast<uint8_t>(((c >> 30) & 0x00000001) + 0xfc);
-    data[1] = static_cast<uint8_t>(((c >> 24) & 0x0000003f) + 0x80);
-    data[2] = static_cast<uint8_t>(((c >> 18) & 0x0000003f) + 0x80);
-    data[3] = static_cast<uint8_t>(((c >> 12) & 0x0000003f) + 0x80);
-    data[4] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
-    data[5] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
-    dst.append(reinterpret_cast<char *>(data), 6);
+    dst[0] = static_cast<uint8_t>(((c >> 30) & 0x00000001) + 0xfc);
+    dst[1] = static_cast<uint8_t>(((c >> 24) & 0x0000003f) + 0x80);
+    dst[2] = static_cast<uint8_t>(((c >> 18) & 0x0000003f) + 0x80);
+    dst[3] = static_cast<uint8_t>(((c >> 12) & 0x0000003f) + 0x80);
+    dst[4] = static_cast<uint8_t>(((c >> 6) & 0x0000003f) + 0x80);
+    dst[5] = static_cast<uint8_t>((c & 0x0000003f) + 0x80);
+    return dst + 6;
   } else {
     assert(0 && "character out of range");
+    return dst;
   }
 }
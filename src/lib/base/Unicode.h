@@ -129,9 +129,10 @@ private:
   static std::string doUTF16ToUTF8(const uint8_t *src, uint32_t n, bool *errors);
   static std::string doUTF32ToUTF8(const uint8_t *src, uint32_t n, bool *errors);
 
-  // convert characters to/from UTF8
+  // convert characters to/from UTF8.  toUTF8 writes at most six bytes
+  // and returns the end of what it wrote.
   static uint32_t fromUTF8(const uint8_t *&src, uint32_t &size);
-  static void toUTF8(std::string &dst, uint32_t c, bool *errors);
+  static uint8_t *toUTF8(uint8_t *dst, uint32_t c, bool *errors);
 
 private:
   static uint32_t s_invalid;
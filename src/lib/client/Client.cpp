@@ -13,6 +13,7 @@
 #include "base/Log.h"
 #include "base/TMethodJob.h"
 #include "client/ServerProxy.h"
+#include "common/CoreStatus.h"
 #include "deskflow/AppUtil.h"
 #include "deskflow/IPlatformScreen.h"
 #include "deskflow/PacketStreamFilter.h"
@@ -115,6 +116,9 @@ void Client::connect(size_t addressIndex)
           (CLOG_NOTE "connecting to '%s': %s:%i", m_serverAddress.getHostname().c_str(),
            ARCH->addrToString(m_serverAddress.getAddress()).c_str(), m_serverAddress.getPort())
       );
+      deskflow::CoreStatusChannel::send(
+          deskflow::CoreStatus::Type::Connecting, QString::fromStdString(m_serverAddress.getHostname())
+      );
     }
 
     // create the socket
@@ -122,7 +126,9 @@ void Client::connect(size_t addressIndex)
     bindNetworkInterface(socket);
 
     // filter socket messages, including a packetizing filter
-    m_stream = new PacketStreamFilter(m_events, socket, true);
+    auto *stream = new PacketStreamFilter(m_events, socket, true);
+    stream->capture(deskflow::ProtocolCapture::Peer::Server);
+    m_stream = stream;
 
     // connect
     LOG((CLOG_DEBUG1 "connecting to server"));
@@ -184,6 +190,11 @@ NetworkAddress Client::getServerAddress() const
   return m_serverAddress;
 }
 
+bool Client::isReceivingFiles() const
+{
+  return m_args.m_receiveFiles;
+}
+
 void *Client::getEventTarget() const
 {
   return m_screen->getEventTarget();
@@ -432,7 +443,7 @@ void Client::setupScreen()
   assert(m_server == nullptr);
 
   m_ready = false;
-  m_server = new ServerProxy(this, m_stream, m_events);
+  m_server = new ServerProxy(this, m_stream, m_events, m_pHelloBack->negotiatedMinorVersion());
   m_events->addHandler(EventTypes::ScreenShapeChanged, getEventTarget(), [this](const auto &) {
     handleShapeChanged();
   });
@@ -122,6 +122,12 @@ public:
   */
   NetworkAddress getServerAddress() const;
 
+  //! Test if receiving files
+  /*!
+  Returns true iff files dragged from the server are saved.
+  */
+  bool isReceivingFiles() const;
+
   //! Return last resolved adresses count
   size_t getLastResolvedAddressesCount() const
   {
@@ -33,7 +33,7 @@ void HelloBack::Deps::incompatible(int major, int minor)
 // HelloBack
 //
 
-void HelloBack::handleHello(deskflow::IStream *stream, const std::string &clientName) const
+void HelloBack::handleHello(deskflow::IStream *stream, const std::string &clientName)
 {
   int16_t serverMajor;
   int16_t serverMinor;
@@ -64,6 +64,8 @@ void HelloBack::handleHello(deskflow::IStream *stream, const std::string &client
     return;
   }
 
+  m_negotiatedMinorVersion = helloBackMinor;
+
   // say hello back with same protocol name and version
   LOG_DEBUG(
       "saying hello back with version %s %d.%d", //
@@ -79,11 +81,17 @@ void HelloBack::handleHello(deskflow::IStream *stream, const std::string &client
 bool HelloBack::shouldDowngrade(int major, int minor) const
 {
   const std::map<int, std::set<int>> map{
-      // 1.6 is compatible with 1.7 and 1.8
-      {6, {7, 8}},
+      // 1.6 is compatible with 1.7, 1.8, 1.9 and 1.10
+      {6, {7, 8, 9, 10}},
+
+      // 1.7 is compatible with 1.8, 1.9 and 1.10
+      {7, {8, 9, 10}},
+
+      // 1.8 is compatible with 1.9 and 1.10
+      {8, {9, 10}},
 
-      // 1.7 is compatible with 1.8
-      {7, {8}},
+      // 1.9 is compatible with 1.10
+      {9, {10}},
   };
 
   if (major == m_majorVersion) {
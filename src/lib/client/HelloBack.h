@@ -50,7 +50,8 @@ public:
   )
       : m_deps(deps),
         m_majorVersion(majorVersion),
-        m_minorVersion(minorVersion)
+        m_minorVersion(minorVersion),
+        m_negotiatedMinorVersion(minorVersion)
   {
     // do nothing
   }
@@ -58,7 +59,15 @@ public:
   /**
    * @brief Handle hello message from server and reply with hello back.
    */
-  void handleHello(deskflow::IStream *stream, const std::string &clientName) const;
+  void handleHello(deskflow::IStream *stream, const std::string &clientName);
+
+  /**
+   * @brief Minor protocol version used in the last hello back.
+   */
+  int16_t negotiatedMinorVersion() const
+  {
+    return m_negotiatedMinorVersion;
+  }
 
 private:
   bool shouldDowngrade(int major, int minor) const;
@@ -66,6 +75,7 @@ private:
   std::shared_ptr<Deps> m_deps;
   int16_t m_majorVersion;
   int16_t m_minorVersion;
+  int16_t m_negotiatedMinorVersion;
 };
 
 } // namespace deskflow::client
@@ -12,6 +12,7 @@
 #include "base/Log.h"
 #include "base/XBase.h"
 #include "client/Client.h"
+#include "common/CoreStatus.h"
 #include "deskflow/AppUtil.h"
 #include "deskflow/Clipboard.h"
 #include "deskflow/ClipboardChunk.h"
@@ -26,13 +27,16 @@
 #include <cstring>
 #include <memory>
 
+using deskflow::InputTrace;
+
 //
 // ServerProxy
 //
 
-ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events)
+ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events, int16_t protocolMinorVersion)
     : m_client(client),
       m_stream(stream),
+      m_protocolMinorVersion(protocolMinorVersion),
       m_events(events)
 {
   assert(m_client != nullptr);
@@ -43,13 +47,20 @@ ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue
     m_modifierTranslationTable[id] = id;
 
   // handle data on stream
-  m_events->addHandler(EventTypes::StreamInputReady, m_stream->getEventTarget(), [this](const auto &) {
+  m_events->addHandler(EventTypes::StreamInputReady, m_stream->getEventTarget(), [this](const auto &e) {
+    m_readTime = e.getTime();
     handleData();
   });
   m_events->addHandler(EventTypes::ClipboardSending, this, [this](const auto &e) {
     ClipboardChunk::send(m_stream, e.getDataObject());
   });
 
+  // files dragged from the server
+  const auto peer = m_client->getServerAddress().getHostname();
+  m_fileTransfer = std::make_unique<deskflow::FileTransfer>(m_stream, m_events, peer);
+  m_fileTransfer->setResumable(m_protocolMinorVersion >= 10);
+  m_fileTransfer->setReceiving(m_client->isReceivingFiles());
+
   // send heartbeat
   setKeepAliveRate(kKeepAliveRate);
 }
@@ -92,8 +103,9 @@ void ServerProxy::handleData()
       return;
     }
 
-    // parse message
+    // parse message, a pending trace belongs to this message
     LOG((CLOG_DEBUG2 "msg from server: %c%c%c%c", code[0], code[1], code[2], code[3]));
+    const bool traced = m_hasInputTrace;
     try {
       switch ((this->*m_parser)(code)) {
         using enum ConnectionResult;
@@ -111,6 +123,10 @@ void ServerProxy::handleData()
       case Disconnect:
         return;
       }
+
+      if (traced) {
+        completeInputTrace();
+      }
     } catch (const XBadClient &e) {
       LOG((CLOG_ERR "protocol error from server: %s", e.what()));
       ProtocolUtil::writef(m_stream, kMsgEBad);
@@ -151,9 +167,7 @@ ServerProxy::ConnectionResult ServerProxy::parseHandshakeMessage(const uint8_t *
   }
 
   else if (memcmp(code, kMsgCKeepAlive, 4) == 0) {
-    // echo keep alives and reset alarm
-    ProtocolUtil::writef(m_stream, kMsgCKeepAlive);
-    resetKeepAliveAlarm();
+    keepAlive();
   }
 
   else if (memcmp(code, kMsgCNoop, 4) == 0) {
@@ -178,12 +192,20 @@ ServerProxy::ConnectionResult ServerProxy::parseHandshakeMessage(const uint8_t *
 
   else if (memcmp(code, kMsgEBusy, 4) == 0) {
     LOG((CLOG_ERR "server already has a connected client with name \"%s\"", m_client->getName().c_str()));
+    deskflow::CoreStatusChannel::send(
+        deskflow::CoreStatus::Type::ConnectRefused, QString::fromStdString(m_client->getName()),
+        static_cast<uint32_t>(deskflow::CoreStatus::Refusal::NameInUse)
+    );
     m_client->refuseConnection("server already has a connected client with our name");
     return Disconnect;
   }
 
   else if (memcmp(code, kMsgEUnknown, 4) == 0) {
     LOG((CLOG_ERR "server refused client with name \"%s\"", m_client->getName().c_str()));
+    deskflow::CoreStatusChannel::send(
+        deskflow::CoreStatus::Type::ConnectRefused, QString::fromStdString(m_client->getName()),
+        static_cast<uint32_t>(deskflow::CoreStatus::Refusal::NameUnknown)
+    );
     m_client->refuseConnection("server refused client with our name");
     return Disconnect;
   }
@@ -205,6 +227,12 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
 {
   using enum ConnectionResult;
 
+  if (memcmp(code, kMsgDInputTrace, 4) == 0) {
+    // no reply, the input message that follows gets one
+    inputTrace();
+    return Okay;
+  }
+
   if (memcmp(code, kMsgDMouseMove, 4) == 0) {
     mouseMove();
   }
@@ -257,9 +285,7 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
   }
 
   else if (memcmp(code, kMsgCKeepAlive, 4) == 0) {
-    // echo keep alives and reset alarm
-    ProtocolUtil::writef(m_stream, kMsgCKeepAlive);
-    resetKeepAliveAlarm();
+    keepAlive();
   }
 
   else if (memcmp(code, kMsgCNoop, 4) == 0) {
@@ -306,6 +332,14 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
     secureInputNotification();
   }
 
+  else if (memcmp(code, kMsgDFileTransfer, 4) == 0) {
+    m_fileTransfer->chunkReceived();
+  }
+
+  else if (memcmp(code, kMsgDDragInfo, 4) == 0) {
+    m_fileTransfer->dragInfoReceived();
+  }
+
   else if (memcmp(code, kMsgCClose, 4) == 0) {
     // server wants us to hangup
     LOG((CLOG_DEBUG1 "recv close"));
@@ -331,6 +365,31 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
   return Okay;
 }
 
+void ServerProxy::completeInputTrace()
+{
+  m_hasInputTrace = false;
+  if (m_compressMouse || m_compressMouseRelative) {
+    // motion is injected when the compressed motion is flushed
+    m_compressedInputTraces.push_back(m_inputTrace);
+    return;
+  }
+
+  m_inputTrace[InputTrace::Stage::Inject] = InputTrace::now();
+  InputTrace::record(m_inputTrace);
+}
+
+InputTrace::Time ServerProxy::toLocalTime(uint32_t serverTime) const
+{
+  if (serverTime == 0) {
+    return 0;
+  }
+
+  // server times are modulo 2^32 so place them relative to the read time
+  const uint32_t localTime = serverTime + m_clockOffset;
+  const auto delta = static_cast<int32_t>(localTime - static_cast<uint32_t>(m_readTime));
+  return static_cast<InputTrace::Time>(static_cast<int64_t>(m_readTime) + delta);
+}
+
 void ServerProxy::handleKeepAliveAlarm()
 {
   LOG((CLOG_NOTE "server is dead"));
@@ -356,7 +415,7 @@ bool ServerProxy::onGrabClipboard(ClipboardID id)
 
 void ServerProxy::onClipboardChanged(ClipboardID id, const IClipboard *clipboard)
 {
-  std::string data = IClipboard::marshall(clipboard);
+  std::string data = IClipboard::marshall(clipboard, m_protocolMinorVersion >= 10);
   LOG((CLOG_DEBUG "sending clipboard %d seqnum=%d", id, m_seqNum));
 
   StreamChunker::sendClipboard(data, data.size(), id, m_seqNum, m_events, this);
@@ -374,6 +433,16 @@ void ServerProxy::flushCompressedMouse()
     m_dxMouse = 0;
     m_dyMouse = 0;
   }
+
+  // compressed motion is injected together with the last motion
+  if (!m_compressedInputTraces.empty()) {
+    const auto injected = InputTrace::now();
+    for (auto &stamps : m_compressedInputTraces) {
+      stamps[InputTrace::Stage::Inject] = injected;
+      InputTrace::record(stamps);
+    }
+    m_compressedInputTraces.clear();
+  }
 }
 
 void ServerProxy::sendInfo(const ClientInfo &info)
@@ -502,6 +571,7 @@ void ServerProxy::enter()
   m_compressMouseRelative = false;
   m_dxMouse = 0;
   m_dyMouse = 0;
+  m_compressedInputTraces.clear();
   m_seqNum = seqNum;
   m_serverLanguage = "";
   m_isUserNotifiedAboutLanguageSyncError = false;
@@ -546,6 +616,53 @@ void ServerProxy::setClipboard()
   }
 }
 
+void ServerProxy::keepAlive()
+{
+  if (m_protocolMinorVersion < 9) {
+    // echo keep alives and reset alarm
+    ProtocolUtil::writef(m_stream, kMsgCKeepAlive);
+    resetKeepAliveAlarm();
+    return;
+  }
+
+  // reply with our clock so the server can estimate the offset
+  const auto received = static_cast<uint32_t>(InputTrace::now());
+  uint32_t sent = 0;
+  uint32_t offset = 0;
+  ProtocolUtil::readf(m_stream, kMsgCKeepAliveSync + 4, &sent, &offset);
+  ProtocolUtil::writef(m_stream, kMsgCKeepAliveSyncReply, sent, received, static_cast<uint32_t>(InputTrace::now()));
+  resetKeepAliveAlarm();
+
+  // the first keep alive is sent before the server has an estimate
+  if (m_clockSyncs < 2) {
+    ++m_clockSyncs;
+  }
+  m_clockOffset = offset;
+}
+
+void ServerProxy::inputTrace()
+{
+  uint32_t capture = 0;
+  uint32_t dispatch = 0;
+  uint32_t server = 0;
+  uint32_t write = 0;
+  ProtocolUtil::readf(m_stream, kMsgDInputTrace + 4, &capture, &dispatch, &server, &write);
+  if (!InputTrace::isEnabled() || m_readTime == 0) {
+    return;
+  }
+
+  using Stage = InputTrace::Stage;
+  m_inputTrace = {};
+  m_inputTrace[Stage::Capture] = toLocalTime(capture);
+  m_inputTrace[Stage::Dispatch] = toLocalTime(dispatch);
+  m_inputTrace[Stage::Server] = toLocalTime(server);
+  m_inputTrace[Stage::Write] = toLocalTime(write);
+  m_inputTrace[Stage::Read] = m_readTime;
+  m_inputTrace[Stage::Parse] = InputTrace::now();
+  m_inputTrace.m_clockSynced = m_clockSyncs >= 2;
+  m_hasInputTrace = true;
+}
+
 void ServerProxy::grabClipboard()
 {
   // parse
@@ -9,10 +9,15 @@
 #pragma once
 
 #include "base/Event.h"
+#include "base/InputTrace.h"
 #include "deskflow/ClipboardTypes.h"
+#include "deskflow/FileTransfer.h"
 #include "deskflow/KeyTypes.h"
 #include "deskflow/languages/LanguageManager.h"
 
+#include <memory>
+#include <vector>
+
 class Client;
 class ClientInfo;
 class EventQueueTimer;
@@ -32,9 +37,10 @@ class ServerProxy
 public:
   /*!
   Process messages from the server on \p stream and forward to
-  \p client.
+  \p client.  \p protocolMinorVersion is the version agreed with the
+  server in the hello exchange.
   */
-  ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events);
+  ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events, int16_t protocolMinorVersion);
   ServerProxy(ServerProxy const &) = delete;
   ServerProxy(ServerProxy &&) = delete;
   ~ServerProxy();
@@ -70,6 +76,10 @@ private:
   void resetKeepAliveAlarm();
   void setKeepAliveRate(double);
 
+  // input latency tracing
+  void completeInputTrace();
+  deskflow::InputTrace::Time toLocalTime(uint32_t serverTime) const;
+
   // modifier key translation
   KeyID translateKey(KeyID) const;
   KeyModifierMask translateModifierMask(KeyModifierMask) const;
@@ -79,6 +89,8 @@ private:
   void handleKeepAliveAlarm();
 
   // message handlers
+  void keepAlive();
+  void inputTrace();
   void enter();
   void leave();
   void setClipboard();
@@ -106,6 +118,7 @@ private:
 
   Client *m_client = nullptr;
   deskflow::IStream *m_stream = nullptr;
+  int16_t m_protocolMinorVersion = 0;
 
   uint32_t m_seqNum = 0;
 
@@ -123,9 +136,20 @@ private:
   double m_keepAliveAlarm = 0.0;
   EventQueueTimer *m_keepAliveAlarmTimer = nullptr;
 
+  // server clock to client clock, valid after the second keep alive
+  uint32_t m_clockOffset = 0;
+  int m_clockSyncs = 0;
+
+  // input latency tracing
+  deskflow::InputTrace::Time m_readTime = 0;
+  bool m_hasInputTrace = false;
+  deskflow::InputTrace::Stamps m_inputTrace;
+  std::vector<deskflow::InputTrace::Stamps> m_compressedInputTraces;
+
   MessageParser m_parser = &ServerProxy::parseHandshakeMessage;
   IEventQueue *m_events = nullptr;
   std::string m_serverLanguage = "";
   bool m_isUserNotifiedAboutLanguageSyncError = false;
   deskflow::languages::LanguageManager m_languageManager;
+  std::unique_ptr<deskflow::FileTransfer> m_fileTransfer;
 };
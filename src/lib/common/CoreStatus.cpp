@@ -0,0 +1,382 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "common/CoreStatus.h"
+
+#include <QLocalSocket>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if SYSAPI_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#endif
+
+namespace deskflow {
+
+namespace {
+
+const int kConnectTimeout = 5000;
+const int kWriteTimeout = 1000;
+
+// where the writer can't sleep until the gui sends a request, it looks
+// for one when it has been idle this long
+const auto kReadInterval = std::chrono::milliseconds(200);
+
+// enough for a burst of clients connecting, a GUI that has stopped
+// reading for longer than that has no use for the messages anyway
+const std::size_t kMaxQueued = 256;
+
+const std::size_t kSizeField = 4;
+const std::size_t kHeaderSize = 1 + 4;
+
+std::atomic_bool s_enabled{false};
+
+// guards the queue and thread, messages may be sent from any thread
+std::mutex s_mutex;
+std::deque<QByteArray> s_queue;
+bool s_stopping = false;
+std::function<void(const CoreStatus &)> s_requestHandler;
+
+#if SYSAPI_UNIX
+// written to wake the writer while it waits for a request from the gui
+int s_wakePipe[2] = {-1, -1};
+#else
+std::condition_variable s_queued;
+#endif
+
+// the core can exit without stopping the channel, so the writer is joined
+// on exit as well rather than being left to terminate the process
+struct Writer
+{
+  std::thread m_thread;
+  ~Writer()
+  {
+    CoreStatusChannel::stop();
+  }
+} s_writer;
+
+void putLE(QByteArray &out, std::uint32_t value)
+{
+  for (std::size_t i = 0; i < kSizeField; ++i) {
+    out.append(static_cast<char>(value >> (i * 8)));
+  }
+}
+
+std::uint32_t getLE(const char *in)
+{
+  std::uint32_t value = 0;
+  for (std::size_t i = 0; i < kSizeField; ++i) {
+    value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(in[i])) << (i * 8);
+  }
+  return value;
+}
+
+#if SYSAPI_UNIX
+
+void openWakePipe()
+{
+  if (pipe(s_wakePipe) != 0) {
+    s_wakePipe[0] = s_wakePipe[1] = -1;
+    return;
+  }
+
+  for (const auto fd : s_wakePipe) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+}
+
+void closeWakePipe()
+{
+  for (auto &fd : s_wakePipe) {
+    if (fd != -1) {
+      close(fd);
+      fd = -1;
+    }
+  }
+}
+
+#endif
+
+// wake the writer to send the queue or stop, called with the mutex held
+void wake()
+{
+#if SYSAPI_UNIX
+  if (s_wakePipe[1] != -1) {
+    const char byte = 0;
+    [[maybe_unused]] const auto written = write(s_wakePipe[1], &byte, 1);
+  }
+#else
+  s_queued.notify_one();
+#endif
+}
+
+// wait until there's something to send, the channel is stopping or the
+// gui sent something, returns false if the socket can't be waited on
+bool waitForWork([[maybe_unused]] QLocalSocket &socket, std::unique_lock<std::mutex> &lock)
+{
+#if SYSAPI_UNIX
+  if (s_stopping || !s_queue.empty()) {
+    return true;
+  }
+
+  // sleep until the socket is readable or a message is queued, so the
+  // thread doesn't wake while there's nothing to do
+  pollfd fds[] = {{static_cast<int>(socket.socketDescriptor()), POLLIN, 0}, {s_wakePipe[0], POLLIN, 0}};
+  const auto timeout = s_wakePipe[0] == -1 ? static_cast<int>(kReadInterval.count()) : -1;
+  lock.unlock();
+  const auto result = poll(fds, 2, timeout);
+  const auto error = errno;
+  if (fds[1].revents & POLLIN) {
+    char buffer[64];
+    while (read(s_wakePipe[0], buffer, sizeof(buffer)) > 0) {
+      // drain every wake, the queue is read as a whole
+    }
+  }
+  lock.lock();
+
+  if (result < 0) {
+    return error == EINTR;
+  }
+  return (fds[0].revents & (POLLERR | POLLNVAL)) == 0;
+#else
+  // the pipe can't be waited on along with the queue
+  s_queued.wait_for(lock, kReadInterval, [] { return s_stopping || !s_queue.empty(); });
+  return true;
+#endif
+}
+
+void readRequests(QLocalSocket &socket, CoreStatusReader &reader)
+{
+  if (socket.bytesAvailable() == 0 && !socket.waitForReadyRead(0)) {
+    return;
+  }
+
+  reader.append(socket.readAll());
+  while (const auto request = reader.next()) {
+    std::function<void(const CoreStatus &)> handler;
+    {
+      std::scoped_lock lock{s_mutex};
+      handler = s_requestHandler;
+    }
+    if (handler) {
+      handler(*request);
+    }
+  }
+}
+
+void writeMessages(const QString &name)
+{
+  QLocalSocket socket;
+  socket.connectToServer(name, QIODevice::ReadWrite);
+  const bool connected = socket.waitForConnected(kConnectTimeout);
+  CoreStatusReader reader;
+
+  std::unique_lock lock{s_mutex};
+  while (connected) {
+    if (!waitForWork(socket, lock) || (s_stopping && s_queue.empty())) {
+      break;
+    }
+
+    QByteArray bytes;
+    while (!s_queue.empty()) {
+      bytes.append(s_queue.front());
+      s_queue.pop_front();
+    }
+
+    lock.unlock();
+    if (!bytes.isEmpty()) {
+      socket.write(bytes);
+      socket.waitForBytesWritten(kWriteTimeout);
+    }
+    readRequests(socket, reader);
+    lock.lock();
+
+    if (socket.state() != QLocalSocket::ConnectedState || reader.isCorrupt()) {
+      break;
+    }
+  }
+
+  // the gui is gone or never listened, there's no point queueing any more
+  s_enabled = false;
+  s_queue.clear();
+  lock.unlock();
+
+  if (socket.state() == QLocalSocket::ConnectedState) {
+    socket.disconnectFromServer();
+  }
+}
+
+} // namespace
+
+//
+// CoreStatus
+//
+
+QByteArray CoreStatus::encode() const
+{
+  const auto text = m_text.toUtf8();
+
+  QByteArray body;
+  body.append(static_cast<char>(m_type));
+  putLE(body, m_code);
+  putLE(body, static_cast<std::uint32_t>(text.size()));
+  body.append(text);
+  putLE(body, static_cast<std::uint32_t>(m_data.size()));
+  body.append(m_data);
+
+  QByteArray frame;
+  putLE(frame, static_cast<std::uint32_t>(body.size()));
+  frame.append(body);
+  return frame;
+}
+
+//
+// CoreStatusReader
+//
+
+void CoreStatusReader::append(const QByteArray &bytes)
+{
+  if (!m_corrupt) {
+    m_buffer.append(bytes);
+  }
+}
+
+std::optional<CoreStatus> CoreStatusReader::next()
+{
+  if (m_corrupt || static_cast<std::size_t>(m_buffer.size()) < kSizeField) {
+    return std::nullopt;
+  }
+
+  const auto frameSize = getLE(m_buffer.constData());
+  if (frameSize > CoreStatus::kMaxFrameSize || frameSize < kHeaderSize + 2 * kSizeField) {
+    m_corrupt = true;
+    m_buffer.clear();
+    return std::nullopt;
+  }
+  if (static_cast<std::size_t>(m_buffer.size()) < kSizeField + frameSize) {
+    return std::nullopt;
+  }
+
+  const char *frame = m_buffer.constData() + kSizeField;
+  const char *end = frame + frameSize;
+
+  CoreStatus message;
+  message.m_type = static_cast<CoreStatus::Type>(frame[0]);
+  message.m_code = getLE(frame + 1);
+
+  const char *field = frame + kHeaderSize;
+  const auto textSize = getLE(field);
+  field += kSizeField;
+  if (textSize > static_cast<std::size_t>(end - field) - kSizeField) {
+    m_corrupt = true;
+    m_buffer.clear();
+    return std::nullopt;
+  }
+  message.m_text = QString::fromUtf8(field, textSize);
+  field += textSize;
+
+  const auto dataSize = getLE(field);
+  field += kSizeField;
+  if (dataSize != static_cast<std::size_t>(end - field)) {
+    m_corrupt = true;
+    m_buffer.clear();
+    return std::nullopt;
+  }
+  message.m_data = QByteArray(field, dataSize);
+
+  m_buffer.remove(0, static_cast<qsizetype>(kSizeField + frameSize));
+  return message;
+}
+
+bool CoreStatusReader::isCorrupt() const
+{
+  return m_corrupt;
+}
+
+//
+// CoreStatusChannel
+//
+
+void CoreStatusChannel::start(const QString &name)
+{
+  stop();
+
+  std::scoped_lock lock{s_mutex};
+  s_stopping = false;
+  s_queue.push_back(CoreStatus{CoreStatus::Type::Hello, CoreStatus::kVersion}.encode());
+  s_enabled = true;
+#if SYSAPI_UNIX
+  openWakePipe();
+#endif
+  s_writer.m_thread = std::thread(writeMessages, name);
+}
+
+void CoreStatusChannel::stop()
+{
+  {
+    std::scoped_lock lock{s_mutex};
+    s_enabled = false;
+    s_stopping = true;
+    wake();
+  }
+
+  if (s_writer.m_thread.joinable()) {
+    s_writer.m_thread.join();
+  }
+
+#if SYSAPI_UNIX
+  std::scoped_lock lock{s_mutex};
+  closeWakePipe();
+#endif
+}
+
+void CoreStatusChannel::send(const CoreStatus &message)
+{
+  if (!isEnabled()) {
+    return;
+  }
+
+  auto frame = message.encode();
+  {
+    std::scoped_lock lock{s_mutex};
+    if (s_stopping || s_queue.size() >= kMaxQueued) {
+      return;
+    }
+    s_queue.push_back(std::move(frame));
+    wake();
+  }
+}
+
+void CoreStatusChannel::send(CoreStatus::Type type, const QString &text, std::uint32_t code, const QByteArray &data)
+{
+  if (isEnabled()) {
+    send(CoreStatus{type, code, text, data});
+  }
+}
+
+void CoreStatusChannel::setRequestHandler(std::function<void(const CoreStatus &)> handler)
+{
+  std::scoped_lock lock{s_mutex};
+  s_requestHandler = std::move(handler);
+}
+
+bool CoreStatusChannel::isEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+} // namespace deskflow
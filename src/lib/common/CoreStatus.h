@@ -0,0 +1,173 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace deskflow {
+
+//! Core status message
+/*!
+A change in the state of the core, sent to the GUI over the status
+channel so that the GUI doesn't need to find it in the log.
+
+On the wire each message is a frame of:
+
+  - frame size, not including this field (uint32)
+  - message type (uint8)
+  - code, meaning depends on the type (uint32)
+  - text size (uint32) followed by the UTF-8 text
+  - data size (uint32) followed by the data
+
+All integers are little endian.  Messages of a type the reader doesn't
+know are skipped, so new types can be added without breaking an older
+GUI.
+
+From version 2 the GUI can send requests to the core in the same
+frames, on the same socket.
+*/
+struct CoreStatus
+{
+  static constexpr std::uint32_t kVersion = 2;
+
+  //! The first version that reads requests from the GUI
+  static constexpr std::uint32_t kRequestVersion = 2;
+
+  //! Frames larger than this are taken as a corrupt stream
+  static constexpr std::uint32_t kMaxFrameSize = 64 * 1024;
+
+  enum class Type : std::uint8_t
+  {
+    Hello,              //!< First message, code is kVersion
+    Connecting,         //!< Client connecting, text is the server address
+    Connected,          //!< Client connected to the server
+    ConnectFailed,      //!< Client failed to connect, text is the reason
+    ConnectRefused,     //!< Server refused the client, code is a Refusal
+    Disconnected,       //!< Client disconnected from the server
+    Listening,          //!< Server started and waiting for clients
+    ClientConnected,    //!< Server accepted a client, text is its name
+    ClientDisconnected, //!< Client of the server disconnected, text is its name
+    ClientUnrecognised, //!< Server refused a client not in its config, text is its name
+    SecureProtocol,     //!< Secure connection made, text is the TLS version
+    PeerFingerprint,    //!< Secure peer's certificate, data is its SHA-256 fingerprint
+    ReloadConfig        //!< Request from the GUI for the server to read its config file again
+  };
+
+  //! Why the server refused the client
+  enum class Refusal : std::uint32_t
+  {
+    NameUnknown, //!< The server has no screen with the client's name
+    NameInUse    //!< The server already has a client with the client's name
+  };
+
+  //! Encode the message as a frame
+  QByteArray encode() const;
+
+  Type m_type = Type::Hello;
+  std::uint32_t m_code = 0;
+  QString m_text;
+  QByteArray m_data;
+};
+
+//! Core status message reader
+/*!
+Splits the bytes read from the status channel into messages, holding
+on to any partial frame until the rest of it is read.
+*/
+class CoreStatusReader
+{
+public:
+  //! @name manipulators
+  //@{
+
+  //! Add bytes read from the channel
+  void append(const QByteArray &bytes);
+
+  //! Take the next complete message
+  /*!
+  Returns nothing if no complete message has been read yet, or if the
+  stream is corrupt.
+  */
+  std::optional<CoreStatus> next();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns true if a frame could not be decoded
+  /*!
+  Nothing more can be read from a corrupt stream.
+  */
+  bool isCorrupt() const;
+
+  //@}
+
+private:
+  QByteArray m_buffer;
+  bool m_corrupt = false;
+};
+
+//! Core status channel
+/*!
+Sends status messages from the core to the GUI over a local socket
+opened by the GUI, named by the GUI on the command line.  Nothing is
+sent unless the channel is started.  Requests the GUI sends back are
+given to the request handler, if one is set.
+
+Messages are queued and written by a thread of their own, as the core
+has no Qt event loop to drive the socket and messages are sent from
+any thread, including the handshake workers.  If the GUI stops reading,
+messages beyond a limit are dropped rather than blocking the core.
+*/
+class CoreStatusChannel
+{
+public:
+  //! @name manipulators
+  //@{
+
+  //! Connect to the GUI's socket called \p name
+  /*!
+  Connects in the background, messages sent before the connection is
+  made are written once it is.
+  */
+  static void start(const QString &name);
+
+  //! Write any queued messages and disconnect
+  static void stop();
+
+  //! Send \p message if the channel is started
+  static void send(const CoreStatus &message);
+
+  //! Send a message of \p type if the channel is started
+  static void send(
+      CoreStatus::Type type, const QString &text = QString(), std::uint32_t code = 0,
+      const QByteArray &data = QByteArray()
+  );
+
+  //! Handle requests from the GUI with \p handler
+  /*!
+  The handler is called on the channel's thread, so it should hand the
+  request on to the event queue.  An empty handler ignores requests.
+  */
+  static void setRequestHandler(std::function<void(const CoreStatus &)> handler);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns true if the channel is started
+  static bool isEnabled();
+
+  //@}
+};
+
+} // namespace deskflow
@@ -75,7 +75,8 @@ void Settings::cleanSettings()
 QVariant Settings::defaultValue(const QString &key)
 {
   if ((key == Gui::Autohide) || (key == Core::StartedBefore) || (key == Core::PreventSleep) ||
-      (key == Server::ExternalConfig) || (key == Client::InvertScrollDirection) || (key == Log::ToFile)) {
+      (key == Server::ExternalConfig) || (key == Client::InvertScrollDirection) || (key == Log::ToFile) ||
+      (key == Security::KernelTls) || (key == Core::ReceiveFiles)) {
     return false;
   }
 
@@ -97,12 +98,18 @@ QVariant Settings::defaultValue(const QString &key)
   if (key == Security::KeySize)
     return 2048;
 
+  if (key == Security::KeyType)
+    return QStringLiteral("rsa");
+
   if (key == Log::File)
     return QStringLiteral("%1/%2").arg(QDir::homePath(), kDefaultLogFile);
 
   if (key == Log::Level)
     return 0;
 
+  if (key == Log::MaxLines)
+    return 10000;
+
   if (key == Client::Binary)
     return kClientBinName;
 
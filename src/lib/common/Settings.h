@@ -46,6 +46,7 @@ public:
     inline static const auto Port = QStringLiteral("core/port");
     inline static const auto PreventSleep = QStringLiteral("core/preventSleep");
     inline static const auto ProcessMode = QStringLiteral("core/processMode");
+    inline static const auto ReceiveFiles = QStringLiteral("core/receiveFiles");
     inline static const auto ScreenName = QStringLiteral("core/screenName");
     inline static const auto StartedBefore = QStringLiteral("core/startedBefore");
     inline static const auto UpdateUrl = QStringLiteral("core/updateUrl");
@@ -71,6 +72,7 @@ public:
   {
     inline static const auto File = QStringLiteral("log/file");
     inline static const auto Level = QStringLiteral("log/level");
+    inline static const auto MaxLines = QStringLiteral("log/maxLines");
     inline static const auto ToFile = QStringLiteral("log/toFile");
   };
   struct Security
@@ -78,6 +80,8 @@ public:
     inline static const auto CheckPeers = QStringLiteral("security/checkPeerFingerprints");
     inline static const auto Certificate = QStringLiteral("security/certificate");
     inline static const auto KeySize = QStringLiteral("security/keySize");
+    inline static const auto KernelTls = QStringLiteral("security/kernelTls");
+    inline static const auto KeyType = QStringLiteral("security/keyType");
     inline static const auto TlsEnabled = QStringLiteral("security/tlsEnabled");
   };
   struct Server
@@ -163,6 +167,7 @@ private:
     , Settings::Core::Port
     , Settings::Core::PreventSleep
     , Settings::Core::ProcessMode
+    , Settings::Core::ReceiveFiles
     , Settings::Core::ScreenName
     , Settings::Core::StartedBefore
     , Settings::Core::UpdateUrl
@@ -171,6 +176,7 @@ private:
     , Settings::Daemon::LogFile
     , Settings::Log::File
     , Settings::Log::Level
+    , Settings::Log::MaxLines
     , Settings::Log::ToFile
     , Settings::Gui::Autohide
     , Settings::Gui::AutoUpdateCheck
@@ -182,6 +188,8 @@ private:
     , Settings::Security::Certificate
     , Settings::Security::CheckPeers
     , Settings::Security::KeySize
+    , Settings::Security::KernelTls
+    , Settings::Security::KeyType
     , Settings::Security::TlsEnabled
     , Settings::Server::Binary
     , Settings::Server::ConfigVisible
@@ -10,18 +10,19 @@
 #include "DisplayInvalidException.h"
 #include "VersionInfo.h"
 #include "arch/Arch.h"
+#include "base/IEventQueue.h"
+#include "base/InputTrace.h"
 #include "base/Log.h"
 #include "base/LogOutputters.h"
+#include "base/Trace.h"
 #include "common/Constants.h"
+#include "common/CoreStatus.h"
 #include "deskflow/ArgsBase.h"
 #include "deskflow/Config.h"
+#include "deskflow/ProtocolCapture.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/XDeskflow.h"
 
-#if SYSAPI_WIN32
-#include "base/IEventQueue.h"
-#endif
-
 #include <iostream>
 #include <stdexcept>
 #include <stdio.h>
@@ -54,6 +55,12 @@ App::App(IEventQueue *events, deskflow::ArgsBase *args)
 
 App::~App()
 {
+  if (Trace::isEnabled() && !argsBase().m_traceFile.empty()) {
+    Trace::write(argsBase().m_traceFile);
+  }
+  ProtocolCapture::stop();
+  CoreStatusChannel::stop();
+
   s_instance = nullptr;
   delete m_args;
 }
@@ -180,10 +187,59 @@ void App::initApp(int argc, const char **argv)
   // setup file logging after parsing args
   setupFileLogging();
 
+  if (argsBase().m_latencyTrace || !argsBase().m_traceFile.empty()) {
+    initDiagnostics();
+  }
+
+  if (!argsBase().m_protocolCaptureFile.empty() && ProtocolCapture::start(argsBase().m_protocolCaptureFile)) {
+    LOG_WARN("capturing protocol to %s, this includes typed text and clipboard contents", argsBase().m_protocolCaptureFile.c_str());
+  }
+
+  if (!argsBase().m_statusChannel.empty()) {
+    LOG_DEBUG("sending status to the gui on: %s", argsBase().m_statusChannel.c_str());
+    CoreStatusChannel::start(QString::fromStdString(argsBase().m_statusChannel));
+  }
+
   // load configuration
   loadConfig();
 }
 
+void App::initDiagnostics()
+{
+  if (argsBase().m_latencyTrace) {
+    InputTrace::setEnabled(true);
+    LOG((CLOG_NOTE "input latency tracing enabled"));
+  }
+
+  // record from the start so the spans leading up to a hitch are kept
+  if (!argsBase().m_traceFile.empty()) {
+    Trace::start();
+    LOG((CLOG_NOTE "event tracing enabled, trace file: %s", argsBase().m_traceFile.c_str()));
+  }
+
+  // handle user signal by writing the latencies to the log and the trace to file
+  ARCH->setSignalHandler(Arch::ThreadSignal::User, &dumpDiagnosticsSignalHandler, nullptr);
+  m_events->addHandler(EventTypes::AppDumpDiagnostics, m_events->getSystemTarget(), [this](const auto &) {
+    dumpDiagnostics();
+  });
+}
+
+void App::dumpDiagnostics() const
+{
+  if (argsBase().m_latencyTrace) {
+    InputTrace::dump();
+  }
+  if (!argsBase().m_traceFile.empty()) {
+    Trace::write(argsBase().m_traceFile);
+  }
+}
+
+void App::dumpDiagnosticsSignalHandler(Arch::ThreadSignal, void *)
+{
+  IEventQueue *events = App::instance().getEvents();
+  events->addEvent(Event(EventTypes::AppDumpDiagnostics, events->getSystemTarget()));
+}
+
 void App::runEventsLoop(void *)
 {
   m_events->loop();
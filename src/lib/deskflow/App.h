@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "arch/Arch.h"
 #include "base/EventQueue.h"
 #include "base/Log.h"
 #include "common/Common.h"
@@ -113,6 +114,9 @@ public:
 
 protected:
   void runEventsLoop(void *);
+  void initDiagnostics();
+  void dumpDiagnostics() const;
+  static void dumpDiagnosticsSignalHandler(Arch::ThreadSignal, void *);
 
   IEventQueue *m_events = nullptr;
 
@@ -139,7 +143,15 @@ constexpr static auto s_helpGeneralArgs = //
     "*     --restart            restart the server automatically if it fails.\n"
     "  -l  --log <file>         write log messages to file.\n"
     "      --enable-crypto      enable TLS encryption.\n"
-    "      --tls-cert           specify the path to the TLS certificate file.\n";
+    "      --tls-cert           specify the path to the TLS certificate file.\n"
+    "      --latency-trace      record input latency, send SIGUSR2 to log it.\n"
+    "      --receive-files      save files dragged from the other computer to\n"
+    "                             the downloads directory.\n"
+    "      --trace-events <file> record event trace spans, send SIGUSR2 to\n"
+    "                             write them to file.\n"
+    "      --capture-protocol <file> record every packet sent and received\n"
+    "                             to file, for replay with deskflow-replay.\n"
+    "      --status-channel <name> send status to the GUI on this local socket.\n";
 
 constexpr static auto s_helpVersionArgs = //
     "  -h, --help               display this help and exit.\n"
@@ -165,6 +165,16 @@ bool ArgParser::parseGenericArgs(int argc, const char *const *argv, int &i) cons
     argsBase().m_tlsCertFile = argv[++i];
   } else if (isArg(i, argc, argv, nullptr, "--prevent-sleep")) {
     argsBase().m_preventSleep = true;
+  } else if (isArg(i, argc, argv, nullptr, "--latency-trace")) {
+    argsBase().m_latencyTrace = true;
+  } else if (isArg(i, argc, argv, nullptr, "--receive-files")) {
+    argsBase().m_receiveFiles = true;
+  } else if (isArg(i, argc, argv, nullptr, "--trace-events", 1)) {
+    argsBase().m_traceFile = argv[++i];
+  } else if (isArg(i, argc, argv, nullptr, "--capture-protocol", 1)) {
+    argsBase().m_protocolCaptureFile = argv[++i];
+  } else if (isArg(i, argc, argv, nullptr, "--status-channel", 1)) {
+    argsBase().m_statusChannel = argv[++i];
   } else {
     // option not supported here
     return false;
@@ -77,6 +77,21 @@ public:
   /// @brief Stop this computer from sleeping
   bool m_preventSleep = false;
 
+  /// @brief Record end-to-end input latency, dumped to the log on SIGUSR2
+  bool m_latencyTrace = false;
+
+  /// @brief Save files dragged from the peer to the downloads directory
+  bool m_receiveFiles = false;
+
+  /// @brief Record event trace spans, written to this file on SIGUSR2 and on exit
+  std::string m_traceFile;
+
+  /// @brief Record every packet sent and received to this protocol capture file
+  std::string m_protocolCaptureFile;
+
+  /// @brief Name of the local socket to send status messages to the GUI on
+  std::string m_statusChannel;
+
 protected:
   /// @brief deletes pointers and sets the value to null
   template <class T> static inline void destroy(T *&p)
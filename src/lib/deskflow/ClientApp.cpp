@@ -14,6 +14,7 @@
 #include "base/Log.h"
 #include "client/Client.h"
 #include "common/Constants.h"
+#include "common/CoreStatus.h"
 #include "deskflow/ArgParser.h"
 #include "deskflow/ClientArgs.h"
 #include "deskflow/ProtocolTypes.h"
@@ -241,6 +242,7 @@ void ClientApp::scheduleClientRestart(double retryTime)
 void ClientApp::handleClientConnected() const
 {
   LOG((CLOG_NOTE "connected to server"));
+  deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::Connected);
   updateStatus();
 }
 
@@ -251,6 +253,7 @@ void ClientApp::handleClientFailed(const Event &e)
 
     updateStatus(std::string("Failed to connect to server: ") + info->m_what + " Trying next address...");
     LOG((CLOG_WARN "failed to connect to server=%s, trying next address", info->m_what.c_str()));
+    deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::ConnectFailed, QString::fromStdString(info->m_what));
     if (!m_suspended) {
       scheduleClientRestart(s_retryTime);
     }
@@ -265,6 +268,7 @@ void ClientApp::handleClientRefused(const Event &e)
   std::unique_ptr<Client::FailInfo> info(static_cast<Client::FailInfo *>(e.getData()));
 
   updateStatus(std::string("Failed to connect to server: ") + info->m_what);
+  deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::ConnectFailed, QString::fromStdString(info->m_what));
   if (!args().m_restartable || !info->m_retry) {
     LOG((CLOG_ERR "failed to connect to server: %s", info->m_what.c_str()));
     m_events->addEvent(Event(EventTypes::Quit));
@@ -279,6 +283,7 @@ void ClientApp::handleClientRefused(const Event &e)
 void ClientApp::handleClientDisconnected()
 {
   LOG((CLOG_NOTE "disconnected from server"));
+  deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::Disconnected);
   if (!args().m_restartable) {
     m_events->addEvent(Event(EventTypes::Quit));
   } else if (!m_suspended) {
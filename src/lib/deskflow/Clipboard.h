@@ -56,6 +56,6 @@ private:
   mutable Time m_time;
   bool m_owner = false;
   Time m_timeOwned;
-  bool m_added[kNumFormats] = {false, false, false};
-  std::string m_data[kNumFormats] = {"", "", ""};
+  bool m_added[kNumFormats] = {false, false, false, false};
+  std::string m_data[kNumFormats] = {"", "", "", ""};
 };
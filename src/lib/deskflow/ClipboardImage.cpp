@@ -0,0 +1,511 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ClipboardImage.h"
+
+#include "base/Log.h"
+
+#include <zlib.h>
+
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const char kSignature[] = "\x89PNG\r\n\x1a\n";
+const size_t kSignatureSize = 8;
+const size_t kInfoHeaderSize = 40;
+
+// images are read into memory whole, so a PNG that would inflate to
+// more than this is refused rather than trusted
+const size_t kMaxImageSize = 256 * 1024 * 1024;
+
+enum ColorType : uint8_t
+{
+  kGray = 0,
+  kRGB = 2,
+  kPalette = 3,
+  kGrayAlpha = 4,
+  kRGBAlpha = 6
+};
+
+enum Filter : uint8_t
+{
+  kNone,
+  kSub,
+  kUp,
+  kAverage,
+  kPaeth,
+  kNumFilters
+};
+
+uint32_t readBE32(const uint8_t *data)
+{
+  return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+uint32_t readLE32(const uint8_t *data)
+{
+  return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+uint16_t readLE16(const uint8_t *data)
+{
+  return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+void writeBE32(std::string &data, uint32_t value)
+{
+  data += static_cast<char>((value >> 24) & 0xff);
+  data += static_cast<char>((value >> 16) & 0xff);
+  data += static_cast<char>((value >> 8) & 0xff);
+  data += static_cast<char>(value & 0xff);
+}
+
+void writeLE32(std::string &data, uint32_t value)
+{
+  data += static_cast<char>(value & 0xff);
+  data += static_cast<char>((value >> 8) & 0xff);
+  data += static_cast<char>((value >> 16) & 0xff);
+  data += static_cast<char>((value >> 24) & 0xff);
+}
+
+void writeLE16(std::string &data, uint16_t value)
+{
+  data += static_cast<char>(value & 0xff);
+  data += static_cast<char>((value >> 8) & 0xff);
+}
+
+uint32_t crc32(uint32_t crc, const char *data, size_t size)
+{
+  static const auto s_table = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < table.size(); ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      }
+      table[i] = c;
+    }
+    return table;
+  }();
+
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = s_table[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void writeChunk(std::string &png, const char *type, const char *data, size_t size)
+{
+  writeBE32(png, static_cast<uint32_t>(size));
+  const auto start = png.size();
+  png.append(type, 4);
+  png.append(data, size);
+  writeBE32(png, crc32(0, png.data() + start, size + 4));
+}
+
+uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+{
+  const int p = a + b - c;
+  const int pa = std::abs(p - a);
+  const int pb = std::abs(p - b);
+  const int pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+// reverses the filter of a row in place, prior is the row above which
+// is already unfiltered, or zeros for the first row
+bool unfilterRow(uint8_t filter, uint8_t *row, const uint8_t *prior, size_t size, size_t bpp)
+{
+  switch (filter) {
+  case kNone:
+    return true;
+
+  case kSub:
+    for (size_t i = bpp; i < size; ++i) {
+      row[i] = static_cast<uint8_t>(row[i] + row[i - bpp]);
+    }
+    return true;
+
+  case kUp:
+    for (size_t i = 0; i < size; ++i) {
+      row[i] = static_cast<uint8_t>(row[i] + prior[i]);
+    }
+    return true;
+
+  case kAverage:
+    for (size_t i = 0; i < size; ++i) {
+      const int left = i >= bpp ? row[i - bpp] : 0;
+      row[i] = static_cast<uint8_t>(row[i] + ((left + prior[i]) >> 1));
+    }
+    return true;
+
+  case kPaeth:
+    for (size_t i = 0; i < size; ++i) {
+      const uint8_t left = i >= bpp ? row[i - bpp] : 0;
+      const uint8_t upperLeft = i >= bpp ? prior[i - bpp] : 0;
+      row[i] = static_cast<uint8_t>(row[i] + paeth(left, prior[i], upperLeft));
+    }
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+void filterRow(uint8_t filter, const uint8_t *row, const uint8_t *prior, size_t size, size_t bpp, uint8_t *out)
+{
+  for (size_t i = 0; i < size; ++i) {
+    const uint8_t left = i >= bpp ? row[i - bpp] : 0;
+    const uint8_t upperLeft = i >= bpp ? prior[i - bpp] : 0;
+    uint8_t predicted = 0;
+    switch (filter) {
+    case kSub:
+      predicted = left;
+      break;
+    case kUp:
+      predicted = prior[i];
+      break;
+    case kAverage:
+      predicted = static_cast<uint8_t>((left + prior[i]) >> 1);
+      break;
+    case kPaeth:
+      predicted = paeth(left, prior[i], upperLeft);
+      break;
+    default:
+      break;
+    }
+    out[i] = static_cast<uint8_t>(row[i] - predicted);
+  }
+}
+
+// the usual heuristic: the filter whose output is closest to zero
+// tends to compress best
+uint32_t filterCost(const uint8_t *data, size_t size)
+{
+  uint32_t cost = 0;
+  for (size_t i = 0; i < size; ++i) {
+    cost += static_cast<uint32_t>(std::abs(static_cast<int8_t>(data[i])));
+  }
+  return cost;
+}
+
+// inflates a zlib stream into exactly size bytes.  the output buffer is
+// never grown, so a stream that would inflate to more than that fails as
+// soon as it tries rather than after it has all been inflated.
+bool inflateExactly(const std::vector<uint8_t> &compressed, uint8_t *out, size_t size)
+{
+  if (compressed.size() > UINT_MAX || size > UINT_MAX) {
+    return false;
+  }
+
+  z_stream stream{};
+  if (inflateInit(&stream) != Z_OK) {
+    return false;
+  }
+  stream.next_in = const_cast<Bytef *>(compressed.data());
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  stream.next_out = out;
+  stream.avail_out = static_cast<uInt>(size);
+  const int result = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+
+  // anything but the end of the stream with the buffer exactly full is
+  // either corrupt, too short or more than the image
+  return result == Z_STREAM_END && stream.avail_out == 0;
+}
+
+} // namespace
+
+//
+// ClipboardImage
+//
+
+bool ClipboardImage::isPNG(const std::string &data)
+{
+  return data.size() >= kSignatureSize && std::memcmp(data.data(), kSignature, kSignatureSize) == 0;
+}
+
+std::string ClipboardImage::pngToBitmap(const std::string &png)
+{
+  if (!isPNG(png)) {
+    return std::string();
+  }
+
+  const auto *data = reinterpret_cast<const uint8_t *>(png.data());
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint8_t depth = 0;
+  uint8_t colorType = 0;
+  std::vector<std::array<uint8_t, 4>> palette;
+  bool transparent = false;
+  std::vector<uint8_t> compressed;
+
+  // read the chunks we need, skipping the rest
+  size_t pos = kSignatureSize;
+  while (pos + 12 <= png.size()) {
+    const uint32_t length = readBE32(data + pos);
+    if (length > png.size() - pos - 12) {
+      LOG((CLOG_DEBUG "png chunk overruns the data"));
+      return std::string();
+    }
+    const auto *type = data + pos + 4;
+    const auto *chunk = data + pos + 8;
+
+    if (std::memcmp(type, "IHDR", 4) == 0) {
+      if (length != 13) {
+        return std::string();
+      }
+      width = readBE32(chunk);
+      height = readBE32(chunk + 4);
+      depth = chunk[8];
+      colorType = chunk[9];
+
+      // compression and filter method, and interlace
+      if (chunk[10] != 0 || chunk[11] != 0 || chunk[12] != 0) {
+        LOG((CLOG_DEBUG "png is interlaced or uses an unknown method"));
+        return std::string();
+      }
+    } else if (std::memcmp(type, "PLTE", 4) == 0) {
+      for (uint32_t i = 0; i + 3 <= length; i += 3) {
+        palette.push_back({chunk[i], chunk[i + 1], chunk[i + 2], 0xff});
+      }
+    } else if (std::memcmp(type, "tRNS", 4) == 0) {
+      // only a palette's alpha is kept, a color key is rare enough to ignore
+      if (colorType == kPalette) {
+        for (uint32_t i = 0; i < length && i < palette.size(); ++i) {
+          palette[i][3] = chunk[i];
+        }
+        transparent = true;
+      }
+    } else if (std::memcmp(type, "IDAT", 4) == 0) {
+      compressed.insert(compressed.end(), chunk, chunk + length);
+    } else if (std::memcmp(type, "IEND", 4) == 0) {
+      break;
+    }
+
+    pos += 12 + length;
+  }
+
+  size_t channels = 0;
+  switch (colorType) {
+  case kGray:
+  case kPalette:
+    channels = 1;
+    break;
+  case kGrayAlpha:
+    channels = 2;
+    break;
+  case kRGB:
+    channels = 3;
+    break;
+  case kRGBAlpha:
+    channels = 4;
+    break;
+  default:
+    break;
+  }
+
+  if (channels == 0 || width == 0 || height == 0 || (depth != 8 && (depth != 16 || colorType == kPalette))) {
+    LOG((CLOG_DEBUG "unsupported png, type=%d depth=%d", colorType, depth));
+    return std::string();
+  }
+
+  const size_t sampleSize = depth / 8;
+  const size_t bpp = channels * sampleSize;
+  if (width > kMaxImageSize / bpp || height > kMaxImageSize / (width * bpp + 1)) {
+    LOG((CLOG_DEBUG "png too large, %dx%d", width, height));
+    return std::string();
+  }
+  const size_t stride = width * bpp;
+  const size_t expected = height * (stride + 1);
+
+  std::vector<uint8_t> raw(expected);
+  if (!inflateExactly(compressed, raw.data(), raw.size())) {
+    LOG((CLOG_DEBUG "png image data is corrupt"));
+    return std::string();
+  }
+
+  auto *pixels = raw.data();
+  const std::vector<uint8_t> zeros(stride, 0);
+  for (uint32_t y = 0; y < height; ++y) {
+    uint8_t *row = pixels + y * (stride + 1);
+    const uint8_t *prior = y == 0 ? zeros.data() : row - stride;
+    if (!unfilterRow(row[0], row + 1, prior, stride, bpp)) {
+      LOG((CLOG_DEBUG "png has an unknown filter"));
+      return std::string();
+    }
+  }
+
+  // write the bitmap bottom up, rows padded to 4 bytes
+  const bool alpha = transparent || colorType == kGrayAlpha || colorType == kRGBAlpha;
+  const uint16_t bitCount = alpha ? 32 : 24;
+  const size_t bitmapStride = (width * (bitCount / 8) + 3) & ~static_cast<size_t>(3);
+  const size_t imageSize = bitmapStride * height;
+
+  std::string bitmap;
+  bitmap.reserve(kInfoHeaderSize + imageSize);
+  writeLE32(bitmap, static_cast<uint32_t>(kInfoHeaderSize));
+  writeLE32(bitmap, width);
+  writeLE32(bitmap, height);
+  writeLE16(bitmap, 1);
+  writeLE16(bitmap, bitCount);
+  writeLE32(bitmap, 0); // BI_RGB
+  writeLE32(bitmap, static_cast<uint32_t>(imageSize));
+  writeLE32(bitmap, 2834); // 72 dpi
+  writeLE32(bitmap, 2834); // 72 dpi
+  writeLE32(bitmap, 0);
+  writeLE32(bitmap, 0);
+  bitmap.resize(kInfoHeaderSize + imageSize, '\0');
+
+  auto *out = reinterpret_cast<uint8_t *>(bitmap.data()) + kInfoHeaderSize;
+  for (uint32_t y = 0; y < height; ++y) {
+    // the high byte of a 16 bit sample comes first
+    const uint8_t *src = pixels + (height - 1 - y) * (stride + 1) + 1;
+    uint8_t *dst = out + y * bitmapStride;
+    for (uint32_t x = 0; x < width; ++x, src += bpp) {
+      std::array<uint8_t, 4> rgba{};
+      switch (colorType) {
+      case kGray:
+        rgba = {src[0], src[0], src[0], 0xff};
+        break;
+      case kGrayAlpha:
+        rgba = {src[0], src[0], src[0], src[sampleSize]};
+        break;
+      case kRGB:
+        rgba = {src[0], src[sampleSize], src[2 * sampleSize], 0xff};
+        break;
+      case kRGBAlpha:
+        rgba = {src[0], src[sampleSize], src[2 * sampleSize], src[3 * sampleSize]};
+        break;
+      case kPalette:
+        if (src[0] < palette.size()) {
+          rgba = palette[src[0]];
+        }
+        break;
+      default:
+        break;
+      }
+
+      *dst++ = rgba[2];
+      *dst++ = rgba[1];
+      *dst++ = rgba[0];
+      if (alpha) {
+        *dst++ = rgba[3];
+      }
+    }
+  }
+
+  return bitmap;
+}
+
+std::string ClipboardImage::bitmapToPNG(const std::string &bitmap)
+{
+  if (bitmap.size() < kInfoHeaderSize) {
+    return std::string();
+  }
+
+  const auto *header = reinterpret_cast<const uint8_t *>(bitmap.data());
+  const auto width = static_cast<int32_t>(readLE32(header + 4));
+  const auto height = static_cast<int32_t>(readLE32(header + 8));
+  const uint16_t bitCount = readLE16(header + 14);
+  const uint32_t compression = readLE32(header + 16);
+  if (readLE32(header) != kInfoHeaderSize || width <= 0 || height == 0 || height == INT32_MIN ||
+      compression != 0 || (bitCount != 24 && bitCount != 32)) {
+    return std::string();
+  }
+
+  // a negative height means the rows are top down
+  const auto rows = static_cast<size_t>(height < 0 ? -height : height);
+  const size_t bpp = bitCount / 8;
+  const size_t bitmapStride = (width * bpp + 3) & ~static_cast<size_t>(3);
+  if (rows > (bitmap.size() - kInfoHeaderSize) / bitmapStride) {
+    return std::string();
+  }
+
+  // BI_RGB leaves the fourth byte of a 32 bpp pixel undefined, and most
+  // bitmaps leave it zero.  it's only taken as alpha if some pixel isn't.
+  const uint8_t *pixels = header + kInfoHeaderSize;
+  bool alpha = false;
+  for (size_t y = 0; y < rows && bitCount == 32 && !alpha; ++y) {
+    const uint8_t *src = pixels + y * bitmapStride;
+    for (size_t x = 0; x < static_cast<size_t>(width) && !alpha; ++x) {
+      alpha = src[x * 4 + 3] != 0;
+    }
+  }
+
+  const size_t channels = alpha ? 4 : 3;
+  const size_t stride = static_cast<size_t>(width) * channels;
+  std::vector<uint8_t> prior(stride, 0);
+  std::vector<uint8_t> current(stride);
+  std::array<std::vector<uint8_t>, kNumFilters> filtered;
+  for (auto &candidate : filtered) {
+    candidate.resize(stride);
+  }
+
+  std::vector<uint8_t> raw;
+  raw.reserve(rows * (stride + 1));
+  for (size_t y = 0; y < rows; ++y) {
+    const uint8_t *src = pixels + (height > 0 ? rows - 1 - y : y) * bitmapStride;
+    for (size_t x = 0; x < static_cast<size_t>(width); ++x, src += bpp) {
+      auto *dst = current.data() + x * channels;
+      dst[0] = src[2];
+      dst[1] = src[1];
+      dst[2] = src[0];
+      if (alpha) {
+        dst[3] = src[3];
+      }
+    }
+
+    uint8_t best = kNone;
+    uint32_t bestCost = UINT32_MAX;
+    for (uint8_t filter = kNone; filter != kNumFilters; ++filter) {
+      filterRow(filter, current.data(), prior.data(), stride, channels, filtered[filter].data());
+      if (const auto cost = filterCost(filtered[filter].data(), stride); cost < bestCost) {
+        best = filter;
+        bestCost = cost;
+      }
+    }
+
+    raw.push_back(best);
+    raw.insert(raw.end(), filtered[best].begin(), filtered[best].end());
+    std::swap(prior, current);
+  }
+
+  if (raw.size() > UINT_MAX) {
+    return std::string();
+  }
+  auto compressedSize = compressBound(static_cast<uLong>(raw.size()));
+  std::vector<uint8_t> compressed(compressedSize);
+  if (compress(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size())) != Z_OK) {
+    return std::string();
+  }
+
+  std::string ihdr;
+  writeBE32(ihdr, static_cast<uint32_t>(width));
+  writeBE32(ihdr, static_cast<uint32_t>(rows));
+  ihdr += static_cast<char>(8);
+  ihdr += static_cast<char>(alpha ? kRGBAlpha : kRGB);
+  ihdr.append(3, '\0');
+
+  std::string png(kSignature, kSignatureSize);
+  png.reserve(kSignatureSize + 3 * 12 + ihdr.size() + compressedSize);
+  writeChunk(png, "IHDR", ihdr.data(), ihdr.size());
+  writeChunk(png, "IDAT", reinterpret_cast<const char *>(compressed.data()), compressedSize);
+  writeChunk(png, "IEND", "", 0);
+  return png;
+}
@@ -0,0 +1,40 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <string>
+
+//! Clipboard image conversion
+/*!
+Converts between the two image formats of IClipboard: \c kBitmap, a BMP
+without its file header, and \c kPNG, a complete PNG file.  A PNG only
+needs converting for a peer or platform that can't take it as it is.
+
+Only what a clipboard needs is supported: PNGs that aren't interlaced
+with 8 or 16 bits per sample, and 24 or 32 bpp BI_RGB bitmaps.
+*/
+class ClipboardImage
+{
+public:
+  //! Returns true if \p data starts with the PNG signature
+  static bool isPNG(const std::string &data);
+
+  //! Convert PNG to bitmap
+  /*!
+  The bitmap is 32 bpp if the PNG has transparency, otherwise 24 bpp.
+  Returns an empty string if the PNG can't be decoded.
+  */
+  static std::string pngToBitmap(const std::string &png);
+
+  //! Convert bitmap to PNG
+  /*!
+  The fourth byte of a 32 bpp bitmap is kept as alpha unless it's zero
+  for every pixel, since BI_RGB leaves it undefined and most bitmaps
+  leave it zero.  Returns an empty string if the bitmap can't be read.
+  */
+  static std::string bitmapToPNG(const std::string &bitmap);
+};
@@ -33,6 +33,8 @@
 using namespace std;
 using namespace deskflow::core;
 
+const auto kTraceFilename = "deskflow-trace.json";
+
 void showHelp(int argc, char **argv) // NOSONAR - CLI args
 {
   const auto binName = argc > 0 ? std::filesystem::path(argv[0]).filename().string() : kDaemonBinName;
@@ -67,12 +69,37 @@ void DaemonApp::setCommand(const QString &command)
   m_command = command.toStdString();
 }
 
+void DaemonApp::setTrace(bool trace)
+{
+  LOG_DEBUG("trace value changed: %s", trace ? "on" : "off");
+  if (m_trace == trace) {
+    return;
+  }
+
+  // The core only records spans when started with the trace arg, so the core is restarted
+  // to apply the change; when turned off, the old core writes its trace file as it exits.
+  m_trace = trace;
+  if (!m_command.empty()) {
+    applyWatchdogCommand();
+  }
+}
+
+std::string DaemonApp::watchdogCommand() const
+{
+  if (!m_trace) {
+    return m_command;
+  }
+
+  const auto traceFile = std::filesystem::path(logFilename().toStdString()).replace_filename(kTraceFilename);
+  return m_command + " --trace-events \"" + traceFile.string() + "\"";
+}
+
 void DaemonApp::applyWatchdogCommand() const
 {
   LOG_DEBUG("applying watchdog command");
 
 #if SYSAPI_WIN32
-  m_pWatchdog->setProcessConfig(m_command, m_elevate);
+  m_pWatchdog->setProcessConfig(watchdogCommand(), m_elevate);
 #else
   LOG_ERR("applying watchdog command not implemented on this platform");
 #endif
@@ -129,6 +156,10 @@ void DaemonApp::connectIpcServer(const ipc::DaemonIpcServer *ipcServer) const
       ipcServer, &ipc::DaemonIpcServer::clearSettingsRequested, this, &DaemonApp::clearSettings, //
       Qt::DirectConnection
   );
+  QObject::connect(
+      ipcServer, &ipc::DaemonIpcServer::traceChanged, this, &DaemonApp::setTrace, //
+      Qt::DirectConnection
+  );
 }
 
 void DaemonApp::install() const
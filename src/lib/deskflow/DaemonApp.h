@@ -65,6 +65,8 @@ private:
   void saveLogLevel(const QString &logLevel) const;
   void setElevate(bool elevate);
   void setCommand(const QString &command);
+  void setTrace(bool trace);
+  std::string watchdogCommand() const;
   void applyWatchdogCommand() const;
   void clearWatchdogCommand();
   void clearSettings() const;
@@ -80,5 +82,6 @@ private:
   deskflow::core::ipc::DaemonIpcServer *m_ipcServer = nullptr;
   std::string m_command = "";
   bool m_elevate = false;
+  bool m_trace = false;
   bool m_foreground = false;
 };
@@ -0,0 +1,623 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/FileTransfer.h"
+
+#include "base/EventTypes.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/IStream.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QStorageInfo>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#if SYSAPI_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace deskflow {
+
+namespace {
+
+// small enough that input events written between windows go out promptly,
+// large enough that the link doesn't sit idle while the next is queued
+const uint64_t kChunkSize = 64 * 1024;
+const uint64_t kWindowSize = 4 * kChunkSize;
+
+// how long to wait for the receiver to say where to send from
+const double kResumeTimeout = 30.0;
+
+// files the peer can announce ahead of sending them
+const std::size_t kMaxIncoming = 1024;
+
+// space left free on the disk after allocating a received file
+const uint64_t kReservedSpace = 64 * 1024 * 1024;
+
+// the same wire format as kMsgDFileTransfer, but the data is written from
+// a pointer so chunks go from the mapped file straight into the message
+const char *const kMsgDFileTransferData = "DFTR%1i%S";
+
+struct Partial
+{
+  uint64_t m_size = 0;
+  uint64_t m_offset = 0;
+};
+
+// progress of interrupted transfers by partial file path, kept across
+// connections so that a reconnected peer can resume
+std::mutex s_partialsMutex;
+std::map<QString, Partial> s_partials;
+
+std::string encodeSize(uint64_t size)
+{
+  std::string data(8, '\0');
+  for (auto i = 7; i >= 0; --i) {
+    data[i] = static_cast<char>(size & 0xff);
+    size >>= 8;
+  }
+  return data;
+}
+
+bool decodeSize(const std::string &data, uint64_t &size)
+{
+  if (data.size() != 8) {
+    return false;
+  }
+
+  size = 0;
+  for (const auto c : data) {
+    size = (size << 8) | static_cast<uint8_t>(c);
+  }
+  return true;
+}
+
+void writeEnd(IStream *stream)
+{
+  const std::string empty;
+  ProtocolUtil::writef(stream, kMsgDFileTransfer, ChunkType::DataEnd, &empty);
+}
+
+bool allocate(QFile &file, uint64_t size)
+{
+  if (size == 0) {
+    return true;
+  }
+
+#if SYSAPI_UNIX && !defined(__APPLE__)
+  // reserve the blocks up front so the file isn't fragmented as it grows
+  // and a full disk is found before any data is sent, not part way through
+  if (const auto result = posix_fallocate(file.handle(), 0, static_cast<off_t>(size)); result == 0) {
+    return true;
+  } else if (result != EINVAL && result != EOPNOTSUPP) {
+    LOG((CLOG_ERR "failed to allocate %llu bytes for file: %s", size, strerror(result)));
+    return false;
+  }
+  // the file system can't allocate, fall through to setting the size
+#endif
+
+  return file.resize(static_cast<qint64>(size));
+}
+
+bool hasSpace(const QString &directory, uint64_t size)
+{
+  // the size comes from the peer, so check it fits before allocating
+  const QStorageInfo storage(directory);
+  if (!storage.isValid() || storage.bytesAvailable() < 0) {
+    return false;
+  }
+
+  const auto available = static_cast<uint64_t>(storage.bytesAvailable());
+  return available > kReservedSpace && size <= available - kReservedSpace;
+}
+
+bool writeAt(QFile &file, const char *data, uint64_t size, uint64_t offset)
+{
+#if SYSAPI_UNIX
+  while (size > 0) {
+    const auto written = pwrite(file.handle(), data, size, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG((CLOG_ERR "failed to write file: %s", strerror(errno)));
+      return false;
+    }
+    data += written;
+    size -= written;
+    offset += written;
+  }
+  return true;
+#else
+  return file.seek(static_cast<qint64>(offset)) && file.write(data, static_cast<qint64>(size)) == size;
+#endif
+}
+
+QString safeName(const std::string &path)
+{
+  // only ever use the last part of a path given by the peer, so that a
+  // file can't be written outside the directory
+  auto name = QString::fromStdString(path);
+  name.replace(QLatin1Char('\\'), QLatin1Char('/'));
+  name = QFileInfo(name).fileName();
+  if (name.isEmpty() || name == QStringLiteral(".") || name == QStringLiteral("..")) {
+    return QStringLiteral("file");
+  }
+  return name;
+}
+
+} // namespace
+
+//
+// FileSender
+//
+
+FileSender::FileSender(const QString &path) : m_file{path}
+{
+  // do nothing
+}
+
+bool FileSender::start(IStream *stream)
+{
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    LOG((CLOG_ERR "failed to open file to send: %s", qPrintable(m_file.fileName())));
+    return false;
+  }
+
+  m_size = static_cast<uint64_t>(m_file.size());
+  LOG((CLOG_DEBUG "start sending file: %s size=%llu", qPrintable(m_file.fileName()), m_size));
+
+  const auto size = encodeSize(m_size);
+  ProtocolUtil::writef(stream, kMsgDFileTransfer, ChunkType::DataStart, &size);
+  return true;
+}
+
+void FileSender::resume(uint64_t offset)
+{
+  m_offset = std::min(offset, m_size);
+  m_resumed = true;
+
+  if (m_offset > 0) {
+    LOG((CLOG_DEBUG "resuming file transfer at offset=%llu", m_offset));
+  }
+}
+
+bool FileSender::send(IStream *stream, uint64_t budget)
+{
+  if (!m_resumed || m_done) {
+    return true;
+  }
+
+  if (const auto length = std::min(budget, m_size - m_offset); length > 0) {
+    // map only the window being sent, so large files don't take up address
+    // space and pages already sent can be dropped
+    auto *map = m_file.map(static_cast<qint64>(m_offset), static_cast<qint64>(length));
+    if (map == nullptr) {
+      LOG((CLOG_ERR "failed to map file to send: %s", qPrintable(m_file.errorString())));
+      return false;
+    }
+
+    for (uint64_t sent = 0; sent < length;) {
+      const auto size = static_cast<uint32_t>(std::min(kChunkSize, length - sent));
+      ProtocolUtil::writef(stream, kMsgDFileTransferData, ChunkType::DataChunk, size, map + sent);
+      sent += size;
+    }
+
+    m_file.unmap(map);
+    m_offset += length;
+  }
+
+  if (m_offset == m_size) {
+    writeEnd(stream);
+    m_file.close();
+    m_done = true;
+    LOG((CLOG_DEBUG "finished sending file size=%llu", m_size));
+  }
+  return true;
+}
+
+bool FileSender::isResumed() const
+{
+  return m_resumed;
+}
+
+bool FileSender::isDone() const
+{
+  return m_done;
+}
+
+uint64_t FileSender::offset() const
+{
+  return m_offset;
+}
+
+uint64_t FileSender::size() const
+{
+  return m_size;
+}
+
+//
+// FileReceiver
+//
+
+FileReceiver::FileReceiver(const QString &directory, const QString &peer, const QString &name, bool resume)
+    : m_directory{directory},
+      m_peer{peer},
+      m_name{name},
+      m_resume{resume}
+{
+  // do nothing
+}
+
+FileReceiver::~FileReceiver()
+{
+  if (m_file.isOpen() && !m_finished) {
+    LOG((CLOG_DEBUG "file transfer interrupted at offset=%llu, keeping partial file", m_offset));
+    m_file.close();
+  }
+}
+
+TransferState FileReceiver::receive(IStream *stream, uint8_t mark, const std::string &data)
+{
+  switch (mark) {
+  case ChunkType::DataStart:
+    return start(stream, data);
+
+  case ChunkType::DataChunk:
+    return write(data);
+
+  case ChunkType::DataEnd:
+    return finish();
+
+  default:
+    LOG((CLOG_ERR "file transfer failed: unknown mark %d", mark));
+    return TransferState::Error;
+  }
+}
+
+QString FileReceiver::path() const
+{
+  return m_path;
+}
+
+uint64_t FileReceiver::offset() const
+{
+  return m_offset;
+}
+
+TransferState FileReceiver::start(IStream *stream, const std::string &data)
+{
+  if (!decodeSize(data, m_size)) {
+    LOG((CLOG_ERR "file transfer failed: invalid size"));
+    return TransferState::Error;
+  }
+
+  if (!QDir().mkpath(m_directory)) {
+    LOG((CLOG_ERR "failed to create directory for received files: %s", qPrintable(m_directory)));
+    return TransferState::Error;
+  }
+
+  const auto path = partialPath();
+  uint64_t offset = 0;
+  {
+    // a peer that can't resume sends from the start whatever we have
+    std::scoped_lock lock{s_partialsMutex};
+    const auto it = s_partials.find(path);
+    if (m_resume && it != s_partials.end() && it->second.m_size == m_size && QFileInfo(path).size() == qint64(m_size)) {
+      offset = it->second.m_offset;
+    }
+
+    // a resumed partial file is already allocated at its full size
+    if (offset == 0 && !hasSpace(m_directory, m_size)) {
+      LOG((CLOG_ERR "file transfer failed: not enough space for size=%llu in %s", m_size, qPrintable(m_directory)));
+      return TransferState::Error;
+    }
+    s_partials[path] = {m_size, offset};
+  }
+
+  // unbuffered, since writes go straight to the file descriptor by offset
+  auto mode = QIODevice::ReadWrite | QIODevice::Unbuffered;
+  if (offset == 0) {
+    mode |= QIODevice::Truncate;
+  }
+
+  m_file.setFileName(path);
+  if (!m_file.open(mode) || (offset == 0 && !allocate(m_file, m_size))) {
+    LOG((CLOG_ERR "failed to create file: %s", qPrintable(path)));
+    m_file.close();
+    return TransferState::Error;
+  }
+
+  m_offset = offset;
+  if (m_offset > 0) {
+    LOG((CLOG_DEBUG "resuming receiving file: %s at offset=%llu", qPrintable(m_name), m_offset));
+  } else {
+    LOG((CLOG_DEBUG "start receiving file: %s size=%llu", qPrintable(m_name), m_size));
+  }
+
+  if (m_resume) {
+    const auto reply = encodeSize(m_offset);
+    ProtocolUtil::writef(stream, kMsgDFileTransfer, ChunkType::DataResume, &reply);
+  }
+  return TransferState::Started;
+}
+
+TransferState FileReceiver::write(const std::string &data)
+{
+  if (!m_file.isOpen()) {
+    return TransferState::Error;
+  }
+
+  if (m_offset + data.size() > m_size) {
+    LOG((CLOG_ERR "file transfer failed: more data than expected size=%llu", m_size));
+    m_file.close();
+    return TransferState::Error;
+  }
+
+  if (!writeAt(m_file, data.data(), data.size(), m_offset)) {
+    m_file.close();
+    return TransferState::Error;
+  }
+
+  m_offset += data.size();
+
+  std::scoped_lock lock{s_partialsMutex};
+  s_partials[m_file.fileName()].m_offset = m_offset;
+  return TransferState::InProgress;
+}
+
+TransferState FileReceiver::finish()
+{
+  if (!m_file.isOpen()) {
+    return TransferState::Error;
+  }
+
+  m_file.close();
+  if (m_offset != m_size) {
+    LOG((CLOG_ERR "file transfer incomplete, expected size=%llu actual size=%llu", m_size, m_offset));
+    return TransferState::Error;
+  }
+
+  {
+    std::scoped_lock lock{s_partialsMutex};
+    s_partials.erase(m_file.fileName());
+  }
+
+  // never replace an existing file, add a number to the name instead
+  const QDir dir(m_directory);
+  const QFileInfo info(m_name);
+  auto path = dir.filePath(m_name);
+  for (auto i = 1; QFileInfo::exists(path); ++i) {
+    const auto suffix = info.suffix().isEmpty() ? QString() : QStringLiteral(".") + info.suffix();
+    path = dir.filePath(QStringLiteral("%1 (%2)%3").arg(info.completeBaseName()).arg(i).arg(suffix));
+  }
+
+  if (!QFile::rename(m_file.fileName(), path)) {
+    LOG((CLOG_ERR "failed to save received file: %s", qPrintable(path)));
+    return TransferState::Error;
+  }
+
+  m_path = path;
+  m_finished = true;
+  LOG((CLOG_INFO "received file: %s", qPrintable(m_path)));
+  return TransferState::Finished;
+}
+
+QString FileReceiver::partialPath() const
+{
+  return QDir(m_directory).filePath(QStringLiteral(".%1.%2.part").arg(m_name, m_peer));
+}
+
+//
+// FileTransfer
+//
+
+FileTransfer::FileTransfer(IStream *stream, IEventQueue *events, const std::string &peer, const QString &directory)
+    : m_stream{stream},
+      m_events{events},
+      m_peer{safeName(peer)},
+      m_directory{directory}
+{
+  m_events->addHandler(EventTypes::StreamOutputFlushed, m_stream->getEventTarget(), [this](const auto &) {
+    sendWindow();
+  });
+  m_events->addHandler(EventTypes::Timer, this, [this](const auto &) { handleResumeTimeout(); });
+}
+
+FileTransfer::~FileTransfer()
+{
+  removeResumeTimer();
+  m_events->removeHandler(EventTypes::Timer, this);
+  m_events->removeHandler(EventTypes::StreamOutputFlushed, m_stream->getEventTarget());
+}
+
+void FileTransfer::sendFiles(const std::vector<std::string> &paths)
+{
+  std::string info;
+  for (const auto &path : paths) {
+    info.append(path);
+    info.push_back('\0');
+  }
+
+  LOG((CLOG_DEBUG "sending %d file(s)", paths.size()));
+  ProtocolUtil::writef(m_stream, kMsgDDragInfo, static_cast<uint32_t>(paths.size()), &info);
+
+  for (const auto &path : paths) {
+    m_outgoing.push_back(QString::fromStdString(path));
+  }
+
+  if (!m_sender) {
+    sendNext();
+  }
+}
+
+void FileTransfer::setResumable(bool resumable)
+{
+  m_resumable = resumable;
+}
+
+void FileTransfer::setReceiving(bool receiving)
+{
+  m_receiving = receiving;
+}
+
+void FileTransfer::dragInfoReceived()
+{
+  uint16_t count = 0;
+  std::string info;
+  if (!ProtocolUtil::readf(m_stream, kMsgDDragInfo + 4, &count, &info)) {
+    return;
+  }
+
+  if (!m_receiving) {
+    LOG((CLOG_NOTE "ignoring %d file(s) sent by peer, receiving files is turned off", count));
+    return;
+  }
+
+  LOG((CLOG_DEBUG "peer is sending %d file(s)", count));
+  for (std::size_t start = 0; start < info.size();) {
+    auto end = info.find('\0', start);
+    if (end == std::string::npos) {
+      end = info.size();
+    }
+    if (m_incoming.size() == kMaxIncoming) {
+      LOG((CLOG_WARN "ignoring files sent by peer after the first %d", kMaxIncoming));
+      break;
+    }
+    m_incoming.push_back(safeName(info.substr(start, end - start)));
+    start = end + 1;
+  }
+}
+
+void FileTransfer::chunkReceived()
+{
+  uint8_t mark = 0;
+  std::string data;
+  if (!ProtocolUtil::readf(m_stream, kMsgDFileTransfer + 4, &mark, &data)) {
+    return;
+  }
+
+  if (mark == ChunkType::DataResume) {
+    if (uint64_t offset = 0; m_sender && !m_sender->isResumed() && decodeSize(data, offset)) {
+      removeResumeTimer();
+      m_sender->resume(offset);
+      sendWindow();
+    }
+    return;
+  }
+
+  if (!m_receiving) {
+    return;
+  }
+
+  if (mark == ChunkType::DataStart) {
+    m_receiver.reset();
+    if (m_incoming.empty()) {
+      // never save a file the peer didn't announce first
+      LOG((CLOG_WARN "ignoring file transfer that was not announced"));
+      return;
+    }
+    m_receiver = std::make_unique<FileReceiver>(m_directory, m_peer, m_incoming.front(), m_resumable);
+    m_incoming.pop_front();
+  } else if (!m_receiver) {
+    // the peer ends a file without starting it when it couldn't open it
+    if (mark == ChunkType::DataEnd && !m_incoming.empty()) {
+      LOG((CLOG_WARN "peer could not send file: %s", qPrintable(m_incoming.front())));
+      m_incoming.pop_front();
+    }
+    return;
+  }
+
+  m_receiver->receive(m_stream, mark, data);
+  if (mark == ChunkType::DataEnd) {
+    m_receiver.reset();
+  }
+}
+
+QString FileTransfer::defaultDirectory()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
+}
+
+bool FileTransfer::isSending() const
+{
+  return m_sender != nullptr;
+}
+
+void FileTransfer::sendNext()
+{
+  removeResumeTimer();
+  m_sender.reset();
+  while (!m_outgoing.empty()) {
+    auto sender = std::make_unique<FileSender>(m_outgoing.front());
+    m_outgoing.pop_front();
+    if (sender->start(m_stream)) {
+      m_sender = std::move(sender);
+      if (m_resumable) {
+        m_resumeTimer = m_events->newOneShotTimer(kResumeTimeout, this);
+      } else {
+        // the first window goes once the start has left the stream
+        m_sender->resume(0);
+      }
+      return;
+    }
+
+    // keep the peer in step with the files it was told about
+    writeEnd(m_stream);
+  }
+}
+
+void FileTransfer::sendWindow()
+{
+  // the next window is only sent once the last has left the stream
+  if (!m_sender || !m_sender->isResumed()) {
+    return;
+  }
+
+  if (!m_sender->send(m_stream, kWindowSize)) {
+    // the receiver sees the transfer end short and keeps what it has
+    writeEnd(m_stream);
+    sendNext();
+  } else if (m_sender->isDone()) {
+    sendNext();
+  }
+}
+
+void FileTransfer::handleResumeTimeout()
+{
+  removeResumeTimer();
+  if (!m_sender || m_sender->isResumed()) {
+    return;
+  }
+
+  // a late reply can't be told apart from one for the next file, so give
+  // up on all of them rather than send any from the wrong offset
+  LOG((CLOG_WARN "peer did not reply to file transfer, cancelling %d file(s)", m_outgoing.size() + 1));
+  m_sender.reset();
+  writeEnd(m_stream);
+  for (; !m_outgoing.empty(); m_outgoing.pop_front()) {
+    writeEnd(m_stream);
+  }
+}
+
+void FileTransfer::removeResumeTimer()
+{
+  if (m_resumeTimer != nullptr) {
+    m_events->deleteTimer(m_resumeTimer);
+    m_resumeTimer = nullptr;
+  }
+}
+
+} // namespace deskflow
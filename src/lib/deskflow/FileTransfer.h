@@ -0,0 +1,235 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/ProtocolTypes.h"
+
+#include <QFile>
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+class EventQueueTimer;
+class IEventQueue;
+
+namespace deskflow {
+
+class IStream;
+
+//! Sends one file in kMsgDFileTransfer messages
+/*!
+Maps the file a window at a time and writes its chunks straight from
+the mapping, so the file is never read into memory as a whole however
+large it is.
+*/
+class FileSender
+{
+public:
+  explicit FileSender(const QString &path);
+  FileSender(FileSender const &) = delete;
+  FileSender(FileSender &&) = delete;
+  ~FileSender() = default;
+
+  FileSender &operator=(FileSender const &) = delete;
+  FileSender &operator=(FileSender &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Open the file and write the start of the transfer
+  /*!
+  Returns false if the file can't be opened.
+  */
+  bool start(IStream *stream);
+
+  //! Continue from \p offset, as asked by the receiver
+  void resume(uint64_t offset);
+
+  //! Write chunks of up to \p budget bytes in all
+  /*!
+  Writes the end of the transfer once the last chunk is written.
+  Returns false if the file can no longer be read.
+  */
+  bool send(IStream *stream, uint64_t budget);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns true once the receiver has said where to send from
+  bool isResumed() const;
+
+  //! Returns true once the end of the transfer has been written
+  bool isDone() const;
+
+  //! Number of bytes sent or skipped so far
+  uint64_t offset() const;
+
+  //! Size of the file
+  uint64_t size() const;
+
+  //@}
+
+private:
+  QFile m_file;
+  uint64_t m_size = 0;
+  uint64_t m_offset = 0;
+  bool m_resumed = false;
+  bool m_done = false;
+};
+
+//! Receives one file from kMsgDFileTransfer messages
+/*!
+Writes chunks in place into a partial file next to the destination,
+allocated at its full size up front, and renames it once complete.
+The partial file is named after the peer as well as the file, so that
+peers sending files with the same name don't write over each other.
+It is kept if the connection drops, and a later transfer of a file
+with the same name and size from the same peer carries on where it
+stopped when the peer can resume.
+*/
+class FileReceiver
+{
+public:
+  FileReceiver(const QString &directory, const QString &peer, const QString &name, bool resume);
+  FileReceiver(FileReceiver const &) = delete;
+  FileReceiver(FileReceiver &&) = delete;
+  ~FileReceiver();
+
+  FileReceiver &operator=(FileReceiver const &) = delete;
+  FileReceiver &operator=(FileReceiver &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Handle a received message
+  /*!
+  Takes the mark and data of a kMsgDFileTransfer message, and writes the
+  reply to \p stream when the message is the start of the transfer and
+  the peer can resume.
+  */
+  TransferState receive(IStream *stream, uint8_t mark, const std::string &data);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Path the file was saved to, empty until complete
+  QString path() const;
+
+  //! Number of bytes written so far, including those resumed
+  uint64_t offset() const;
+
+  //@}
+
+private:
+  TransferState start(IStream *stream, const std::string &data);
+  TransferState write(const std::string &data);
+  TransferState finish();
+  QString partialPath() const;
+
+  const QString m_directory;
+  const QString m_peer;
+  const QString m_name;
+  const bool m_resume;
+  QString m_path;
+  QFile m_file;
+  uint64_t m_size = 0;
+  uint64_t m_offset = 0;
+  bool m_finished = false;
+};
+
+//! File transfer for one connection
+/*!
+Sends the files announced by a kMsgDDragInfo message one at a time and
+saves those announced by the peer in a directory.  Sending is paced by
+the stream's output being flushed, so that only a window of file data
+is queued at once and the input events written to the same stream
+between windows don't wait behind the whole file.
+
+Files are only received once enabled by the user, and only those
+announced by the peer, up to a limit.  Interrupted transfers are only
+resumed once enabled, as older peers stream every file from the start
+and never reply to it.
+*/
+class FileTransfer
+{
+public:
+  FileTransfer(
+      IStream *stream, IEventQueue *events, const std::string &peer, const QString &directory = defaultDirectory()
+  );
+  FileTransfer(FileTransfer const &) = delete;
+  FileTransfer(FileTransfer &&) = delete;
+  ~FileTransfer();
+
+  FileTransfer &operator=(FileTransfer const &) = delete;
+  FileTransfer &operator=(FileTransfer &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Send files
+  /*!
+  Announces the files in \p paths to the peer and sends them one at a
+  time, after any already being sent.
+  */
+  void sendFiles(const std::vector<std::string> &paths);
+
+  //! Resume interrupted transfers
+  /*!
+  Only enable when the peer supports protocol 1.10 or later.
+  */
+  void setResumable(bool resumable);
+
+  //! Save files sent by the peer
+  /*!
+  Off by default, when files announced or sent by the peer are ignored.
+  */
+  void setReceiving(bool receiving);
+
+  //! Read a kMsgDDragInfo message, after its code
+  void dragInfoReceived();
+
+  //! Read a kMsgDFileTransfer message, after its code
+  void chunkReceived();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Directory received files are saved to
+  static QString defaultDirectory();
+
+  //! Returns true while files are queued or being sent
+  bool isSending() const;
+
+  //@}
+
+private:
+  void sendNext();
+  void sendWindow();
+  void handleResumeTimeout();
+  void removeResumeTimer();
+
+  IStream *m_stream;
+  IEventQueue *m_events;
+  const QString m_peer;
+  const QString m_directory;
+  bool m_resumable = false;
+  bool m_receiving = false;
+  EventQueueTimer *m_resumeTimer = nullptr;
+  std::deque<QString> m_outgoing;
+  std::unique_ptr<FileSender> m_sender;
+  std::deque<QString> m_incoming;
+  std::unique_ptr<FileReceiver> m_receiver;
+};
+
+} // namespace deskflow
@@ -7,7 +7,9 @@
 
 #include "deskflow/IClipboard.h"
 
-#include <vector>
+#include "base/Log.h"
+#include "base/Trace.h"
+#include "deskflow/ClipboardImage.h"
 
 //
 // IClipboard
@@ -15,6 +17,7 @@
 
 void IClipboard::unmarshall(IClipboard *clipboard, const std::string_view &data, Time time)
 {
+  TRACE_SCOPE_ARGS("clipboard", "IClipboard::unmarshall", "size", data.size());
   assert(clipboard != nullptr);
 
   const char *index = data.data();
@@ -53,49 +56,44 @@ void IClipboard::unmarshall(IClipboard *clipboard, const std::string_view &data,
 
 std::string IClipboard::marshall(const IClipboard *clipboard)
 {
-  // return data format:
-  // 4 bytes => number of formats included
-  // 4 bytes => format enum
-  // 4 bytes => clipboard data size n
-  // n bytes => clipboard data
-  // back to the second 4 bytes if there is another format
-
+  TRACE_SCOPE("clipboard", "IClipboard::marshall");
   assert(clipboard != nullptr);
 
-  std::string data;
+  FormatData formats;
+  if (!readFormats(clipboard, formats)) {
+    return std::string();
+  }
+  return marshallFormats(formats);
+}
 
-  std::vector<std::string> formatData;
-  formatData.resize(IClipboard::kNumFormats);
-  // FIXME -- use current time
-  if (clipboard->open(0)) {
-
-    // compute size of marshalled data
-    uint32_t size = 4;
-    uint32_t numFormats = 0;
-    for (uint32_t format = 0; format != IClipboard::kNumFormats; ++format) {
-      if (clipboard->has(static_cast<IClipboard::EFormat>(format))) {
-        ++numFormats;
-        formatData[format] = clipboard->get(static_cast<IClipboard::EFormat>(format));
-        size += 4 + 4 + (uint32_t)formatData[format].size();
-      }
-    }
+std::string IClipboard::marshall(const IClipboard *clipboard, bool withPNG)
+{
+  TRACE_SCOPE("clipboard", "IClipboard::marshall");
+  assert(clipboard != nullptr);
 
-    // allocate space
-    data.reserve(size);
+  FormatData formats;
+  if (!readFormats(clipboard, formats)) {
+    return std::string();
+  }
 
-    // marshall the data
-    writeUInt32(&data, numFormats);
-    for (uint32_t format = 0; format != IClipboard::kNumFormats; ++format) {
-      if (clipboard->has(static_cast<IClipboard::EFormat>(format))) {
-        writeUInt32(&data, format);
-        writeUInt32(&data, (uint32_t)formatData[format].size());
-        data += formatData[format];
+  // send the image once, in the smallest format the peer understands
+  auto &png = formats[kPNG];
+  auto &bitmap = formats[kBitmap];
+  if (withPNG) {
+    if (png.has_value()) {
+      bitmap.reset();
+    }
+  } else {
+    if (png.has_value() && !bitmap.has_value()) {
+      LOG((CLOG_DEBUG "converting clipboard png to bitmap for peer"));
+      if (auto converted = ClipboardImage::pngToBitmap(*png); !converted.empty()) {
+        bitmap = std::move(converted);
       }
     }
-    clipboard->close();
+    png.reset();
   }
 
-  return data;
+  return marshallFormats(formats);
 }
 
 bool IClipboard::copy(IClipboard *dst, const IClipboard *src)
@@ -131,6 +129,59 @@ bool IClipboard::copy(IClipboard *dst, const IClipboard *src, Time time)
   return success;
 }
 
+bool IClipboard::readFormats(const IClipboard *clipboard, FormatData &formats)
+{
+  // FIXME -- use current time
+  if (!clipboard->open(0)) {
+    return false;
+  }
+
+  formats.assign(kNumFormats, std::nullopt);
+  for (uint32_t format = 0; format != kNumFormats; ++format) {
+    if (clipboard->has(static_cast<EFormat>(format))) {
+      formats[format] = clipboard->get(static_cast<EFormat>(format));
+    }
+  }
+  clipboard->close();
+  return true;
+}
+
+std::string IClipboard::marshallFormats(const FormatData &formats)
+{
+  // return data format:
+  // 4 bytes => number of formats included
+  // 4 bytes => format enum
+  // 4 bytes => clipboard data size n
+  // n bytes => clipboard data
+  // back to the second 4 bytes if there is another format
+
+  // compute size of marshalled data
+  uint32_t size = 4;
+  uint32_t numFormats = 0;
+  for (const auto &data : formats) {
+    if (data.has_value()) {
+      ++numFormats;
+      size += 4 + 4 + (uint32_t)data->size();
+    }
+  }
+
+  // allocate space
+  std::string buffer;
+  buffer.reserve(size);
+
+  // marshall the data
+  writeUInt32(&buffer, numFormats);
+  for (uint32_t format = 0; format != formats.size(); ++format) {
+    if (const auto &data = formats[format]; data.has_value()) {
+      writeUInt32(&buffer, format);
+      writeUInt32(&buffer, (uint32_t)data->size());
+      buffer += *data;
+    }
+  }
+
+  return buffer;
+}
+
 uint32_t IClipboard::readUInt32(const char *buf)
 {
   const auto *ubuf = reinterpret_cast<const unsigned char *>(buf);
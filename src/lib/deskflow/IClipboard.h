@@ -10,7 +10,9 @@
 #include "base/EventTypes.h"
 #include "common/IInterface.h"
 
+#include <optional>
 #include <string>
+#include <vector>
 
 //! Clipboard interface
 /*!
@@ -45,12 +47,17 @@ public:
   \c kHTML is a text format encoded in UTF-8 and containing a valid
   HTML fragment (but not necessarily a complete HTML document).
   Newlines are LF.
+
+  \c kPNG is an image format.  The data is a complete PNG file, kept as
+  it was copied so that it's not decoded and encoded again on the way.
+  A clipboard may have an image as both \c kBitmap and \c kPNG.
   */
   enum EFormat
   {
     kText,      //!< Text format, UTF-8, newline is LF
     kHTML,      //!< HTML format, HTML fragment, UTF-8, newline is LF
     kBitmap,    //!< Bitmap format, BMP 24/32bpp, BI_RGB
+    kPNG,       //!< PNG format, complete PNG file
     kNumFormats //!< The number of clipboard formats
   };
 
@@ -126,6 +133,15 @@ public:
   */
   static std::string marshall(const IClipboard *clipboard);
 
+  //! Marshall clipboard data for a peer
+  /*!
+  Like marshall() but with an image in only one format, the one the
+  peer should use.  A peer that supports \c kPNG gets the PNG as it
+  is, and no bitmap.  Any other peer gets the bitmap, decoded from the
+  PNG if there isn't one, and no PNG.
+  */
+  static std::string marshall(const IClipboard *clipboard, bool withPNG);
+
   //! Unmarshall clipboard data
   /*!
   Extract marshalled clipboard data and store it in \p clipboard.
@@ -155,6 +171,10 @@ public:
   //@}
 
 private:
+  using FormatData = std::vector<std::optional<std::string>>;
+
+  static bool readFormats(const IClipboard *, FormatData &);
+  static std::string marshallFormats(const FormatData &);
   static uint32_t readUInt32(const char *);
   static void writeUInt32(std::string *, uint32_t);
 };
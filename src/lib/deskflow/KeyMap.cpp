@@ -7,16 +7,67 @@
 
 #include "deskflow/KeyMap.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "deskflow/App.h"
 #include "deskflow/ArgsBase.h"
 #include "deskflow/KeyTypes.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 
 namespace deskflow {
 
+namespace {
+
+// bump whenever the marshalled form of a map changes
+const uint32_t kMarshallVersion = 1;
+
+// marshalled maps are only read back on the machine that wrote them, so
+// values are written in native byte order
+template <typename T> void writeValue(std::string &buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+class MarshallReader
+{
+public:
+  explicit MarshallReader(std::string_view data) : m_data(data)
+  {
+    // do nothing
+  }
+
+  template <typename T> bool read(T &value)
+  {
+    if (m_data.size() < sizeof(value)) {
+      return false;
+    }
+    memcpy(&value, m_data.data(), sizeof(value));
+    m_data.remove_prefix(sizeof(value));
+    return true;
+  }
+
+  // reads a count of things that take at least one byte each, so a
+  // damaged count can't ask for more than is left
+  bool readCount(uint32_t &count)
+  {
+    return read(count) && count <= m_data.size();
+  }
+
+  bool atEnd() const
+  {
+    return m_data.empty();
+  }
+
+private:
+  std::string_view m_data;
+};
+
+} // namespace
+
 KeyMap::NameToKeyMap *KeyMap::s_nameToKeyMap = nullptr;
 KeyMap::NameToModifierMap *KeyMap::s_nameToModifierMap = nullptr;
 KeyMap::KeyToNameMap *KeyMap::s_keyToNameMap = nullptr;
@@ -38,6 +89,7 @@ KeyMap::KeyMap() : m_numGroups(0), m_composeAcrossGroups(false)
 void KeyMap::swap(KeyMap &x) noexcept
 {
   m_keyIDMap.swap(x.m_keyIDMap);
+  m_keyIDIndex.swap(x.m_keyIDIndex);
   m_modifierKeys.swap(x.m_modifierKeys);
   m_halfDuplex.swap(x.m_halfDuplex);
   m_halfDuplexMods.swap(x.m_halfDuplexMods);
@@ -47,6 +99,8 @@ void KeyMap::swap(KeyMap &x) noexcept
   bool tmp2 = m_composeAcrossGroups;
   m_composeAcrossGroups = x.m_composeAcrossGroups;
   x.m_composeAcrossGroups = tmp2;
+  clearPlans();
+  x.clearPlans();
 }
 
 void KeyMap::addKeyEntry(const KeyItem &item)
@@ -55,13 +109,14 @@ void KeyMap::addKeyEntry(const KeyItem &item)
   if (item.m_id == kKeyNone) {
     return;
   }
+  clearPlans();
 
   // resize number of groups for key
   auto numGroups = item.m_group + 1;
   if (getNumGroups() > numGroups) {
     numGroups = getNumGroups();
   }
-  KeyGroupTable &groupTable = m_keyIDMap[item.m_id];
+  KeyGroupTable &groupTable = addKeyGroupTable(item.m_id);
   if (groupTable.size() < static_cast<size_t>(numGroups)) {
     groupTable.resize(numGroups);
   }
@@ -123,12 +178,13 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, int32_t group, const KeyID *keys,
   if (id == kKeyNone) {
     return false;
   }
+  clearPlans();
 
   int32_t numGroups = group + 1;
   if (getNumGroups() > numGroups) {
     numGroups = getNumGroups();
   }
-  KeyGroupTable &groupTable = m_keyIDMap[id];
+  KeyGroupTable &groupTable = addKeyGroupTable(id);
   if (groupTable.size() < static_cast<size_t>(numGroups)) {
     groupTable.resize(numGroups);
   }
@@ -140,11 +196,11 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, int32_t group, const KeyID *keys,
   // convert to buttons
   KeyItemList items;
   for (uint32_t i = 0; i < numKeys; ++i) {
-    KeyIDMap::const_iterator gtIndex = m_keyIDMap.find(keys[i]);
-    if (gtIndex == m_keyIDMap.end()) {
+    const KeyGroupTable *keyGroupTable = findKeyGroupTable(keys[i]);
+    if (keyGroupTable == nullptr) {
       return false;
     }
-    const KeyGroupTable &groupTable = gtIndex->second;
+    const KeyGroupTable &groupTable = *keyGroupTable;
 
     // if we allow group switching during composition then search all
     // groups for keys, otherwise search just the given group.
@@ -179,25 +235,30 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, int32_t group, const KeyID *keys,
 void KeyMap::allowGroupSwitchDuringCompose()
 {
   m_composeAcrossGroups = true;
+  clearPlans();
 }
 
 void KeyMap::addHalfDuplexButton(KeyButton button)
 {
   m_halfDuplex.insert(button);
+  clearPlans();
 }
 
 void KeyMap::clearHalfDuplexModifiers()
 {
   m_halfDuplexMods.clear();
+  clearPlans();
 }
 
 void KeyMap::addHalfDuplexModifier(KeyID key)
 {
   m_halfDuplexMods.insert(key);
+  clearPlans();
 }
 
 void KeyMap::finish()
 {
+  clearPlans();
   m_numGroups = findNumGroups();
 
   // make sure every key has the same number of groups
@@ -225,11 +286,102 @@ void KeyMap::foreachKey(ForeachKeyCallback cb, void *userData)
   }
 }
 
+bool KeyMap::unmarshall(std::string_view data)
+{
+  // read into an empty map so a damaged buffer leaves nothing behind
+  KeyMap keyMap;
+  MarshallReader reader(data);
+  auto readMap = [&keyMap, &reader] {
+    uint32_t version;
+    if (!reader.read(version) || version != kMarshallVersion) {
+      return false;
+    }
+
+    uint8_t composeAcrossGroups;
+    uint32_t count;
+    if (!reader.read(composeAcrossGroups) || !reader.readCount(count)) {
+      return false;
+    }
+    keyMap.m_composeAcrossGroups = (composeAcrossGroups != 0);
+    for (uint32_t i = 0; i < count; ++i) {
+      KeyButton button;
+      if (!reader.read(button)) {
+        return false;
+      }
+      keyMap.m_halfDuplex.insert(button);
+    }
+    if (!reader.readCount(count)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      KeyID id;
+      if (!reader.read(id)) {
+        return false;
+      }
+      keyMap.m_halfDuplexMods.insert(id);
+    }
+
+    uint32_t numKeys;
+    if (!reader.readCount(numKeys)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < numKeys; ++i) {
+      KeyID id;
+      uint32_t numGroups;
+      if (!reader.read(id) || id == kKeyNone || !reader.readCount(numGroups)) {
+        return false;
+      }
+      KeyGroupTable &groupTable = keyMap.addKeyGroupTable(id);
+      if (!groupTable.empty()) {
+        return false;
+      }
+      groupTable.resize(numGroups);
+      for (auto &entries : groupTable) {
+        uint32_t numEntries;
+        if (!reader.readCount(numEntries)) {
+          return false;
+        }
+        entries.resize(numEntries);
+        for (auto &items : entries) {
+          uint32_t numItems;
+          if (!reader.readCount(numItems)) {
+            return false;
+          }
+          items.resize(numItems);
+          for (auto &item : items) {
+            uint8_t dead;
+            uint8_t lock;
+            if (!reader.read(item.m_id) || !reader.read(item.m_group) || !reader.read(item.m_button) ||
+                !reader.read(item.m_required) || !reader.read(item.m_sensitive) || !reader.read(item.m_generates) ||
+                !reader.read(dead) || !reader.read(lock) || !reader.read(item.m_client)) {
+              return false;
+            }
+            item.m_dead = (dead != 0);
+            item.m_lock = (lock != 0);
+          }
+        }
+      }
+    }
+    return reader.atEnd();
+  };
+
+  if (!readMap()) {
+    KeyMap empty;
+    swap(empty);
+    finish();
+    return false;
+  }
+  swap(keyMap);
+  finish();
+  return true;
+}
+
 const KeyMap::KeyItem *KeyMap::mapKey(
     Keystrokes &keys, KeyID id, int32_t group, ModifierToKeys &activeModifiers, KeyModifierMask &currentState,
     KeyModifierMask desiredMask, bool isAutoRepeat, const std::string &lang
 ) const
 {
+  TRACE_SCOPE_ARGS("keymap", "KeyMap::mapKey", "id", id, "mask", desiredMask);
   LOG(
       (CLOG_DEBUG1 "mapKey %04x (%d) with mask %04x, start state: %04x, group: %d", id, id, desiredMask, currentState,
        group)
@@ -244,6 +396,21 @@ const KeyMap::KeyItem *KeyMap::mapKey(
     return nullptr;
   }
 
+  // replay the keystrokes from the last time the key was mapped from
+  // the same state
+  PlanKey planKey{id, group, currentState, desiredMask, isAutoRepeat, lang};
+  if (const auto i = m_plans.find(planKey); i != m_plans.end() && i->second.m_activeModifiers == activeModifiers) {
+    const Plan &plan = i->second;
+    keys.insert(keys.end(), plan.m_keys.begin(), plan.m_keys.end());
+    activeModifiers = plan.m_newModifiers;
+    currentState = plan.m_newState;
+    LOG((CLOG_DEBUG1 "mapped to %03x, new state %04x (remembered)", plan.m_item->m_button, currentState));
+    return plan.m_item;
+  }
+  const auto firstKey = keys.size();
+  Plan plan;
+  plan.m_activeModifiers = activeModifiers;
+
   const KeyItem *item;
   switch (id) {
   case kKeyShift_L:
@@ -290,6 +457,17 @@ const KeyMap::KeyItem *KeyMap::mapKey(
 
   if (item != nullptr) {
     LOG((CLOG_DEBUG1 "mapped to %03x, new state %04x", item->m_button, currentState));
+
+    // remember the keystrokes.  failures aren't remembered as they may
+    // have cleared keys from before this call.
+    if (m_plans.size() >= kMaxPlans) {
+      m_plans.clear();
+    }
+    plan.m_item = item;
+    plan.m_keys.assign(keys.begin() + firstKey, keys.end());
+    plan.m_newModifiers = activeModifiers;
+    plan.m_newState = currentState;
+    m_plans.insert_or_assign(std::move(planKey), std::move(plan));
   }
   return item;
 }
@@ -297,6 +475,7 @@ const KeyMap::KeyItem *KeyMap::mapKey(
 void KeyMap::setLanguageData(std::vector<std::string> layouts)
 {
   m_keyboardLayouts = std::move(layouts);
+  clearPlans();
 }
 
 int32_t KeyMap::getLanguageGroupID(int32_t group, const std::string &lang) const
@@ -328,12 +507,12 @@ KeyMap::findCompatibleKey(KeyID id, int32_t group, KeyModifierMask required, Key
 {
   assert(group >= 0 && group < getNumGroups());
 
-  KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-  if (i == m_keyIDMap.end()) {
+  const KeyGroupTable *keyGroupTable = findKeyGroupTable(id);
+  if (keyGroupTable == nullptr) {
     return nullptr;
   }
 
-  const KeyEntryList &entries = i->second[group];
+  const KeyEntryList &entries = (*keyGroupTable)[group];
   for (const auto &entry : entries) {
     if ((entry.back().m_sensitive & sensitive) == 0 ||
         (entry.back().m_required & sensitive) == (required & sensitive)) {
@@ -362,6 +541,45 @@ KeyModifierMask KeyMap::getCommandModifiers() const
   return KeyModifierControl | KeyModifierAlt | KeyModifierAltGr | KeyModifierMeta | KeyModifierSuper;
 }
 
+std::string KeyMap::marshall() const
+{
+  std::string buffer;
+  writeValue(buffer, kMarshallVersion);
+  writeValue(buffer, static_cast<uint8_t>(m_composeAcrossGroups ? 1 : 0));
+  writeValue(buffer, static_cast<uint32_t>(m_halfDuplex.size()));
+  for (const auto button : m_halfDuplex) {
+    writeValue(buffer, button);
+  }
+  writeValue(buffer, static_cast<uint32_t>(m_halfDuplexMods.size()));
+  for (const auto id : m_halfDuplexMods) {
+    writeValue(buffer, id);
+  }
+
+  writeValue(buffer, static_cast<uint32_t>(m_keyIDMap.size()));
+  for (const auto &[id, groupTable] : m_keyIDMap) {
+    writeValue(buffer, id);
+    writeValue(buffer, static_cast<uint32_t>(groupTable.size()));
+    for (const auto &entries : groupTable) {
+      writeValue(buffer, static_cast<uint32_t>(entries.size()));
+      for (const auto &items : entries) {
+        writeValue(buffer, static_cast<uint32_t>(items.size()));
+        for (const auto &item : items) {
+          writeValue(buffer, item.m_id);
+          writeValue(buffer, item.m_group);
+          writeValue(buffer, item.m_button);
+          writeValue(buffer, item.m_required);
+          writeValue(buffer, item.m_sensitive);
+          writeValue(buffer, item.m_generates);
+          writeValue(buffer, static_cast<uint8_t>(item.m_dead ? 1 : 0));
+          writeValue(buffer, static_cast<uint8_t>(item.m_lock ? 1 : 0));
+          writeValue(buffer, item.m_client);
+        }
+      }
+    }
+  }
+  return buffer;
+}
+
 void KeyMap::collectButtons(const ModifierToKeys &mods, ButtonToKeyMap &keys)
 {
   keys.clear();
@@ -479,13 +697,13 @@ const KeyMap::KeyItem *KeyMap::mapCommandKey(
   static const KeyModifierMask s_overrideModifiers = 0xffffu;
 
   // find KeySym in table
-  KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-  if (i == m_keyIDMap.end()) {
+  const KeyGroupTable *table = findKeyGroupTable(id);
+  if (table == nullptr) {
     // unknown key
     LOG((CLOG_DEBUG1 "key %04x is not on keyboard", id));
     return nullptr;
   }
-  const KeyGroupTable &keyGroupTable = i->second;
+  const KeyGroupTable &keyGroupTable = *table;
 
   // find the first key that generates this KeyID
   const KeyItem *keyItem = nullptr;
@@ -580,8 +798,8 @@ const KeyMap::KeyItem *KeyMap::mapCharacterKey(
 ) const
 {
   // find KeySym in table
-  KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-  if (i == m_keyIDMap.end()) {
+  const KeyGroupTable *keyGroupTable = findKeyGroupTable(id);
+  if (keyGroupTable == nullptr) {
     // unknown key
     LOG((CLOG_DEBUG1 "key %04x is not on keyboard", id));
 
@@ -589,7 +807,7 @@ const KeyMap::KeyItem *KeyMap::mapCharacterKey(
   }
 
   // get keys to press for key
-  const auto itemList = getKeyItemList(i->second, getLanguageGroupID(group, lang), desiredMask);
+  const auto itemList = getKeyItemList(*keyGroupTable, getLanguageGroupID(group, lang), desiredMask);
   if (!itemList || itemList->empty()) {
     // no mapping for this keysym
     LOG((CLOG_DEBUG1 "no mapping for key %04x", id));
@@ -626,6 +844,25 @@ const KeyMap::KeyItem *KeyMap::mapCharacterKey(
   return &keyItem;
 }
 
+KeyMap::KeyGroupTable &KeyMap::addKeyGroupTable(KeyID id)
+{
+  auto [i, inserted] = m_keyIDMap.try_emplace(id);
+  if (inserted) {
+    m_keyIDIndex.insert(id, &i->second);
+  }
+  return i->second;
+}
+
+const KeyMap::KeyGroupTable *KeyMap::findKeyGroupTable(KeyID id) const
+{
+  return m_keyIDIndex.find(id);
+}
+
+void KeyMap::clearPlans()
+{
+  m_plans.clear();
+}
+
 void KeyMap::addGroupToKeystroke(Keystrokes &keys, int32_t &group, const std::string &lang) const
 {
   group = getLanguageGroupID(group, lang);
@@ -1214,6 +1451,72 @@ void KeyMap::initKeyNameMaps()
   }
 }
 
+//
+// KeyMap::KeyIDIndex
+//
+
+const KeyMap::KeyGroupTable *KeyMap::KeyIDIndex::find(KeyID id) const
+{
+  if (m_slots.empty()) {
+    return nullptr;
+  }
+  return m_slots[slotFor(id)].m_table;
+}
+
+void KeyMap::KeyIDIndex::insert(KeyID id, const KeyGroupTable *table)
+{
+  // keep the table at most half full so runs of used slots stay short
+  if (2 * (m_size + 1) > m_slots.size()) {
+    std::vector<Slot> slots(std::max<size_t>(64, 2 * m_slots.size()));
+    m_slots.swap(slots);
+    m_size = 0;
+    for (const auto &slot : slots) {
+      if (slot.m_id != kKeyNone) {
+        insert(slot.m_id, slot.m_table);
+      }
+    }
+  }
+
+  Slot &slot = m_slots[slotFor(id)];
+  if (slot.m_id == kKeyNone) {
+    ++m_size;
+  }
+  slot.m_id = id;
+  slot.m_table = table;
+}
+
+void KeyMap::KeyIDIndex::swap(KeyIDIndex &x) noexcept
+{
+  m_slots.swap(x.m_slots);
+  std::swap(m_size, x.m_size);
+}
+
+size_t KeyMap::KeyIDIndex::slotFor(KeyID id) const
+{
+  // kKeyNone is never added so it marks an empty slot
+  const size_t mask = m_slots.size() - 1;
+  auto slot = static_cast<size_t>(id * 0x9e3779b9u) & mask;
+  while (m_slots[slot].m_id != kKeyNone && m_slots[slot].m_id != id) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+//
+// KeyMap::PlanKeyHash
+//
+
+size_t KeyMap::PlanKeyHash::operator()(const PlanKey &key) const
+{
+  size_t hash = std::hash<std::string>()(key.m_lang);
+  for (const size_t value :
+       {size_t{key.m_id}, static_cast<size_t>(key.m_group), size_t{key.m_currentState}, size_t{key.m_desiredMask},
+        size_t{key.m_isAutoRepeat}}) {
+    hash ^= value + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
 //
 // KeyMap::KeyItem
 //
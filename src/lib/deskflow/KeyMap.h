@@ -12,6 +12,8 @@
 
 #include <map>
 #include <set>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace deskflow {
@@ -191,6 +193,8 @@ public:
   //! Finish adding entries
   /*!
   Called after adding entries, this does some internal housekeeping.
+  Keystrokes remembered by \c mapKey() are forgotten, as they are by
+  every other manipulator.
   */
   virtual void finish();
 
@@ -200,6 +204,15 @@ public:
   */
   virtual void foreachKey(ForeachKeyCallback cb, void *userData);
 
+  //! Restore a marshalled map
+  /*!
+  Replaces every entry and half-duplex setting with those marshalled
+  in \p data and finishes the map.  Returns \c false and leaves the map
+  empty if \p data was marshalled by another version of the format or
+  is damaged.
+  */
+  bool unmarshall(std::string_view data);
+
   //@}
   //! @name accessors
   //@{
@@ -211,6 +224,9 @@ public:
   \p desiredMask into the keystrokes necessary to synthesize that key
   event in \p keys.  It returns the \c KeyItem of the key being
   pressed/repeated, or nullptr if the key cannot be mapped.
+
+  The keystrokes for a key are remembered, so mapping the same key
+  again from the same state replays them rather than searching the map.
   */
   virtual const KeyItem *mapKey(
       Keystrokes &keys, KeyID id, int32_t group, ModifierToKeys &activeModifiers, KeyModifierMask &currentState,
@@ -268,6 +284,14 @@ public:
   */
   KeyModifierMask getCommandModifiers() const;
 
+  //! Marshall the map
+  /*!
+  Returns the entries and half-duplex settings in a compact binary form
+  that \c unmarshall() restores, so a platform can keep a map it took a
+  while to build.  The language data isn't included.
+  */
+  std::string marshall() const;
+
   //! Get buttons from modifier map
   /*!
   Put all the keys in \p modifiers into \p keys.
@@ -427,6 +451,15 @@ private:
   const KeyItemList *
   getKeyItemList(const KeyGroupTable &keyGroupTable, int32_t group, KeyModifierMask desiredMask) const;
 
+  // returns the table for \p id, adding an empty one if there isn't one
+  KeyGroupTable &addKeyGroupTable(KeyID id);
+
+  // returns the table for \p id or nullptr if there isn't one
+  const KeyGroupTable *findKeyGroupTable(KeyID id) const;
+
+  // forgets the keystrokes remembered by mapKey()
+  void clearPlans();
+
   // not implemented
   KeyMap(const KeyMap &);
   KeyMap &operator=(const KeyMap &);
@@ -435,6 +468,63 @@ private:
   // Table of KeyID to ways to synthesize that KeyID
   using KeyIDMap = std::map<KeyID, KeyGroupTable>;
 
+  // Open addressing index into a KeyIDMap, so finding a KeyID is a
+  // hash and a probe or two rather than a walk down the tree.  the
+  // map owns the tables and never moves them, so the index only needs
+  // adding to when the map is.
+  class KeyIDIndex
+  {
+  public:
+    const KeyGroupTable *find(KeyID id) const;
+    void insert(KeyID id, const KeyGroupTable *table);
+    void swap(KeyIDIndex &) noexcept;
+
+  private:
+    struct Slot
+    {
+      KeyID m_id = kKeyNone;
+      const KeyGroupTable *m_table = nullptr;
+    };
+
+    size_t slotFor(KeyID id) const;
+
+    std::vector<Slot> m_slots;
+    size_t m_size = 0;
+  };
+
+  // The inputs to mapKey() that its result depends on.  the active
+  // modifiers are kept in the plan rather than here, since comparing
+  // them is only needed for the one plan that's found.
+  struct PlanKey
+  {
+    KeyID m_id;
+    int32_t m_group;
+    KeyModifierMask m_currentState;
+    KeyModifierMask m_desiredMask;
+    bool m_isAutoRepeat;
+    std::string m_lang;
+
+    bool operator==(const PlanKey &) const = default;
+  };
+
+  struct PlanKeyHash
+  {
+    size_t operator()(const PlanKey &key) const;
+  };
+
+  // What mapKey() did for a PlanKey and the active modifiers
+  struct Plan
+  {
+    ModifierToKeys m_activeModifiers;
+    const KeyItem *m_item = nullptr;
+    Keystrokes m_keys;
+    ModifierToKeys m_newModifiers;
+    KeyModifierMask m_newState = 0;
+  };
+
+  // Plans are dropped all at once when there are this many
+  static constexpr size_t kMaxPlans = 4096;
+
   // List of KeyItems that generate a particular modifier
   using ModifierKeyItemList = std::vector<const KeyItem *>;
 
@@ -455,6 +545,7 @@ private:
 
   // KeyID info
   KeyIDMap m_keyIDMap;
+  KeyIDIndex m_keyIDIndex;
   int32_t m_numGroups;
   ModifierToKeyTable m_modifierKeys;
 
@@ -471,6 +562,9 @@ private:
   // Language sync data
   std::vector<std::string> m_keyboardLayouts;
 
+  // keystrokes remembered by mapKey()
+  mutable std::unordered_map<PlanKey, Plan, PlanKeyHash> m_plans;
+
   // parsing/formatting tables
   static NameToKeyMap *s_nameToKeyMap;
   static NameToModifierMap *s_nameToModifierMap;
@@ -1004,6 +1004,11 @@ KeyButton KeyState::getButton(KeyID id, int32_t group) const
   }
 }
 
+const deskflow::KeyMap &KeyState::getCurrentKeyMap() const
+{
+  return m_keyMap;
+}
+
 void KeyState::addAliasEntries()
 {
   for (int32_t g = 0, n = m_keyMap.getNumGroups(); g < n; ++g) {
@@ -126,6 +126,13 @@ protected:
   */
   KeyButton getButton(KeyID id, int32_t group) const;
 
+  //! Get the keyboard map
+  /*!
+  Returns the keyboard map as of the last \c updateKeyMap(), including
+  the composition, keypad and alias entries added to the platform's map.
+  */
+  const deskflow::KeyMap &getCurrentKeyMap() const;
+
   //@}
 
 private:
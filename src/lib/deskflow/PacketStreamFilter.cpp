@@ -23,6 +23,16 @@ PacketStreamFilter::PacketStreamFilter(IEventQueue *events, deskflow::IStream *s
   // do nothing
 }
 
+PacketStreamFilter::~PacketStreamFilter()
+{
+  deskflow::ProtocolCapture::closeStream(m_captureStream);
+}
+
+void PacketStreamFilter::capture(deskflow::ProtocolCapture::Peer peer)
+{
+  m_captureStream = deskflow::ProtocolCapture::openStream(peer);
+}
+
 void PacketStreamFilter::close()
 {
   std::scoped_lock lock{m_mutex};
@@ -44,6 +54,14 @@ uint32_t PacketStreamFilter::read(void *buffer, uint32_t n)
     return 0;
   }
 
+  // capture the whole packet on its first read
+  if (m_captureStream != 0 && !m_captured) {
+    deskflow::ProtocolCapture::record(
+        m_captureStream, deskflow::ProtocolCapture::RecordType::Input, m_buffer.peek(m_size), m_size
+    );
+    m_captured = true;
+  }
+
   // read no more than what's left in the buffered packet
   if (n > m_size) {
     n = m_size;
@@ -69,6 +87,8 @@ uint32_t PacketStreamFilter::read(void *buffer, uint32_t n)
 
 void PacketStreamFilter::write(const void *buffer, uint32_t count)
 {
+  deskflow::ProtocolCapture::record(m_captureStream, deskflow::ProtocolCapture::RecordType::Output, buffer, count);
+
   // write the length of the payload
   uint8_t length[4];
   length[0] = (uint8_t)((count >> 24) & 0xff);
@@ -81,6 +101,16 @@ void PacketStreamFilter::write(const void *buffer, uint32_t count)
   getStream()->write(buffer, count);
 }
 
+void PacketStreamFilter::writePacket(const deskflow::SharedPacket &packet)
+{
+  deskflow::ProtocolCapture::record(
+      m_captureStream, deskflow::ProtocolCapture::RecordType::Output, packet.getPayload(), packet.getPayloadSize()
+  );
+
+  // already framed, so pass the whole packet along for the socket to share
+  getStream()->writePacket(packet);
+}
+
 void PacketStreamFilter::shutdownInput()
 {
   std::scoped_lock lock{m_mutex};
@@ -114,6 +144,7 @@ bool PacketStreamFilter::readPacketSize()
     uint8_t buffer[4];
     memcpy(buffer, m_buffer.peek(sizeof(buffer)), sizeof(buffer));
     m_buffer.pop(sizeof(buffer));
+    m_captured = false;
     m_size =
         ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3];
     if (m_size > PROTOCOL_MAX_MESSAGE_LENGTH) {
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "deskflow/ProtocolCapture.h"
 #include "io/StreamBuffer.h"
 #include "io/StreamFilter.h"
 
@@ -22,12 +23,25 @@ class PacketStreamFilter : public StreamFilter
 {
 public:
   PacketStreamFilter(IEventQueue *events, deskflow::IStream *stream, bool adoptStream = true);
-  ~PacketStreamFilter() override = default;
+  ~PacketStreamFilter() override;
+
+  //! @name manipulators
+  //@{
+
+  //! Record this stream's packets
+  /*!
+  Opens the stream in the protocol capture, if capturing.  \p peer is
+  the end of the connection on the other side.
+  */
+  void capture(deskflow::ProtocolCapture::Peer peer);
+
+  //@}
 
   // IStream overrides
   void close() override;
   uint32_t read(void *buffer, uint32_t n) override;
   void write(const void *buffer, uint32_t n) override;
+  void writePacket(const deskflow::SharedPacket &packet) override;
   void shutdownInput() override;
   bool isReady() const override;
   uint32_t getSize() const override;
@@ -47,4 +61,6 @@ private:
   StreamBuffer m_buffer;
   bool m_inputShutdown = false;
   IEventQueue *m_events = nullptr;
+  std::uint16_t m_captureStream = 0;
+  bool m_captured = false; //!< Current packet has been captured
 };
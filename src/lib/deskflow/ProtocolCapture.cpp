@@ -0,0 +1,291 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ProtocolCapture.h"
+
+#include "base/Log.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+namespace deskflow {
+
+namespace {
+
+const std::array<char, 8> kMagic = {'D', 'F', 'L', 'W', 'C', 'A', 'P', '\0'};
+
+std::atomic_bool s_enabled{false};
+
+// guards the file and stream ids, packets may be written from any thread
+std::mutex s_mutex;
+std::ofstream s_file;
+std::chrono::steady_clock::time_point s_start;
+std::uint16_t s_nextStream = 1;
+
+void putLE(std::uint8_t *out, std::uint64_t value, std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    out[i] = static_cast<std::uint8_t>(value >> (i * 8));
+  }
+}
+
+std::uint64_t getLE(const std::uint8_t *in, std::size_t size)
+{
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    value |= static_cast<std::uint64_t>(in[i]) << (i * 8);
+  }
+  return value;
+}
+
+std::size_t padding(std::size_t size)
+{
+  return (ProtocolCapture::kAlignment - size % ProtocolCapture::kAlignment) % ProtocolCapture::kAlignment;
+}
+
+void writeRecord(std::uint16_t stream, ProtocolCapture::RecordType type, const void *data, std::uint32_t size)
+{
+  // note -- s_mutex must be locked on entry
+
+  using namespace std::chrono;
+  const auto time = duration_cast<nanoseconds>(steady_clock::now() - s_start).count();
+
+  std::array<std::uint8_t, ProtocolCapture::kRecordHeaderSize> header{};
+  putLE(&header[0], static_cast<std::uint64_t>(time), 8);
+  putLE(&header[8], size, 4);
+  putLE(&header[12], stream, 2);
+  header[14] = static_cast<std::uint8_t>(type);
+  s_file.write(reinterpret_cast<const char *>(header.data()), header.size());
+
+  if (size > 0) {
+    const std::array<char, ProtocolCapture::kAlignment> zeros{};
+    s_file.write(static_cast<const char *>(data), size);
+    s_file.write(zeros.data(), static_cast<std::streamsize>(padding(size)));
+  }
+}
+
+} // namespace
+
+//
+// ProtocolCapture
+//
+
+bool ProtocolCapture::start(const std::string &filename)
+{
+  std::scoped_lock lock{s_mutex};
+  if (s_file.is_open()) {
+    s_file.close();
+  }
+
+  s_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!s_file.is_open()) {
+    LOG_ERR("failed to open protocol capture file: %s", filename.c_str());
+    return false;
+  }
+
+  std::array<std::uint8_t, kFileHeaderSize> header{};
+  std::memcpy(header.data(), kMagic.data(), kMagic.size());
+  putLE(&header[8], kVersion, 4);
+  s_file.write(reinterpret_cast<const char *>(header.data()), header.size());
+
+  s_start = std::chrono::steady_clock::now();
+  s_nextStream = 1;
+  s_enabled = true;
+  return true;
+}
+
+void ProtocolCapture::stop()
+{
+  std::scoped_lock lock{s_mutex};
+  s_enabled = false;
+  if (s_file.is_open()) {
+    s_file.close();
+  }
+}
+
+std::uint16_t ProtocolCapture::openStream(Peer peer)
+{
+  if (!isEnabled()) {
+    return 0;
+  }
+
+  std::scoped_lock lock{s_mutex};
+  const auto stream = s_nextStream++;
+  if (s_nextStream == 0) {
+    s_nextStream = 1;
+  }
+
+  const auto payload = static_cast<std::uint8_t>(peer);
+  writeRecord(stream, RecordType::Open, &payload, sizeof(payload));
+  return stream;
+}
+
+void ProtocolCapture::record(std::uint16_t stream, RecordType type, const void *data, std::uint32_t size)
+{
+  if (stream == 0 || !isEnabled()) {
+    return;
+  }
+
+  std::scoped_lock lock{s_mutex};
+  if (s_file.is_open()) {
+    writeRecord(stream, type, data, size);
+  }
+}
+
+void ProtocolCapture::closeStream(std::uint16_t stream)
+{
+  if (stream == 0 || !isEnabled()) {
+    return;
+  }
+
+  // flush so a capture is complete up to the last closed connection
+  std::scoped_lock lock{s_mutex};
+  if (s_file.is_open()) {
+    writeRecord(stream, RecordType::Close, nullptr, 0);
+    s_file.flush();
+  }
+}
+
+bool ProtocolCapture::isEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+//
+// ProtocolCaptureReader
+//
+
+ProtocolCaptureReader::ProtocolCaptureReader() = default;
+
+ProtocolCaptureReader::~ProtocolCaptureReader() = default;
+
+bool ProtocolCaptureReader::open(const std::string &filename)
+{
+  m_records.clear();
+  m_file = std::make_unique<QFile>(QString::fromStdString(filename));
+  if (!m_file->open(QIODevice::ReadOnly)) {
+    m_error = "failed to open " + filename;
+    return false;
+  }
+
+  const auto size = static_cast<std::size_t>(m_file->size());
+  const auto *data = size > 0 ? m_file->map(0, m_file->size()) : nullptr;
+  if (data == nullptr) {
+    m_error = "failed to map " + filename;
+    return false;
+  }
+
+  return parse(data, size);
+}
+
+bool ProtocolCaptureReader::parse(const std::uint8_t *data, std::size_t size)
+{
+  m_records.clear();
+  m_truncated = false;
+  m_error.clear();
+
+  using enum ProtocolCapture::RecordType;
+
+  if (size < ProtocolCapture::kFileHeaderSize || std::memcmp(data, kMagic.data(), kMagic.size()) != 0) {
+    m_error = "not a protocol capture";
+    return false;
+  }
+  if (const auto version = getLE(&data[8], 4); version != ProtocolCapture::kVersion) {
+    m_error = "unsupported protocol capture version " + std::to_string(version);
+    return false;
+  }
+
+  std::size_t offset = ProtocolCapture::kFileHeaderSize;
+  while (offset < size) {
+    if (size - offset < ProtocolCapture::kRecordHeaderSize) {
+      m_truncated = true;
+      break;
+    }
+
+    const auto *header = &data[offset];
+    Record record;
+    record.m_time = getLE(&header[0], 8);
+    record.m_size = static_cast<std::uint32_t>(getLE(&header[8], 4));
+    record.m_stream = static_cast<std::uint16_t>(getLE(&header[12], 2));
+    record.m_type = static_cast<ProtocolCapture::RecordType>(header[14]);
+    offset += ProtocolCapture::kRecordHeaderSize;
+
+    // the payload of the last record may be cut short by a crash, the
+    // padding is not needed
+    if (size - offset < record.m_size) {
+      m_truncated = true;
+      break;
+    }
+    if (record.m_type > Close) {
+      m_error = "unknown record type " + std::to_string(header[14]) + " at offset " +
+                std::to_string(offset - ProtocolCapture::kRecordHeaderSize);
+      m_records.clear();
+      return false;
+    }
+
+    record.m_data = &data[offset];
+    offset += std::min(size - offset, record.m_size + padding(record.m_size));
+    m_records.push_back(record);
+  }
+
+  return true;
+}
+
+const std::vector<ProtocolCaptureReader::Record> &ProtocolCaptureReader::records() const
+{
+  return m_records;
+}
+
+std::vector<ProtocolCaptureReader::Record> ProtocolCaptureReader::records(std::uint16_t stream) const
+{
+  std::vector<Record> records;
+  for (const auto &record : m_records) {
+    if (record.m_stream == stream) {
+      records.push_back(record);
+    }
+  }
+  return records;
+}
+
+std::vector<std::uint16_t> ProtocolCaptureReader::streams() const
+{
+  std::vector<std::uint16_t> streams;
+  for (const auto &record : m_records) {
+    if (record.m_type == ProtocolCapture::RecordType::Open) {
+      streams.push_back(record.m_stream);
+    }
+  }
+  return streams;
+}
+
+ProtocolCapture::Peer ProtocolCaptureReader::peer(std::uint16_t stream) const
+{
+  for (const auto &record : m_records) {
+    if (record.m_stream == stream && record.m_type == ProtocolCapture::RecordType::Open && record.m_size == 1) {
+      return static_cast<ProtocolCapture::Peer>(record.m_data[0]);
+    }
+  }
+  return ProtocolCapture::Peer::Server;
+}
+
+bool ProtocolCaptureReader::isTruncated() const
+{
+  return m_truncated;
+}
+
+const std::string &ProtocolCaptureReader::error() const
+{
+  return m_error;
+}
+
+} // namespace deskflow
@@ -0,0 +1,188 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class QFile;
+
+namespace deskflow {
+
+//! Protocol capture
+/*!
+Records every packet sent and received on the protocol streams of this
+process to a capture file, so that a session from the field can be
+replayed later by deskflow-replay.  Capturing is off by default and
+costs a single atomic load per packet when off.
+
+The file is append-only and laid out so it can be memory mapped.  All
+integers are little endian.  The file starts with a 16 byte header:
+
+  - magic "DFLWCAP\0" (8 bytes)
+  - format version (uint32)
+  - reserved, 0 (uint32)
+
+followed by records, each a 16 byte header and then the payload padded
+with zeros to a multiple of 8 bytes:
+
+  - time in nanoseconds since the capture started (uint64)
+  - payload size (uint32)
+  - stream id (uint16)
+  - record type (uint8)
+  - reserved, 0 (uint8)
+
+Each stream starts with an \c Open record whose single byte payload is
+the peer on the other end of the stream, and input and output records
+hold the packet payloads without the length prefix.  A capture cut off
+by a crash is readable up to the last complete record.
+
+Captures contain everything sent over the connection, including typed
+text and clipboard contents, so they should be handled with care.
+*/
+class ProtocolCapture
+{
+public:
+  static const std::uint32_t kVersion = 1;
+  static const std::size_t kFileHeaderSize = 16;
+  static const std::size_t kRecordHeaderSize = 16;
+  static const std::size_t kAlignment = 8;
+
+  //! The end of the connection on the other side of a stream
+  enum class Peer : std::uint8_t
+  {
+    Server, //!< Captured by a client, input comes from the server
+    Client  //!< Captured by a server, input comes from a client
+  };
+
+  enum class RecordType : std::uint8_t
+  {
+    Open,   //!< Stream opened, payload is the Peer
+    Input,  //!< Packet received
+    Output, //!< Packet sent
+    Close   //!< Stream closed
+  };
+
+  //! @name manipulators
+  //@{
+
+  //! Start capturing to \p filename
+  /*!
+  Truncates the file.  Returns false if the file could not be opened.
+  */
+  static bool start(const std::string &filename);
+
+  //! Stop capturing and close the file
+  static void stop();
+
+  //! Open a stream in the capture
+  /*!
+  Returns the id to record the stream's packets with, or 0 if not
+  capturing.
+  */
+  static std::uint16_t openStream(Peer peer);
+
+  //! Record a packet on \p stream
+  /*!
+  Does nothing if \p stream is 0.
+  */
+  static void record(std::uint16_t stream, RecordType type, const void *data, std::uint32_t size);
+
+  //! Close \p stream in the capture
+  /*!
+  Does nothing if \p stream is 0.
+  */
+  static void closeStream(std::uint16_t stream);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns true if capturing
+  static bool isEnabled();
+
+  //@}
+};
+
+//! Protocol capture file reader
+/*!
+Maps a file written by ProtocolCapture and indexes its records.  The
+record payloads point into the mapped file and are valid for the
+lifetime of the reader.
+*/
+class ProtocolCaptureReader
+{
+public:
+  struct Record
+  {
+    std::uint64_t m_time = 0; //!< Nanoseconds since the capture started
+    std::uint16_t m_stream = 0;
+    ProtocolCapture::RecordType m_type = ProtocolCapture::RecordType::Open;
+    std::uint32_t m_size = 0;
+    const std::uint8_t *m_data = nullptr;
+  };
+
+  ProtocolCaptureReader();
+  ProtocolCaptureReader(ProtocolCaptureReader const &) = delete;
+  ProtocolCaptureReader(ProtocolCaptureReader &&) = delete;
+  ~ProtocolCaptureReader();
+
+  ProtocolCaptureReader &operator=(ProtocolCaptureReader const &) = delete;
+  ProtocolCaptureReader &operator=(ProtocolCaptureReader &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Map and index \p filename
+  /*!
+  Returns false and sets the error if the file can't be mapped or isn't
+  a capture.
+  */
+  bool open(const std::string &filename);
+
+  //! Index a capture already in memory
+  /*!
+  \p data must outlive the reader.  Returns false and sets the error if
+  \p data isn't a capture.
+  */
+  bool parse(const std::uint8_t *data, std::size_t size);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! All records in the order they were written
+  const std::vector<Record> &records() const;
+
+  //! Records belonging to \p stream, including its Open record
+  std::vector<Record> records(std::uint16_t stream) const;
+
+  //! Ids of the streams in the capture, in the order they were opened
+  std::vector<std::uint16_t> streams() const;
+
+  //! The peer of \p stream, or Peer::Server if it has no Open record
+  ProtocolCapture::Peer peer(std::uint16_t stream) const;
+
+  //! Returns true if the file ends with an incomplete record
+  bool isTruncated() const;
+
+  //! Why the last open() or parse() failed
+  const std::string &error() const;
+
+  //@}
+
+private:
+  std::unique_ptr<QFile> m_file;
+  std::vector<Record> m_records;
+  bool m_truncated = false;
+  std::string m_error;
+};
+
+} // namespace deskflow
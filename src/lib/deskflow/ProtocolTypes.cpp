@@ -27,6 +27,8 @@ const char *const kMsgCScreenSaver = "CSEC%1i";
 const char *const kMsgCResetOptions = "CROP";
 const char *const kMsgCInfoAck = "CIAK";
 const char *const kMsgCKeepAlive = "CALV";
+const char *const kMsgCKeepAliveSync = "CALV%4i%4i";
+const char *const kMsgCKeepAliveSyncReply = "CALV%4i%4i%4i";
 const char *const kMsgDKeyDownLang = "DKDL%2i%2i%2i%s";
 const char *const kMsgDKeyDown = "DKDN%2i%2i%2i";
 const char *const kMsgDKeyDown1_0 = "DKDN%2i%2i";
@@ -47,6 +49,7 @@ const char *const kMsgDFileTransfer = "DFTR%1i%s";
 const char *const kMsgDDragInfo = "DDRG%2i%s";
 const char *const kMsgDSecureInputNotification = "SECN%s";
 const char *const kMsgDLanguageSynchronisation = "LSYN%s";
+const char *const kMsgDInputTrace = "DTRC%4i%4i%4i%4i";
 const char *const kMsgQInfo = "QINF";
 const char *const kMsgEIncompatible = "EICV%2i%2i";
 const char *const kMsgEBusy = "EBSY";
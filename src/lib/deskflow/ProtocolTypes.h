@@ -47,7 +47,7 @@ static const int16_t kProtocolMajorVersion = 1;
  * @note When incrementing the minor version, the Deskflow application version should also increment
  * @since Protocol version 1.0
  */
-static const int16_t kProtocolMinorVersion = 8;
+static const int16_t kProtocolMinorVersion = 10;
 
 /**
  * @brief Default TCP port for Deskflow connections
@@ -159,9 +159,10 @@ static constexpr uint32_t PROTOCOL_MAX_STRING_LENGTH = 1024 * 1024;
  */
 struct ChunkType
 {
-  inline static const auto DataStart = 1; ///< Start of transfer (contains file size)
-  inline static const auto DataChunk = 2; ///< Data chunk (contains file content)
-  inline static const auto DataEnd = 3;   ///< End of transfer (transfer complete)
+  inline static const auto DataStart = 1;  ///< Start of transfer (contains file size)
+  inline static const auto DataChunk = 2;  ///< Data chunk (contains file content)
+  inline static const auto DataEnd = 3;    ///< End of transfer (transfer complete)
+  inline static const auto DataResume = 4; ///< Reply to start (contains offset to send from)
 };
 
 /**
@@ -511,6 +512,46 @@ extern const char *const kMsgCInfoAck;
  */
 extern const char *const kMsgCKeepAlive;
 
+/**
+ * @brief Keep-alive message with clock synchronization (v1.9+)
+ *
+ * **Message Code**: `"CALV"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"CALV%4i%4i"`
+ * **Parameters**:
+ * - `$1`: Primary send time (4 bytes) - Primary monotonic clock in microseconds, modulo 2^32
+ * - `$2`: Clock offset (4 bytes) - Secondary clock minus primary clock in microseconds, modulo 2^32
+ *
+ * Replaces kMsgCKeepAlive when protocol version 1.9 is negotiated. The
+ * secondary must reply with kMsgCKeepAliveSyncReply. The primary uses the
+ * reply to estimate the round trip time and the clock offset, and sends
+ * the estimate with the next keep-alive so the secondary can convert the
+ * times in kMsgDInputTrace to its own clock.
+ *
+ * The clock offset in the first keep-alive is always 0 and should be ignored,
+ * later keep-alives carry the estimate from the replies received so far.
+ *
+ * @see kMsgCKeepAliveSyncReply, kMsgDInputTrace
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgCKeepAliveSync;
+
+/**
+ * @brief Keep-alive reply with clock synchronization (v1.9+)
+ *
+ * **Message Code**: `"CALV"`
+ * **Direction**: Secondary → Primary
+ * **Format**: `"CALV%4i%4i%4i"`
+ * **Parameters**:
+ * - `$1`: Primary send time (4 bytes) - Copied from kMsgCKeepAliveSync
+ * - `$2`: Secondary receive time (4 bytes) - Secondary monotonic clock in microseconds, modulo 2^32
+ * - `$3`: Secondary send time (4 bytes) - Secondary monotonic clock in microseconds, modulo 2^32
+ *
+ * @see kMsgCKeepAliveSync
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgCKeepAliveSyncReply;
+
 /** @} */ // end of protocol_commands group
 
 /**
@@ -927,6 +968,12 @@ extern const char *const kMsgDMouseWheel1_0;
  * - `2`: Middle chunk
  * - `3`: Final chunk
  *
+ * **Images (v1.10+)**:
+ * Peers that both support 1.10 send an image copied as PNG as the PNG
+ * (IClipboard::kPNG) with no bitmap. Older peers are sent a bitmap
+ * (IClipboard::kBitmap) decoded from the PNG instead, and ignore the
+ * PNG format if they are sent it.
+ *
  * @see kMsgCClipboard
  * @since Protocol version 1.0
  */
@@ -1022,15 +1069,18 @@ extern const char *const kMsgDSetOptions;
  * - `$2`: Data (string) - Content depends on mark
  *
  * **Transfer Marks**:
- * - `1` (kDataStart): Data contains file size (8 bytes)
+ * - `1` (kDataStart): Data contains file size (8 bytes, big endian)
  * - `2` (kDataChunk): Data contains file content chunk
  * - `3` (kDataEnd): Transfer complete (data may be empty)
+ * - `4` (kDataResume): Sent by the receiver in reply to kDataStart, data
+ *   contains the offset to send from (8 bytes, big endian).  Protocol 1.10+
  *
  * **Example Transfer Sequence**:
  *
  * Send 4096 bytes
  * ```
  * "DFTR\x01\x00\x00\x00\x00\x00\x00\x10\x00"
+ * "DFTR\x04\x00\x00\x00\x00\x00\x00\x00\x00" (reply, protocol 1.10+)
  * "DFTR\x02[1024 bytes of file data]"
  * "DFTR\x02[1024 bytes of file data]"
  * "DFTR\x02[1024 bytes of file data]"
@@ -1040,13 +1090,19 @@ extern const char *const kMsgDSetOptions;
  *
  * **Protocol Flow**:
  * 1. Sender initiates with kDataStart containing total file size
- * 2. Sender sends multiple kDataChunk messages with file content
- * 3. Sender concludes with kDataEnd to signal completion
- * 4. Receiver can abort by closing connection
+ * 2. From protocol 1.10, receiver replies with kDataResume, containing
+ *    the number of bytes it already has from an interrupted transfer of
+ *    the same file, or 0.  The sender gives up if no reply comes
+ * 3. Sender sends multiple kDataChunk messages with file content from
+ *    that offset, or from the start before protocol 1.10
+ * 4. Sender concludes with kDataEnd to signal completion
+ * 5. Receiver can abort by closing connection
+ *
+ * Files are sent one at a time, in the order of the preceding
+ * kMsgDDragInfo message.  Files that weren't announced are ignored.
  *
  * @see kMsgDDragInfo, EDataTransfer
  * @since Protocol version 1.5
- * @deprecated File drag and drop is no longer implemented.
  */
 extern const char *const kMsgDFileTransfer;
 
@@ -1077,7 +1133,6 @@ extern const char *const kMsgDFileTransfer;
  *
  * @see kMsgDFileTransfer
  * @since Protocol version 1.5
- * @deprecated File drag and drop is no longer implemented.
  */
 extern const char *const kMsgDDragInfo;
 
@@ -1148,6 +1203,35 @@ extern const char *const kMsgDSecureInputNotification;
  */
 extern const char *const kMsgDLanguageSynchronisation;
 
+/**
+ * @brief Input latency trace (v1.9+)
+ *
+ * **Message Code**: `"DTRC"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DTRC%4i%4i%4i%4i"`
+ * **Parameters**:
+ * - `$1`: Capture time (4 bytes) - Input event posted by the primary screen
+ * - `$2`: Dispatch time (4 bytes) - Input event dispatched by the primary
+ * - `$3`: Server time (4 bytes) - Input event handled by the server
+ * - `$4`: Write time (4 bytes) - Input message written to the connection
+ *
+ * All times are on the primary monotonic clock in microseconds, modulo
+ * 2^32, and 0 when not known.
+ *
+ * Only sent when input latency tracing is enabled on the primary. It
+ * immediately precedes the input message it describes (kMsgDMouseMove,
+ * kMsgDMouseRelMove, kMsgDMouseDown, kMsgDMouseUp, kMsgDMouseWheel,
+ * kMsgDKeyDownLang, kMsgDKeyRepeat or kMsgDKeyUp). The secondary converts
+ * the times with the offset from kMsgCKeepAliveSync, adds its own read,
+ * parse and injection times and records the latency of each step.
+ *
+ * The secondary does not reply to this message.
+ *
+ * @see kMsgCKeepAliveSync
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDInputTrace;
+
 /** @} */ // end of protocol_system group
 
 /** @} */ // end of protocol_data group
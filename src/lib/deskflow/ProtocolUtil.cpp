@@ -7,6 +7,7 @@
 
 #include "deskflow/ProtocolUtil.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/XDeskflow.h"
 #include "io/IStream.h"
@@ -77,13 +78,36 @@ void ProtocolUtil::writef(deskflow::IStream *stream, const char *fmt, ...)
   va_start(args, fmt);
   auto size = getLength(fmt, args);
   va_end(args);
+  TRACE_SCOPE_ARGS("protocol", "ProtocolUtil::writef", "size", size);
   va_start(args, fmt);
   vwritef(stream, fmt, size, args);
   va_end(args);
 }
 
+deskflow::SharedPacket ProtocolUtil::formatf(const char *fmt, ...)
+{
+  assert(fmt != nullptr);
+  LOG((CLOG_DEBUG2 "formatf(%s)", fmt));
+
+  va_list args;
+  va_start(args, fmt);
+  auto size = getLength(fmt, args);
+  va_end(args);
+  TRACE_SCOPE_ARGS("protocol", "ProtocolUtil::formatf", "size", size);
+
+  // leave room for the packet header and encode the message after it
+  std::vector<uint8_t> packet(deskflow::SharedPacket::kHeaderSize);
+  packet.reserve(deskflow::SharedPacket::kHeaderSize + size);
+  va_start(args, fmt);
+  writef(packet, fmt, args);
+  va_end(args);
+
+  return deskflow::SharedPacket(std::move(packet));
+}
+
 bool ProtocolUtil::readf(deskflow::IStream *stream, const char *fmt, ...)
 {
+  TRACE_SCOPE("protocol", "ProtocolUtil::readf");
   bool result = false;
 
   if (stream && fmt) {
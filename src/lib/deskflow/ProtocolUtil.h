@@ -8,6 +8,7 @@
 #pragma once
 
 #include "base/EventTypes.h"
+#include "io/SharedPacket.h"
 #include "io/XIO.h"
 
 #include <stdarg.h>
@@ -45,6 +46,14 @@ public:
   */
   static void writef(deskflow::IStream *, const char *fmt, ...);
 
+  //! Format a packet
+  /*!
+  Format binary data as writef() does, framed as a packet that can be
+  written to any number of streams with \c IStream::writePacket().  Use
+  this to encode a message once when sending it to many clients.
+  */
+  static deskflow::SharedPacket formatf(const char *fmt, ...);
+
   //! Read formatted data
   /*!
   Read formatted binary data from a buffer.  This performs the
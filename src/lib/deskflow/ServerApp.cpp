@@ -12,6 +12,7 @@
 #include "base/IEventQueue.h"
 #include "base/Log.h"
 #include "base/Path.h"
+#include "common/CoreStatus.h"
 #include "deskflow/App.h"
 #include "deskflow/ArgParser.h"
 #include "deskflow/Screen.h"
@@ -149,12 +150,29 @@ void ServerApp::reloadSignalHandler(Arch::ThreadSignal, void *)
 void ServerApp::reloadConfig()
 {
   LOG((CLOG_DEBUG "reload configuration"));
-  if (loadConfig(args().m_configFile)) {
-    if (m_server != nullptr) {
-      m_server->setConfig(*args().m_config);
+  if (m_server == nullptr) {
+    if (loadConfig(args().m_configFile)) {
+      setConfigDefaults(*args().m_config);
+      LOG((CLOG_NOTE "reloaded configuration"));
     }
-    LOG((CLOG_NOTE "reloaded configuration"));
+    return;
+  }
+
+  // read into a new configuration so the server can apply only what
+  // changed and keep clients that are still configured connected
+  ServerConfig config(m_events);
+  if (!readConfig(args().m_configFile, config)) {
+    return;
+  }
+  setConfigDefaults(config);
+  if (config.getDeskflowAddress() != args().m_config->getDeskflowAddress()) {
+    LOG((CLOG_WARN "the server must restart to listen on %s", config.getDeskflowAddress().getHostname().c_str()));
   }
+  if (!m_server->applyConfig(config)) {
+    LOG((CLOG_ERR "cannot reload configuration, unknown screen name `%s'", args().m_name.c_str()));
+    return;
+  }
+  LOG((CLOG_NOTE "reloaded configuration"));
 }
 
 void ServerApp::loadConfig()
@@ -172,6 +190,11 @@ void ServerApp::loadConfig()
 }
 
 bool ServerApp::loadConfig(const std::string &pathname)
+{
+  return readConfig(pathname, *args().m_config);
+}
+
+bool ServerApp::readConfig(const std::string &pathname, ServerConfig &config) const
 {
   try {
     // load configuration
@@ -181,7 +204,7 @@ bool ServerApp::loadConfig(const std::string &pathname)
       LOG((CLOG_ERR "cannot open configuration \"%s\"", pathname.c_str()));
       return false;
     }
-    configStream >> *args().m_config;
+    configStream >> config;
     LOG((CLOG_DEBUG "configuration read successfully"));
     return true;
   } catch (XConfigRead &e) {
@@ -191,6 +214,24 @@ bool ServerApp::loadConfig(const std::string &pathname)
   return false;
 }
 
+void ServerApp::setConfigDefaults(ServerConfig &config) const
+{
+  // if configuration has no screens then add this system
+  // as the default
+  if (config.begin() == config.end()) {
+    config.addScreen(args().m_name);
+  }
+
+  // set the contact address, if provided, in the config.
+  // otherwise, if the config doesn't have an address, use
+  // the default.
+  if (m_deskflowAddress->isValid()) {
+    config.setDeskflowAddress(*m_deskflowAddress);
+  } else if (!config.getDeskflowAddress().isValid()) {
+    config.setDeskflowAddress(NetworkAddress(kDefaultPort));
+  }
+}
+
 void ServerApp::forceReconnect()
 {
   if (m_server != nullptr) {
@@ -448,6 +489,7 @@ bool ServerApp::startServer()
     m_listener = listener;
     updateStatus();
     LOG((CLOG_NOTE "started server, waiting for clients"));
+    deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::Listening);
     m_serverState = kStarted;
     return true;
   } catch (XSocketAddressInUse &e) {
@@ -591,20 +633,8 @@ int ServerApp::mainLoop()
   // on unix because threads evaporate across a fork().
   setSocketMultiplexer(std::make_unique<SocketMultiplexer>());
 
-  // if configuration has no screens then add this system
-  // as the default
-  if (args().m_config->begin() == args().m_config->end()) {
-    args().m_config->addScreen(args().m_name);
-  }
-
-  // set the contact address, if provided, in the config.
-  // otherwise, if the config doesn't have an address, use
-  // the default.
-  if (m_deskflowAddress->isValid()) {
-    args().m_config->setDeskflowAddress(*m_deskflowAddress);
-  } else if (!args().m_config->getDeskflowAddress().isValid()) {
-    args().m_config->setDeskflowAddress(NetworkAddress(kDefaultPort));
-  }
+  // fill in the screen and address the configuration may leave out
+  setConfigDefaults(*args().m_config);
 
   // canonicalize the primary screen name
   if (std::string primaryName = args().m_config->getCanonicalName(args().m_name); primaryName.empty()) {
@@ -621,6 +651,13 @@ int ServerApp::mainLoop()
     reloadConfig();
   });
 
+  // the gui asks for the same once the user has changed the configuration
+  deskflow::CoreStatusChannel::setRequestHandler([events = m_events](const deskflow::CoreStatus &request) {
+    if (request.m_type == deskflow::CoreStatus::Type::ReloadConfig) {
+      events->addEvent(Event(EventTypes::ServerAppReloadConfig, events->getSystemTarget()));
+    }
+  });
+
   // handle force reconnect event by disconnecting clients.  they'll
   // reconnect automatically.
   m_events->addHandler(EventTypes::ServerAppForceReconnect, m_events->getSystemTarget(), [this](const auto &) {
@@ -657,6 +694,7 @@ int ServerApp::mainLoop()
   LOG((CLOG_DEBUG1 "stopping server"));
   m_events->removeHandler(EventTypes::ServerAppForceReconnect, m_events->getSystemTarget());
   m_events->removeHandler(EventTypes::ServerAppReloadConfig, m_events->getSystemTarget());
+  deskflow::CoreStatusChannel::setRequestHandler(nullptr);
   cleanupServer();
   updateStatus();
   LOG((CLOG_NOTE "stopped server"));
@@ -128,6 +128,8 @@ private:
   void handleScreenSwitched() const;
   std::unique_ptr<ISocketFactory> getSocketFactory() const;
   NetworkAddress getAddress(const NetworkAddress &address) const;
+  bool readConfig(const std::string &pathname, ServerConfig &config) const;
+  void setConfigDefaults(ServerConfig &config) const;
 
   bool m_suspended = false;
   Server *m_server = nullptr;
@@ -13,7 +13,9 @@
 #include "base/String.h"
 #include "deskflow/ClipboardChunk.h"
 #include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 
@@ -59,3 +61,29 @@ void StreamChunker::sendClipboard(
 
   LOG((CLOG_DEBUG "sent clipboard size=%d", sentLength));
 }
+
+std::vector<deskflow::SharedPacket>
+StreamChunker::encodeClipboard(const std::string_view &data, ClipboardID id, uint32_t sequence)
+{
+  std::vector<deskflow::SharedPacket> packets;
+  packets.reserve(data.size() / g_chunkSize + 3);
+
+  // first message (data size)
+  const auto dataSize = deskflow::string::sizeTypeToString(data.size());
+  packets.push_back(ProtocolUtil::formatf(kMsgDClipboard, id, sequence, ChunkType::DataStart, &dataSize));
+
+  // clipboard chunks with a fixed size, at least one even if empty
+  size_t sentLength = 0;
+  do {
+    const auto chunkSize = std::min(g_chunkSize, data.size() - sentLength);
+    const std::string chunk(data.substr(sentLength, chunkSize));
+    packets.push_back(ProtocolUtil::formatf(kMsgDClipboard, id, sequence, ChunkType::DataChunk, &chunk));
+    sentLength += chunkSize;
+  } while (sentLength < data.size());
+
+  // last message
+  const std::string end;
+  packets.push_back(ProtocolUtil::formatf(kMsgDClipboard, id, sequence, ChunkType::DataEnd, &end));
+
+  return packets;
+}
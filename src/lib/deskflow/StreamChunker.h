@@ -7,8 +7,10 @@
 #pragma once
 
 #include "deskflow/ClipboardTypes.h"
+#include "io/SharedPacket.h"
 
 #include <string>
+#include <vector>
 
 class IEventQueue;
 
@@ -19,4 +21,13 @@ public:
       const std::string_view &data, size_t size, ClipboardID id, uint32_t sequence, IEventQueue *events,
       void *eventTarget
   );
+
+  //! Encode clipboard messages
+  /*!
+  Encodes the same messages sendClipboard() sends as packets that can be
+  written to any number of client streams, so clipboard data sent to
+  several clients is only chunked and formatted once.
+  */
+  static std::vector<deskflow::SharedPacket>
+  encodeClipboard(const std::string_view &data, ClipboardID id, uint32_t sequence);
 };
@@ -141,6 +141,8 @@ void DaemonIpcServer::processMessage(QLocalSocket *clientSocket, const QString &
     LOG_DEBUG("ipc server got clear settings message");
     Q_EMIT clearSettingsRequested();
     clientSocket->write(kAckMessage);
+  } else if (command == "trace") {
+    processTrace(clientSocket, parts);
   } else {
     LOG_WARN("ipc server got unknown message: %s", message.toUtf8().constData());
   }
@@ -208,4 +210,24 @@ void DaemonIpcServer::processCommand(QLocalSocket *&clientSocket, const QStringL
   clientSocket->write(kAckMessage);
 }
 
+void DaemonIpcServer::processTrace(QLocalSocket *&clientSocket, const QStringList &messageParts)
+{
+  if (messageParts.size() < 2) {
+    LOG_ERR("ipc server got invalid trace message");
+    clientSocket->write(kErrorMessage);
+    return;
+  }
+
+  const auto &trace = messageParts[1];
+  if (trace != "on" && trace != "off") {
+    LOG_ERR("ipc server got invalid trace value: %s", trace.toUtf8().constData());
+    clientSocket->write(kErrorMessage);
+    return;
+  }
+
+  LOG_DEBUG("ipc server got new trace value: %s", trace.toUtf8().constData());
+  Q_EMIT traceChanged(trace == "on");
+  clientSocket->write(kAckMessage);
+}
+
 } // namespace deskflow::core::ipc
@@ -31,12 +31,14 @@ Q_SIGNALS:
   void startProcessRequested();
   void stopProcessRequested();
   void clearSettingsRequested();
+  void traceChanged(bool enabled);
 
 private:
   void processMessage(QLocalSocket *clientSocket, const QString &message);
   void processLogLevel(QLocalSocket *&clientSocket, const QStringList &messageParts);
   void processElevate(QLocalSocket *&clientSocket, const QStringList &messageParts);
   void processCommand(QLocalSocket *&clientSocket, const QStringList &messageParts);
+  void processTrace(QLocalSocket *&clientSocket, const QStringList &messageParts);
 
 private Q_SLOTS:
   void handleNewConnection();
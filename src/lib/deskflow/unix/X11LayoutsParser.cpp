@@ -7,19 +7,29 @@
 
 #if WINAPI_XWINDOWS
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
+#include <string_view>
 
-#include <QDomDocument>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
 
 #include "DeskflowXkbKeyboard.h"
 #include "ISO639Table.h"
 #include "X11LayoutsParser.h"
 #include "base/Log.h"
+#include "common/Constants.h"
 
 namespace {
 
+// bump whenever the layout of the language data cache file changes
+const uint32_t kLanguageDataCacheVersion = 1;
+
 void splitLine(std::vector<std::string> &parts, const std::string &line, char delimiter)
 {
   std::stringstream stream(line);
@@ -30,27 +40,166 @@ void splitLine(std::vector<std::string> &parts, const std::string &line, char de
   }
 }
 
+QString getLanguageDataCachePath()
+{
+  return QStringLiteral("%1/%2/evdev-layouts")
+      .arg(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation), kAppId);
+}
+
+// the cache is only read on the machine that wrote it, so values are in
+// native byte order
+template <typename T> void writeCacheValue(std::string &buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void writeCacheString(std::string &buffer, const std::string &value)
+{
+  writeCacheValue(buffer, static_cast<uint32_t>(value.size()));
+  buffer += value;
+}
+
+void writeCacheStrings(std::string &buffer, const std::vector<std::string> &values)
+{
+  writeCacheValue(buffer, static_cast<uint32_t>(values.size()));
+  for (const auto &value : values) {
+    writeCacheString(buffer, value);
+  }
+}
+
+template <typename T> bool readCacheValue(std::string_view &data, T &value)
+{
+  if (data.size() < sizeof(value)) {
+    return false;
+  }
+  memcpy(&value, data.data(), sizeof(value));
+  data.remove_prefix(sizeof(value));
+  return true;
+}
+
+// reads a count of things that take at least a byte each, so a damaged
+// count can't ask for more than is left
+bool readCacheCount(std::string_view &data, uint32_t &count)
+{
+  return readCacheValue(data, count) && count <= data.size();
+}
+
+bool readCacheString(std::string_view &data, std::string &value)
+{
+  uint32_t size;
+  if (!readCacheCount(data, size)) {
+    return false;
+  }
+  value.assign(data.substr(0, size));
+  data.remove_prefix(size);
+  return true;
+}
+
+bool readCacheStrings(std::string_view &data, std::vector<std::string> &values)
+{
+  uint32_t count;
+  if (!readCacheCount(data, count)) {
+    return false;
+  }
+  values.resize(count);
+  for (auto &value : values) {
+    if (!readCacheString(data, value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
-bool X11LayoutsParser::readXMLConfigItemElem(const QDomNode &node, std::vector<Lang> &langList)
+bool X11LayoutsParser::readXMLConfigItemElem(QXmlStreamReader &reader, std::vector<Lang> &langList)
 {
-  auto configItemElem = node.firstChildElement("configItem");
-  if (configItemElem.isNull()) {
+  Lang lang;
+  bool hasConfigItem = false;
+  while (reader.readNextStartElement()) {
+    if (reader.name() == u"configItem" && !hasConfigItem) {
+      hasConfigItem = true;
+      while (reader.readNextStartElement()) {
+        if (reader.name() == u"name") {
+          lang.name = reader.readElementText().toStdString();
+        } else if (reader.name() == u"languageList") {
+          // only the first language of each list is used
+          std::string iso639Id;
+          while (reader.readNextStartElement()) {
+            if (reader.name() == u"iso639Id" && iso639Id.empty()) {
+              iso639Id = reader.readElementText().toStdString();
+            } else {
+              reader.skipCurrentElement();
+            }
+          }
+          lang.layoutBaseISO639_2.emplace_back(std::move(iso639Id));
+        } else {
+          reader.skipCurrentElement();
+        }
+      }
+    } else if (reader.name() == u"variantList") {
+      while (reader.readNextStartElement()) {
+        if (reader.name() == u"variant") {
+          readXMLConfigItemElem(reader, lang.variants);
+        } else {
+          reader.skipCurrentElement();
+        }
+      }
+    } else {
+      reader.skipCurrentElement();
+    }
+  }
+
+  if (!hasConfigItem) {
     LOG((CLOG_WARN "failed to read \"configItem\" in xml file"));
     return false;
   }
 
-  langList.emplace_back();
-  if (auto nameElem = configItemElem.firstChildElement("name"); !nameElem.isNull())
-    langList.back().name = nameElem.toElement().text().toStdString();
+  langList.emplace_back(std::move(lang));
+  return true;
+}
 
-  if (auto languageListElem = configItemElem.elementsByTagName("languageList"); !languageListElem.isEmpty()) {
-    for (int i = 0; i < languageListElem.count(); i++) {
-      const auto isoElem = languageListElem.at(i).namedItem("iso639Id").toElement();
-      langList.back().layoutBaseISO639_2.emplace_back(isoElem.text().toStdString());
+bool X11LayoutsParser::readAllLanguageData(const std::string &pathToEvdevFile, std::vector<Lang> &allCodes)
+{
+  QFile inFile(QString::fromStdString(pathToEvdevFile));
+  if (!inFile.open(QIODevice::ReadOnly)) {
+    LOG((CLOG_WARN "unable to open %s", pathToEvdevFile.c_str()));
+    return false;
+  }
+
+  // evdev.xml runs to thousands of lines, most of them models and options,
+  // so stream through it and stop once the layouts have been read
+  QXmlStreamReader reader(&inFile);
+  if (!reader.readNextStartElement() || reader.name() != u"xkbConfigRegistry") {
+    LOG((CLOG_WARN "failed to read xkbConfigRegistry in %s", pathToEvdevFile.c_str()));
+    return true;
+  }
+
+  bool hasLayoutList = false;
+  while (!hasLayoutList && reader.readNextStartElement()) {
+    if (reader.name() != u"layoutList") {
+      reader.skipCurrentElement();
+      continue;
+    }
+
+    hasLayoutList = true;
+    while (reader.readNextStartElement()) {
+      if (reader.name() == u"layout") {
+        readXMLConfigItemElem(reader, allCodes);
+      } else {
+        reader.skipCurrentElement();
+      }
     }
   }
 
+  if (reader.hasError()) {
+    LOG((CLOG_WARN "failed to parse %s: %s", pathToEvdevFile.c_str(), qPrintable(reader.errorString())));
+    allCodes.clear();
+    return false;
+  }
+  if (!hasLayoutList) {
+    LOG((CLOG_WARN "failed to read layoutList in %s", pathToEvdevFile.c_str()));
+  }
   return true;
 }
 
@@ -58,38 +207,97 @@ std::vector<X11LayoutsParser::Lang> X11LayoutsParser::getAllLanguageData(const s
 {
   std::vector<Lang> allCodes;
 
-  QFile inFile(QString::fromStdString(pathToEvdevFile));
-  if (!inFile.open(QIODevice::ReadOnly)) {
-    LOG((CLOG_WARN "unable to open %s", pathToEvdevFile.c_str()));
+  // evdev.xml only changes when the xkb data is upgraded, so what was read
+  // from it last time is used until its size or modification time changes
+  const QFileInfo info(QString::fromStdString(pathToEvdevFile));
+  std::string key = pathToEvdevFile;
+  key += '\0';
+  writeCacheValue(key, static_cast<int64_t>(info.size()));
+  writeCacheValue(key, static_cast<int64_t>(info.lastModified().toMSecsSinceEpoch()));
+  if (info.exists() && loadLanguageDataCache(key, allCodes)) {
     return allCodes;
   }
 
-  QDomDocument xmlDoc;
-  xmlDoc.setContent(inFile.readAll());
+  if (readAllLanguageData(pathToEvdevFile, allCodes)) {
+    saveLanguageDataCache(key, allCodes);
+  }
+  return allCodes;
+}
 
-  const auto xkbConfigElem = xmlDoc.firstChildElement("xkbConfigRegistry");
-  if (xkbConfigElem.isNull()) {
-    LOG((CLOG_WARN "failed to read xkbConfigRegistry in %s", pathToEvdevFile.c_str()));
-    return allCodes;
+bool X11LayoutsParser::loadLanguageDataCache(const std::string &key, std::vector<Lang> &allCodes)
+{
+  QFile file(getLanguageDataCachePath());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
   }
+  const auto contents = file.readAll();
+  std::string_view data(contents.constData(), static_cast<size_t>(contents.size()));
 
-  auto layoutListElem = xkbConfigElem.firstChildElement("layoutList");
-  if (layoutListElem.isNull()) {
-    LOG((CLOG_WARN "failed to read layoutList in %s", pathToEvdevFile.c_str()));
-    return allCodes;
+  uint32_t version;
+  std::string storedKey;
+  if (!readCacheValue(data, version) || version != kLanguageDataCacheVersion || !readCacheString(data, storedKey) ||
+      storedKey != key) {
+    return false;
   }
 
-  const auto layouts = layoutListElem.elementsByTagName("layout");
-  for (int i = 0; i < layouts.count(); i++) {
-    auto item = layouts.at(i);
-    if (!readXMLConfigItemElem(item, allCodes))
-      continue;
+  std::vector<Lang> langs;
+  uint32_t count;
+  if (!readCacheCount(data, count)) {
+    return false;
+  }
+  langs.resize(count);
+  for (auto &lang : langs) {
+    uint32_t variantCount;
+    if (!readCacheString(data, lang.name) || !readCacheStrings(data, lang.layoutBaseISO639_2) ||
+        !readCacheCount(data, variantCount)) {
+      return false;
+    }
+    lang.variants.resize(variantCount);
+    for (auto &variant : lang.variants) {
+      if (!readCacheString(data, variant.name) || !readCacheStrings(data, variant.layoutBaseISO639_2)) {
+        return false;
+      }
+    }
+  }
+  if (!data.empty()) {
+    return false;
+  }
+
+  LOG((CLOG_DEBUG1 "keyboard layouts loaded from %s", qPrintable(file.fileName())));
+  allCodes.swap(langs);
+  return true;
+}
 
-    auto variantListElem = item.namedItem("variantList").childNodes();
-    for (int i = 0; i < variantListElem.count(); i++)
-      readXMLConfigItemElem(variantListElem.at(i), allCodes.back().variants);
+void X11LayoutsParser::saveLanguageDataCache(const std::string &key, const std::vector<Lang> &allCodes)
+{
+  std::string buffer;
+  writeCacheValue(buffer, kLanguageDataCacheVersion);
+  writeCacheString(buffer, key);
+  writeCacheValue(buffer, static_cast<uint32_t>(allCodes.size()));
+  for (const auto &lang : allCodes) {
+    writeCacheString(buffer, lang.name);
+    writeCacheStrings(buffer, lang.layoutBaseISO639_2);
+    writeCacheValue(buffer, static_cast<uint32_t>(lang.variants.size()));
+    for (const auto &variant : lang.variants) {
+      writeCacheString(buffer, variant.name);
+      writeCacheStrings(buffer, variant.layoutBaseISO639_2);
+    }
+  }
+
+  // write to a temporary file and rename it, so another instance never
+  // sees half a cache
+  const auto path = getLanguageDataCachePath();
+  const QDir dir = QFileInfo(path).dir();
+  if (!dir.mkpath(dir.absolutePath())) {
+    LOG((CLOG_DEBUG "unable to create keyboard layout cache directory %s", qPrintable(dir.path())));
+    return;
+  }
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(buffer.data(), static_cast<qint64>(buffer.size())) != static_cast<qint64>(buffer.size()) ||
+      !file.commit()) {
+    LOG((CLOG_DEBUG "unable to save keyboard layout cache %s: %s", qPrintable(path), qPrintable(file.errorString())));
   }
-  return allCodes;
 }
 
 void X11LayoutsParser::appendVectorUniq(const std::vector<std::string> &source, std::vector<std::string> &dst)
@@ -202,16 +410,15 @@ std::vector<std::string> X11LayoutsParser::convertISO639_2ToISO639_1(const std::
 {
   std::vector<std::string> result;
   for (const auto &isoCode : iso639_2Codes) {
-    const auto &tableIter =
-        std::find_if(ISO_Table.begin(), ISO_Table.end(), [&isoCode](const std::pair<std::string, std::string> &c) {
-          return c.first == isoCode;
-        });
-    if (tableIter == ISO_Table.end()) {
+    const auto tableIter = std::ranges::lower_bound(ISO_Table, std::string_view(isoCode), {}, [](const auto &c) {
+      return c.first;
+    });
+    if (tableIter == std::ranges::end(ISO_Table) || tableIter->first != isoCode) {
       LOG((CLOG_WARN "the ISO 639-2 code \"%s\" is missed in table", isoCode.c_str()));
       continue;
     }
 
-    appendVectorUniq({tableIter->second}, result);
+    appendVectorUniq({std::string(tableIter->second)}, result);
   }
 
   return result;
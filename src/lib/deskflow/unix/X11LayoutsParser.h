@@ -11,7 +11,7 @@
 #include <string>
 #include <vector>
 
-class QDomNode;
+class QXmlStreamReader;
 
 class X11LayoutsParser
 {
@@ -29,10 +29,16 @@ private:
     std::vector<Lang> variants;
   };
 
-  static bool readXMLConfigItemElem(const QDomNode &node, std::vector<Lang> &langList);
+  static bool readXMLConfigItemElem(QXmlStreamReader &reader, std::vector<Lang> &langList);
+
+  static bool readAllLanguageData(const std::string &pathToEvdevFile, std::vector<Lang> &allCodes);
 
   static std::vector<Lang> getAllLanguageData(const std::string &pathToEvdevFile);
 
+  static bool loadLanguageDataCache(const std::string &key, std::vector<Lang> &allCodes);
+
+  static void saveLanguageDataCache(const std::string &key, const std::vector<Lang> &allCodes);
+
   static void appendVectorUniq(const std::vector<std::string> &source, std::vector<std::string> &dst);
 
   static void convertLayoutToISO639_2(
@@ -0,0 +1,181 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LogModel.h"
+
+#include <QStringView>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace deskflow::gui {
+
+namespace {
+
+struct LevelName
+{
+  QLatin1StringView m_name;
+  LogModel::Level m_level;
+};
+
+// the core has more debug levels than are worth filtering by, so the finer ones share a level
+const auto kLevelNames = std::to_array<LevelName>({
+    {QLatin1StringView("FATAL"), LogModel::Level::Fatal},
+    {QLatin1StringView("ERROR"), LogModel::Level::Error},
+    {QLatin1StringView("CRITICAL"), LogModel::Level::Error},
+    {QLatin1StringView("WARNING"), LogModel::Level::Warning},
+    {QLatin1StringView("NOTE"), LogModel::Level::Note},
+    {QLatin1StringView("INFO"), LogModel::Level::Info},
+    {QLatin1StringView("VERBOSE"), LogModel::Level::Info},
+    {QLatin1StringView("DEBUG"), LogModel::Level::Debug},
+    {QLatin1StringView("DEBUG1"), LogModel::Level::Debug1},
+    {QLatin1StringView("DEBUG2"), LogModel::Level::Debug2},
+    {QLatin1StringView("DEBUG3"), LogModel::Level::Debug2},
+    {QLatin1StringView("DEBUG4"), LogModel::Level::Debug2},
+    {QLatin1StringView("DEBUG5"), LogModel::Level::Debug2},
+});
+
+} // namespace
+
+LogModel::LogModel(QObject *parent, int capacity) : QAbstractListModel(parent), m_capacity{std::max(capacity, 1)}
+{
+  m_lines.resize(m_capacity);
+
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setInterval(kFlushInterval);
+  connect(&m_flushTimer, &QTimer::timeout, this, &LogModel::flush);
+}
+
+void LogModel::appendLine(const QString &line)
+{
+  m_lastLevel = parseLevel(line, m_lastLevel);
+  m_pending.append(Line{line, m_lastLevel});
+
+  if (!m_flushTimer.isActive()) {
+    m_flushTimer.start();
+  }
+}
+
+void LogModel::flush()
+{
+  m_flushTimer.stop();
+  if (m_pending.isEmpty()) {
+    return;
+  }
+
+  auto pending = std::exchange(m_pending, {});
+  if (pending.size() > m_capacity) {
+    pending.remove(0, pending.size() - m_capacity);
+  }
+
+  // the oldest rows go first, the new rows then take their slots in the ring
+  const auto overflow = m_count + static_cast<int>(pending.size()) - m_capacity;
+  if (overflow > 0) {
+    beginRemoveRows(QModelIndex(), 0, overflow - 1);
+    m_first = (m_first + overflow) % m_capacity;
+    m_count -= overflow;
+    endRemoveRows();
+  }
+
+  beginInsertRows(QModelIndex(), m_count, m_count + static_cast<int>(pending.size()) - 1);
+  for (auto &line : pending) {
+    m_lines[(m_first + m_count) % m_capacity] = std::move(line);
+    m_count++;
+  }
+  endInsertRows();
+}
+
+void LogModel::setCapacity(int capacity)
+{
+  capacity = std::max(capacity, 1);
+  if (capacity == m_capacity) {
+    return;
+  }
+
+  flush();
+
+  beginResetModel();
+  const auto kept = std::min(m_count, capacity);
+  QList<Line> lines(capacity);
+  for (int row = 0; row < kept; row++) {
+    lines[row] = std::move(m_lines[(m_first + m_count - kept + row) % m_capacity]);
+  }
+  m_lines = std::move(lines);
+  m_capacity = capacity;
+  m_first = 0;
+  m_count = kept;
+  endResetModel();
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+  return parent.isValid() ? 0 : m_count;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() >= m_count) {
+    return {};
+  }
+
+  switch (role) {
+  case Qt::DisplayRole:
+    return text(index.row());
+  case LevelRole:
+    return QVariant::fromValue(level(index.row()));
+  default:
+    return {};
+  }
+}
+
+LogModel::Level LogModel::parseLevel(const QString &line, Level previous)
+{
+  const auto start = line.indexOf(QLatin1String("] "));
+  if (start < 0) {
+    return previous;
+  }
+
+  const auto end = line.indexOf(QLatin1Char(':'), start + 2);
+  if (end < 0) {
+    return previous;
+  }
+
+  const auto name = QStringView(line).sliced(start + 2, end - start - 2);
+  for (const auto &levelName : kLevelNames) {
+    if (name == levelName.m_name) {
+      return levelName.m_level;
+    }
+  }
+  return previous;
+}
+
+void LogFilterModel::setMaxLevel(LogModel::Level level)
+{
+  if (level != m_maxLevel) {
+    m_maxLevel = level;
+    invalidateFilter();
+  }
+}
+
+void LogFilterModel::setText(const QString &text)
+{
+  if (text != m_text) {
+    m_text = text;
+    invalidateFilter();
+  }
+}
+
+bool LogFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
+{
+  const auto *model = static_cast<const LogModel *>(sourceModel());
+  if (model->level(sourceRow) > m_maxLevel) {
+    return false;
+  }
+  return m_text.isEmpty() || model->text(sourceRow).contains(m_text, Qt::CaseInsensitive);
+}
+
+} // namespace deskflow::gui
@@ -0,0 +1,137 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QTimer>
+
+namespace deskflow::gui {
+
+/**
+ * @brief The lines shown in the log view, kept in a ring of fixed capacity.
+ *
+ * Lines are queued as they arrive and added to the model a few times a second, so a busy core doesn't make
+ * the view lay itself out for every line. Once the ring is full the oldest lines make room for the newest.
+ */
+class LogModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Log levels of both the core and the GUI, most severe first.
+   */
+  enum class Level
+  {
+    Fatal,
+    Error,
+    Warning,
+    Note,
+    Info,
+    Debug,
+    Debug1,
+    Debug2
+  };
+  Q_ENUM(Level)
+
+  enum Role
+  {
+    LevelRole = Qt::UserRole + 1
+  };
+
+  static constexpr int kDefaultCapacity = 10000;
+  static constexpr int kFlushInterval = 100;
+
+  explicit LogModel(QObject *parent = nullptr, int capacity = kDefaultCapacity);
+
+  /**
+   * @brief Queues a line to be added on the next flush.
+   */
+  void appendLine(const QString &line);
+
+  /**
+   * @brief Adds any queued lines now rather than waiting for the timer.
+   */
+  void flush();
+
+  /**
+   * @brief Changes how many lines are kept, dropping the oldest if there are now too many.
+   */
+  void setCapacity(int capacity);
+
+  int capacity() const
+  {
+    return m_capacity;
+  }
+
+  const QString &text(int row) const
+  {
+    return at(row).m_text;
+  }
+
+  Level level(int row) const
+  {
+    return at(row).m_level;
+  }
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  /**
+   * @brief Gets the level from a line such as `[time] LEVEL: message`.
+   *
+   * Lines without a level, like the `file:line` that follows a core message, take the level of the line
+   * before them.
+   */
+  static Level parseLevel(const QString &line, Level previous);
+
+private:
+  struct Line
+  {
+    QString m_text;
+    Level m_level = Level::Info;
+  };
+
+  const Line &at(int row) const
+  {
+    return m_lines.at((m_first + row) % m_capacity);
+  }
+
+  QList<Line> m_lines;
+  QList<Line> m_pending;
+  int m_capacity;
+  int m_first = 0;
+  int m_count = 0;
+  Level m_lastLevel = Level::Info;
+  QTimer m_flushTimer;
+};
+
+/**
+ * @brief Shows only the log lines at or above a level which contain some text.
+ */
+class LogFilterModel : public QSortFilterProxyModel
+{
+  Q_OBJECT
+
+public:
+  using QSortFilterProxyModel::QSortFilterProxyModel;
+
+  void setMaxLevel(LogModel::Level level);
+  void setText(const QString &text);
+
+protected:
+  bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+  LogModel::Level m_maxLevel = LogModel::Level::Debug2;
+  QString m_text;
+};
+
+} // namespace deskflow::gui
@@ -11,6 +11,8 @@
 #include <QMessageBox>
 #include <QTime>
 
+#include <cstdio>
+
 #if defined(Q_OS_WIN)
 #include <Windows.h>
 #endif
@@ -27,30 +29,28 @@ Logger Logger::s_instance;
 
 QString printLine(FILE *out, const QString &type, const QString &message, const QString &fileLine = "")
 {
+  // This runs for every line, so it's built in one go rather than with arg() and text streams.
+  const auto datetime = QDateTime::currentDateTime().toString(QStringLiteral("yyyy-MM-ddTHH:mm:ss"));
 
-  auto datetime = QDateTime::currentDateTime().toString("yyyy-MM-ddTHH:mm:ss");
-  auto logLine = QString("[%1] %2: %3").arg(datetime, type, message);
-
-  QTextStream stream(&logLine);
+  QString logLine;
+  logLine.reserve(datetime.size() + type.size() + message.size() + fileLine.size() + 8);
+  logLine.append(QLatin1Char('[')).append(datetime).append(QLatin1String("] "));
+  logLine.append(type).append(QLatin1String(": ")).append(message);
   if (!fileLine.isEmpty()) {
-    stream << "\n\t" + fileLine;
+    logLine.append(QLatin1String("\n\t")).append(fileLine);
   }
 
-  // We must return a non-terminated log line, but before returning,
-  // stdout/stderr and Windows debug output all expect a terminated line.
-  QString terminatedLogLine = logLine;
-  QTextStream terminatedStream(&terminatedLogLine);
-  terminatedStream << Qt::endl;
-
+  // We must return a non-terminated log line, but stdout/stderr and Windows
+  // debug output all expect a terminated line.
 #if defined(Q_OS_WIN)
   // Debug output is viewable using either VS Code, Visual Studio, DebugView, or
   // DbgView++ (only one can be used at once). It's important to send output to
   // the debug output API, because it's difficult to view stdout and stderr from
   // a Windows GUI app.
-  OutputDebugStringA(terminatedLogLine.toLocal8Bit().constData());
+  OutputDebugStringA(logLine.toLocal8Bit().append('\n').constData());
 #else
-  QTextStream outStream(out);
-  outStream << terminatedLogLine;
+  const auto bytes = logLine.toUtf8().append('\n');
+  std::fwrite(bytes.constData(), 1, static_cast<std::size_t>(bytes.size()), out);
 #endif
 
   return logLine;
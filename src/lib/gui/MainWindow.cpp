@@ -21,20 +21,24 @@
 #include "base/String.h"
 #include "common/Settings.h"
 #include "common/UrlConstants.h"
+#include "gui/LogModel.h"
 #include "gui/Logger.h"
 #include "gui/Messages.h"
 #include "gui/Styles.h"
 #include "gui/core/CoreProcess.h"
 #include "gui/ipc/DaemonIpcClient.h"
 #include "net/FingerprintDatabase.h"
+#include "net/SecureUtils.h"
 #include "platform/Wayland.h"
 
 #if defined(Q_OS_LINUX)
 #include "Config.h"
 #endif
 
+#include <QClipboard>
 #include <QDesktopServices>
 #include <QFileDialog>
+#include <QGuiApplication>
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QMenu>
@@ -47,7 +51,10 @@
 #include <QRegularExpressionValidator>
 #include <QScrollBar>
 
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <utility>
 
 #if defined(Q_OS_MAC)
 #include <ApplicationServices/ApplicationServices.h>
@@ -82,20 +89,30 @@ MainWindow::MainWindow()
       m_actionSettings{new QAction(tr("&Preferences"), this)},
       m_actionStartCore{new QAction(tr("&Start"), this)},
       m_actionRestartCore{new QAction(tr("Rest&art"), this)},
-      m_actionStopCore{new QAction(tr("S&top"), this)}
+      m_actionStopCore{new QAction(tr("S&top"), this)},
+      m_actionCopyLog{new QAction(tr("&Copy"), this)},
+      m_logModel{new LogModel(this, Settings::value(Settings::Log::MaxLines).toInt())},
+      m_logFilter{new LogFilterModel(this)}
 {
   ui->setupUi(this);
 
   setWindowIcon(QIcon::fromTheme(QStringLiteral("deskflow")));
 
   // setup the log font
-  ui->textLog->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+  ui->listLog->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
 #ifdef Q_OS_MAC
-  auto f = ui->textLog->font();
+  auto f = ui->listLog->font();
   f.setPixelSize(12);
-  ui->textLog->setFont(f);
+  ui->listLog->setFont(f);
 #endif
 
+  // the view only lays out the lines in sight, the model holds the rest
+  m_logFilter->setSourceModel(m_logModel);
+  ui->listLog->setModel(m_logFilter);
+  m_actionCopyLog->setShortcut(QKeySequence::Copy);
+  m_actionCopyLog->setShortcutContext(Qt::WidgetShortcut);
+  ui->listLog->addAction(m_actionCopyLog);
+
   // Setup Actions
   m_actionAbout->setText(tr("About %1...").arg(kAppName));
   m_actionAbout->setMenuRole(QAction::AboutRole);
@@ -155,7 +172,8 @@ MainWindow::MainWindow()
 
   // Force generation of SHA256 for the localhost
   if (Settings::value(Settings::Security::TlsEnabled).toBool()) {
-    if (Settings::value(Settings::Security::KeySize).toInt() < 2048) {
+    const auto keyType = deskflow::keyTypeFromString(Settings::value(Settings::Security::KeyType).toString());
+    if (keyType == deskflow::KeyType::RSA && Settings::value(Settings::Security::KeySize).toInt() < 2048) {
       QMessageBox::information(
           this, kAppName,
           tr("Your current TLS key is smaller than the minimum allowed size, A new key 2048-bit key will be generated.")
@@ -230,10 +248,10 @@ void MainWindow::setupControls()
   ui->btnToggleLog->setStyleSheet(kStyleFlatButton);
   if (Settings::value(Settings::Gui::LogExpanded).toBool()) {
     ui->btnToggleLog->setArrowType(Qt::DownArrow);
-    ui->textLog->setVisible(true);
+    ui->widgetLog->setVisible(true);
     ui->btnToggleLog->click();
   } else {
-    ui->textLog->setVisible(false);
+    ui->widgetLog->setVisible(false);
   }
 
   ui->serverOptions->setVisible(false);
@@ -307,6 +325,7 @@ void MainWindow::connectSlots()
   );
   connect(&m_coreProcess, &CoreProcess::connectionStateChanged, this, &MainWindow::coreConnectionStateChanged);
   connect(&m_coreProcess, &CoreProcess::secureSocket, this, &MainWindow::secureSocket);
+  connect(&m_coreProcess, &CoreProcess::statusReceived, this, &MainWindow::handleCoreStatus);
   connect(
       &m_coreProcess, &CoreProcess::daemonIpcClientConnectionFailed, this, &MainWindow::daemonIpcClientConnectionFailed
   );
@@ -353,6 +372,11 @@ void MainWindow::connectSlots()
   connect(ui->rbModeClient, &QRadioButton::toggled, this, &MainWindow::coreModeToggled);
 
   connect(ui->btnToggleLog, &QAbstractButton::toggled, this, &MainWindow::toggleLogVisible);
+  connect(ui->lineLogFilter, &QLineEdit::textChanged, m_logFilter, &LogFilterModel::setText);
+  connect(ui->comboLogFilterLevel, &QComboBox::currentIndexChanged, this, &MainWindow::setLogFilterLevel);
+  connect(m_actionCopyLog, &QAction::triggered, this, &MainWindow::copyLogLines);
+  connect(m_logFilter, &QAbstractItemModel::rowsAboutToBeInserted, this, &MainWindow::logLinesInserting);
+  connect(m_logFilter, &QAbstractItemModel::rowsInserted, this, &MainWindow::logLinesInserted);
 
   connect(m_btnUpdate, &QPushButton::clicked, this, &MainWindow::openGetNewVersionUrl);
 
@@ -371,7 +395,7 @@ void MainWindow::toggleLogVisible(bool visible)
     ui->btnToggleLog->setArrowType(Qt::RightArrow);
     m_expandedSize = size();
   }
-  ui->textLog->setVisible(visible);
+  ui->widgetLog->setVisible(visible);
   Settings::setValue(Settings::Gui::LogExpanded, visible);
   // 15 ms delay is to make sure we have left the function before calling updateSize
   QTimer::singleShot(15, this, &MainWindow::updateSize);
@@ -384,11 +408,17 @@ void MainWindow::settingsChanged(const QString &key)
     return;
   }
 
+  if (key == Settings::Log::MaxLines) {
+    m_logModel->setCapacity(Settings::value(Settings::Log::MaxLines).toInt());
+    return;
+  }
+
   if (key == Settings::Core::ScreenName)
     updateScreenName();
 
   if ((key == Settings::Security::Certificate) || (key == Settings::Security::KeySize) ||
-      (key == Settings::Security::TlsEnabled) || (key == Settings::Security::CheckPeers)) {
+      (key == Settings::Security::KeyType) || (key == Settings::Security::TlsEnabled) ||
+      (key == Settings::Security::CheckPeers)) {
     if (m_tlsUtility.isEnabled() && !QFile::exists(Settings::value(Settings::Security::Certificate).toString())) {
       m_tlsUtility.generateCertificate();
     }
@@ -610,7 +640,7 @@ void MainWindow::serverConnectionConfigureClient(const QString &clientName)
 {
   Settings::setValue(Settings::Server::ConfigVisible, true);
   ServerConfigDialog dialog(this, m_serverConfig);
-  if (dialog.addClient(clientName) && dialog.exec() == QDialog::Accepted) {
+  if (dialog.addClient(clientName) && dialog.exec() == QDialog::Accepted && !m_coreProcess.reloadConfig()) {
     m_coreProcess.restart();
   }
   Settings::setValue(Settings::Server::ConfigVisible, false);
@@ -752,31 +782,74 @@ void MainWindow::setIcon()
 }
 
 void MainWindow::handleLogLine(const QString &line)
+{
+  // Never trim the log line; doing so would hide underlying bugs where newlines and space is added unintentionally.
+  m_logModel->appendLine(line);
+
+  updateFromLogLine(line);
+}
+
+void MainWindow::logLinesInserting()
 {
   const int kScrollBottomThreshold = 2;
 
-  QScrollBar *verticalScroll = ui->textLog->verticalScrollBar();
-  int currentScroll = verticalScroll->value();
-  int maxScroll = verticalScroll->maximum();
-  const auto scrollAtBottom = qAbs(currentScroll - maxScroll) <= kScrollBottomThreshold;
+  // only follow new lines if already at the bottom, so scrolling back to read isn't interrupted
+  const auto *verticalScroll = ui->listLog->verticalScrollBar();
+  m_logAtBottom = qAbs(verticalScroll->value() - verticalScroll->maximum()) <= kScrollBottomThreshold;
+}
 
-  // Never trim the log line; doing so would hide underlying bugs where newlines and space is added unintentionally.
-  ui->textLog->appendPlainText(line);
+void MainWindow::logLinesInserted()
+{
+  if (m_logAtBottom) {
+    ui->listLog->scrollToBottom();
+  }
+}
+
+void MainWindow::setLogFilterLevel(int index)
+{
+  using enum LogModel::Level;
+  static const auto kLevels = std::to_array({Debug2, Debug, Info, Warning, Error});
 
-  if (scrollAtBottom) {
-    verticalScroll->setValue(verticalScroll->maximum());
-    ui->textLog->horizontalScrollBar()->setValue(0);
+  if (index >= 0 && index < static_cast<int>(kLevels.size())) {
+    m_logFilter->setMaxLevel(kLevels.at(index));
   }
+}
 
-  updateFromLogLine(line);
+void MainWindow::copyLogLines() const
+{
+  auto rows = ui->listLog->selectionModel()->selectedRows();
+  std::ranges::sort(rows);
+
+  QStringList lines;
+  lines.reserve(rows.size());
+  for (const auto &row : std::as_const(rows)) {
+    lines.append(row.data().toString());
+  }
+  QGuiApplication::clipboard()->setText(lines.join(QLatin1Char('\n')));
 }
 
 void MainWindow::updateFromLogLine(const QString &line)
 {
+  // the status channel says all this without the log being searched
+  if (m_coreProcess.hasStatusChannel()) {
+    return;
+  }
+
   checkConnected(line);
   checkFingerprint(line);
 }
 
+void MainWindow::handleCoreStatus(const deskflow::CoreStatus &status)
+{
+  if (status.m_type == deskflow::CoreStatus::Type::PeerFingerprint) {
+    checkPeerFingerprint(status.m_data);
+  } else if (ui->rbModeServer->isChecked()) {
+    m_serverConnection.handleStatus(status);
+  } else {
+    m_clientConnection.handleStatus(status);
+  }
+}
+
 void MainWindow::checkConnected(const QString &line)
 {
   if (ui->rbModeServer->isChecked()) {
@@ -795,9 +868,13 @@ void MainWindow::checkFingerprint(const QString &line)
   if (midStart == -1)
     return;
 
-  const auto sha256Text = line.mid(midStart + msgLen).remove(':');
+  checkPeerFingerprint(QByteArray::fromHex(line.mid(midStart + msgLen).remove(':').toLatin1()));
+}
 
-  const Fingerprint sha256 = {Fingerprint::Type::SHA256, QByteArray::fromHex(sha256Text.toLatin1())};
+void MainWindow::checkPeerFingerprint(const QByteArray &sha256Data)
+{
+  const auto sha256Text = QString::fromLatin1(sha256Data.toHex().toUpper());
+  const Fingerprint sha256 = {Fingerprint::Type::SHA256, sha256Data};
 
   const bool isClient = m_coreProcess.mode() == CoreMode::Client;
   if ((isClient && m_checkedServers.contains(sha256Text)) || (!isClient && m_checkedClients.contains(sha256Text))) {
@@ -1059,7 +1136,8 @@ void MainWindow::showConfigureServer(const QString &message)
 {
   ServerConfigDialog dialog(this, serverConfig());
   dialog.message(message);
-  if ((dialog.exec() == QDialog::Accepted) && m_coreProcess.isStarted()) {
+  // clients still in the config stay connected if the server can reload it
+  if ((dialog.exec() == QDialog::Accepted) && m_coreProcess.isStarted() && !m_coreProcess.reloadConfig()) {
     m_coreProcess.restart();
   }
 }
@@ -50,6 +50,11 @@ namespace Ui {
 class MainWindow;
 }
 
+namespace deskflow::gui {
+class LogFilterModel;
+class LogModel;
+} // namespace deskflow::gui
+
 namespace deskflow::gui::ipc {
 class DaemonIpcClient;
 }
@@ -129,11 +134,17 @@ private:
   [[nodiscard]] QString getIPAddresses() const;
   void checkConnected(const QString &line);
   void checkFingerprint(const QString &line);
+  void checkPeerFingerprint(const QByteArray &sha256Data);
   [[nodiscard]] QString getTimeStamp() const;
   void closeEvent(QCloseEvent *event) override;
   void secureSocket(bool secureSocket);
   void connectSlots();
   void handleLogLine(const QString &line);
+  void logLinesInserting();
+  void logLinesInserted();
+  void setLogFilterLevel(int index);
+  void copyLogLines() const;
+  void handleCoreStatus(const deskflow::CoreStatus &status);
   void updateLocalFingerprint();
   void updateScreenName();
   void saveSettings() const;
@@ -197,4 +208,10 @@ private:
   QAction *m_actionStartCore = nullptr;
   QAction *m_actionRestartCore = nullptr;
   QAction *m_actionStopCore = nullptr;
+  QAction *m_actionCopyLog = nullptr;
+
+  // Log view
+  deskflow::gui::LogModel *m_logModel = nullptr;
+  deskflow::gui::LogFilterModel *m_logFilter = nullptr;
+  bool m_logAtBottom = true;
 };
@@ -29,30 +29,57 @@ void ClientConnection::Deps::showError(QWidget *parent, messages::ClientError er
 
 void ClientConnection::handleLogLine(const QString &logLine)
 {
+  using enum CoreStatus::Type;
+  using enum CoreStatus::Refusal;
 
+  // only used when the core has no status channel, so the log is all there is
   if (logLine.contains("failed to connect to server")) {
-
-    if (!m_showMessage) {
-      qDebug("message already shown, skipping");
-      return;
+    if (logLine.contains("server refused client with our name")) {
+      handleStatus({ConnectRefused, static_cast<uint32_t>(NameUnknown)});
+    } else if (logLine.contains("server already has a connected client with our name")) {
+      handleStatus({ConnectRefused, static_cast<uint32_t>(NameInUse)});
+    } else {
+      handleStatus({ConnectFailed});
     }
+  } else if (logLine.contains("connected to server")) {
+    handleStatus({Connected});
+  }
+}
 
+void ClientConnection::handleStatus(const CoreStatus &status)
+{
+  using enum CoreStatus::Type;
+
+  if (status.m_type == Connected) {
     m_showMessage = false;
+    return;
+  }
 
-    // ignore the message if it's about the server refusing by name as
-    // this will trigger the server to show an 'add client' dialog.
-    if (logLine.contains("server refused client with our name")) {
-      qDebug("ignoring client name refused message");
-      return;
-    }
+  // a refusal is followed by a failure, only the first is shown
+  if (status.m_type != ConnectFailed && status.m_type != ConnectRefused) {
+    return;
+  }
 
-    showMessage(logLine);
-  } else if (logLine.contains("connected to server")) {
-    m_showMessage = false;
+  if (!m_showMessage) {
+    qDebug("message already shown, skipping");
+    return;
   }
+
+  m_showMessage = false;
+
+  const auto refusal = static_cast<CoreStatus::Refusal>(status.m_code);
+
+  // ignore the message if it's about the server refusing by name as
+  // this will trigger the server to show an 'add client' dialog.
+  if (status.m_type == ConnectRefused && refusal == CoreStatus::Refusal::NameUnknown) {
+    qDebug("ignoring client name refused message");
+    return;
+  }
+
+  showMessage(status.m_type == ConnectRefused && refusal == CoreStatus::Refusal::NameInUse);
 }
 
-void ClientConnection::showMessage(const QString &logLine)
+void ClientConnection::showMessage(bool alreadyConnected)
 {
   using enum messages::ClientError;
 
@@ -60,7 +87,7 @@ void ClientConnection::showMessage(const QString &logLine)
 
   const auto address = Settings::value(Settings::Client::RemoteHost).toString();
 
-  if (logLine.contains("server already has a connected client with our name")) {
+  if (alreadyConnected) {
     m_deps->showError(m_pParent, AlreadyConnected, address);
   } else if (QHostAddress a(address); a.isNull()) {
     qDebug("ip not detected, showing hostname error");
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "common/CoreStatus.h"
 #include "gui/Messages.h"
 
 #include <QObject>
@@ -36,6 +37,7 @@ public:
   }
 
   void handleLogLine(const QString &line);
+  void handleStatus(const deskflow::CoreStatus &status);
   void setShowMessage()
   {
     m_showMessage = true;
@@ -45,7 +47,7 @@ Q_SIGNALS:
   void messageShowing();
 
 private:
-  void showMessage(const QString &logLine);
+  void showMessage(bool alreadyConnected);
 
   QWidget *m_pParent;
   std::shared_ptr<Deps> m_deps;
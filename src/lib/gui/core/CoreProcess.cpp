@@ -7,6 +7,7 @@
 #include "CoreProcess.h"
 
 #include "common/Settings.h"
+#include "gui/ipc/CoreStatusServer.h"
 #include "gui/ipc/DaemonIpcClient.h"
 #include "tls/TlsUtility.h"
 
@@ -137,8 +138,11 @@ bool CoreProcess::Deps::fileExists(const QString &path) const
 CoreProcess::CoreProcess(const IServerConfig &serverConfig, std::shared_ptr<Deps> deps)
     : m_serverConfig(serverConfig),
       m_pDeps(deps),
-      m_daemonIpcClient{new ipc::DaemonIpcClient(this)}
+      m_daemonIpcClient{new ipc::DaemonIpcClient(this)},
+      m_statusServer{new ipc::CoreStatusServer(this)}
 {
+  connect(m_statusServer, &ipc::CoreStatusServer::messageReceived, this, &CoreProcess::handleStatus);
+
   connect(m_daemonIpcClient, &ipc::DaemonIpcClient::connected, this, &CoreProcess::daemonIpcClientConnected);
   connect(
       m_daemonIpcClient, &ipc::DaemonIpcClient::connectionFailed, this, &CoreProcess::daemonIpcClientConnectionFailed
@@ -194,6 +198,44 @@ void CoreProcess::daemonIpcClientConnected()
   }
 }
 
+void CoreProcess::handleStatus(const CoreStatus &status)
+{
+  using enum CoreStatus::Type;
+
+  switch (status.m_type) {
+  case Connecting:
+    setConnectionState(ConnectionState::Connecting);
+    break;
+  case Connected:
+  case ClientConnected:
+    m_connections++;
+    setConnectionState(ConnectionState::Connected);
+    break;
+  case Listening:
+    m_connections = 0;
+    setConnectionState(ConnectionState::Listening);
+    break;
+  case Disconnected:
+    m_connections = 0;
+    setConnectionState(ConnectionState::Disconnected);
+    break;
+  case ClientDisconnected:
+    m_connections--;
+    if (m_connections < 1) {
+      setConnectionState(ConnectionState::Listening);
+    }
+    break;
+  case SecureProtocol:
+    m_secureSocketVersion = status.m_text;
+    Q_EMIT secureSocket(true);
+    break;
+  default:
+    break;
+  }
+
+  Q_EMIT statusReceived(status);
+}
+
 void CoreProcess::onProcessFinished(int exitCode, QProcess::ExitStatus)
 {
   const auto wasStarted = m_processState == ProcessState::Started;
@@ -323,7 +365,17 @@ void CoreProcess::handleLogLines(const QString &text)
     }
 #endif
 
-    checkLogLine(line);
+    // the status channel says all this without the log being searched
+    if (!hasStatusChannel()) {
+      checkLogLine(line);
+    }
+
+    // server and client processes are not allowed to show notifications.
+    // process the log from it and show notification from deskflow instead.
+#ifdef Q_OS_MAC
+    checkOSXNotification(line);
+#endif
+
     Q_EMIT logLine(line);
   }
 }
@@ -385,6 +437,7 @@ void CoreProcess::start(std::optional<ProcessMode> processModeOption)
   }
 
   m_lastProcessMode = processMode;
+  m_lastArgs = args;
 }
 
 void CoreProcess::stop(std::optional<ProcessMode> processModeOption)
@@ -441,6 +494,35 @@ void CoreProcess::restart()
   start();
 }
 
+bool CoreProcess::reloadConfig()
+{
+  QMutexLocker locker(&m_processMutex);
+
+  if (mode() != Settings::CoreMode::Server || m_processState != ProcessState::Started) {
+    return false;
+  }
+
+  // the server can read its config file again, but anything else that
+  // changed on its command line (such as the screen name) needs a restart.
+  // building the args also saves the config file.
+  const auto processMode = Settings::value(Settings::Core::ProcessMode).value<ProcessMode>();
+  QString app;
+  QStringList args;
+  addGenericArgs(args, processMode);
+  if (m_lastProcessMode != processMode || !addServerArgs(args, app) || args != m_lastArgs) {
+    qDebug("core args changed, config can't be reloaded");
+    return false;
+  }
+
+  if (!m_statusServer->send(CoreStatus{CoreStatus::Type::ReloadConfig})) {
+    qDebug("core status channel not available, config can't be reloaded");
+    return false;
+  }
+
+  qInfo("reloading core config");
+  return true;
+}
+
 void CoreProcess::cleanup()
 {
   qInfo("cleaning up core process");
@@ -467,6 +549,14 @@ bool CoreProcess::addGenericArgs(QStringList &args, const ProcessMode processMod
     args << "--prevent-sleep";
   }
 
+  if (Settings::value(Settings::Core::ReceiveFiles).toBool()) {
+    args << "--receive-files";
+  }
+
+  if (m_statusServer->listen()) {
+    args << "--status-channel" << m_statusServer->name();
+  }
+
   return true;
 }
 
@@ -626,12 +716,6 @@ void CoreProcess::checkLogLine(const QString &line)
   }
 
   checkSecureSocket(line);
-
-  // server and client processes are not allowed to show notifications.
-  // process the log from it and show notification from deskflow instead.
-#ifdef Q_OS_MAC
-  checkOSXNotification(line);
-#endif
 }
 
 bool CoreProcess::checkSecureSocket(const QString &line)
@@ -663,6 +747,11 @@ void CoreProcess::checkOSXNotification(const QString &line)
 }
 #endif
 
+bool CoreProcess::hasStatusChannel() const
+{
+  return m_statusServer->isConnected();
+}
+
 QString CoreProcess::correctedInterface() const
 {
   const QString interface = wrapIpv6(Settings::value(Settings::Core::Interface).toString());
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "common/CoreStatus.h"
 #include "common/Settings.h"
 #include "gui/FileTail.h"
 #include "gui/config/IServerConfig.h"
@@ -23,6 +24,7 @@
 namespace deskflow::gui {
 
 namespace ipc {
+class CoreStatusServer;
 class DaemonIpcClient;
 }
 
@@ -76,6 +78,7 @@ public:
   void start(std::optional<ProcessMode> processMode = std::nullopt);
   void stop(std::optional<ProcessMode> processMode = std::nullopt);
   void restart();
+  bool reloadConfig();
   void cleanup();
   void applyLogLevel();
   void clearSettings();
@@ -102,6 +105,7 @@ public:
   {
     return m_connectionState;
   }
+  bool hasStatusChannel() const;
 
   // setters
   void setAddress(const QString &address)
@@ -120,6 +124,7 @@ Q_SIGNALS:
   void connectionStateChanged(ConnectionState state);
   void processStateChanged(ProcessState state);
   void secureSocket(bool enabled);
+  void statusReceived(const deskflow::CoreStatus &status);
   void daemonIpcClientConnectionFailed();
 
 private Q_SLOTS:
@@ -127,6 +132,7 @@ private Q_SLOTS:
   void onProcessReadyReadStandardOutput();
   void onProcessReadyReadStandardError();
   void daemonIpcClientConnected();
+  void handleStatus(const deskflow::CoreStatus &status);
 
 private:
   void startForegroundProcess(const QString &app, const QStringList &args);
@@ -162,9 +168,11 @@ private:
   QMutex m_processMutex;
   QString m_secureSocketVersion = "";
   std::optional<ProcessMode> m_lastProcessMode = std::nullopt;
+  QStringList m_lastArgs;
   QTimer m_retryTimer;
   int m_connections = 0;
   deskflow::gui::ipc::DaemonIpcClient *m_daemonIpcClient = nullptr;
+  deskflow::gui::ipc::CoreStatusServer *m_statusServer = nullptr;
   FileTail *m_daemonFileTail = nullptr;
 };
 
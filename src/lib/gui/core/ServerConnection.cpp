@@ -41,25 +41,38 @@ ServerConnection::ServerConnection(QWidget *parent, IServerConfig &serverConfig,
 
 void ServerConnection::handleLogLine(const QString &logLine)
 {
-  ServerMessage message(logLine);
-  const auto &clientName = message.getClientName();
+  using enum CoreStatus::Type;
 
+  // only used when the core has no status channel, so the log is all there is
+  ServerMessage message(logLine);
   if (message.isDisconnectedMessage()) {
-    m_connectedClients.remove(clientName);
-    Q_EMIT clientsChanged(connectedClients());
-    return;
+    handleStatus({ClientDisconnected, 0, message.getClientName()});
+  } else if (message.isConnectedMessage()) {
+    handleStatus({ClientConnected, 0, message.getClientName()});
+  } else if (message.isNewClientMessage()) {
+    handleStatus({ClientUnrecognised, 0, message.getClientName()});
   }
+}
+
+void ServerConnection::handleStatus(const CoreStatus &status)
+{
+  using enum CoreStatus::Type;
+
+  const auto &clientName = status.m_text;
 
-  if (message.isConnectedMessage()) {
+  if (status.m_type == ClientDisconnected) {
+    m_connectedClients.remove(clientName);
+    Q_EMIT clientsChanged(connectedClients());
+  } else if (status.m_type == ClientConnected) {
     m_connectedClients.insert(clientName);
     Q_EMIT clientsChanged(connectedClients());
-    return;
-  }
-
-  if (!message.isNewClientMessage()) {
-    return;
+  } else if (status.m_type == ClientUnrecognised) {
+    handleUnrecognisedClient(clientName);
   }
+}
 
+void ServerConnection::handleUnrecognisedClient(const QString &clientName)
+{
   if (m_messageShowing) {
     qDebug("new client message already shown, skipping for now");
     return;
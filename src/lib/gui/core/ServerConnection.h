@@ -8,6 +8,7 @@
 
 #include <QString>
 
+#include "common/CoreStatus.h"
 #include "gui/Messages.h"
 #include "gui/config/IServerConfig.h"
 
@@ -30,6 +31,7 @@ public:
       QWidget *parent, IServerConfig &serverConfig, std::shared_ptr<Deps> deps = std::make_shared<Deps>()
   );
   void handleLogLine(const QString &logLine);
+  void handleStatus(const deskflow::CoreStatus &status);
 
 Q_SIGNALS:
   void messageShowing();
@@ -37,6 +39,7 @@ Q_SIGNALS:
   void clientsChanged(const QStringList &clients);
 
 private:
+  void handleUnrecognisedClient(const QString &clientName);
   void handleNewClient(const QString &clientName);
   QStringList connectedClients() const;
 
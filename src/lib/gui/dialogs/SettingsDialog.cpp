@@ -14,6 +14,7 @@
 #include "gui/core/CoreProcess.h"
 #include "gui/tls/TlsCertificate.h"
 #include "gui/tls/TlsUtility.h"
+#include "net/SecureUtils.h"
 
 #include <QDir>
 #include <QFileDialog>
@@ -33,6 +34,9 @@ SettingsDialog::SettingsDialog(QWidget *parent, const IServerConfig &serverConfi
 
   ui->comboTlsKeyLength->setItemIcon(0, QIcon::fromTheme(QStringLiteral("security-medium")));
   ui->comboTlsKeyLength->setItemIcon(1, QIcon::fromTheme(QIcon::ThemeIcon::SecurityHigh));
+  ui->comboTlsKeyType->setItemData(0, deskflow::keyTypeToString(deskflow::KeyType::RSA));
+  ui->comboTlsKeyType->setItemData(1, deskflow::keyTypeToString(deskflow::KeyType::ECDSA));
+  ui->comboTlsKeyType->setItemData(2, deskflow::keyTypeToString(deskflow::KeyType::Ed25519));
   ui->lblTlsCertInfo->setFixedSize(28, 28);
 
   ui->rbIconMono->setIcon(QIcon::fromTheme(QStringLiteral("deskflow-symbolic")));
@@ -64,6 +68,7 @@ void SettingsDialog::initConnections() const
   connect(ui->groupService, &QGroupBox::toggled, this, &SettingsDialog::updateControls);
   connect(ui->btnTlsRegenCert, &QPushButton::clicked, this, &SettingsDialog::regenCertificates);
   connect(ui->comboTlsKeyLength, &QComboBox::currentIndexChanged, this, &SettingsDialog::updateRequestedKeySize);
+  connect(ui->comboTlsKeyType, &QComboBox::currentIndexChanged, this, &SettingsDialog::updateRequestedKeyType);
   connect(ui->btnTlsCertPath, &QPushButton::clicked, this, &SettingsDialog::browseCertificatePath);
   connect(ui->btnBrowseLog, &QPushButton::clicked, this, &SettingsDialog::browseLogPath);
   connect(ui->cbLogToFile, &QCheckBox::toggled, this, &SettingsDialog::setLogToFile);
@@ -131,12 +136,14 @@ void SettingsDialog::accept()
   Settings::setValue(Settings::Log::Level, ui->comboLogLevel->currentIndex());
   Settings::setValue(Settings::Log::ToFile, ui->cbLogToFile->isChecked());
   Settings::setValue(Settings::Log::File, ui->lineLogFilename->text());
+  Settings::setValue(Settings::Log::MaxLines, ui->sbLogMaxLines->value());
   Settings::setValue(Settings::Daemon::Elevate, ui->cbElevateDaemon->isChecked());
   Settings::setValue(Settings::Gui::Autohide, ui->cbAutoHide->isChecked());
   Settings::setValue(Settings::Gui::AutoUpdateCheck, ui->cbAutoUpdate->isChecked());
   Settings::setValue(Settings::Core::PreventSleep, ui->cbPreventSleep->isChecked());
   Settings::setValue(Settings::Security::Certificate, ui->lineTlsCertPath->text());
   Settings::setValue(Settings::Security::KeySize, ui->comboTlsKeyLength->currentText().toInt());
+  Settings::setValue(Settings::Security::KeyType, ui->comboTlsKeyType->currentData());
   Settings::setValue(Settings::Security::TlsEnabled, ui->groupSecurity->isChecked());
   Settings::setValue(Settings::Client::LanguageSync, ui->cbLanguageSync->isChecked());
   Settings::setValue(Settings::Client::InvertScrollDirection, ui->cbScrollDirection->isChecked());
@@ -161,6 +168,7 @@ void SettingsDialog::loadFromConfig()
   ui->comboLogLevel->setCurrentIndex(Settings::value(Settings::Log::Level).toInt());
   ui->cbLogToFile->setChecked(Settings::value(Settings::Log::ToFile).toBool());
   ui->lineLogFilename->setText(Settings::value(Settings::Log::File).toString());
+  ui->sbLogMaxLines->setValue(Settings::value(Settings::Log::MaxLines).toInt());
   ui->cbAutoHide->setChecked(Settings::value(Settings::Gui::Autohide).toBool());
   ui->cbPreventSleep->setChecked(Settings::value(Settings::Core::PreventSleep).toBool());
   ui->cbLanguageSync->setChecked(Settings::value(Settings::Client::LanguageSync).toBool());
@@ -189,6 +197,8 @@ void SettingsDialog::updateTlsControls()
   }
 
   ui->comboTlsKeyLength->setCurrentText(Settings::value(Settings::Security::KeySize).toString());
+  const auto keyType = deskflow::keyTypeFromString(Settings::value(Settings::Security::KeyType).toString());
+  ui->comboTlsKeyType->setCurrentIndex(ui->comboTlsKeyType->findData(deskflow::keyTypeToString(keyType)));
 
   const auto tlsEnabled = Settings::value(Settings::Security::TlsEnabled).toBool();
   const auto writable = Settings::isWritable();
@@ -199,9 +209,11 @@ void SettingsDialog::updateTlsControls()
   ui->groupSecurity->setChecked(tlsEnabled);
 
   ui->groupSecurity->setEnabled(writable);
-  ui->comboTlsKeyLength->setEnabled(enabled);
+  ui->comboTlsKeyType->setEnabled(enabled);
+  ui->lblTlsKeyType->setEnabled(enabled);
+  ui->comboTlsKeyLength->setEnabled(enabled && isRsaKeyType());
   ui->widgetTlsCert->setEnabled(enabled);
-  ui->lblTlsKeyLength->setEnabled(enabled);
+  ui->lblTlsKeyLength->setEnabled(enabled && isRsaKeyType());
   ui->btnTlsRegenCert->setEnabled(enabled);
   ui->cbRequireClientCert->setEnabled(enabled);
 }
@@ -214,8 +226,10 @@ void SettingsDialog::updateTlsControlsEnabled()
   const auto tlsChecked = ui->groupSecurity->isChecked();
 
   auto enabled = writable && tlsChecked && !clientMode;
-  ui->lblTlsKeyLength->setEnabled(enabled);
-  ui->comboTlsKeyLength->setEnabled(enabled);
+  ui->lblTlsKeyType->setEnabled(enabled);
+  ui->comboTlsKeyType->setEnabled(enabled);
+  ui->lblTlsKeyLength->setEnabled(enabled && isRsaKeyType());
+  ui->comboTlsKeyLength->setEnabled(enabled && isRsaKeyType());
   ui->lblTlsCert->setEnabled(enabled);
   ui->widgetTlsCert->setEnabled(enabled);
   ui->btnTlsRegenCert->setEnabled(enabled);
@@ -227,6 +241,12 @@ bool SettingsDialog::isClientMode() const
   return m_coreProcess.mode() == Settings::CoreMode::Client;
 }
 
+bool SettingsDialog::isRsaKeyType() const
+{
+  // the key length only applies to rsa, elliptic curve keys have a fixed size
+  return deskflow::keyTypeFromString(ui->comboTlsKeyType->currentData().toString()) == deskflow::KeyType::RSA;
+}
+
 void SettingsDialog::updateKeyLengthOnFile(const QString &path)
 {
   TlsCertificate ssl;
@@ -235,14 +255,18 @@ void SettingsDialog::updateKeyLengthOnFile(const QString &path)
   }
 
   auto length = ssl.getCertKeyLength(path);
+  auto keyType = ssl.getCertKeyType(path);
   auto labelIcon = QPixmap(QIcon::fromTheme(QIcon::ThemeIcon::SecurityLow).pixmap(24, 24));
   if (length == 2048)
     labelIcon = QPixmap(QIcon::fromTheme(QStringLiteral("security-medium")).pixmap(24, 24));
-  if (length == 4096)
+  if (length == 4096 || keyType != deskflow::KeyType::RSA)
     labelIcon = QPixmap(QIcon::fromTheme(QIcon::ThemeIcon::SecurityHigh).pixmap(24, 24));
 
   ui->lblTlsCertInfo->setPixmap(labelIcon);
-  ui->lblTlsCertInfo->setToolTip(QStringLiteral("Key length: %1 bits").arg(QString::number(length)));
+  ui->lblTlsCertInfo->setToolTip(
+      QStringLiteral("Key type: %1, key length: %2 bits")
+          .arg(deskflow::keyTypeToString(keyType).toUpper(), QString::number(length))
+  );
 }
 
 void SettingsDialog::updateControls()
@@ -257,11 +281,13 @@ void SettingsDialog::updateControls()
   ui->lineInterface->setEnabled(writable);
   ui->comboLogLevel->setEnabled(writable);
   ui->cbLogToFile->setEnabled(writable);
+  ui->sbLogMaxLines->setEnabled(writable);
   ui->cbAutoHide->setEnabled(writable);
   ui->cbAutoUpdate->setEnabled(writable);
   ui->cbPreventSleep->setEnabled(writable);
   ui->lineTlsCertPath->setEnabled(writable);
-  ui->comboTlsKeyLength->setEnabled(writable);
+  ui->comboTlsKeyType->setEnabled(writable);
+  ui->comboTlsKeyLength->setEnabled(writable && isRsaKeyType());
   ui->cbCloseToTray->setEnabled(writable);
 
   // Handle enable and disable of service items
@@ -287,4 +313,14 @@ void SettingsDialog::updateRequestedKeySize() const
   Settings::setValue(Settings::Security::KeySize, ui->comboTlsKeyLength->currentText());
 }
 
+void SettingsDialog::updateRequestedKeyType() const
+{
+  const auto keyType = ui->comboTlsKeyType->currentData().toString();
+  ui->lblTlsKeyLength->setEnabled(ui->comboTlsKeyType->isEnabled() && isRsaKeyType());
+  ui->comboTlsKeyLength->setEnabled(ui->comboTlsKeyType->isEnabled() && isRsaKeyType());
+  if (keyType == Settings::value(Settings::Security::KeyType).toString())
+    return;
+  Settings::setValue(Settings::Security::KeyType, keyType);
+}
+
 SettingsDialog::~SettingsDialog() = default;
@@ -42,6 +42,7 @@ private:
   void accept() override;
   void showEvent(QShowEvent *event) override;
   bool isClientMode() const;
+  bool isRsaKeyType() const;
   void updateTlsControls();
   void updateTlsControlsEnabled();
   void showReadOnlyMessage();
@@ -58,6 +59,9 @@ private:
   /// @brief updates the setting vaule for key size.
   void updateRequestedKeySize() const;
 
+  /// @brief updates the setting value for key type.
+  void updateRequestedKeyType() const;
+
   std::unique_ptr<Ui::SettingsDialog> ui;
   const IServerConfig &m_serverConfig;
   const CoreProcess &m_coreProcess;
@@ -0,0 +1,122 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "CoreStatusServer.h"
+
+#include "common/Constants.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QRandomGenerator>
+
+namespace deskflow::gui::ipc {
+
+CoreStatusServer::CoreStatusServer(QObject *parent)
+    : QObject(parent),
+      m_server{new QLocalServer(this)} // NOSONAR - Qt memory
+{
+  connect(m_server, &QLocalServer::newConnection, this, &CoreStatusServer::handleNewConnection);
+}
+
+CoreStatusServer::~CoreStatusServer()
+{
+  m_server->close();
+}
+
+bool CoreStatusServer::listen()
+{
+  if (m_server->isListening()) {
+    return true;
+  }
+
+  // the random part stops another user guessing the name and listening first
+  const auto name = QStringLiteral("%1-status-%2-%3")
+                        .arg(kAppId)
+                        .arg(QCoreApplication::applicationPid())
+                        .arg(QRandomGenerator::system()->generate(), 8, 16, QLatin1Char('0'));
+
+  if (!m_server->listen(name)) {
+    qWarning() << "core status server failed to listen on:" << name << m_server->errorString();
+    return false;
+  }
+
+  qDebug() << "core status server listening on:" << m_server->fullServerName();
+  return true;
+}
+
+QString CoreStatusServer::name() const
+{
+  return m_server->serverName();
+}
+
+bool CoreStatusServer::send(const CoreStatus &request)
+{
+  if (!m_connected || m_version < CoreStatus::kRequestVersion) {
+    return false;
+  }
+
+  const auto frame = request.encode();
+  return m_socket->write(frame) == frame.size();
+}
+
+void CoreStatusServer::handleNewConnection()
+{
+  while (auto *socket = m_server->nextPendingConnection()) {
+    closeSocket();
+
+    qDebug() << "core status server got new connection";
+    m_socket = socket;
+    m_reader = CoreStatusReader();
+    connect(m_socket, &QLocalSocket::readyRead, this, &CoreStatusServer::handleReadyRead);
+    connect(m_socket, &QLocalSocket::disconnected, this, &CoreStatusServer::handleDisconnected);
+  }
+}
+
+void CoreStatusServer::handleReadyRead()
+{
+  m_reader.append(m_socket->readAll());
+  while (const auto message = m_reader.next()) {
+    if (message->m_type == CoreStatus::Type::Hello) {
+      qDebug() << "core status channel connected, version:" << message->m_code;
+      m_connected = true;
+      m_version = message->m_code;
+    }
+    Q_EMIT messageReceived(*message);
+  }
+
+  // a handler may have run an event loop in which the socket went away
+  if (m_socket != nullptr && m_reader.isCorrupt()) {
+    qWarning() << "core status server got a corrupt message, disconnecting";
+    m_socket->abort();
+  }
+}
+
+void CoreStatusServer::handleDisconnected()
+{
+  qDebug() << "core status channel disconnected";
+  closeSocket();
+}
+
+void CoreStatusServer::closeSocket()
+{
+  if (m_socket == nullptr) {
+    return;
+  }
+
+  m_socket->disconnect(this);
+  m_socket->abort();
+  m_socket->deleteLater();
+  m_socket = nullptr;
+
+  if (m_connected) {
+    m_connected = false;
+    Q_EMIT disconnected();
+  }
+}
+
+} // namespace deskflow::gui::ipc
@@ -0,0 +1,69 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "common/CoreStatus.h"
+
+#include <QObject>
+#include <QString>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace deskflow::gui::ipc {
+
+/**
+ * @brief Receives status messages sent by the core over the status channel.
+ *
+ * Listens on a local socket with a name unique to this process, which is given to the core on the command
+ * line. Only the most recently connected core is read from, as a core that has been replaced is on its way out.
+ */
+class CoreStatusServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit CoreStatusServer(QObject *parent = nullptr);
+  ~CoreStatusServer() override;
+
+  bool listen();
+  QString name() const;
+
+  /**
+   * @brief True once a core has connected and said hello, until it disconnects.
+   */
+  bool isConnected() const
+  {
+    return m_connected;
+  }
+
+  /**
+   * @brief Sends a request to the connected core.
+   * @return False if no core is connected, or the core is too old to read requests.
+   */
+  bool send(const deskflow::CoreStatus &request);
+
+Q_SIGNALS:
+  void messageReceived(const deskflow::CoreStatus &message);
+  void disconnected();
+
+private Q_SLOTS:
+  void handleNewConnection();
+  void handleReadyRead();
+  void handleDisconnected();
+
+private:
+  void closeSocket();
+
+  QLocalServer *m_server;
+  QLocalSocket *m_socket = nullptr;
+  deskflow::CoreStatusReader m_reader;
+  bool m_connected = false;
+  std::uint32_t m_version = 0;
+};
+
+} // namespace deskflow::gui::ipc
@@ -250,4 +250,12 @@ bool DaemonIpcClient::sendClearSettings()
   return sendMessage("clearSettings");
 }
 
+bool DaemonIpcClient::sendTrace(bool enabled)
+{
+  if (!keepAlive())
+    return false;
+
+  return sendMessage("trace=" + (enabled ? QStringLiteral("on") : QStringLiteral("off")));
+}
+
 } // namespace deskflow::gui::ipc
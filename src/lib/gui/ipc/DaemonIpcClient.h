@@ -33,6 +33,7 @@ public:
   bool sendStartProcess(const QString &command, bool elevate);
   bool sendStopProcess();
   bool sendClearSettings();
+  bool sendTrace(bool enabled);
   QString requestLogPath();
 
   bool isConnected() const
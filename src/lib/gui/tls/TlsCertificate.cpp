@@ -27,7 +27,7 @@ TlsCertificate::TlsCertificate(QObject *parent) : QObject(parent)
   // do nothing
 }
 
-bool TlsCertificate::generateCertificate(const QString &path, int keyLength) const
+bool TlsCertificate::generateCertificate(const QString &path, int keyLength, deskflow::KeyType keyType) const
 {
   qDebug("generating tls certificate: %s", qUtf8Printable(path));
 
@@ -38,7 +38,7 @@ bool TlsCertificate::generateCertificate(const QString &path, int keyLength) con
   }
 
   try {
-    deskflow::generatePemSelfSignedCert(path.toStdString(), keyLength);
+    deskflow::generatePemSelfSignedCert(path.toStdString(), keyLength, keyType);
   } catch (const std::exception &e) {
     qCritical() << "failed to generate self-signed pem cert: " << e.what();
     return false;
@@ -61,6 +61,11 @@ int TlsCertificate::getCertKeyLength(const QString &path) const
   return deskflow::getCertLength(path.toStdString());
 }
 
+deskflow::KeyType TlsCertificate::getCertKeyType(const QString &path) const
+{
+  return deskflow::getCertKeyType(path.toStdString());
+}
+
 bool TlsCertificate::isCertificateValid(const QString &path) const
 {
   OpenSSL_add_all_algorithms();
@@ -87,8 +92,14 @@ bool TlsCertificate::isCertificateValid(const QString &path) const
   }
   auto pubkeyFree = deskflow::finally([pubkey]() { EVP_PKEY_free(pubkey); });
 
-  if (auto type = EVP_PKEY_type(EVP_PKEY_id(pubkey)); type != EVP_PKEY_RSA && type != EVP_PKEY_DSA) {
-    qWarning() << tr("public key in default certificate key file is not RSA or DSA");
+  const auto type = EVP_PKEY_type(EVP_PKEY_id(pubkey));
+  if (type == EVP_PKEY_EC || type == EVP_PKEY_ED25519) {
+    // elliptic curve keys are far shorter than rsa keys of the same strength
+    return true;
+  }
+
+  if (type != EVP_PKEY_RSA && type != EVP_PKEY_DSA) {
+    qWarning() << tr("public key in default certificate key file is not RSA, DSA, ECDSA or Ed25519");
     return false;
   }
 
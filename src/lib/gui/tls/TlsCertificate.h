@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "net/SecureUtils.h"
+
 #include <QObject>
 
 class TlsCertificate : public QObject
@@ -17,7 +19,10 @@ public:
   explicit TlsCertificate(QObject *parent = nullptr);
 
   bool isCertificateValid(const QString &path) const;
-  bool generateCertificate(const QString &path, int keyLength) const;
+  bool generateCertificate(
+      const QString &path, int keyLength, deskflow::KeyType keyType = deskflow::KeyType::RSA
+  ) const;
   bool generateFingerprint(const QString &certificateFilename) const;
   int getCertKeyLength(const QString &path) const;
+  deskflow::KeyType getCertKeyType(const QString &path) const;
 };
@@ -38,16 +38,17 @@ bool TlsUtility::generateCertificate() const
     return false;
   }
 
+  const auto keyType = deskflow::keyTypeFromString(Settings::value(Settings::Security::KeyType).toString());
   auto length = Settings::value(Settings::Security::KeySize).toInt();
 
-  if (length < 2048) {
+  if (keyType == deskflow::KeyType::RSA && length < 2048) {
     length = 2048;
     qDebug("selected size too small setting certificate size to 2048");
     Settings::setValue(Settings::Security::KeySize, 2048);
   }
 
   const auto certificate = Settings::value(Settings::Security::Certificate).toString();
-  return m_certificate.generateCertificate(certificate, length);
+  return m_certificate.generateCertificate(certificate, length, keyType);
 }
 
 bool TlsUtility::persistCertificate() const
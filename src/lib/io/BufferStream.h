@@ -0,0 +1,84 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "io/IStream.h"
+#include "io/StreamBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+//! In-memory stream
+/*!
+Everything written can be read back in order, so protocol code can be
+tested and measured without sockets or threads.
+*/
+class BufferStream : public deskflow::IStream
+{
+public:
+  BufferStream() = default;
+  ~BufferStream() override = default;
+
+  // IStream overrides
+  void close() override
+  {
+    m_buffer.pop(m_buffer.getSize());
+  }
+
+  uint32_t read(void *buffer, uint32_t n) override
+  {
+    n = std::min(n, m_buffer.getSize());
+    if (buffer != nullptr && n > 0) {
+      memcpy(buffer, m_buffer.peek(n), n);
+    }
+    m_buffer.pop(n);
+    return n;
+  }
+
+  void write(const void *buffer, uint32_t n) override
+  {
+    m_buffer.write(buffer, n);
+  }
+
+  void writePacket(const deskflow::SharedPacket &packet) override
+  {
+    m_buffer.write(packet);
+  }
+
+  void flush() override
+  {
+    // do nothing
+  }
+
+  void shutdownInput() override
+  {
+    // do nothing
+  }
+
+  void shutdownOutput() override
+  {
+    // do nothing
+  }
+
+  void *getEventTarget() const override
+  {
+    return const_cast<BufferStream *>(this);
+  }
+
+  bool isReady() const override
+  {
+    return m_buffer.getSize() > 0;
+  }
+
+  uint32_t getSize() const override
+  {
+    return m_buffer.getSize();
+  }
+
+private:
+  StreamBuffer m_buffer;
+};
@@ -11,6 +11,7 @@
 #include "base/EventTypes.h"
 #include "base/IEventQueue.h"
 #include "common/IInterface.h"
+#include "io/SharedPacket.h"
 
 class IEventQueue;
 
@@ -55,6 +56,18 @@ public:
   */
   virtual void write(const void *buffer, uint32_t n) = 0;
 
+  //! Write a packet to stream
+  /*!
+  Write a packet that's already framed for the wire.  Packet streams
+  pass it through as it is rather than framing it again, and streams
+  that buffer output may queue a reference to it instead of a copy.
+  The default writes the packet's bytes with \c write().
+  */
+  virtual void writePacket(const SharedPacket &packet)
+  {
+    write(packet.getData(), packet.getSize());
+  }
+
   //! Flush the stream
   /*!
   Waits until all buffered data has been written to the stream.
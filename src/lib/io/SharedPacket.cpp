@@ -0,0 +1,54 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "io/SharedPacket.h"
+
+#include <cassert>
+
+namespace deskflow {
+
+//
+// SharedPacket
+//
+
+SharedPacket::SharedPacket(std::vector<uint8_t> &&packet)
+{
+  assert(packet.size() >= kHeaderSize);
+
+  const auto size = static_cast<uint32_t>(packet.size()) - kHeaderSize;
+  packet[0] = static_cast<uint8_t>((size >> 24) & 0xff);
+  packet[1] = static_cast<uint8_t>((size >> 16) & 0xff);
+  packet[2] = static_cast<uint8_t>((size >> 8) & 0xff);
+  packet[3] = static_cast<uint8_t>(size & 0xff);
+  m_packet = std::make_shared<const std::vector<uint8_t>>(std::move(packet));
+}
+
+const uint8_t *SharedPacket::getData() const
+{
+  return isEmpty() ? nullptr : m_packet->data();
+}
+
+uint32_t SharedPacket::getSize() const
+{
+  return isEmpty() ? 0 : static_cast<uint32_t>(m_packet->size());
+}
+
+const uint8_t *SharedPacket::getPayload() const
+{
+  return isEmpty() ? nullptr : m_packet->data() + kHeaderSize;
+}
+
+uint32_t SharedPacket::getPayloadSize() const
+{
+  return isEmpty() ? 0 : getSize() - kHeaderSize;
+}
+
+bool SharedPacket::isEmpty() const
+{
+  return m_packet == nullptr;
+}
+
+} // namespace deskflow
@@ -0,0 +1,71 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace deskflow {
+
+//! Encoded packet shared between streams
+/*!
+An immutable packet framed for the wire, a 4 byte length in network
+byte order followed by the payload.  Copies share the same bytes, so a
+message sent to many clients is encoded once and each stream that
+queues it holds a reference rather than its own copy.
+*/
+class SharedPacket
+{
+public:
+  //! Size of the length header at the start of a packet
+  static constexpr uint32_t kHeaderSize = 4;
+
+  SharedPacket() = default;
+
+  //! Frame an encoded packet
+  /*!
+  Takes ownership of \p packet, which must start with \c kHeaderSize
+  bytes reserved for the length header followed by the payload.  The
+  header is filled in here.
+  */
+  explicit SharedPacket(std::vector<uint8_t> &&packet);
+
+  //! @name accessors
+  //@{
+
+  //! Get the packet
+  /*!
+  Returns the framed packet, header first, as written to the wire.
+  */
+  const uint8_t *getData() const;
+
+  //! Get the size of the packet
+  /*!
+  Returns the size of the framed packet including the header.
+  */
+  uint32_t getSize() const;
+
+  //! Get the payload
+  /*!
+  Returns the packet's payload without the header.
+  */
+  const uint8_t *getPayload() const;
+
+  //! Get the size of the payload
+  uint32_t getPayloadSize() const;
+
+  //! Test for a default constructed packet
+  bool isEmpty() const;
+
+  //@}
+
+private:
+  std::shared_ptr<const std::vector<uint8_t>> m_packet;
+};
+
+} // namespace deskflow
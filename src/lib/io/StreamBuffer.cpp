@@ -24,19 +24,31 @@ const void *StreamBuffer::peek(uint32_t n)
     return nullptr;
   }
 
-  // reserve space in first chunk
+  // nothing to do if the first chunk already has n bytes
   auto head = m_chunks.begin();
-  head->reserve(n + m_headUsed);
+  if (head->size() - m_headUsed >= n) {
+    return static_cast<const void *>(head->data() + m_headUsed);
+  }
+
+  // a shared packet can't be added to, so copy what's left of it first
+  if (head->isShared()) {
+    head->m_bytes.assign(head->data() + m_headUsed, head->data() + head->size());
+    head->m_packet = {};
+    m_headUsed = 0;
+  }
+
+  // reserve space in first chunk
+  head->m_bytes.reserve(n + m_headUsed);
 
   // consolidate chunks into the first chunk until it has n bytes
   ChunkList::iterator scan = head;
   ++scan;
   while (head->size() - m_headUsed < n && scan != m_chunks.end()) {
-    head->insert(head->end(), scan->begin(), scan->end());
+    head->m_bytes.insert(head->m_bytes.end(), scan->data(), scan->data() + scan->size());
     scan = m_chunks.erase(scan);
   }
 
-  return static_cast<const void *>(&(head->begin()[m_headUsed]));
+  return static_cast<const void *>(head->data() + m_headUsed);
 }
 
 void StreamBuffer::pop(uint32_t n)
@@ -85,7 +97,7 @@ void StreamBuffer::write(const void *vdata, uint32_t n)
   auto scan = m_chunks.end();
   if (scan != m_chunks.begin()) {
     --scan;
-    if (scan->size() >= kChunkSize) {
+    if (scan->isShared() || scan->size() >= kChunkSize) {
       ++scan;
     }
   }
@@ -102,7 +114,7 @@ void StreamBuffer::write(const void *vdata, uint32_t n)
       count = n;
 
     // transfer data
-    scan->insert(scan->end(), data, data + count);
+    scan->m_bytes.insert(scan->m_bytes.end(), data, data + count);
     n -= count;
     data += count;
 
@@ -114,7 +126,39 @@ void StreamBuffer::write(const void *vdata, uint32_t n)
   }
 }
 
+void StreamBuffer::write(const deskflow::SharedPacket &packet)
+{
+  // small packets are cheaper to copy than to keep a chunk of their own
+  if (packet.getSize() < kChunkSize) {
+    write(packet.getData(), packet.getSize());
+    return;
+  }
+
+  m_size += packet.getSize();
+  m_chunks.push_back(Chunk{{}, packet});
+}
+
 uint32_t StreamBuffer::getSize() const
 {
   return m_size;
 }
+
+uint32_t StreamBuffer::getRunSize() const
+{
+  if (m_chunks.empty()) {
+    return 0;
+  }
+
+  // a shared packet at the front goes on its own
+  auto scan = m_chunks.begin();
+  uint32_t n = scan->size() - m_headUsed;
+  if (scan->isShared()) {
+    return n;
+  }
+
+  // otherwise everything up to the next shared packet
+  for (++scan; scan != m_chunks.end() && !scan->isShared(); ++scan) {
+    n += scan->size();
+  }
+  return n;
+}
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "base/EventTypes.h"
+#include "io/SharedPacket.h"
 
 #include <list>
 #include <vector>
@@ -46,6 +47,14 @@ public:
   */
   void write(const void *data, uint32_t n);
 
+  //! Write a packet to buffer
+  /*!
+  Appends \c packet to the buffer.  Packets of a chunk or more are
+  queued by reference rather than copied, so the same packet written to
+  many buffers is only held once.  Smaller packets are copied.
+  */
+  void write(const deskflow::SharedPacket &packet);
+
   //@}
   //! @name accessors
   //@{
@@ -56,12 +65,38 @@ public:
   */
   uint32_t getSize() const;
 
+  //! Get size of data that can be peeked without copying a packet
+  /*!
+  Returns the number of bytes at the front of the buffer that peek() can
+  return without copying a packet queued by reference:  the rest of that
+  packet if it's at the front, otherwise everything up to the next one.
+  */
+  uint32_t getRunSize() const;
+
   //@}
 
 private:
   static const uint32_t kChunkSize;
 
-  using Chunk = std::vector<uint8_t>;
+  // a chunk holds either bytes copied into the buffer or a shared packet
+  struct Chunk
+  {
+    std::vector<uint8_t> m_bytes;
+    deskflow::SharedPacket m_packet;
+
+    const uint8_t *data() const
+    {
+      return isShared() ? m_packet.getData() : m_bytes.data();
+    }
+    uint32_t size() const
+    {
+      return isShared() ? m_packet.getSize() : static_cast<uint32_t>(m_bytes.size());
+    }
+    bool isShared() const
+    {
+      return !m_packet.isEmpty();
+    }
+  };
   using ChunkList = std::list<Chunk>;
 
   ChunkList m_chunks;
@@ -46,6 +46,11 @@ void StreamFilter::write(const void *buffer, uint32_t n)
   getStream()->write(buffer, n);
 }
 
+void StreamFilter::writePacket(const deskflow::SharedPacket &packet)
+{
+  getStream()->writePacket(packet);
+}
+
 void StreamFilter::flush()
 {
   getStream()->flush();
@@ -83,5 +88,7 @@ deskflow::IStream *StreamFilter::getStream() const
 
 void StreamFilter::filterEvent(const Event &event)
 {
-  m_events->dispatchEvent(Event(event.getType(), getEventTarget(), event.getData()));
+  Event filtered(event.getType(), getEventTarget(), event.getData());
+  filtered.setTime(event.getTime());
+  m_events->dispatchEvent(filtered);
 }
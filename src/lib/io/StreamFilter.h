@@ -38,6 +38,7 @@ public:
   void close() override;
   uint32_t read(void *buffer, uint32_t n) override;
   void write(const void *buffer, uint32_t n) override;
+  void writePacket(const deskflow::SharedPacket &packet) override;
   void flush() override;
   void shutdownInput() override;
   void shutdownOutput() override;
@@ -0,0 +1,103 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/HandshakePool.h"
+
+#include <algorithm>
+
+namespace {
+
+// a handful of threads is enough to keep a burst of clients from queueing
+// behind one slow peer without competing with the rest of the process
+const std::size_t kMaxThreads = 4;
+
+// the owner of the task running on this thread, if it is a worker
+thread_local const void *t_owner = nullptr;
+
+} // namespace
+
+//
+// HandshakePool
+//
+
+HandshakePool::HandshakePool(std::size_t threads) : m_running(std::max<std::size_t>(threads, 1), nullptr)
+{
+  for (std::size_t i = 0; i < m_running.size(); ++i) {
+    m_threads.emplace_back([this, i] { work(i); });
+  }
+}
+
+HandshakePool::~HandshakePool()
+{
+  {
+    std::scoped_lock lock{m_mutex};
+    m_stopping = true;
+    m_queue.clear();
+  }
+  m_added.notify_all();
+
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+void HandshakePool::add(const void *owner, Task task)
+{
+  {
+    std::scoped_lock lock{m_mutex};
+    m_queue.push_back({owner, std::move(task)});
+  }
+  m_added.notify_one();
+}
+
+void HandshakePool::cancel(const void *owner)
+{
+  std::unique_lock lock{m_mutex};
+  std::erase_if(m_queue, [owner](const Entry &entry) { return entry.m_owner == owner; });
+
+  // a task may cancel its own owner, it can't wait for itself
+  if (t_owner == owner) {
+    return;
+  }
+
+  m_finished.wait(lock, [this, owner] { return std::ranges::find(m_running, owner) == m_running.end(); });
+}
+
+HandshakePool &HandshakePool::instance()
+{
+  static HandshakePool s_instance(std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, kMaxThreads));
+  return s_instance;
+}
+
+std::size_t HandshakePool::threads() const
+{
+  return m_threads.size();
+}
+
+void HandshakePool::work(std::size_t index)
+{
+  std::unique_lock lock{m_mutex};
+  for (;;) {
+    m_added.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+    if (m_stopping) {
+      return;
+    }
+
+    auto entry = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_running[index] = entry.m_owner;
+    t_owner = entry.m_owner;
+
+    lock.unlock();
+    entry.m_task();
+    entry.m_task = nullptr;
+    lock.lock();
+
+    m_running[index] = nullptr;
+    t_owner = nullptr;
+    m_finished.notify_all();
+  }
+}
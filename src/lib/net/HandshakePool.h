@@ -0,0 +1,84 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! TLS handshake worker pool
+/*!
+Runs the steps of TLS handshakes and the peer checks that follow them
+on a few worker threads, so that the private key operations and file
+reads of a new connection don't hold up the socket multiplexer thread
+and with it every established connection.
+
+Each task belongs to an owner, normally the socket it works on.  The
+tasks of one owner are expected to be added one at a time, with the
+next added only by the previous one or once it has finished.
+*/
+class HandshakePool
+{
+public:
+  using Task = std::function<void()>;
+
+  explicit HandshakePool(std::size_t threads);
+  HandshakePool(HandshakePool const &) = delete;
+  HandshakePool(HandshakePool &&) = delete;
+  ~HandshakePool();
+
+  HandshakePool &operator=(HandshakePool const &) = delete;
+  HandshakePool &operator=(HandshakePool &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Run \p task on a worker thread
+  void add(const void *owner, Task task);
+
+  //! Cancel the tasks of \p owner
+  /*!
+  Drops the tasks of \p owner that haven't started and waits for the one
+  that has, if any, to return.  Call before destroying the owner.  Must
+  not be called with a lock held that the owner's tasks take, other than
+  from a task of the same owner.
+  */
+  void cancel(const void *owner);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! The pool shared by all secure sockets
+  static HandshakePool &instance();
+
+  //! Number of worker threads
+  std::size_t threads() const;
+
+  //@}
+
+private:
+  struct Entry
+  {
+    const void *m_owner;
+    Task m_task;
+  };
+
+  void work(std::size_t index);
+
+  std::mutex m_mutex;
+  std::condition_variable m_added;
+  std::condition_variable m_finished;
+  std::deque<Entry> m_queue;
+  std::vector<const void *> m_running; //!< Owner of each worker's task
+  std::vector<std::thread> m_threads;
+  bool m_stopping = false;
+};
@@ -0,0 +1,317 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/SecureContext.h"
+
+#include "base/Log.h"
+#include "net/SslLogger.h"
+
+#include <openssl/err.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace {
+
+// the same on every server, so sessions can be resumed on any of them
+const unsigned char kSessionIdContext[] = "deskflow";
+
+// long enough to resume after a laptop sleeps for a while
+const long kSessionTimeout = 2 * 60 * 60;
+
+int verifyIgnoreCertCallback(X509_STORE_CTX *, void *)
+{
+  return 1;
+}
+
+void initLibrary()
+{
+  static std::once_flag s_once;
+  std::call_once(s_once, [] {
+    SSL_library_init();
+
+    // load & register all cryptos, etc.
+    OpenSSL_add_all_algorithms();
+
+    // load all error messages
+    SSL_load_error_strings();
+    SslLogger::logSecureLibInfo();
+  });
+}
+
+// the same cipher suites as openssl's defaults, in two orders.  aes-gcm is
+// fastest with aes instructions, chacha20 is faster without them, as on
+// the raspberry pi
+const char *const kAesFirstSuites = "TLS_AES_256_GCM_SHA384:TLS_AES_128_GCM_SHA256:TLS_CHACHA20_POLY1305_SHA256";
+const char *const kChaChaFirstSuites = "TLS_CHACHA20_POLY1305_SHA256:TLS_AES_256_GCM_SHA384:TLS_AES_128_GCM_SHA256";
+const char *const kAesFirstCiphers = "ECDHE+AESGCM:ECDHE+CHACHA20:ALL:!COMPLEMENTOFDEFAULT:!eNULL";
+const char *const kChaChaFirstCiphers = "ECDHE+CHACHA20:ECDHE+AESGCM:ALL:!COMPLEMENTOFDEFAULT:!eNULL";
+
+bool hasAesInstructions()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  return __builtin_cpu_supports("aes");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int info[4] = {};
+  __cpuid(info, 1);
+  return (info[2] & (1 << 25)) != 0;
+#elif defined(__aarch64__) && defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#elif defined(__aarch64__) && defined(__APPLE__)
+  // every apple arm cpu has the armv8 crypto extensions
+  return true;
+#else
+  return false;
+#endif
+}
+
+void preferFastCiphers(SSL_CTX *context, bool server)
+{
+  static const bool s_aes = [] {
+    const auto aes = hasAesInstructions();
+    LOG_DEBUG("aes instructions %s, preferring %s", aes ? "found" : "not found", aes ? "aes-gcm" : "chacha20");
+    return aes;
+  }();
+
+  SSL_CTX_set_ciphersuites(context, s_aes ? kAesFirstSuites : kChaChaFirstSuites);
+  SSL_CTX_set_cipher_list(context, s_aes ? kAesFirstCiphers : kChaChaFirstCiphers);
+
+  // the server picks from its own order, unless the client puts chacha20
+  // first because it has no aes instructions
+  if (server) {
+    SSL_CTX_set_options(context, SSL_OP_CIPHER_SERVER_PREFERENCE | SSL_OP_PRIORITIZE_CHACHA);
+  }
+}
+
+// marks an SSL object whose sessions may be saved, holds its context
+int trustedSessionIndex()
+{
+  static const int s_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return s_index;
+}
+
+} // namespace
+
+//
+// SecureContext
+//
+
+SecureContext::SecureContext(bool server, SecurityLevel securityLevel, const std::string &certificate, bool kernelTls)
+    : m_server{server},
+      m_securityLevel{securityLevel},
+      m_certificate{certificate},
+      m_kernelTls{kernelTls}
+{
+  initLibrary();
+
+  const SSL_METHOD *method = server ? SSLv23_server_method() : SSLv23_client_method();
+  m_context = SSL_CTX_new(method);
+  if (m_context == nullptr) {
+    SslLogger::logError();
+    return;
+  }
+
+  // Prevent the usage of of all version prior to TLSv1.2 as they are known to
+  // be vulnerable
+  SSL_CTX_set_options(m_context, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1 | SSL_OP_NO_TLSv1_1);
+
+  preferFastCiphers(m_context, server);
+
+  if (m_securityLevel == SecurityLevel::PeerAuth) {
+    // We want to ask for peer certificate, but not verify it. If we don't ask for peer
+    // certificate, e.g. client won't send it.
+    SSL_CTX_set_verify(m_context, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, nullptr);
+    SSL_CTX_set_cert_verify_callback(m_context, verifyIgnoreCertCallback, nullptr);
+  }
+
+  if (server) {
+    // session ids must have a context when peer certificates are requested
+    SSL_CTX_set_session_id_context(m_context, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+    SSL_CTX_set_timeout(m_context, kSessionTimeout);
+  } else {
+    // sessions are saved by hand, only once the server is trusted
+    SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(m_context, &SecureContext::handleNewSession);
+  }
+
+  // stamp before reading, so a change made while loading is seen next time
+  m_stamp = stamp(m_certificate);
+  m_loaded = loadCertificates();
+}
+
+SecureContext::~SecureContext()
+{
+  // SSL objects hold their own reference, so this only frees the context
+  // once the last socket using it is gone
+  SSL_SESSION_free(m_session);
+  SSL_CTX_free(m_context);
+}
+
+std::shared_ptr<const SecureContext> SecureContext::update(
+    const std::shared_ptr<const SecureContext> &current, bool server, SecurityLevel securityLevel,
+    const std::string &certificate, bool kernelTls
+)
+{
+  // a failed load is retried every time, as the file may have been fixed
+  if (current && current->isLoaded() && current->isServer() == server && current->securityLevel() == securityLevel &&
+      current->certificate() == certificate && current->isKernelTlsEnabled() == kernelTls && !current->isModified()) {
+    return current;
+  }
+
+  if (current && current->isLoaded() && current->certificate() == certificate) {
+    LOG_INFO("reloading tls certificate: %s", certificate.c_str());
+  }
+  return std::make_shared<const SecureContext>(server, securityLevel, certificate, kernelTls);
+}
+
+void SecureContext::resumeSession(SSL *ssl) const
+{
+  std::scoped_lock lock{m_sessionMutex};
+  if (m_session != nullptr) {
+    LOG_DEBUG1("offering saved tls session");
+    SSL_set_session(ssl, m_session);
+  }
+}
+
+void SecureContext::trustSession(SSL *ssl) const
+{
+  if (m_server) {
+    return;
+  }
+
+  SSL_set_ex_data(ssl, trustedSessionIndex(), const_cast<SecureContext *>(this));
+
+  // with tls 1.3 the session is only resumable once a ticket arrives
+  if (auto *session = SSL_get1_session(ssl); session != nullptr) {
+    if (SSL_SESSION_is_resumable(session)) {
+      saveSession(session);
+    } else {
+      SSL_SESSION_free(session);
+    }
+  }
+}
+
+void SecureContext::forgetSession() const
+{
+  saveSession(nullptr);
+}
+
+SSL_CTX *SecureContext::context() const
+{
+  return m_context;
+}
+
+bool SecureContext::isLoaded() const
+{
+  return m_loaded;
+}
+
+bool SecureContext::isModified() const
+{
+  return stamp(m_certificate) != m_stamp;
+}
+
+bool SecureContext::isKernelTlsEnabled() const
+{
+  return m_kernelTls;
+}
+
+bool SecureContext::isServer() const
+{
+  return m_server;
+}
+
+SecurityLevel SecureContext::securityLevel() const
+{
+  return m_securityLevel;
+}
+
+const std::string &SecureContext::certificate() const
+{
+  return m_certificate;
+}
+
+SecureContext::FileStamp SecureContext::stamp(const std::string &filename)
+{
+  FileStamp stamp;
+  if (filename.empty()) {
+    return stamp;
+  }
+
+  std::error_code error;
+  const auto path = std::filesystem::path(filename);
+  stamp.m_time = std::filesystem::last_write_time(path, error);
+  if (!error) {
+    stamp.m_size = std::filesystem::file_size(path, error);
+  }
+  stamp.m_exists = !error;
+  return stamp;
+}
+
+int SecureContext::handleNewSession(SSL *ssl, SSL_SESSION *session)
+{
+  const auto *context = static_cast<const SecureContext *>(SSL_get_ex_data(ssl, trustedSessionIndex()));
+  if (context == nullptr) {
+    // the server isn't trusted yet, let openssl free the session
+    return 0;
+  }
+
+  context->saveSession(session);
+  return 1;
+}
+
+void SecureContext::saveSession(SSL_SESSION *session) const
+{
+  // note -- takes the reference to session
+  std::scoped_lock lock{m_sessionMutex};
+  SSL_SESSION_free(m_session);
+  m_session = session;
+}
+
+bool SecureContext::loadCertificates()
+{
+  if (m_context == nullptr) {
+    return false;
+  }
+
+  if (m_certificate.empty()) {
+    SslLogger::logError("tls certificate is not specified");
+    return false;
+  }
+
+  if (!m_stamp.m_exists) {
+    std::string errorMsg("tls certificate doesn't exist: ");
+    errorMsg.append(m_certificate);
+    SslLogger::logError(errorMsg.c_str());
+    return false;
+  }
+
+  int r = 0;
+  r = SSL_CTX_use_certificate_file(m_context, m_certificate.c_str(), SSL_FILETYPE_PEM);
+  if (r <= 0) {
+    SslLogger::logError("could not use tls certificate");
+    return false;
+  }
+
+  r = SSL_CTX_use_PrivateKey_file(m_context, m_certificate.c_str(), SSL_FILETYPE_PEM);
+  if (r <= 0) {
+    SslLogger::logError("could not use tls private key");
+    return false;
+  }
+
+  r = SSL_CTX_check_private_key(m_context);
+  if (!r) {
+    SslLogger::logError("could not verify tls private key");
+    return false;
+  }
+
+  LOG_DEBUG("loaded tls certificate: %s", m_certificate.c_str());
+  return true;
+}
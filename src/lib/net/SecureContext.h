@@ -0,0 +1,121 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "net/SecurityLevel.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <openssl/ssl.h>
+#include <string>
+
+//! Shared TLS context
+/*!
+Holds an SSL_CTX with the certificate and private key already parsed, so
+that every secure socket with the same role can be created from it
+without touching the disk.  The context is immutable once loaded; when
+the certificate file changes a new context is built and sockets still
+using the old one keep it alive through their shared pointer.
+
+Server contexts cache sessions and issue session tickets, so a client
+that reconnects can resume its session with an abbreviated handshake.
+Client contexts keep the last session of a trusted server to offer on
+the next connection.  The peer certificate is part of the session, so
+the fingerprint of a resumed peer is checked just like a new one.
+
+Settings that sockets need during the handshake are read when the
+context is built, on the thread that owns the listener or factory, as
+handshakes run on the handshake pool where settings can't be read.
+*/
+class SecureContext
+{
+public:
+  SecureContext(bool server, SecurityLevel securityLevel, const std::string &certificate, bool kernelTls);
+  SecureContext(SecureContext const &) = delete;
+  SecureContext(SecureContext &&) = delete;
+  ~SecureContext();
+
+  SecureContext &operator=(SecureContext const &) = delete;
+  SecureContext &operator=(SecureContext &&) = delete;
+
+  //! Returns a context for \p certificate
+  /*!
+  Returns \p current if it was made for the same role, security level,
+  certificate and kernel tls setting, loaded it and the certificate file
+  hasn't changed since, otherwise builds and returns a new context.
+  */
+  static std::shared_ptr<const SecureContext> update(
+      const std::shared_ptr<const SecureContext> &current, bool server, SecurityLevel securityLevel,
+      const std::string &certificate, bool kernelTls
+  );
+
+  //! @name manipulators
+  //@{
+
+  //! Offer the saved session on \p ssl, for client contexts
+  void resumeSession(SSL *ssl) const;
+
+  //! Save sessions of \p ssl for resumption
+  /*!
+  Call once the peer of \p ssl is trusted.  Saves its session now if it
+  can be resumed, or later when the server sends a session ticket.
+  */
+  void trustSession(SSL *ssl) const;
+
+  //! Forget the saved session
+  void forgetSession() const;
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! The context to create SSL objects from
+  SSL_CTX *context() const;
+
+  //! Returns true if the certificate and private key were loaded
+  bool isLoaded() const;
+
+  //! Returns true if the certificate file changed since it was loaded
+  bool isModified() const;
+
+  //! Returns true if sockets should offer their keys to the kernel
+  bool isKernelTlsEnabled() const;
+
+  bool isServer() const;
+  SecurityLevel securityLevel() const;
+  const std::string &certificate() const;
+
+  //@}
+
+private:
+  struct FileStamp
+  {
+    bool m_exists = false;
+    std::filesystem::file_time_type m_time;
+    std::uintmax_t m_size = 0;
+
+    bool operator==(const FileStamp &) const = default;
+  };
+
+  static FileStamp stamp(const std::string &filename);
+  static int handleNewSession(SSL *ssl, SSL_SESSION *session);
+  bool loadCertificates();
+  void saveSession(SSL_SESSION *session) const;
+
+  const bool m_server;
+  const SecurityLevel m_securityLevel;
+  const std::string m_certificate;
+  const bool m_kernelTls;
+  SSL_CTX *m_context = nullptr;
+  FileStamp m_stamp;
+  bool m_loaded = false;
+
+  mutable std::mutex m_sessionMutex;
+  mutable SSL_SESSION *m_session = nullptr;
+};
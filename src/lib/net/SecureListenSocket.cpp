@@ -14,6 +14,7 @@
 #include "deskflow/ArgParser.h"
 #include "deskflow/ArgsBase.h"
 #include "net/NetworkAddress.h"
+#include "net/SecureContext.h"
 #include "net/SocketMultiplexer.h"
 #include "net/TSocketMultiplexerMethodJob.h"
 
@@ -39,7 +40,6 @@ std::unique_ptr<IDataSocket> SecureListenSocket::accept()
     socket = std::make_unique<SecureSocket>(
         m_events, m_socketMultiplexer, ARCH->acceptSocket(m_socket, nullptr), m_securityLevel
     );
-    socket->initSsl(true);
 
     setListeningJob();
 
@@ -51,10 +51,15 @@ std::unique_ptr<IDataSocket> SecureListenSocket::accept()
       certificateFilename = ArgParser::argsBase().m_tlsCertFile;
     }
 
-    if (!socket->loadCertificates(certificateFilename)) {
+    // the certificate is only parsed again when the file changes
+    const auto kernelTls = Settings::value(Settings::Security::KernelTls).toBool();
+    m_context = SecureContext::update(m_context, true, m_securityLevel, certificateFilename, kernelTls);
+    if (!m_context->isLoaded()) {
       return nullptr;
     }
 
+    socket->initSsl(m_context, Settings::tlsTrustedClientsDb());
+
     socket->secureAccept();
 
     return socket;
@@ -10,11 +10,13 @@
 #include "net/SecurityLevel.h"
 #include "net/TCPListenSocket.h"
 
+#include <memory>
 #include <set>
 
 class IEventQueue;
 class SocketMultiplexer;
 class IDataSocket;
+class SecureContext;
 
 class SecureListenSocket : public TCPListenSocket
 {
@@ -29,4 +31,5 @@ public:
 
 private:
   const SecurityLevel m_securityLevel;
+  std::shared_ptr<const SecureContext> m_context;
 };
@@ -12,17 +12,17 @@
 #include "base/Log.h"
 #include "base/Path.h"
 #include "base/String.h"
-#include "common/Settings.h"
+#include "base/Trace.h"
+#include "common/CoreStatus.h"
 #include "mt/Lock.h"
-#include "net/FingerprintDatabase.h"
+#include "net/HandshakePool.h"
+#include "net/SecureContext.h"
 #include "net/TCPSocket.h"
 #include "net/TSocketMultiplexerMethodJob.h"
+#include "net/TrustedFingerprints.h"
 #include <net/SslLogger.h>
 
-#include <cstdlib>
-#include <cstring>
-#include <fstream>
-#include <iterator>
+#include <algorithm>
 #include <memory>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
@@ -33,19 +33,13 @@
 //
 static const std::size_t s_maxInputBufferSize = 1024 * 1024;
 
-static const float s_retryDelay = 0.01f;
-
 struct Ssl
 {
-  SSL_CTX *m_context = nullptr;
+  std::shared_ptr<const SecureContext> m_context;
+  QString m_trustedFingerprints;
   SSL *m_ssl = nullptr;
 };
 
-static int verifyIgnoreCertCallback(X509_STORE_CTX *, void *)
-{
-  return 1;
-}
-
 SecureSocket::SecureSocket(
     IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family,
     SecurityLevel securityLevel
@@ -112,9 +106,8 @@ void SecureSocket::secureAccept()
 TCPSocket::JobResult SecureSocket::doRead()
 {
   using enum JobResult;
-  static uint8_t buffer[4096];
-  static const auto bufferSize = std::size(buffer);
-  memset(buffer, 0, bufferSize);
+  auto *buffer = m_readBuffer.data();
+  const auto bufferSize = static_cast<int>(m_readBuffer.size());
   int bytesRead = 0;
   int status = 0;
 
@@ -169,66 +162,44 @@ TCPSocket::JobResult SecureSocket::doRead()
 TCPSocket::JobResult SecureSocket::doWrite()
 {
   using enum JobResult;
-  static bool s_retry = false;
-  static int s_retrySize = 0;
-  static int s_staticBufferSize = 0;
-  static void *s_staticBuffer = nullptr;
-
-  // write data
-  int bufferSize = 0;
-  int bytesWrote = 0;
-  int status = 0;
 
-  if (s_retry) {
-    bufferSize = s_retrySize;
-  } else {
-    bufferSize = m_outputBuffer.getSize();
-    if (bufferSize != 0) {
-      if (bufferSize > s_staticBufferSize) {
-        s_staticBuffer = realloc(s_staticBuffer, bufferSize);
-        s_staticBufferSize = bufferSize;
-      }
-      memcpy(s_staticBuffer, m_outputBuffer.peek(bufferSize), bufferSize);
-    }
-  }
-
-  if (bufferSize == 0) {
+  if (m_outputBuffer.getSize() == 0 || !isSecureReady()) {
     return Retry;
   }
 
-  if (isSecureReady()) {
-    status = secureWrite(s_staticBuffer, bufferSize, bytesWrote);
-    if (status > 0) {
-      s_retry = false;
-      bufferSize = 0;
-    } else if (status < 0) {
+  // write up to a full record at a time, so small messages queued since
+  // the last write share a record and bulk data goes out in full ones.
+  // peek joins the buffer's chunks up to that size, but a shared packet
+  // is written from its own memory rather than copied to join it up.
+  // a retry never passes less than before since the front isn't popped.
+  while (m_outputBuffer.getSize() > 0) {
+    const auto bufferSize = std::min<uint32_t>(m_outputBuffer.getRunSize(), SSL3_RT_MAX_PLAIN_LENGTH);
+    int bytesWrote = 0;
+    const auto status = secureWrite(m_outputBuffer.peek(bufferSize), static_cast<int>(bufferSize), bytesWrote);
+    if (status < 0) {
       return Break;
     } else if (status == 0) {
-      s_retry = true;
-      s_retrySize = bufferSize;
+      // the retry may pass the same data at a new address, the buffer
+      // can move when more is written to it
       return New;
     }
-  } else {
-    return Retry;
-  }
 
-  if (bytesWrote > 0) {
     discardWrittenData(bytesWrote);
-    return New;
   }
 
-  return Retry;
+  return New;
 }
 
 int SecureSocket::secureRead(void *buffer, int size, int &read)
 {
+  TRACE_SCOPE_ARGS("net", "SecureSocket::secureRead", "size", size, "ktls", m_kernelTlsReceive);
   std::scoped_lock ssl_lock{ssl_mutex_};
 
   if (m_ssl->m_ssl != nullptr) {
     LOG((CLOG_DEBUG2 "reading secure socket"));
     read = SSL_read(m_ssl->m_ssl, buffer, size);
 
-    static int retry;
+    int retry = 0;
 
     // Check result will cleanup the connection in the case of a fatal
     checkResult(read, retry);
@@ -249,17 +220,21 @@ int SecureSocket::secureRead(void *buffer, int size, int &read)
 
 int SecureSocket::secureWrite(const void *buffer, int size, int &wrote)
 {
+  TRACE_SCOPE_ARGS("net", "SecureSocket::secureWrite", "size", size, "ktls", m_kernelTlsSend);
   std::scoped_lock ssl_lock{ssl_mutex_};
 
   if (m_ssl->m_ssl != nullptr) {
     LOG((CLOG_DEBUG2 "writing secure socket: %p", this));
 
-    wrote = SSL_write(m_ssl->m_ssl, buffer, size);
+    std::size_t written = 0;
+    const auto status = SSL_write_ex(m_ssl->m_ssl, buffer, size, &written);
+    wrote = static_cast<int>(written);
 
-    static int retry;
+    int retry = 0;
 
-    // Check result will cleanup the connection in the case of a fatal
-    checkResult(wrote, retry);
+    // Check result will cleanup the connection in the case of a fatal, it
+    // expects a failed write to be -1 as returned by SSL_write
+    checkResult(status == 1 ? wrote : -1, retry);
 
     if (retry) {
       return 0;
@@ -280,94 +255,18 @@ bool SecureSocket::isSecureReady() const
   return m_secureReady;
 }
 
-void SecureSocket::initSsl(bool server)
+bool SecureSocket::isKernelTls() const
 {
-  std::scoped_lock ssl_lock{ssl_mutex_};
-
-  m_ssl = std::make_unique<Ssl>();
-
-  initContext(server);
+  return m_kernelTlsSend || m_kernelTlsReceive;
 }
 
-bool SecureSocket::loadCertificates(const std::string &filename)
+void SecureSocket::initSsl(std::shared_ptr<const SecureContext> context, const QString &trustedFingerprints)
 {
   std::scoped_lock ssl_lock{ssl_mutex_};
 
-  if (filename.empty()) {
-    SslLogger::logError("tls certificate is not specified");
-    return false;
-  } else {
-    std::ifstream file(deskflow::filesystem::path(filename));
-    bool exist = file.good();
-    file.close();
-
-    if (!exist) {
-      std::string errorMsg("tls certificate doesn't exist: ");
-      errorMsg.append(filename);
-      SslLogger::logError(errorMsg.c_str());
-      return false;
-    }
-  }
-
-  int r = 0;
-  r = SSL_CTX_use_certificate_file(m_ssl->m_context, filename.c_str(), SSL_FILETYPE_PEM);
-  if (r <= 0) {
-    SslLogger::logError("could not use tls certificate");
-    return false;
-  }
-
-  r = SSL_CTX_use_PrivateKey_file(m_ssl->m_context, filename.c_str(), SSL_FILETYPE_PEM);
-  if (r <= 0) {
-    SslLogger::logError("could not use tls private key");
-    return false;
-  }
-
-  r = SSL_CTX_check_private_key(m_ssl->m_context);
-  if (!r) {
-    SslLogger::logError("could not verify tls private key");
-    return false;
-  }
-
-  return true;
-}
-
-void SecureSocket::initContext(bool server)
-{
-  SSL_library_init();
-
-  const SSL_METHOD *method;
-
-  // load & register all cryptos, etc.
-  OpenSSL_add_all_algorithms();
-
-  // load all error messages
-  SSL_load_error_strings();
-  SslLogger::logSecureLibInfo();
-
-  if (server) {
-    method = SSLv23_server_method();
-  } else {
-    method = SSLv23_client_method();
-  }
-
-  // create new context from method
-  const auto *m = const_cast<SSL_METHOD *>(method);
-  m_ssl->m_context = SSL_CTX_new(m);
-
-  // Prevent the usage of of all version prior to TLSv1.2 as they are known to
-  // be vulnerable
-  SSL_CTX_set_options(m_ssl->m_context, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1 | SSL_OP_NO_TLSv1_1);
-
-  if (m_ssl->m_context == nullptr) {
-    SslLogger::logError();
-  }
-
-  if (m_securityLevel == SecurityLevel::PeerAuth) {
-    // We want to ask for peer certificate, but not verify it. If we don't ask for peer
-    // certificate, e.g. client won't send it.
-    SSL_CTX_set_verify(m_ssl->m_context, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, nullptr);
-    SSL_CTX_set_cert_verify_callback(m_ssl->m_context, verifyIgnoreCertCallback, nullptr);
-  }
+  m_ssl = std::make_unique<Ssl>();
+  m_ssl->m_context = std::move(context);
+  m_ssl->m_trustedFingerprints = trustedFingerprints;
 }
 
 void SecureSocket::createSSL()
@@ -376,19 +275,47 @@ void SecureSocket::createSSL()
   // get new SSL state with context
   if (m_ssl->m_ssl == nullptr) {
     assert(m_ssl->m_context != nullptr);
-    m_ssl->m_ssl = SSL_new(m_ssl->m_context);
+    m_ssl->m_ssl = SSL_new(m_ssl->m_context->context());
+
+    // doWrite hands SSL_write_ex the output buffer as it is, which may be
+    // written in part and may move between retries
+    SSL_set_mode(m_ssl->m_ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+    // openssl hands the keys to the kernel after the handshake if it can,
+    // and quietly keeps encrypting itself if the tls module or cipher
+    // isn't supported
+    if (m_ssl->m_context->isKernelTlsEnabled()) {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+      SSL_set_options(m_ssl->m_ssl, SSL_OP_ENABLE_KTLS);
+#else
+      LOG((CLOG_DEBUG "kernel tls not supported by this openssl build"));
+#endif
+    }
+
+    // reconnecting clients resume the last session to skip the full handshake
+    if (!m_ssl->m_context->isServer()) {
+      m_ssl->m_context->resumeSession(m_ssl->m_ssl);
+    }
   }
 }
 
 void SecureSocket::freeSSL()
 {
-  std::scoped_lock ssl_lock{ssl_mutex_};
+  {
+    std::scoped_lock ssl_lock{ssl_mutex_};
 
-  isFatal(true);
-  // take socket from multiplexer ASAP otherwise the race condition
-  // could cause events to get called on a dead object. TCPSocket
-  // will do this, too, but the double-call is harmless
-  setJob(nullptr);
+    isFatal(true);
+    // take socket from multiplexer ASAP otherwise the race condition
+    // could cause events to get called on a dead object. TCPSocket
+    // will do this, too, but the double-call is harmless
+    setJob(nullptr);
+  }
+
+  // a handshake step on the pool won't give the socket back to the
+  // multiplexer now that it's fatal, wait for it before freeing
+  HandshakePool::instance().cancel(this);
+
+  std::scoped_lock ssl_lock{ssl_mutex_};
   if (m_ssl) {
     if (m_ssl->m_ssl != nullptr) {
       SSL_shutdown(m_ssl->m_ssl);
@@ -396,10 +323,8 @@ void SecureSocket::freeSSL()
       SSL_free(m_ssl->m_ssl);
       m_ssl->m_ssl = nullptr;
     }
-    if (m_ssl->m_context != nullptr) {
-      SSL_CTX_free(m_ssl->m_context);
-      m_ssl->m_context = nullptr;
-    }
+    m_kernelTlsSend = false;
+    m_kernelTlsReceive = false;
     m_ssl = nullptr;
   }
 }
@@ -416,39 +341,41 @@ int SecureSocket::secureAccept(int socket)
   LOG((CLOG_DEBUG2 "accepting secure socket"));
   int r = SSL_accept(m_ssl->m_ssl);
 
-  static int retry;
-
-  checkResult(r, retry);
+  checkResult(r, m_handshakeRetries);
 
   if (isFatal()) {
-    // tell user and sleep so the socket isn't hammered.
+    // tell user.  this runs on the handshake pool, so don't sleep here,
+    // it would hold up every other accept.  the job isn't added again
+    // after a fatal error so the socket won't be hammered anyway.
     LOG((CLOG_ERR "failed to accept secure socket"));
     LOG((CLOG_WARN "client connection may not be secure"));
     m_secureReady = false;
-    Arch::sleep(1);
-    retry = 0;
+    m_handshakeRetries = 0;
     return -1; // Failed, error out
   }
 
   // If not fatal and no retry, state is good
-  if (retry == 0) {
-    if (m_securityLevel == SecurityLevel::PeerAuth && !verifyCertFingerprint(Settings::tlsTrustedClientsDb())) {
-      retry = 0;
+  if (m_handshakeRetries == 0) {
+    if (m_securityLevel == SecurityLevel::PeerAuth && !verifyCertFingerprint()) {
+      m_handshakeRetries = 0;
       disconnect();
       return -1; // Fail
     }
     m_secureReady = true;
     LOG((CLOG_INFO "accepted secure socket"));
+    if (SSL_session_reused(m_ssl->m_ssl)) {
+      LOG((CLOG_DEBUG "resumed tls session"));
+    }
     SslLogger::logSecureCipherInfo(m_ssl->m_ssl);
     SslLogger::logSecureConnectInfo(m_ssl->m_ssl);
+    checkKernelTls();
     return 1;
   }
 
   // If not fatal and retry is set, not ready, and return retry
-  if (retry > 0) {
+  if (m_handshakeRetries > 0) {
     LOG((CLOG_DEBUG2 "retry accepting secure socket"));
     m_secureReady = false;
-    Arch::sleep(s_retryDelay);
     return 0;
   }
 
@@ -459,17 +386,15 @@ int SecureSocket::secureAccept(int socket)
 
 int SecureSocket::secureConnect(int socket)
 {
+  std::scoped_lock ssl_lock{ssl_mutex_};
 
-  std::string certDir = Settings::value(Settings::Security::Certificate).toString().toStdString();
-
-  if (!loadCertificates(certDir)) {
+  // the certificate is loaded once into the shared context, not per connection
+  if (!m_ssl->m_context->isLoaded()) {
     LOG((CLOG_ERR "could not load client certificates"));
     disconnect();
     return -1;
   }
 
-  std::scoped_lock ssl_lock{ssl_mutex_};
-
   createSSL();
 
   // attach the socket descriptor
@@ -482,28 +407,25 @@ int SecureSocket::secureConnect(int socket)
   // we'll probably need to find a way of securely transferring the cert.
   int r = SSL_connect(m_ssl->m_ssl);
 
-  static int retry;
-
-  checkResult(r, retry);
+  checkResult(r, m_handshakeRetries);
 
   if (isFatal()) {
     LOG((CLOG_ERR "failed to connect secure socket"));
-    retry = 0;
+    m_handshakeRetries = 0;
     return -1;
   }
 
   // If we should retry, not ready and return 0
-  if (retry > 0) {
+  if (m_handshakeRetries > 0) {
     LOG((CLOG_DEBUG2 "retry connect secure socket"));
     m_secureReady = false;
-    Arch::sleep(s_retryDelay);
     return 0;
   }
 
-  retry = 0;
+  m_handshakeRetries = 0;
   // No error, set ready, process and return ok
   m_secureReady = true;
-  if (verifyCertFingerprint(Settings::tlsTrustedServersDb())) {
+  if (verifyCertFingerprint()) {
     LOG((CLOG_INFO "connected to secure socket"));
     if (!showCertificate()) {
       disconnect();
@@ -511,12 +433,20 @@ int SecureSocket::secureConnect(int socket)
     }
   } else {
     LOG((CLOG_ERR "failed to verify server certificate fingerprint"));
+    m_ssl->m_context->forgetSession();
     disconnect();
     return -1; // Fingerprint failed, error
   }
+
+  // only a session with a trusted server is kept for resuming
+  m_ssl->m_context->trustSession(m_ssl->m_ssl);
+  if (SSL_session_reused(m_ssl->m_ssl)) {
+    LOG((CLOG_DEBUG "resumed tls session"));
+  }
   LOG((CLOG_DEBUG2 "connected secure socket"));
   SslLogger::logSecureCipherInfo(m_ssl->m_ssl);
   SslLogger::logSecureConnectInfo(m_ssl->m_ssl);
+  checkKernelTls();
   return 1;
 }
 
@@ -540,6 +470,28 @@ bool SecureSocket::showCertificate() const
   return true;
 }
 
+void SecureSocket::checkKernelTls()
+{
+  bool requested = false;
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  requested = (SSL_get_options(m_ssl->m_ssl) & SSL_OP_ENABLE_KTLS) != 0;
+  m_kernelTlsSend = BIO_get_ktls_send(SSL_get_wbio(m_ssl->m_ssl));
+  m_kernelTlsReceive = BIO_get_ktls_recv(SSL_get_rbio(m_ssl->m_ssl));
+#endif
+
+  if (m_kernelTlsSend && m_kernelTlsReceive) {
+    LOG((CLOG_INFO "tls offload: kernel"));
+  } else if (m_kernelTlsSend) {
+    LOG((CLOG_INFO "tls offload: kernel for sending, user space for receiving"));
+  } else if (m_kernelTlsReceive) {
+    LOG((CLOG_INFO "tls offload: kernel for receiving, user space for sending"));
+  } else if (requested) {
+    LOG((CLOG_INFO "tls offload: kernel tls unavailable, using user space"));
+  } else {
+    LOG((CLOG_DEBUG "tls offload: none, using user space"));
+  }
+}
+
 void SecureSocket::checkResult(int status, int &retry)
 {
   // ssl errors are a little quirky. the "want" errors are normal and
@@ -624,7 +576,7 @@ void SecureSocket::disconnect()
   sendEvent(StreamInputShutdown);
 }
 
-bool SecureSocket::verifyCertFingerprint(const QString &FingerprintDatabasePath) const
+bool SecureSocket::verifyCertFingerprint() const
 {
   const auto cert = SSL_get_peer_certificate(m_ssl->m_ssl);
   const auto sha256 = deskflow::sslCertFingerprint(cert, Fingerprint::Type::SHA256);
@@ -635,26 +587,20 @@ bool SecureSocket::verifyCertFingerprint(const QString &FingerprintDatabasePath)
   if (!sha256.isValid())
     return false;
 
-  // Gui Must Parse this line, DO NOT CHANGE
+  // older guis without the status channel parse this line, do not change it
   LOG((CLOG_NOTE "peer fingerprint: %s", deskflow::formatSSLFingerprint(sha256.data, false).toStdString().c_str()));
+  deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::PeerFingerprint, QString(), 0, sha256.data);
 
-  QFile file(FingerprintDatabasePath);
-
-  FingerprintDatabase db;
-  db.read(FingerprintDatabasePath);
-  const bool emptyDB = db.fingerprints().empty();
+  // the trusted fingerprints are only read again when the file changes
+  auto &trusted = TrustedFingerprints::forFile(m_ssl->m_trustedFingerprints);
+  const bool isTrusted = trusted.isTrusted(sha256);
 
-  const auto &path = FingerprintDatabasePath;
-  if (file.exists() && emptyDB) {
-    LOG((CLOG_ERR "failed to open trusted fingerprints file: %s", path.toStdString().c_str()));
+  if (trusted.exists() && trusted.count() == 0) {
+    LOG((CLOG_ERR "failed to open trusted fingerprints file: %s", trusted.path().toStdString().c_str()));
     return false;
   }
 
-  if (!emptyDB) {
-    LOG((CLOG_DEBUG "read %d fingerprint(s) from file: %s", db.fingerprints().size(), path.toStdString().c_str()));
-  }
-
-  if (!db.isTrusted(sha256)) {
+  if (!isTrusted) {
     LOG((CLOG_WARN "fingerprint does not match trusted fingerprint"));
     return false;
   }
@@ -663,59 +609,62 @@ bool SecureSocket::verifyCertFingerprint(const QString &FingerprintDatabasePath)
   return true;
 }
 
-ISocketMultiplexerJob *SecureSocket::serviceConnect(ISocketMultiplexerJob *job, bool, bool write, bool error)
+ISocketMultiplexerJob *SecureSocket::serviceConnect(ISocketMultiplexerJob *, bool, bool, bool)
+{
+  // the handshake step and the fingerprint check are too slow for the
+  // multiplexer thread, the pool hands the socket back once they're done
+  HandshakePool::instance().add(this, [this] { handshake(false); });
+  return nullptr;
+}
+
+ISocketMultiplexerJob *SecureSocket::serviceAccept(ISocketMultiplexerJob *, bool, bool, bool)
 {
+  HandshakePool::instance().add(this, [this] { handshake(true); });
+  return nullptr;
+}
+
+void SecureSocket::handshake(bool accept)
+{
+  // note -- runs on the handshake pool while the socket has no job
+
   Lock lock(&getMutex());
 
-  int status = 0;
+  int socket = 0;
 #ifdef SYSAPI_WIN32
-  status = secureConnect(static_cast<int>(getSocket()->m_socket));
+  socket = static_cast<int>(getSocket()->m_socket);
 #elif SYSAPI_UNIX
-  status = secureConnect(getSocket()->m_fd);
+  socket = getSocket()->m_fd;
 #endif
 
+  const int status = accept ? secureAccept(socket) : secureConnect(socket);
+
   // If status < 0, error happened
   if (status < 0) {
-    return nullptr;
+    return;
   }
 
   // If status > 0, success
   if (status > 0) {
-    sendEvent(EventTypes::DataSocketSecureConnected);
-    return newJob();
+    sendEvent(accept ? EventTypes::ClientListenerAccepted : EventTypes::DataSocketSecureConnected);
   }
 
-  // Retry case
-  return new TSocketMultiplexerMethodJob<SecureSocket>(
-      this, &SecureSocket::serviceConnect, getSocket(), isReadable(), isWritable()
-  );
-}
-
-ISocketMultiplexerJob *SecureSocket::serviceAccept(ISocketMultiplexerJob *job, bool, bool write, bool error)
-{
-  Lock lock(&getMutex());
-
-  int status = 0;
-#ifdef SYSAPI_WIN32
-  status = secureAccept(static_cast<int>(getSocket()->m_socket));
-#elif SYSAPI_UNIX
-  status = secureAccept(getSocket()->m_fd);
-#endif
-  // If status < 0, error happened
-  if (status < 0) {
-    return nullptr;
+  // the socket may have been closed meanwhile, freeSSL() marks it fatal
+  // before waiting for this step
+  std::scoped_lock ssl_lock{ssl_mutex_};
+  if (isFatal()) {
+    return;
   }
 
-  // If status > 0, success
   if (status > 0) {
-    sendEvent(EventTypes::ClientListenerAccepted);
-    return newJob();
+    setJob(newJob());
+    return;
   }
 
-  // Retry case
-  return new TSocketMultiplexerMethodJob<SecureSocket>(
-      this, &SecureSocket::serviceAccept, getSocket(), isReadable(), isWritable()
-  );
+  // Retry case, wait for the peer rather than polling a writable socket
+  const bool wantWrite = SSL_want_write(m_ssl->m_ssl);
+  setJob(new TSocketMultiplexerMethodJob<SecureSocket>(
+      this, accept ? &SecureSocket::serviceAccept : &SecureSocket::serviceConnect, getSocket(), !wantWrite, wantWrite
+  ));
 }
 
 void SecureSocket::handleTCPConnected(const Event &)
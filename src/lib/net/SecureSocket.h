@@ -12,6 +12,7 @@
 #include "net/TCPSocket.h"
 #include "net/XSocket.h"
 
+#include <array>
 #include <memory>
 #include <mutex>
 
@@ -19,6 +20,7 @@ class IEventQueue;
 class SocketMultiplexer;
 class ISocketMultiplexerJob;
 class QString;
+class SecureContext;
 
 struct Ssl;
 
@@ -60,31 +62,38 @@ public:
     m_fatal = b;
   }
   bool isSecureReady() const;
+  bool isKernelTls() const;
   void secureConnect();
   void secureAccept();
   int secureRead(void *buffer, int size, int &read);
   int secureWrite(const void *buffer, int size, int &wrote);
   JobResult doRead() override;
   JobResult doWrite() override;
-  void initSsl(bool server);
-  bool loadCertificates(const std::string &CertFile);
+  //! Set the context and the trusted fingerprints file to check the peer against
+  /*!
+  Call on the thread that owns the socket, as the handshake runs on the
+  handshake pool where settings can't be read.
+  */
+  void initSsl(std::shared_ptr<const SecureContext> context, const QString &trustedFingerprints);
 
 private:
   // SSL
-  void initContext(bool server);
   void createSSL();
   void freeSSL();
   int secureAccept(int s);
   int secureConnect(int s);
   bool showCertificate() const;
+  void checkKernelTls();
   void checkResult(int n, int &retry);
   void disconnect();
-  bool verifyCertFingerprint(const QString &FingerprintDatabasePath) const;
+  bool verifyCertFingerprint() const;
 
   ISocketMultiplexerJob *serviceConnect(ISocketMultiplexerJob *, bool, bool, bool);
 
   ISocketMultiplexerJob *serviceAccept(ISocketMultiplexerJob *, bool, bool, bool);
 
+  void handshake(bool accept);
+
   void handleTCPConnected(const Event &event);
 
 private:
@@ -94,7 +103,13 @@ private:
   std::mutex ssl_mutex_;
 
   std::unique_ptr<Ssl> m_ssl;
+  int m_handshakeRetries = 0;
   bool m_secureReady = false;
   bool m_fatal = false;
+  bool m_kernelTlsSend = false;
+  bool m_kernelTlsReceive = false;
   SecurityLevel m_securityLevel = SecurityLevel::Encrypted;
+
+  // large enough for a whole tls record
+  std::array<uint8_t, 16 * 1024> m_readBuffer{};
 };
@@ -36,6 +36,40 @@ const EVP_MD *digestForType(Fingerprint::Type type)
   throw std::runtime_error("Unknown fingerprint type " + std::to_string(static_cast<int>(type)));
 }
 
+EVP_PKEY *generateKey(int keyLength, KeyType keyType)
+{
+  switch (keyType) {
+  case KeyType::ECDSA:
+    return EVP_EC_gen("P-256");
+  case KeyType::Ed25519:
+    return EVP_PKEY_Q_keygen(nullptr, nullptr, "ED25519");
+  default:
+    return EVP_RSA_gen(keyLength);
+  }
+}
+
+// read the private key from a certificate file written by generatePemSelfSignedCert
+EVP_PKEY *readPrivateKey(const std::string &path)
+{
+  auto fp = fopenUtf8Path(path.c_str(), "r");
+  if (!fp) {
+    throw std::runtime_error("could not open certificate output path");
+  }
+
+  EVP_PKEY *privateKey = PEM_read_PrivateKey(fp, nullptr, nullptr, nullptr);
+
+  fclose(fp);
+
+  if (!privateKey) {
+    throw std::runtime_error("could not open certificate");
+  }
+  return privateKey;
+}
+
+const QString kKeyTypeRsa = QStringLiteral("rsa");
+const QString kKeyTypeEcdsa = QStringLiteral("ecdsa");
+const QString kKeyTypeEd25519 = QStringLiteral("ed25519");
+
 } // namespace
 
 QString formatSSLFingerprint(const QByteArray &fingerprint, bool enableSeparators)
@@ -80,18 +114,16 @@ Fingerprint pemFileCertFingerprint(const std::string &path, Fingerprint::Type ty
   return sslCertFingerprint(cert, type);
 }
 
-void generatePemSelfSignedCert(const std::string &path, int keyLength)
+void generatePemSelfSignedCert(const std::string &path, int keyLength, KeyType keyType)
 {
   auto expirationDays = 365;
 
-  auto *privateKey = EVP_PKEY_new();
+  auto *privateKey = generateKey(keyLength, keyType);
   if (!privateKey) {
-    throw std::runtime_error("could not allocate private key for certificate");
+    throw std::runtime_error("could not generate private key for certificate");
   }
   auto privateKeyFree = finally([privateKey]() { EVP_PKEY_free(privateKey); });
 
-  privateKey = EVP_RSA_gen(keyLength);
-
   auto *cert = X509_new();
   if (!cert) {
     throw std::runtime_error("could not allocate certificate");
@@ -107,7 +139,11 @@ void generatePemSelfSignedCert(const std::string &path, int keyLength)
   X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("Deskflow"), -1, -1, 0);
   X509_set_issuer_name(cert, name);
 
-  X509_sign(cert, privateKey, EVP_sha256());
+  // ed25519 signs the whole message itself and takes no digest
+  const auto *digest = keyType == KeyType::Ed25519 ? nullptr : EVP_sha256();
+  if (X509_sign(cert, privateKey, digest) <= 0) {
+    throw std::runtime_error("could not sign certificate");
+  }
 
   auto fp = fopenUtf8Path(path.c_str(), "w");
   if (!fp) {
@@ -121,30 +157,53 @@ void generatePemSelfSignedCert(const std::string &path, int keyLength)
 
 int getCertLength(const std::string &path)
 {
-  auto fp = fopenUtf8Path(path.c_str(), "r");
-  if (!fp) {
-    throw std::runtime_error("could not open certificate output path");
-    return -1;
-  }
+  auto *privateKey = readPrivateKey(path);
+  auto privateKeyFree = finally([privateKey]() { EVP_PKEY_free(privateKey); });
 
-  EVP_PKEY *privateKey = PEM_read_PrivateKey(fp, nullptr, nullptr, nullptr);
+  if (const auto id = EVP_PKEY_base_id(privateKey);
+      id != EVP_PKEY_RSA && id != EVP_PKEY_EC && id != EVP_PKEY_ED25519) {
+    throw std::runtime_error("not an RSA, ECDSA or Ed25519 key");
+  }
+  return EVP_PKEY_get_bits(privateKey);
+}
 
-  fclose(fp);
+KeyType getCertKeyType(const std::string &path)
+{
+  auto *privateKey = readPrivateKey(path);
+  auto privateKeyFree = finally([privateKey]() { EVP_PKEY_free(privateKey); });
 
-  if (!privateKey) {
-    throw std::runtime_error("could not open certificate");
-    return -1;
+  switch (EVP_PKEY_base_id(privateKey)) {
+  case EVP_PKEY_RSA:
+    return KeyType::RSA;
+  case EVP_PKEY_EC:
+    return KeyType::ECDSA;
+  case EVP_PKEY_ED25519:
+    return KeyType::Ed25519;
+  default:
+    throw std::runtime_error("not an RSA, ECDSA or Ed25519 key");
   }
+}
 
-  if (EVP_PKEY_base_id(privateKey) != EVP_PKEY_RSA) {
-    throw std::runtime_error("not an RSA key");
-    return -1;
+QString keyTypeToString(KeyType keyType)
+{
+  switch (keyType) {
+  case KeyType::ECDSA:
+    return kKeyTypeEcdsa;
+  case KeyType::Ed25519:
+    return kKeyTypeEd25519;
+  default:
+    return kKeyTypeRsa;
   }
-  int size = EVP_PKEY_get_bits(privateKey);
-
-  EVP_PKEY_free(privateKey);
+}
 
-  return size;
+KeyType keyTypeFromString(const QString &keyType)
+{
+  const auto type = keyType.toLower();
+  if (type == kKeyTypeEcdsa)
+    return KeyType::ECDSA;
+  if (type == kKeyTypeEd25519)
+    return KeyType::Ed25519;
+  return KeyType::RSA;
 }
 
 QString formatSSLFingerprintColumns(const QByteArray &fingerprint)
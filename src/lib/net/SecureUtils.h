@@ -16,6 +16,18 @@
 
 namespace deskflow {
 
+/**
+ * @brief The type of key a certificate is generated with
+ * ECDSA and Ed25519 keys make for much cheaper handshakes than RSA on slow
+ * machines, as signing with them costs a fraction of an RSA signature
+ */
+enum class KeyType
+{
+  RSA,
+  ECDSA, //!< NIST P-256
+  Ed25519
+};
+
 /**
  * @brief formatSSLFingerprint Format an ssl Fingerprint
  * @param fingerprint input string
@@ -30,9 +42,29 @@ Fingerprint sslCertFingerprint(const X509 *cert, Fingerprint::Type type);
 
 Fingerprint pemFileCertFingerprint(const std::string &path, Fingerprint::Type type);
 
-void generatePemSelfSignedCert(const std::string &path, int keyLength = 2048);
+/**
+ * @brief generatePemSelfSignedCert Write a new private key and self signed certificate
+ * @param path the file to write the key and certificate to
+ * @param keyLength the length of an RSA key in bits, other key types have a fixed length
+ * @param keyType the type of key to generate
+ */
+void generatePemSelfSignedCert(const std::string &path, int keyLength = 2048, KeyType keyType = KeyType::RSA);
 
 int getCertLength(const std::string &path);
 
+/**
+ * @brief getCertKeyType The type of the private key in a certificate file
+ * @throws std::runtime_error if the file can't be read or the key isn't of a supported type
+ */
+KeyType getCertKeyType(const std::string &path);
+
+QString keyTypeToString(KeyType keyType);
+
+/**
+ * @brief keyTypeFromString The key type named by a string from keyTypeToString
+ * @return KeyType::RSA if the name isn't known
+ */
+KeyType keyTypeFromString(const QString &keyType);
+
 QString generateFingerprintArt(const QByteArray &rawDigest);
 } // namespace deskflow
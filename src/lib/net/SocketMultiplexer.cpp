@@ -11,6 +11,7 @@
 #include "arch/XArch.h"
 #include "base/Log.h"
 #include "base/TMethodJob.h"
+#include "base/Trace.h"
 #include "mt/CondVar.h"
 #include "mt/Lock.h"
 #include "mt/Mutex.h"
@@ -195,9 +196,14 @@ void SocketMultiplexer::removeSocket(ISocket *socket)
 
           // run job
           ISocketMultiplexerJob *job = *jobCursor;
+          ISocketMultiplexerJob *newJob = nullptr;
+          {
+            TRACE_SCOPE_ARGS("net", "SocketMultiplexer::runJob", "read", read, "write", write);
+            newJob = job->run(read, write, error);
+          }
 
           // save job, if different
-          if (ISocketMultiplexerJob *newJob = job->run(read, write, error); newJob != job) {
+          if (newJob != job) {
             Lock lock(m_mutex);
             delete job;
             *jobCursor = newJob;
@@ -9,6 +9,7 @@
 #include <sstream>
 
 #include <base/Log.h>
+#include <common/CoreStatus.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 
@@ -107,11 +108,13 @@ void SslLogger::logSecureConnectInfo(const SSL *ssl)
       if (parts.size() > 2) {
         // log the section containing the protocol version
         LOG((CLOG_INFO "network encryption protocol: %s", parts[1].c_str()));
+        deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::SecureProtocol, QString::fromStdString(parts[1]));
       } else {
         // log the error in spliting then display the whole description rather
         // then nothing
         LOG((CLOG_ERR "could not split cipher for protocol"));
         LOG((CLOG_INFO "network encryption protocol: %s", msg));
+        deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::SecureProtocol, QString::fromUtf8(msg));
       }
     } else {
       LOG((CLOG_ERR "could not get secure socket cipher"));
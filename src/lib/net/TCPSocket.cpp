@@ -11,6 +11,7 @@
 #include "arch/XArch.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Trace.h"
 #include "mt/Lock.h"
 #include "net/NetworkAddress.h"
 #include "net/SocketMultiplexer.h"
@@ -138,33 +139,13 @@ uint32_t TCPSocket::read(void *buffer, uint32_t n)
 
 void TCPSocket::write(const void *buffer, uint32_t n)
 {
-  bool wasEmpty;
-  {
-    Lock lock(&m_mutex);
-
-    // must not have shutdown output
-    if (!m_writable) {
-      sendEvent(EventTypes::StreamOutputError);
-      return;
-    }
-
-    // ignore empty writes
-    if (n == 0) {
-      return;
-    }
-
-    // copy data to the output buffer
-    wasEmpty = (m_outputBuffer.getSize() == 0);
-    m_outputBuffer.write(buffer, n);
-
-    // there's data to write
-    m_flushed = false;
-  }
+  queueOutput(n, [this, buffer, n] { m_outputBuffer.write(buffer, n); });
+}
 
-  // make sure we're waiting to write
-  if (wasEmpty) {
-    setJob(newJob());
-  }
+void TCPSocket::writePacket(const deskflow::SharedPacket &packet)
+{
+  // queue the packet, shared with any other sockets sending it
+  queueOutput(packet.getSize(), [this, &packet] { m_outputBuffer.write(packet); });
 }
 
 void TCPSocket::flush()
@@ -296,8 +277,41 @@ void TCPSocket::init()
   }
 }
 
+void TCPSocket::queueOutput(uint32_t n, const std::function<void()> &append)
+{
+  bool wasEmpty;
+  {
+    Lock lock(&m_mutex);
+
+    // must not have shutdown output
+    if (!m_writable) {
+      sendEvent(EventTypes::StreamOutputError);
+      return;
+    }
+
+    // ignore empty writes
+    if (n == 0) {
+      return;
+    }
+
+    // copy data to the output buffer
+    wasEmpty = (m_outputBuffer.getSize() == 0);
+    append();
+
+    // there's data to write
+    m_flushed = false;
+  }
+
+  // make sure we're waiting to write
+  if (wasEmpty) {
+    setJob(newJob());
+  }
+}
+
 TCPSocket::JobResult TCPSocket::doRead()
 {
+  TRACE_SCOPE("net", "TCPSocket::doRead");
+
   uint8_t buffer[4096];
   memset(buffer, 0, sizeof(buffer));
   size_t bytesRead = 0;
@@ -340,11 +354,14 @@ TCPSocket::JobResult TCPSocket::doRead()
 
 TCPSocket::JobResult TCPSocket::doWrite()
 {
+  TRACE_SCOPE("net", "TCPSocket::doWrite");
+
   // write data
   uint32_t bufferSize = 0;
   int bytesWrote = 0;
 
-  bufferSize = m_outputBuffer.getSize();
+  // everything queued, short of copying a shared packet to join it up
+  bufferSize = m_outputBuffer.getRunSize();
   const void *buffer = m_outputBuffer.peek(bufferSize);
   bytesWrote = (uint32_t)ARCH->writeSocket(m_socket, buffer, bufferSize);
 
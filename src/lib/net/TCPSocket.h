@@ -13,6 +13,8 @@
 #include "mt/Mutex.h"
 #include "net/IDataSocket.h"
 
+#include <functional>
+
 class Mutex;
 class Thread;
 class ISocketMultiplexerJob;
@@ -46,6 +48,7 @@ public:
   // IStream overrides
   uint32_t read(void *buffer, uint32_t n) override;
   void write(const void *buffer, uint32_t n) override;
+  void writePacket(const deskflow::SharedPacket &packet) override;
   void flush() override;
   void shutdownInput() override;
   void shutdownOutput() override;
@@ -129,6 +132,7 @@ protected:
 
 private:
   void init();
+  void queueOutput(uint32_t n, const std::function<void()> &append);
 
   void sendConnectionFailedEvent(const char *);
   void onConnected();
@@ -9,6 +9,8 @@
 #include "net/TCPSocketFactory.h"
 #include "arch/Arch.h"
 #include "base/Log.h"
+#include "common/Settings.h"
+#include "net/SecureContext.h"
 #include "net/SecureListenSocket.h"
 #include "net/SecureSocket.h"
 #include "net/TCPListenSocket.h"
@@ -28,8 +30,12 @@ TCPSocketFactory::TCPSocketFactory(IEventQueue *events, SocketMultiplexer *socke
 IDataSocket *TCPSocketFactory::create(IArchNetwork::AddressFamily family, SecurityLevel securityLevel) const
 {
   if (securityLevel != SecurityLevel::PlainText) {
+    const auto certificate = Settings::value(Settings::Security::Certificate).toString().toStdString();
+    const auto kernelTls = Settings::value(Settings::Security::KernelTls).toBool();
+    m_clientContext = SecureContext::update(m_clientContext, false, securityLevel, certificate, kernelTls);
+
     auto *secureSocket = new SecureSocket(m_events, m_socketMultiplexer, family, securityLevel);
-    secureSocket->initSsl(false);
+    secureSocket->initSsl(m_clientContext, Settings::tlsTrustedServersDb());
     return secureSocket;
   } else {
     return new TCPSocket(m_events, m_socketMultiplexer, family);
@@ -11,7 +11,10 @@
 #include "arch/IArchNetwork.h"
 #include "net/ISocketFactory.h"
 
+#include <memory>
+
 class IEventQueue;
+class SecureContext;
 class SocketMultiplexer;
 
 //! Socket factory for TCP sockets
@@ -34,4 +37,8 @@ public:
 private:
   IEventQueue *m_events;
   SocketMultiplexer *m_socketMultiplexer;
+
+  // shared by the client sockets made by this factory, so reconnecting
+  // doesn't parse the certificate again
+  mutable std::shared_ptr<const SecureContext> m_clientContext;
 };
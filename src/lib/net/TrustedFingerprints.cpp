@@ -0,0 +1,104 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/TrustedFingerprints.h"
+
+#include "base/Log.h"
+#include "net/FingerprintDatabase.h"
+
+#include <QFileInfo>
+
+#include <map>
+#include <memory>
+
+//
+// TrustedFingerprints
+//
+
+TrustedFingerprints::TrustedFingerprints(const QString &path) : m_path{path}
+{
+  // do nothing
+}
+
+TrustedFingerprints &TrustedFingerprints::forFile(const QString &path)
+{
+  // there is one file for trusted clients and one for trusted servers, the
+  // stores live until exit so references to them stay valid
+  static std::mutex s_mutex;
+  static std::map<QString, std::unique_ptr<TrustedFingerprints>> s_stores;
+
+  std::scoped_lock lock{s_mutex};
+  auto &store = s_stores[path];
+  if (!store) {
+    store = std::make_unique<TrustedFingerprints>(path);
+  }
+  return *store;
+}
+
+bool TrustedFingerprints::isTrusted(const Fingerprint &fingerprint)
+{
+  std::scoped_lock lock{m_mutex};
+
+  // stamp before reading, so a change made while reading is seen next time
+  if (const auto current = stamp(); !m_loaded || current != m_stamp) {
+    m_stamp = current;
+    reload();
+  }
+
+  return fingerprint.type == Fingerprint::Type::SHA256 && m_sha256.contains(fingerprint.data);
+}
+
+qsizetype TrustedFingerprints::count() const
+{
+  std::scoped_lock lock{m_mutex};
+  return m_count;
+}
+
+bool TrustedFingerprints::exists() const
+{
+  std::scoped_lock lock{m_mutex};
+  return m_stamp.m_exists;
+}
+
+const QString &TrustedFingerprints::path() const
+{
+  return m_path;
+}
+
+TrustedFingerprints::FileStamp TrustedFingerprints::stamp() const
+{
+  const QFileInfo info(m_path);
+  FileStamp stamp;
+  stamp.m_exists = info.exists();
+  if (stamp.m_exists) {
+    stamp.m_time = info.lastModified();
+    stamp.m_size = info.size();
+  }
+  return stamp;
+}
+
+void TrustedFingerprints::reload()
+{
+  // note -- m_mutex must be locked on entry
+
+  m_loaded = true;
+  m_count = 0;
+  m_sha256.clear();
+  if (!m_stamp.m_exists) {
+    return;
+  }
+
+  FingerprintDatabase db;
+  db.read(m_path);
+  m_count = db.fingerprints().size();
+  for (const auto &fingerprint : db.fingerprints()) {
+    if (fingerprint.type == Fingerprint::Type::SHA256) {
+      m_sha256.insert(fingerprint.data);
+    }
+  }
+
+  LOG_DEBUG("read %d fingerprint(s) from file: %s", static_cast<int>(m_count), m_path.toStdString().c_str());
+}
@@ -0,0 +1,88 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "net/Fingerprint.h"
+
+#include <QDateTime>
+#include <QSet>
+#include <QString>
+
+#include <mutex>
+
+//! Trusted fingerprints file, kept in memory
+/*!
+Holds the SHA-256 fingerprints of a trusted fingerprints file in a hash
+set, so that checking a peer during a handshake doesn't read and parse
+the file each time.  The file is read again only when its modification
+time or size has changed, which costs a stat per check rather than a
+read, so fingerprints added or removed by the GUI take effect on the
+next handshake.  SHA-1 fingerprints from old files are not trusted, as
+peers are only ever checked by their SHA-256 fingerprint.
+
+The core has no Qt event loop to deliver file system watcher signals,
+which is why changes are found by checking the file rather than being
+notified of them.  Safe to use from any thread.
+*/
+class TrustedFingerprints
+{
+public:
+  explicit TrustedFingerprints(const QString &path);
+  TrustedFingerprints(TrustedFingerprints const &) = delete;
+  TrustedFingerprints(TrustedFingerprints &&) = delete;
+  ~TrustedFingerprints() = default;
+
+  TrustedFingerprints &operator=(TrustedFingerprints const &) = delete;
+  TrustedFingerprints &operator=(TrustedFingerprints &&) = delete;
+
+  //! The process wide store for the file at \p path
+  static TrustedFingerprints &forFile(const QString &path);
+
+  //! @name manipulators
+  //@{
+
+  //! Returns true if \p fingerprint is trusted
+  /*!
+  Reads the file again first if it has changed.
+  */
+  bool isTrusted(const Fingerprint &fingerprint);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Number of fingerprints of any type in the file as of the last check
+  qsizetype count() const;
+
+  //! Returns true if the file existed as of the last check
+  bool exists() const;
+
+  //! Path of the file
+  const QString &path() const;
+
+  //@}
+
+private:
+  struct FileStamp
+  {
+    bool m_exists = false;
+    QDateTime m_time;
+    qint64 m_size = 0;
+
+    bool operator==(const FileStamp &) const = default;
+  };
+
+  FileStamp stamp() const;
+  void reload();
+
+  const QString m_path;
+  mutable std::mutex m_mutex;
+  FileStamp m_stamp;
+  bool m_loaded = false;
+  qsizetype m_count = 0;
+  QSet<QByteArray> m_sha256;
+};
@@ -366,7 +366,8 @@ std::string EiClipboard::formatToMimeType(EFormat format) const
   case kText:
     return "text/plain;charset=utf-8";
   case kBitmap:
-    // Prefer PNG for lossless compression, fallback to other formats
+    return "image/bmp";
+  case kPNG:
     return "image/png";
   case kHTML:
     return "text/html;charset=utf-8";
@@ -382,7 +383,9 @@ std::vector<std::string> EiClipboard::formatToMimeTypes(EFormat format) const
   case kText:
     return {"text/plain;charset=utf-8", "text/plain", "UTF8_STRING", "STRING", "TEXT"};
   case kBitmap:
-    return {"image/png", "image/jpeg", "image/bmp", "image/tiff", "image/gif"};
+    return {"image/bmp", "image/jpeg", "image/tiff", "image/gif"};
+  case kPNG:
+    return {"image/png"};
   case kHTML:
     return {"text/html;charset=utf-8", "text/html", "application/xhtml+xml"};
   default:
@@ -414,7 +417,10 @@ EiClipboard::EFormat EiClipboard::mimeTypeToFormat(const std::string &mimeType)
     return kHTML;
   }
 
-  // Image formats
+  // Image formats, PNG is passed on as it is
+  if (normalizedType == "image/png") {
+    return kPNG;
+  }
   if (normalizedType.find("image/") == 0) {
     return kBitmap;
   }
@@ -647,6 +653,13 @@ bool EiClipboard::validateClipboardData(EFormat format, const std::string &data)
     break;
   }
 
+  case kPNG: {
+    if (data.substr(0, 8) != "\x89PNG\r\n\x1a\n") {
+      LOG_WARN("png data has unrecognized format");
+    }
+    break;
+  }
+
   default:
     break;
   }
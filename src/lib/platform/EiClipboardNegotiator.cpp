@@ -203,7 +203,7 @@ std::vector<FormatPreference> EiClipboardNegotiator::getDefaultPreferences()
       FormatPreference(IClipboard::kHTML, "application/xhtml+xml", 0.8, 0.6, true, 0.7),
 
       // Image formats (lossless first)
-      FormatPreference(IClipboard::kBitmap, "image/png", 1.0, 0.5, true, 0.9),
+      FormatPreference(IClipboard::kPNG, "image/png", 1.0, 0.5, true, 0.9),
       FormatPreference(IClipboard::kBitmap, "image/bmp", 0.9, 0.3, true, 0.8),
       FormatPreference(IClipboard::kBitmap, "image/tiff", 0.8, 0.4, true, 0.7),
       FormatPreference(IClipboard::kBitmap, "image/jpeg", 0.7, 0.8, false, 0.9),
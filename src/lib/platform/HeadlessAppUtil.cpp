@@ -0,0 +1,32 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/HeadlessAppUtil.h"
+
+namespace deskflow {
+
+int HeadlessAppUtil::run(int, char **)
+{
+  // there is no app to run
+  return 0;
+}
+
+void HeadlessAppUtil::startNode()
+{
+  // do nothing
+}
+
+std::vector<std::string> HeadlessAppUtil::getKeyboardLayoutList()
+{
+  return {"en"};
+}
+
+std::string HeadlessAppUtil::getCurrentLanguageCode()
+{
+  return "en";
+}
+
+} // namespace deskflow
@@ -0,0 +1,34 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/AppUtil.h"
+
+namespace deskflow {
+
+//! App utility for tools built around the headless screen
+/*!
+The client and server look up the keyboard languages through
+AppUtil::instance(), which is normally set up by the app.  Tools that
+run a client or server without an app create one of these instead.  It
+reports a single English layout, to match the US-like keymap of
+HeadlessKeyState.
+*/
+class HeadlessAppUtil : public AppUtil
+{
+public:
+  HeadlessAppUtil() = default;
+  ~HeadlessAppUtil() override = default;
+
+  // IAppUtil overrides
+  int run(int argc, char **argv) override;
+  void startNode() override;
+  std::vector<std::string> getKeyboardLayoutList() override;
+  std::string getCurrentLanguageCode() override;
+};
+
+} // namespace deskflow
@@ -0,0 +1,101 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/HeadlessKeyState.h"
+
+#include "base/Log.h"
+
+#include <cctype>
+
+namespace deskflow {
+
+// printable ascii keys use their code as button, shift sits above them
+static const KeyButton kShiftButton = 0x100;
+
+HeadlessKeyState::HeadlessKeyState(IEventQueue *events) : KeyState(events, {}, false)
+{
+  // do nothing
+}
+
+KeyButton HeadlessKeyState::buttonForKey(KeyID id)
+{
+  if (id == kKeyShift_L) {
+    return kShiftButton;
+  }
+  if (id >= 0x20 && id < 0x7f) {
+    return static_cast<KeyButton>(std::tolower(static_cast<int>(id)));
+  }
+  return 0;
+}
+
+bool HeadlessKeyState::fakeCtrlAltDel()
+{
+  return false;
+}
+
+KeyModifierMask HeadlessKeyState::pollActiveModifiers() const
+{
+  return m_pressed.contains(kShiftButton) ? KeyModifierShift : 0;
+}
+
+int32_t HeadlessKeyState::pollActiveGroup() const
+{
+  return 0;
+}
+
+void HeadlessKeyState::pollPressedKeys(KeyButtonSet &pressedKeys) const
+{
+  pressedKeys.insert(m_pressed.begin(), m_pressed.end());
+}
+
+void HeadlessKeyState::getKeyMap(KeyMap &keyMap)
+{
+  KeyMap::KeyItem item;
+  item.m_group = 0;
+  item.m_dead = false;
+  item.m_lock = false;
+  item.m_client = 0;
+
+  // shift modifier
+  item.m_id = kKeyShift_L;
+  item.m_button = kShiftButton;
+  item.m_required = 0;
+  item.m_sensitive = 0;
+  item.m_generates = KeyModifierShift;
+  keyMap.addKeyEntry(item);
+
+  // printable ascii, letters are sensitive to shift
+  item.m_generates = 0;
+  for (KeyID id = 0x20; id < 0x7f; ++id) {
+    item.m_id = id;
+    item.m_button = buttonForKey(id);
+    if (std::isalpha(static_cast<int>(id))) {
+      item.m_sensitive = KeyModifierShift;
+      item.m_required = std::isupper(static_cast<int>(id)) ? KeyModifierShift : 0;
+    } else {
+      item.m_sensitive = 0;
+      item.m_required = 0;
+    }
+    keyMap.addKeyEntry(item);
+  }
+}
+
+void HeadlessKeyState::fakeKey(const Keystroke &keystroke)
+{
+  if (keystroke.m_type != Keystroke::kButton) {
+    return;
+  }
+
+  const auto &button = keystroke.m_data.m_button;
+  LOG_DEBUG2("headless fake key: 0x%03x %s", button.m_button, button.m_press ? "down" : "up");
+  if (button.m_press) {
+    m_pressed.insert(button.m_button);
+  } else {
+    m_pressed.erase(button.m_button);
+  }
+}
+
+} // namespace deskflow
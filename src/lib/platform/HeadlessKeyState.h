@@ -0,0 +1,44 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/KeyState.h"
+
+namespace deskflow {
+
+//! Key state for the headless screen
+/*!
+Provides a small synthetic US-like keymap (printable ASCII plus shift) so
+that the regular KeyState/KeyMap machinery can be exercised without a
+display server.  Keystrokes are not sent anywhere, they only update the
+internal key state.
+*/
+class HeadlessKeyState : public KeyState
+{
+public:
+  explicit HeadlessKeyState(IEventQueue *events);
+  ~HeadlessKeyState() override = default;
+
+  //! Map a KeyID to the button used by the synthetic keymap
+  static KeyButton buttonForKey(KeyID id);
+
+  // IKeyState overrides
+  bool fakeCtrlAltDel() override;
+  KeyModifierMask pollActiveModifiers() const override;
+  int32_t pollActiveGroup() const override;
+  void pollPressedKeys(KeyButtonSet &pressedKeys) const override;
+
+protected:
+  // KeyState overrides
+  void getKeyMap(KeyMap &keyMap) override;
+  void fakeKey(const Keystroke &keystroke) override;
+
+private:
+  KeyButtonSet m_pressed;
+};
+
+} // namespace deskflow
@@ -0,0 +1,437 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/HeadlessScreen.h"
+
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "platform/HeadlessKeyState.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace deskflow {
+
+// synthesis timer period, events are generated in bursts to reach the rate
+static const double kSynthesisPeriod = 0.001;
+
+// most events a single synthesis tick may generate when catching up
+static const std::uint64_t kMaxBurst = 10000;
+
+static const std::size_t kNumButtons = 16;
+
+HeadlessScreen::HeadlessScreen(bool isPrimary, IEventQueue *events, int32_t width, int32_t height)
+    : PlatformScreen{events},
+      m_isPrimary{isPrimary},
+      m_events{events},
+      m_keyState{new HeadlessKeyState(events)},
+      m_w{width},
+      m_h{height},
+      m_xCursor{width / 2},
+      m_yCursor{height / 2},
+      m_isOnScreen{isPrimary},
+      m_buttons(kNumButtons, false)
+{
+  LOG_DEBUG("opened headless %s screen %dx%d", isPrimary ? "primary" : "secondary", width, height);
+}
+
+HeadlessScreen::~HeadlessScreen()
+{
+  stopSynthesis();
+  delete m_keyState;
+}
+
+void HeadlessScreen::synthesizeMouseMove(int32_t x, int32_t y)
+{
+  assert(m_isPrimary);
+  ++m_synthesized;
+  m_xCursor = x;
+  m_yCursor = y;
+  sendEvent(EventTypes::PrimaryScreenMotionOnPrimary, MotionInfo::alloc(x, y));
+}
+
+void HeadlessScreen::synthesizeMouseRelativeMove(int32_t dx, int32_t dy)
+{
+  assert(m_isPrimary);
+  if (m_isOnScreen) {
+    synthesizeMouseMove(m_xCursor + dx, m_yCursor + dy);
+  } else {
+    // a real screen would warp back to the center after each delta so
+    // the cursor position doesn't change while on a secondary screen
+    ++m_synthesized;
+    sendEvent(EventTypes::PrimaryScreenMotionOnSecondary, MotionInfo::alloc(dx, dy));
+  }
+}
+
+void HeadlessScreen::synthesizeMouseButton(ButtonID id, bool press)
+{
+  assert(m_isPrimary);
+  ++m_synthesized;
+  if (id < m_buttons.size()) {
+    m_buttons[id] = press;
+  }
+  auto type = press ? EventTypes::PrimaryScreenButtonDown : EventTypes::PrimaryScreenButtonUp;
+  sendEvent(type, ButtonInfo::alloc(id, m_keyState->getActiveModifiers()));
+}
+
+void HeadlessScreen::synthesizeMouseWheel(int32_t xDelta, int32_t yDelta)
+{
+  assert(m_isPrimary);
+  ++m_synthesized;
+  sendEvent(EventTypes::PrimaryScreenWheel, WheelInfo::alloc(xDelta, yDelta));
+}
+
+void HeadlessScreen::synthesizeKey(KeyID id, KeyModifierMask mask, bool press)
+{
+  assert(m_isPrimary);
+  ++m_synthesized;
+  const auto button = HeadlessKeyState::buttonForKey(id);
+  m_keyState->onKey(button, press, mask);
+  m_keyState->sendKeyEvent(getEventTarget(), press, false, id, mask, 1, button);
+}
+
+void HeadlessScreen::synthesizeClipboard(ClipboardID id, const std::string &text)
+{
+  assert(m_isPrimary);
+  assert(id < kClipboardEnd);
+  ++m_synthesized;
+
+  auto &clipboard = m_clipboards[id];
+  clipboard.open(0);
+  clipboard.empty();
+  clipboard.add(IClipboard::kText, text);
+  clipboard.close();
+
+  auto *info = static_cast<ClipboardInfo *>(malloc(sizeof(ClipboardInfo)));
+  info->m_id = id;
+  info->m_sequenceNumber = ++m_sequenceNumber;
+  sendEvent(EventTypes::ClipboardGrabbed, info);
+}
+
+void HeadlessScreen::startSynthesis(double rate, const Generator &generator)
+{
+  assert(rate > 0.0);
+  stopSynthesis();
+
+  m_rate = rate;
+  m_generator = generator;
+  m_generated = 0;
+  m_synthesisClock.reset();
+  m_synthesisTimer = m_events->newTimer(kSynthesisPeriod, nullptr);
+  m_events->addHandler(EventTypes::Timer, m_synthesisTimer, [this](const auto &) { handleSynthesisTimer(); });
+}
+
+void HeadlessScreen::stopSynthesis()
+{
+  if (m_synthesisTimer == nullptr) {
+    return;
+  }
+
+  m_events->removeHandler(EventTypes::Timer, m_synthesisTimer);
+  m_events->deleteTimer(m_synthesisTimer);
+  m_synthesisTimer = nullptr;
+  m_generator = nullptr;
+}
+
+void HeadlessScreen::handleSynthesisTimer()
+{
+  // work out how many events should have been generated by now so that
+  // the requested rate holds even when timer events get coalesced
+  const auto due = static_cast<std::uint64_t>(m_synthesisClock.getTime() * m_rate);
+  const auto count = std::min(due - std::min(due, m_generated), kMaxBurst);
+  for (std::uint64_t i = 0; i < count && m_generator; ++i) {
+    ++m_generated;
+    m_generator(*this);
+  }
+}
+
+void HeadlessScreen::setInjectHandler(const InjectHandler &handler)
+{
+  m_injectHandler = handler;
+}
+
+void HeadlessScreen::setRecording(bool enabled)
+{
+  m_recording = enabled;
+  if (!enabled) {
+    m_injected.clear();
+  }
+}
+
+std::vector<HeadlessScreen::InjectedEvent> HeadlessScreen::takeInjected()
+{
+  std::vector<InjectedEvent> injected;
+  injected.swap(m_injected);
+  return injected;
+}
+
+void HeadlessScreen::record(InjectedType type, int32_t x, int32_t y, KeyID key, std::size_t size) const
+{
+  InjectedEvent event;
+  event.m_type = type;
+  event.m_time = Clock::now();
+  event.m_x = x;
+  event.m_y = y;
+  event.m_key = key;
+  event.m_size = size;
+
+  if (m_recording) {
+    m_injected.push_back(event);
+  }
+  if (m_injectHandler) {
+    m_injectHandler(event);
+  }
+}
+
+void HeadlessScreen::sendEvent(EventTypes type, void *data)
+{
+  m_events->addEvent(Event(type, getEventTarget(), data));
+}
+
+void *HeadlessScreen::getEventTarget() const
+{
+  return const_cast<void *>(static_cast<const void *>(this));
+}
+
+bool HeadlessScreen::getClipboard(ClipboardID id, IClipboard *clipboard) const
+{
+  if (id >= kClipboardEnd || clipboard == nullptr) {
+    return false;
+  }
+  return Clipboard::copy(clipboard, &m_clipboards[id]);
+}
+
+void HeadlessScreen::getShape(int32_t &x, int32_t &y, int32_t &width, int32_t &height) const
+{
+  x = 0;
+  y = 0;
+  width = m_w;
+  height = m_h;
+}
+
+void HeadlessScreen::getCursorPos(int32_t &x, int32_t &y) const
+{
+  x = m_xCursor;
+  y = m_yCursor;
+}
+
+void HeadlessScreen::reconfigure(uint32_t activeSides)
+{
+  m_activeSides = activeSides;
+}
+
+uint32_t HeadlessScreen::activeSides()
+{
+  return m_activeSides;
+}
+
+void HeadlessScreen::warpCursor(int32_t x, int32_t y)
+{
+  m_xCursor = x;
+  m_yCursor = y;
+}
+
+uint32_t HeadlessScreen::registerHotKey(KeyID, KeyModifierMask)
+{
+  return m_nextHotKeyID++;
+}
+
+void HeadlessScreen::unregisterHotKey(uint32_t)
+{
+  // do nothing
+}
+
+void HeadlessScreen::fakeInputBegin()
+{
+  // do nothing
+}
+
+void HeadlessScreen::fakeInputEnd()
+{
+  // do nothing
+}
+
+int32_t HeadlessScreen::getJumpZoneSize() const
+{
+  return 1;
+}
+
+bool HeadlessScreen::isAnyMouseButtonDown(uint32_t &buttonID) const
+{
+  for (std::size_t i = 1; i < m_buttons.size(); ++i) {
+    if (m_buttons[i]) {
+      buttonID = static_cast<uint32_t>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+void HeadlessScreen::getCursorCenter(int32_t &x, int32_t &y) const
+{
+  x = m_w / 2;
+  y = m_h / 2;
+}
+
+void HeadlessScreen::fakeMouseButton(ButtonID id, bool press)
+{
+  if (id < m_buttons.size()) {
+    m_buttons[id] = press;
+  }
+  record(InjectedType::MouseButton, id, press ? 1 : 0);
+}
+
+void HeadlessScreen::fakeMouseMove(int32_t x, int32_t y)
+{
+  m_xCursor = x;
+  m_yCursor = y;
+  record(InjectedType::MouseMove, x, y);
+}
+
+void HeadlessScreen::fakeMouseRelativeMove(int32_t dx, int32_t dy) const
+{
+  record(InjectedType::MouseRelativeMove, dx, dy);
+}
+
+void HeadlessScreen::fakeMouseWheel(int32_t xDelta, int32_t yDelta) const
+{
+  record(InjectedType::MouseWheel, xDelta, yDelta);
+}
+
+void HeadlessScreen::fakeKeyDown(KeyID id, KeyModifierMask mask, KeyButton button, const std::string &lang)
+{
+  PlatformScreen::fakeKeyDown(id, mask, button, lang);
+  record(InjectedType::KeyDown, button, 1, id);
+}
+
+bool HeadlessScreen::fakeKeyRepeat(
+    KeyID id, KeyModifierMask mask, int32_t count, KeyButton button, const std::string &lang
+)
+{
+  const bool result = PlatformScreen::fakeKeyRepeat(id, mask, count, button, lang);
+  record(InjectedType::KeyRepeat, button, count, id);
+  return result;
+}
+
+bool HeadlessScreen::fakeKeyUp(KeyButton button)
+{
+  const bool result = PlatformScreen::fakeKeyUp(button);
+  record(InjectedType::KeyUp, button, 0);
+  return result;
+}
+
+void HeadlessScreen::enable()
+{
+  // do nothing
+}
+
+void HeadlessScreen::disable()
+{
+  stopSynthesis();
+}
+
+void HeadlessScreen::enter()
+{
+  m_isOnScreen = true;
+  if (!m_isPrimary) {
+    record(InjectedType::Enter, m_xCursor, m_yCursor);
+  }
+}
+
+bool HeadlessScreen::canLeave()
+{
+  return true;
+}
+
+void HeadlessScreen::leave()
+{
+  m_isOnScreen = false;
+  if (m_isPrimary) {
+    getCursorCenter(m_xCursor, m_yCursor);
+  } else {
+    record(InjectedType::Leave, m_xCursor, m_yCursor);
+  }
+}
+
+bool HeadlessScreen::setClipboard(ClipboardID id, const IClipboard *clipboard)
+{
+  if (id >= kClipboardEnd) {
+    return false;
+  }
+
+  std::size_t size = 0;
+  if (clipboard != nullptr) {
+    Clipboard::copy(&m_clipboards[id], clipboard);
+    if (m_clipboards[id].open(0)) {
+      size = m_clipboards[id].get(IClipboard::kText).size();
+      m_clipboards[id].close();
+    }
+  }
+  record(InjectedType::Clipboard, id, 0, kKeyNone, size);
+  return true;
+}
+
+void HeadlessScreen::checkClipboards()
+{
+  // do nothing, we always know when our clipboard changes
+}
+
+void HeadlessScreen::openScreensaver(bool)
+{
+  // do nothing
+}
+
+void HeadlessScreen::closeScreensaver()
+{
+  // do nothing
+}
+
+void HeadlessScreen::screensaver(bool)
+{
+  // do nothing
+}
+
+void HeadlessScreen::resetOptions()
+{
+  // do nothing
+}
+
+void HeadlessScreen::setOptions(const OptionsList &)
+{
+  // do nothing
+}
+
+void HeadlessScreen::setSequenceNumber(uint32_t seqNum)
+{
+  m_sequenceNumber = seqNum;
+}
+
+bool HeadlessScreen::isPrimary() const
+{
+  return m_isPrimary;
+}
+
+std::string HeadlessScreen::getSecureInputApp() const
+{
+  return "";
+}
+
+void HeadlessScreen::handleSystemEvent(const Event &)
+{
+  // there are no system events without a display
+}
+
+void HeadlessScreen::updateButtons()
+{
+  // do nothing
+}
+
+IKeyState *HeadlessScreen::getKeyState() const
+{
+  return m_keyState;
+}
+
+} // namespace deskflow
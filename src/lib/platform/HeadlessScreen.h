@@ -0,0 +1,212 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Stopwatch.h"
+#include "deskflow/Clipboard.h"
+#include "deskflow/PlatformScreen.h"
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+class EventQueueTimer;
+
+namespace deskflow {
+
+class HeadlessKeyState;
+
+//! Implementation of IPlatformScreen without a display
+/*!
+A screen that needs no display server.  As a primary screen it
+synthesizes input events (on demand or at a fixed rate) and posts them
+exactly like a real platform screen would.  As a secondary screen it
+records every injected event with a timestamp instead of forwarding it
+to a display.  This is used to benchmark the server to client path.
+*/
+class HeadlessScreen : public PlatformScreen
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class InjectedType
+  {
+    MouseMove,
+    MouseRelativeMove,
+    MouseButton,
+    MouseWheel,
+    KeyDown,
+    KeyRepeat,
+    KeyUp,
+    Clipboard,
+    Enter,
+    Leave
+  };
+
+  //! An input event injected into this screen
+  struct InjectedEvent
+  {
+    InjectedType m_type = InjectedType::MouseMove;
+    Clock::time_point m_time;
+    int32_t m_x = 0;        //!< Position, delta or button
+    int32_t m_y = 0;        //!< Position, delta or press state
+    KeyID m_key = kKeyNone; //!< Key for key events
+    std::size_t m_size = 0; //!< Size of clipboard data
+  };
+
+  using InjectHandler = std::function<void(const InjectedEvent &)>;
+  using Generator = std::function<void(HeadlessScreen &)>;
+
+  HeadlessScreen(bool isPrimary, IEventQueue *events, int32_t width = 1920, int32_t height = 1080);
+  ~HeadlessScreen() override;
+
+  //! @name manipulators
+  //@{
+
+  //! Post an absolute motion event (primary only)
+  void synthesizeMouseMove(int32_t x, int32_t y);
+
+  //! Post a relative motion event (primary only)
+  /*!
+  While the cursor is on this screen the delta is applied to the cursor
+  position, otherwise it is reported as motion on a secondary screen.
+  */
+  void synthesizeMouseRelativeMove(int32_t dx, int32_t dy);
+
+  //! Post a mouse button event (primary only)
+  void synthesizeMouseButton(ButtonID id, bool press);
+
+  //! Post a mouse wheel event (primary only)
+  void synthesizeMouseWheel(int32_t xDelta, int32_t yDelta);
+
+  //! Post a key event (primary only)
+  void synthesizeKey(KeyID id, KeyModifierMask mask, bool press);
+
+  //! Replace the clipboard with \p text and post a grab (primary only)
+  void synthesizeClipboard(ClipboardID id, const std::string &text);
+
+  //! Call \p generator \p rate times per second until stopped
+  void startSynthesis(double rate, const Generator &generator);
+
+  //! Stop a synthesis started by startSynthesis()
+  void stopSynthesis();
+
+  //! Set a handler called for every injected event
+  void setInjectHandler(const InjectHandler &handler);
+
+  //! Enable or disable keeping injected events in memory
+  void setRecording(bool enabled);
+
+  //! Return and clear the recorded injected events
+  std::vector<InjectedEvent> takeInjected();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Returns the number of events synthesized so far
+  std::uint64_t synthesizedCount() const
+  {
+    return m_synthesized;
+  }
+
+  //! Returns true while the cursor is on this screen
+  bool isOnScreen() const
+  {
+    return m_isOnScreen;
+  }
+
+  //@}
+
+  // IScreen overrides
+  void *getEventTarget() const final;
+  bool getClipboard(ClipboardID id, IClipboard *) const override;
+  void getShape(int32_t &x, int32_t &y, int32_t &width, int32_t &height) const override;
+  void getCursorPos(int32_t &x, int32_t &y) const override;
+
+  // IPrimaryScreen overrides
+  void reconfigure(uint32_t activeSides) override;
+  uint32_t activeSides() override;
+  void warpCursor(int32_t x, int32_t y) override;
+  uint32_t registerHotKey(KeyID key, KeyModifierMask mask) override;
+  void unregisterHotKey(uint32_t id) override;
+  void fakeInputBegin() override;
+  void fakeInputEnd() override;
+  int32_t getJumpZoneSize() const override;
+  bool isAnyMouseButtonDown(uint32_t &buttonID) const override;
+  void getCursorCenter(int32_t &x, int32_t &y) const override;
+
+  // ISecondaryScreen overrides
+  void fakeMouseButton(ButtonID id, bool press) override;
+  void fakeMouseMove(int32_t x, int32_t y) override;
+  void fakeMouseRelativeMove(int32_t dx, int32_t dy) const override;
+  void fakeMouseWheel(int32_t xDelta, int32_t yDelta) const override;
+
+  // IKeyState overrides
+  void fakeKeyDown(KeyID id, KeyModifierMask mask, KeyButton button, const std::string &lang) override;
+  bool fakeKeyRepeat(KeyID id, KeyModifierMask mask, int32_t count, KeyButton button, const std::string &lang) override;
+  bool fakeKeyUp(KeyButton button) override;
+
+  // IPlatformScreen overrides
+  void enable() override;
+  void disable() override;
+  void enter() override;
+  bool canLeave() override;
+  void leave() override;
+  bool setClipboard(ClipboardID, const IClipboard *) override;
+  void checkClipboards() override;
+  void openScreensaver(bool notify) override;
+  void closeScreensaver() override;
+  void screensaver(bool activate) override;
+  void resetOptions() override;
+  void setOptions(const OptionsList &options) override;
+  void setSequenceNumber(uint32_t) override;
+  bool isPrimary() const override;
+  std::string getSecureInputApp() const override;
+
+protected:
+  // IPlatformScreen overrides
+  void handleSystemEvent(const Event &event) override;
+  void updateButtons() override;
+  IKeyState *getKeyState() const override;
+
+private:
+  void sendEvent(EventTypes type, void *data = nullptr);
+  void record(InjectedType type, int32_t x, int32_t y, KeyID key = kKeyNone, std::size_t size = 0) const;
+  void handleSynthesisTimer();
+
+  bool m_isPrimary = false;
+  IEventQueue *m_events = nullptr;
+  HeadlessKeyState *m_keyState = nullptr;
+
+  int32_t m_w = 0;
+  int32_t m_h = 0;
+  int32_t m_xCursor = 0;
+  int32_t m_yCursor = 0;
+  bool m_isOnScreen = false;
+  uint32_t m_activeSides = 0;
+  uint32_t m_sequenceNumber = 0;
+  uint32_t m_nextHotKeyID = 1;
+  std::vector<bool> m_buttons;
+
+  Clipboard m_clipboards[kClipboardEnd];
+
+  // rate driven synthesis
+  EventQueueTimer *m_synthesisTimer = nullptr;
+  Generator m_generator;
+  double m_rate = 0.0;
+  Stopwatch m_synthesisClock;
+  std::uint64_t m_synthesized = 0;
+  std::uint64_t m_generated = 0;
+
+  // recording of injected events
+  InjectHandler m_injectHandler;
+  bool m_recording = true;
+  mutable std::vector<InjectedEvent> m_injected;
+};
+
+} // namespace deskflow
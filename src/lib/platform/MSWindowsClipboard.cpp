@@ -9,9 +9,11 @@
 
 #include "arch/win32/ArchMiscWindows.h"
 #include "base/Log.h"
+#include "deskflow/ClipboardImage.h"
 #include "platform/MSWindowsClipboardBitmapConverter.h"
 #include "platform/MSWindowsClipboardFacade.h"
 #include "platform/MSWindowsClipboardHTMLConverter.h"
+#include "platform/MSWindowsClipboardPNGConverter.h"
 #include "platform/MSWindowsClipboardTextConverter.h"
 #include "platform/MSWindowsClipboardUTF16Converter.h"
 
@@ -29,6 +31,7 @@ MSWindowsClipboard::MSWindowsClipboard(HWND window)
 {
   // add converters, most desired first
   m_converters.push_back(new MSWindowsClipboardUTF16Converter);
+  m_converters.push_back(new MSWindowsClipboardPNGConverter);
   m_converters.push_back(new MSWindowsClipboardBitmapConverter);
   m_converters.push_back(new MSWindowsClipboardHTMLConverter);
 }
@@ -112,6 +115,11 @@ void MSWindowsClipboard::add(EFormat format, const std::string &data)
   if (!isSucceeded) {
     LOG((CLOG_DEBUG "missed clipboard data convert for format: %d", format));
   }
+
+  // most windows apps only paste a DIB, so a PNG is offered as one too
+  if (format == kPNG && isSucceeded) {
+    add(kBitmap, ClipboardImage::pngToBitmap(data));
+  }
 }
 
 bool MSWindowsClipboard::open(Time time) const
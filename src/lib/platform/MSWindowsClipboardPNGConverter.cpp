@@ -0,0 +1,66 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/MSWindowsClipboardPNGConverter.h"
+
+#include "deskflow/ClipboardImage.h"
+
+//
+// MSWindowsClipboardPNGConverter
+//
+
+MSWindowsClipboardPNGConverter::MSWindowsClipboardPNGConverter()
+{
+  m_format = RegisterClipboardFormat("PNG");
+}
+
+IClipboard::EFormat MSWindowsClipboardPNGConverter::getFormat() const
+{
+  return IClipboard::kPNG;
+}
+
+UINT MSWindowsClipboardPNGConverter::getWin32Format() const
+{
+  return m_format;
+}
+
+HANDLE
+MSWindowsClipboardPNGConverter::fromIClipboard(const std::string &data) const
+{
+  // copy to memory handle
+  HGLOBAL gData = GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, data.size());
+  if (gData != nullptr) {
+    // get a pointer to the allocated memory
+    char *dst = (char *)GlobalLock(gData);
+    if (dst != nullptr) {
+      memcpy(dst, data.data(), data.size());
+      GlobalUnlock(gData);
+    } else {
+      GlobalFree(gData);
+      gData = nullptr;
+    }
+  }
+
+  return gData;
+}
+
+std::string MSWindowsClipboardPNGConverter::toIClipboard(HANDLE data) const
+{
+  LPVOID src = GlobalLock(data);
+  if (src == nullptr) {
+    return std::string();
+  }
+
+  // the handle may be rounded up in size, but trailing bytes after the
+  // IEND chunk are ignored when the PNG is read
+  std::string png(static_cast<const char *>(src), GlobalSize(data));
+  GlobalUnlock(data);
+
+  if (!ClipboardImage::isPNG(png)) {
+    return std::string();
+  }
+  return png;
+}
@@ -0,0 +1,30 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "platform/MSWindowsClipboard.h"
+
+//! Convert to/from PNG
+/*!
+Uses the registered "PNG" format that browsers and image editors put on
+the clipboard next to a DIB.
+*/
+class MSWindowsClipboardPNGConverter : public IMSWindowsClipboardConverter
+{
+public:
+  MSWindowsClipboardPNGConverter();
+  ~MSWindowsClipboardPNGConverter() override = default;
+
+  // IMSWindowsClipboardConverter overrides
+  IClipboard::EFormat getFormat() const override;
+  UINT getWin32Format() const override;
+  HANDLE fromIClipboard(const std::string &) const override;
+  std::string toIClipboard(HANDLE) const override;
+
+private:
+  UINT m_format;
+};
@@ -12,6 +12,7 @@
 #include "deskflow/Clipboard.h"
 #include "platform/OSXClipboardBMPConverter.h"
 #include "platform/OSXClipboardHTMLConverter.h"
+#include "platform/OSXClipboardPNGConverter.h"
 #include "platform/OSXClipboardTextConverter.h"
 #include "platform/OSXClipboardUTF16Converter.h"
 #include "platform/OSXClipboardUTF8Converter.h"
@@ -23,6 +24,7 @@
 OSXClipboard::OSXClipboard() : m_time(0), m_pboard(nullptr)
 {
   m_converters.push_back(new OSXClipboardHTMLConverter);
+  m_converters.push_back(new OSXClipboardPNGConverter);
   m_converters.push_back(new OSXClipboardBMPConverter);
   m_converters.push_back(new OSXClipboardUTF8Converter);
   m_converters.push_back(new OSXClipboardUTF16Converter);
@@ -88,6 +90,8 @@ void OSXClipboard::add(EFormat format, const std::string &data)
     LOG((CLOG_DEBUG "format of data to be added to clipboard was kBitmap"));
   } else if (format == IClipboard::kHTML) {
     LOG((CLOG_DEBUG "format of data to be added to clipboard was kHTML"));
+  } else if (format == IClipboard::kPNG) {
+    LOG((CLOG_DEBUG "format of data to be added to clipboard was kPNG"));
   }
 
   for (ConverterList::const_iterator index = m_converters.begin(); index != m_converters.end(); ++index) {
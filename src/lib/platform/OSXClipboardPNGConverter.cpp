@@ -0,0 +1,36 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/OSXClipboardPNGConverter.h"
+
+#include "deskflow/ClipboardImage.h"
+
+//
+// OSXClipboardPNGConverter
+//
+
+IClipboard::EFormat OSXClipboardPNGConverter::getFormat() const
+{
+  return IClipboard::kPNG;
+}
+
+CFStringRef OSXClipboardPNGConverter::getOSXFormat() const
+{
+  return CFSTR("public.png");
+}
+
+std::string OSXClipboardPNGConverter::fromIClipboard(const std::string &png) const
+{
+  return png;
+}
+
+std::string OSXClipboardPNGConverter::toIClipboard(const std::string &png) const
+{
+  if (!ClipboardImage::isPNG(png)) {
+    return std::string();
+  }
+  return png;
+}
@@ -13,6 +13,7 @@
 #include "common/Common.h"
 #include "platform/XWindowsClipboardBMPConverter.h"
 #include "platform/XWindowsClipboardHTMLConverter.h"
+#include "platform/XWindowsClipboardPNGConverter.h"
 #include "platform/XWindowsClipboardTextConverter.h"
 #include "platform/XWindowsClipboardUCS2Converter.h"
 #include "platform/XWindowsClipboardUTF8Converter.h"
@@ -24,6 +25,10 @@
 #include <cstring>
 #include <vector>
 
+// how long a selection owner may go without making progress on a
+// conversion before we give up on it
+static const double s_selectionTimeout = 0.25; // FIXME -- is this too short?
+
 //
 // XWindowsClipboard
 //
@@ -61,6 +66,7 @@ XWindowsClipboard::XWindowsClipboard(Display *display, Window window, ClipboardI
   // add converters, most desired first
   m_converters.push_back(new XWindowsClipboardHTMLConverter(m_display, "text/html"));
   m_converters.push_back(new XWindowsClipboardHTMLConverter(m_display, "application/x-moz-nativehtml"));
+  m_converters.push_back(new XWindowsClipboardPNGConverter(m_display));
   m_converters.push_back(new XWindowsClipboardBMPConverter(m_display));
   m_converters.push_back(new XWindowsClipboardUTF8Converter(m_display, "text/plain;charset=UTF-8", true));
   m_converters.push_back(new XWindowsClipboardUTF8Converter(m_display, "text/plain;charset=utf-8", true));
@@ -284,6 +290,13 @@ bool XWindowsClipboard::open(Time time) const
 
   LOG((CLOG_DEBUG "open clipboard %d", m_id));
 
+  // the data is needed now, so the conversions are made again below
+  // rather than waiting on a fetch that hasn't finished
+  if (!m_fetches.empty()) {
+    LOG((CLOG_DEBUG1 "abandoning clipboard %d fetch", m_id));
+    const_cast<XWindowsClipboard *>(this)->m_fetches.clear();
+  }
+
   // assume not motif
   m_motif = false;
 
@@ -349,6 +362,129 @@ std::string XWindowsClipboard::get(EFormat format) const
   return m_data[format];
 }
 
+void XWindowsClipboard::fetch(::Time time)
+{
+  m_fetches.clear();
+
+  // the motif clipboard is read from properties on the root window,
+  // there's no selection owner to wait on
+  if (m_id == kClipboardClipboard && motifOwnsClipboard()) {
+    return;
+  }
+
+  LOG((CLOG_DEBUG "fetch clipboard %d", m_id));
+
+  // the replies arrive as events for our window, which we leave
+  // selected for property changes as we own it
+  XWindowAttributes attr;
+  XGetWindowAttributes(m_display, m_window, &attr);
+  if ((attr.your_event_mask & PropertyChangeMask) == 0) {
+    XSelectInput(m_display, m_window, attr.your_event_mask | PropertyChangeMask);
+  }
+
+  // ask for the timestamp and every format at once, each into its own
+  // property.  the timestamp tells a later open() whether the data is
+  // still current.
+  static const int buffer_size = 32;
+  char name[buffer_size];
+  std::vector<const IXWindowsClipboardConverter *> converters{nullptr};
+  converters.insert(converters.end(), m_converters.begin(), m_converters.end());
+  for (const auto *converter : converters) {
+    snprintf(name, buffer_size, "CLIP_TEMPORARY_%d_%d", m_id, static_cast<int>(m_fetches.size()));
+    const Atom property = XInternAtom(m_display, name, False);
+    const Atom target = converter == nullptr ? m_atomTimestamp : converter->getAtom();
+
+    auto &fetch = m_fetches.emplace_back(std::make_unique<Fetch>(m_window, time, property, converter));
+    fetch->m_getter.request(m_display, m_selection, target, &fetch->m_actualTarget, &fetch->m_data);
+  }
+  XFlush(m_display);
+
+  m_fetchProgress.reset();
+}
+
+bool XWindowsClipboard::processFetchEvent(const XEvent *xevent)
+{
+  const bool processed = std::ranges::any_of(m_fetches, [this, xevent](const auto &fetch) {
+    return !fetch->m_getter.isDone() && fetch->m_getter.processEvent(m_display, xevent);
+  });
+  if (!processed) {
+    return false;
+  }
+
+  // reset timer since we've made some progress
+  m_fetchProgress.reset();
+  if (std::ranges::all_of(m_fetches, [](const auto &fetch) { return fetch->m_getter.isDone(); })) {
+    finishFetch();
+  }
+  return true;
+}
+
+bool XWindowsClipboard::checkFetchTimeout()
+{
+  if (m_fetches.empty() || m_fetchProgress.getTime() < s_selectionTimeout) {
+    return false;
+  }
+
+  LOG((CLOG_DEBUG1 "clipboard %d fetch timed out", m_id));
+  finishFetch();
+  return true;
+}
+
+bool XWindowsClipboard::isFetching() const
+{
+  return !m_fetches.empty();
+}
+
+void XWindowsClipboard::finishFetch()
+{
+  const FetchList fetches = std::move(m_fetches);
+  m_fetches.clear();
+
+  // without the owner's timestamp there's no telling if the data is
+  // current when the clipboard is next opened, so it can't be cached
+  const Fetch &timestamp = *fetches.front();
+  if (!timestamp.m_getter.isDone() || timestamp.m_getter.failed() || timestamp.m_actualTarget != m_atomInteger ||
+      timestamp.m_data.size() < sizeof(Time)) {
+    LOG((CLOG_DEBUG1 "can't get ICCCM time, not caching clipboard %d", m_id));
+    return;
+  }
+  Time time;
+  std::memcpy(&time, timestamp.m_data.data(), sizeof(time));
+
+  // the fetches are in the converters' order of preference
+  doClearCache();
+  for (auto index = fetches.begin() + 1; index != fetches.end(); ++index) {
+    const Fetch &fetch = **index;
+    const IXWindowsClipboardConverter *converter = fetch.m_converter;
+    const Atom target = converter->getAtom();
+
+    // skip already handled targets
+    IClipboard::EFormat format = converter->getFormat();
+    if (isAdded(format)) {
+      continue;
+    }
+
+    if (!fetch.m_getter.isDone() || fetch.m_getter.failed() || fetch.m_actualTarget == None) {
+      LOG((CLOG_DEBUG1 "  no data for target %s", XWindowsUtil::atomToString(m_display, target).c_str()));
+      continue;
+    }
+
+    // add to clipboard and note we've done it
+    m_data[format] = converter->toIClipboard(fetch.m_data);
+    m_added[format] = true;
+    LOG(
+        (CLOG_DEBUG "added format %d for target %s (%u %s)", format,
+         XWindowsUtil::atomToString(m_display, target).c_str(), fetch.m_data.size(),
+         fetch.m_data.size() == 1 ? "byte" : "bytes")
+    );
+  }
+
+  LOG((CLOG_DEBUG "fetched clipboard %d at ICCCM time %d", m_id, time));
+  m_timeOwned = time;
+  m_cached = true;
+  m_cacheTime = time;
+}
+
 void XWindowsClipboard::clearConverters()
 {
   for (auto index = m_converters.begin(); index != m_converters.end(); ++index) {
@@ -380,6 +516,16 @@ IXWindowsClipboardConverter *XWindowsClipboard::getConverter(Atom target, bool o
   return converter;
 }
 
+bool XWindowsClipboard::isAdded(EFormat format) const
+{
+  // a peer is only sent one image format, and an older peer's bitmap can
+  // be decoded from the PNG, so the owner needn't convert it to a bitmap
+  if (format == kBitmap && m_added[kPNG]) {
+    return true;
+  }
+  return m_added[format];
+}
+
 void XWindowsClipboard::checkCache() const
 {
   if (!m_checkCache) {
@@ -470,7 +616,7 @@ void XWindowsClipboard::icccmFillCache()
     const IXWindowsClipboardConverter *converter = *index;
 
     // skip already handled targets
-    if (m_added[converter->getFormat()]) {
+    if (isAdded(converter->getFormat())) {
       continue;
     }
 
@@ -695,7 +841,7 @@ void XWindowsClipboard::motifFillCache()
     const IXWindowsClipboardConverter *converter = *index;
 
     // skip already handled targets
-    if (m_added[converter->getFormat()]) {
+    if (isAdded(converter->getFormat())) {
       continue;
     }
 
@@ -1157,35 +1303,13 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
     Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data
 )
 {
-  assert(actualTarget != nullptr);
-  assert(data != nullptr);
-
-  LOG(
-      (CLOG_DEBUG1 "request selection=%s, target=%s, window=%x", XWindowsUtil::atomToString(display, selection).c_str(),
-       XWindowsUtil::atomToString(display, target).c_str(), m_requestor)
-  );
-
-  m_atomNone = XInternAtom(display, "NONE", False);
-  m_atomIncr = XInternAtom(display, "INCR", False);
-
-  // save output pointers
-  m_actualTarget = actualTarget;
-  m_data = data;
-
-  // assume failure
-  *m_actualTarget = None;
-  *m_data = "";
-
-  // delete target property
-  XDeleteProperty(display, m_requestor, m_property);
-
   // select window for property changes
   XWindowAttributes attr;
   XGetWindowAttributes(display, m_requestor, &attr);
   XSelectInput(display, m_requestor, attr.your_event_mask | PropertyChangeMask);
 
   // request data conversion
-  XConvertSelection(display, selection, target, m_property, m_requestor, m_time);
+  request(display, selection, target, actualTarget, data);
 
   // synchronize with server before we start following timeout countdown
   XSync(display, False);
@@ -1197,12 +1321,11 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
   // by badly behaved selection owners.
   XEvent xevent;
   std::vector<XEvent> events;
-  Stopwatch timeout(false);             // timer not stopped, not triggered
-  static const double s_timeout = 0.25; // FIXME -- is this too short?
+  Stopwatch timeout(false); // timer not stopped, not triggered
   bool noWait = false;
   while (!m_done && !m_failed) {
     // fail if timeout has expired
-    if (timeout.getTime() >= s_timeout) {
+    if (timeout.getTime() >= s_selectionTimeout) {
       m_failed = true;
       break;
     }
@@ -1211,7 +1334,7 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
     if (noWait || XPending(display) > 0) {
       while (!m_done && !m_failed && (noWait || XPending(display) > 0)) {
         // fail if timeout has expired
-        if (timeout.getTime() >= s_timeout) {
+        if (timeout.getTime() >= s_selectionTimeout) {
           m_failed = true;
           break;
         }
@@ -1249,6 +1372,37 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
   return !m_failed;
 }
 
+void XWindowsClipboard::CICCCMGetClipboard::request(
+    Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data
+)
+{
+  assert(actualTarget != nullptr);
+  assert(data != nullptr);
+
+  LOG(
+      (CLOG_DEBUG1 "request selection=%s, target=%s, window=%x", XWindowsUtil::atomToString(display, selection).c_str(),
+       XWindowsUtil::atomToString(display, target).c_str(), m_requestor)
+  );
+
+  m_atomNone = XInternAtom(display, "NONE", False);
+  m_atomIncr = XInternAtom(display, "INCR", False);
+  m_target = target;
+
+  // save output pointers
+  m_actualTarget = actualTarget;
+  m_data = data;
+
+  // assume failure
+  *m_actualTarget = None;
+  *m_data = "";
+
+  // delete target property
+  XDeleteProperty(display, m_requestor, m_property);
+
+  // request data conversion
+  XConvertSelection(display, selection, target, m_property, m_requestor, m_time);
+}
+
 bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const XEvent *xevent)
 {
   // process event
@@ -1263,7 +1417,7 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
     return false;
 
   case SelectionNotify:
-    if (xevent->xselection.requestor == m_requestor) {
+    if (xevent->xselection.requestor == m_requestor && xevent->xselection.target == m_target) {
       // done if we can't convert
       if (xevent->xselection.property == None || xevent->xselection.property == m_atomNone) {
         m_done = true;
@@ -1359,6 +1513,19 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
   return true;
 }
 
+//
+// XWindowsClipboard::Fetch
+//
+
+XWindowsClipboard::Fetch::Fetch(
+    Window requestor, Time time, Atom property, const IXWindowsClipboardConverter *converter
+)
+    : m_getter(requestor, time, property),
+      m_converter(converter)
+{
+  // do nothing
+}
+
 //
 // XWindowsClipboard::Reply
 //
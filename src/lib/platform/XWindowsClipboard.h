@@ -7,11 +7,13 @@
 
 #pragma once
 
+#include "base/Stopwatch.h"
 #include "deskflow/ClipboardTypes.h"
 #include "deskflow/IClipboard.h"
 
 #include <list>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <X11/Xlib.h>
@@ -62,12 +64,43 @@ public:
   */
   bool destroyRequest(Window requestor);
 
+  //! Fetch clipboard data
+  /*!
+  Asks the selection owner for the clipboard's data in every format at
+  once and returns without waiting for it.  The replies are handled by
+  processFetchEvent() as they arrive and the data is cached once they're
+  all in, so reading the clipboard later needn't wait on the owner.  A
+  fetch still in progress is abandoned by open().
+  */
+  void fetch(::Time);
+
+  //! Process fetch event
+  /*!
+  Passes a selection event to the conversions started by fetch().
+  Returns true iff the event belonged to one of them.
+  */
+  bool processFetchEvent(const XEvent *);
+
+  //! Expire fetch
+  /*!
+  Gives up on the conversions started by fetch() if the owner hasn't
+  made progress on any of them for a while, caching whatever was
+  received.  Returns true iff the fetch was given up on.
+  */
+  bool checkFetchTimeout();
+
   //! Get window
   /*!
   Returns the clipboard's window (passed the c'tor).
   */
   Window getWindow() const;
 
+  //! Check if fetching
+  /*!
+  Returns true iff conversions started by fetch() are still pending.
+  */
+  bool isFetching() const;
+
   //! Get selection atom
   /*!
   Returns the selection atom that identifies the clipboard to X11
@@ -94,6 +127,9 @@ private:
   // have data of the converter's clipboard format.
   IXWindowsClipboardConverter *getConverter(Atom target, bool onlyIfNotAdded = false) const;
 
+  // returns true if data of the format need not be read from the owner
+  bool isAdded(EFormat) const;
+
   // convert target atom to clipboard format
   EFormat getFormat(Atom target) const;
 
@@ -116,6 +152,9 @@ private:
   void fillCache() const;
   void doFillCache();
 
+  // cache the data from the conversions started by fetch()
+  void finishFetch();
+
 protected:
   //
   // helper classes
@@ -133,13 +172,33 @@ protected:
     // cannot be performed (in which case *actualTarget == None).
     bool readClipboard(Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data);
 
-  private:
+    // ask for the given selection to be converted to the given type
+    // without waiting for it.  the caller must select property change
+    // events on the requestor and pass events to processEvent() until
+    // isDone().
+    void request(Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data);
+
+    // process an event.  returns true iff the event was part of the
+    // conversion.
     bool processEvent(Display *display, const XEvent *event);
 
+    // true iff the conversion has finished, successfully or not
+    bool isDone() const
+    {
+      return m_done || m_failed;
+    }
+
+    // true iff the conversion could not be completed
+    bool failed() const
+    {
+      return m_failed;
+    }
+
   private:
     Window m_requestor;
     Time m_time;
     Atom m_property;
+    Atom m_target = None;
     bool m_incr = false;
     bool m_failed = false;
     bool m_done = false;
@@ -244,6 +303,24 @@ protected:
     // index of next byte in m_data to send
     uint32_t m_ptr = 0;
   };
+  // a conversion started by fetch().  the getter writes to the
+  // target and data so the fetch mustn't move while it's pending.
+  class Fetch
+  {
+  public:
+    Fetch(Window requestor, Time time, Atom property, const IXWindowsClipboardConverter *converter);
+
+  public:
+    CICCCMGetClipboard m_getter;
+
+    // the converter for the data, nullptr for the timestamp
+    const IXWindowsClipboardConverter *m_converter;
+
+    Atom m_actualTarget = None;
+    std::string m_data;
+  };
+  using FetchList = std::vector<std::unique_ptr<Fetch>>;
+
   using ReplyList = std::list<Reply *>;
   using ReplyMap = std::map<Window, ReplyList>;
   using ReplyEventMask = std::map<Window, long>;
@@ -299,6 +376,11 @@ private:
   bool m_added[kNumFormats];
   std::string m_data[kNumFormats];
 
+  // conversions started by fetch() and the time since the owner last
+  // made progress on any of them
+  FetchList m_fetches;
+  Stopwatch m_fetchProgress;
+
   // conversion request replies
   ReplyMap m_replies;
   ReplyEventMask m_eventMasks;
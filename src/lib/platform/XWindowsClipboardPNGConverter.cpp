@@ -0,0 +1,47 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/XWindowsClipboardPNGConverter.h"
+
+#include "deskflow/ClipboardImage.h"
+
+//
+// XWindowsClipboardPNGConverter
+//
+
+XWindowsClipboardPNGConverter::XWindowsClipboardPNGConverter(Display *display)
+    : m_atom(XInternAtom(display, "image/png", False))
+{
+  // do nothing
+}
+
+IClipboard::EFormat XWindowsClipboardPNGConverter::getFormat() const
+{
+  return IClipboard::kPNG;
+}
+
+Atom XWindowsClipboardPNGConverter::getAtom() const
+{
+  return m_atom;
+}
+
+int XWindowsClipboardPNGConverter::getDataSize() const
+{
+  return 8;
+}
+
+std::string XWindowsClipboardPNGConverter::fromIClipboard(const std::string &png) const
+{
+  return png;
+}
+
+std::string XWindowsClipboardPNGConverter::toIClipboard(const std::string &png) const
+{
+  if (!ClipboardImage::isPNG(png)) {
+    return std::string();
+  }
+  return png;
+}
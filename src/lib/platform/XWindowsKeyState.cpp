@@ -5,6 +5,11 @@
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
  */
 
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QString>
 #ifndef __APPLE__
 #include <QDBusConnection>
@@ -14,7 +19,9 @@
 
 #include "platform/XWindowsKeyState.h"
 
+#include "VersionInfo.h"
 #include "base/Log.h"
+#include "common/Constants.h"
 #include "deskflow/AppUtil.h"
 #include "deskflow/ClientApp.h"
 #include "deskflow/ClientArgs.h"
@@ -24,7 +31,9 @@
 #include <X11/Xutil.h>
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <map>
+#include <string_view>
 #define XK_MISCELLANY
 #define XK_XKB_KEYS
 #include <X11/keysymdef.h>
@@ -34,6 +43,36 @@
 
 static const size_t ModifiersFromXDefaultSize = 32;
 
+// bump whenever the layout of a keyboard map cache file changes
+static const uint32_t kKeyMapCacheVersion = 1;
+
+// keyboard map cache files kept, one per keymap
+static const qsizetype kMaxKeyMapCaches = 16;
+
+// cache files are only read on the machine that wrote them, so values
+// are in native byte order
+template <typename T> static void writeCacheValue(std::string &buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> static bool readCacheValue(std::string_view &data, T &value)
+{
+  if (data.size() < sizeof(value)) {
+    return false;
+  }
+  memcpy(&value, data.data(), sizeof(value));
+  data.remove_prefix(sizeof(value));
+  return true;
+}
+
+// reads a count of things that take at least a byte each, so a damaged
+// count can't ask for more than is left
+static bool readCacheCount(std::string_view &data, uint32_t &count)
+{
+  return readCacheValue(data, count) && count <= data.size();
+}
+
 XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *events)
     : KeyState(events, AppUtil::instance().getKeyboardLayoutList(), ClientApp::instance().args().m_enableLangSync),
       m_display(display),
@@ -199,13 +238,37 @@ void XWindowsKeyState::pollPressedKeys(KeyButtonSet &pressedKeys) const
   }
 }
 
+void XWindowsKeyState::updateKeyMap()
+{
+#if HAVE_XKB_EXTENSION
+  // walking every key and adding the compositions takes a while, so a
+  // map built from the same xkb keymap is kept and loaded next time.
+  // without modifiers the map depends on the last good ones as well,
+  // so that's always built.
+  if (m_xkb != nullptr &&
+      XkbGetUpdatedMap(m_display, XkbKeyActionsMask | XkbKeyBehaviorsMask | XkbAllClientInfoMask, m_xkb) == Success &&
+      hasModifiersXKB()) {
+    pollKeyboardControl();
+    const auto fingerprint = getKeyMapFingerprintXKB();
+    deskflow::KeyMap keyMap;
+    if (loadKeyMapCache(fingerprint, keyMap)) {
+      LOG((CLOG_DEBUG1 "xkb mapping %016llx loaded from cache", static_cast<unsigned long long>(fingerprint)));
+      KeyState::updateKeyMap(&keyMap);
+      return;
+    }
+    updateKeysymMapXKB(keyMap);
+    keyMap.finish();
+    KeyState::updateKeyMap(&keyMap);
+    saveKeyMapCache(fingerprint);
+    return;
+  }
+#endif
+  KeyState::updateKeyMap();
+}
+
 void XWindowsKeyState::getKeyMap(deskflow::KeyMap &keyMap)
 {
-  // get autorepeat info.  we must use the global_auto_repeat told to
-  // us because it may have modified by deskflow.
-  int oldGlobalAutoRepeat = m_keyboardState.global_auto_repeat;
-  XGetKeyboardControl(m_display, &m_keyboardState);
-  m_keyboardState.global_auto_repeat = oldGlobalAutoRepeat;
+  pollKeyboardControl();
 
 #if HAVE_XKB_EXTENSION
   if (m_xkb != nullptr) {
@@ -218,6 +281,15 @@ void XWindowsKeyState::getKeyMap(deskflow::KeyMap &keyMap)
   updateKeysymMap(keyMap);
 }
 
+void XWindowsKeyState::pollKeyboardControl()
+{
+  // get autorepeat info.  we must use the global_auto_repeat told to
+  // us because it may have modified by deskflow.
+  int oldGlobalAutoRepeat = m_keyboardState.global_auto_repeat;
+  XGetKeyboardControl(m_display, &m_keyboardState);
+  m_keyboardState.global_auto_repeat = oldGlobalAutoRepeat;
+}
+
 bool XWindowsKeyState::setCurrentLanguageWithDBus(int32_t group) const
 {
   QString service = "org.gnome.Shell";
@@ -780,8 +852,200 @@ void XWindowsKeyState::updateKeysymMapXKB(deskflow::KeyMap &keyMap)
   // allow composition across groups
   keyMap.allowGroupSwitchDuringCompose();
 }
+
+uint64_t XWindowsKeyState::getKeyMapFingerprintXKB() const
+{
+  // FNV-1a over everything updateKeysymMapXKB() reads.  the version is
+  // included because the keysym and composition tables can change
+  // between versions.
+  uint64_t hash = 0xcbf29ce484222325;
+  auto add = [&hash](const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+  };
+
+  add(kVersion, strlen(kVersion));
+  add(&m_xkb->min_key_code, sizeof(m_xkb->min_key_code));
+  add(&m_xkb->max_key_code, sizeof(m_xkb->max_key_code));
+
+  // key types.  the map entries are hashed a field at a time since
+  // they have padding.
+  const XkbClientMapRec *map = m_xkb->map;
+  for (int i = 0; i < map->num_types; ++i) {
+    const XkbKeyTypeRec &type = map->types[i];
+    add(&type.mods.mask, sizeof(type.mods.mask));
+    add(&type.num_levels, sizeof(type.num_levels));
+    add(&type.map_count, sizeof(type.map_count));
+    for (int j = 0; j < type.map_count; ++j) {
+      add(&type.map[j].active, sizeof(type.map[j].active));
+      add(&type.map[j].level, sizeof(type.map[j].level));
+      add(&type.map[j].mods.mask, sizeof(type.map[j].mods.mask));
+      if (type.preserve != nullptr) {
+        add(&type.preserve[j].mask, sizeof(type.preserve[j].mask));
+      }
+    }
+  }
+
+  // symbols, actions and behaviors of every key
+  const auto first = m_xkb->min_key_code;
+  const size_t numKeys = m_xkb->max_key_code - first + 1;
+  add(map->key_sym_map + first, numKeys * sizeof(*map->key_sym_map));
+  add(map->modmap + first, numKeys * sizeof(*map->modmap));
+  add(map->syms, map->num_syms * sizeof(*map->syms));
+  const XkbServerMapRec *server = m_xkb->server;
+  add(server->key_acts + first, numKeys * sizeof(*server->key_acts));
+  add(server->acts, server->num_acts * sizeof(*server->acts));
+  add(server->behaviors + first, numKeys * sizeof(*server->behaviors));
+  return hash;
+}
+
+bool XWindowsKeyState::loadKeyMapCache(uint64_t fingerprint, deskflow::KeyMap &keyMap)
+{
+  QFile file(getKeyMapCachePath(fingerprint));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const auto *mapped = file.map(0, file.size());
+  if (mapped == nullptr) {
+    return false;
+  }
+  std::string_view data(reinterpret_cast<const char *>(mapped), static_cast<size_t>(file.size()));
+
+  uint32_t version;
+  uint64_t storedFingerprint;
+  if (!readCacheValue(data, version) || version != kKeyMapCacheVersion ||
+      !readCacheValue(data, storedFingerprint) || storedFingerprint != fingerprint) {
+    return false;
+  }
+
+  // read the tables updateKeysymMapXKB() fills in besides the map
+  KeyModifierMaskList modifierFromX;
+  KeyModifierToXMask modifierToX;
+  KeyToKeyCodeMap keyCodeFromKey;
+  XKBModifierMap lastGoodModifiers;
+  uint32_t count;
+  if (!readCacheCount(data, count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    KeyModifierMask mask;
+    if (!readCacheValue(data, mask)) {
+      return false;
+    }
+    modifierFromX.push_back(mask);
+  }
+  if (!readCacheCount(data, count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    KeyModifierMask mask;
+    unsigned int xMask;
+    if (!readCacheValue(data, mask) || !readCacheValue(data, xMask)) {
+      return false;
+    }
+    modifierToX.insert(std::make_pair(mask, xMask));
+  }
+  if (!readCacheCount(data, count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    KeyID id;
+    KeyCode keycode;
+    if (!readCacheValue(data, id) || !readCacheValue(data, keycode)) {
+      return false;
+    }
+    keyCodeFromKey.insert(keyCodeFromKey.end(), std::make_pair(id, keycode));
+  }
+  if (!readCacheCount(data, count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t key;
+    XKBModifierInfo info;
+    uint8_t lock;
+    if (!readCacheValue(data, key) || !readCacheValue(data, info.m_level) || !readCacheValue(data, info.m_mask) ||
+        !readCacheValue(data, lock)) {
+      return false;
+    }
+    info.m_lock = (lock != 0);
+    lastGoodModifiers.insert(std::make_pair(key, info));
+  }
+
+  // the rest is the map
+  if (!keyMap.unmarshall(data)) {
+    LOG((CLOG_DEBUG "ignoring damaged keyboard map cache %s", qPrintable(file.fileName())));
+    return false;
+  }
+  m_modifierFromX.swap(modifierFromX);
+  m_modifierToX.swap(modifierToX);
+  m_keyCodeFromKey.swap(keyCodeFromKey);
+  m_lastGoodXKBModifiers.swap(lastGoodModifiers);
+  return true;
+}
+
+void XWindowsKeyState::saveKeyMapCache(uint64_t fingerprint) const
+{
+  std::string buffer;
+  writeCacheValue(buffer, kKeyMapCacheVersion);
+  writeCacheValue(buffer, fingerprint);
+  writeCacheValue(buffer, static_cast<uint32_t>(m_modifierFromX.size()));
+  for (const auto mask : m_modifierFromX) {
+    writeCacheValue(buffer, mask);
+  }
+  writeCacheValue(buffer, static_cast<uint32_t>(m_modifierToX.size()));
+  for (const auto &[mask, xMask] : m_modifierToX) {
+    writeCacheValue(buffer, mask);
+    writeCacheValue(buffer, xMask);
+  }
+  writeCacheValue(buffer, static_cast<uint32_t>(m_keyCodeFromKey.size()));
+  for (const auto &[id, keycode] : m_keyCodeFromKey) {
+    writeCacheValue(buffer, id);
+    writeCacheValue(buffer, keycode);
+  }
+  writeCacheValue(buffer, static_cast<uint32_t>(m_lastGoodXKBModifiers.size()));
+  for (const auto &[key, info] : m_lastGoodXKBModifiers) {
+    writeCacheValue(buffer, key);
+    writeCacheValue(buffer, info.m_level);
+    writeCacheValue(buffer, info.m_mask);
+    writeCacheValue(buffer, static_cast<uint8_t>(info.m_lock ? 1 : 0));
+  }
+  buffer += getCurrentKeyMap().marshall();
+
+  // write to a temporary file and rename it, so another instance never
+  // sees half a cache
+  const auto path = getKeyMapCachePath(fingerprint);
+  const QDir dir = QFileInfo(path).dir();
+  if (!dir.mkpath(dir.absolutePath())) {
+    LOG((CLOG_DEBUG "unable to create keyboard map cache directory %s", qPrintable(dir.path())));
+    return;
+  }
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(buffer.data(), static_cast<qint64>(buffer.size())) != static_cast<qint64>(buffer.size()) ||
+      !file.commit()) {
+    LOG((CLOG_DEBUG "unable to save keyboard map cache %s: %s", qPrintable(path), qPrintable(file.errorString())));
+    return;
+  }
+  LOG((CLOG_DEBUG1 "xkb mapping %016llx saved to cache", static_cast<unsigned long long>(fingerprint)));
+
+  // keep only the most recently built maps, which drops those from
+  // older versions as well
+  const auto entries = dir.entryInfoList(QDir::Files, QDir::Time);
+  for (auto i = kMaxKeyMapCaches; i < entries.size(); ++i) {
+    QFile::remove(entries.at(i).filePath());
+  }
+}
 #endif
 
+QString XWindowsKeyState::getKeyMapCachePath(uint64_t fingerprint)
+{
+  return QStringLiteral("%1/%2/keymaps/%3")
+      .arg(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation), kAppId)
+      .arg(fingerprint, 16, 16, QLatin1Char('0'));
+}
+
 void XWindowsKeyState::remapKeyModifiers(KeyID id, int32_t group, deskflow::KeyMap::KeyItem &item, void *vself)
 {
   const auto *self = static_cast<XWindowsKeyState *>(vself);
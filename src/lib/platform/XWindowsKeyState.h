@@ -23,6 +23,7 @@
 #endif
 
 class IEventQueue;
+class QString;
 
 //! X Windows key state
 /*!
@@ -87,6 +88,7 @@ public:
   //@}
 
   // IKeyState overrides
+  void updateKeyMap() override;
   bool fakeCtrlAltDel() override;
   KeyModifierMask pollActiveModifiers() const override;
   int32_t pollActiveGroup() const final;
@@ -99,8 +101,13 @@ protected:
 
 private:
   void init(const Display *display, bool useXKB);
+  void pollKeyboardControl();
   void updateKeysymMap(deskflow::KeyMap &);
   void updateKeysymMapXKB(deskflow::KeyMap &);
+  uint64_t getKeyMapFingerprintXKB() const;
+  bool loadKeyMapCache(uint64_t fingerprint, deskflow::KeyMap &);
+  void saveKeyMapCache(uint64_t fingerprint) const;
+  static QString getKeyMapCachePath(uint64_t fingerprint);
   bool hasModifiersXKB() const;
   int getEffectiveGroup(KeyCode, int group) const;
   uint32_t getGroupFromState(unsigned int state) const;
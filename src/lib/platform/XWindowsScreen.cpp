@@ -64,6 +64,10 @@ extern "C"
 
 static int xi_opcode;
 
+// how often clipboard fetches are checked for owners that have
+// stopped responding
+static const double s_clipboardFetchCheck = 0.05;
+
 //
 // XWindowsScreen
 //
@@ -166,6 +170,10 @@ XWindowsScreen::~XWindowsScreen()
 
   m_events->adoptBuffer(nullptr);
   m_events->removeHandler(EventTypes::System, m_events->getSystemTarget());
+  if (m_clipboardFetchTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_clipboardFetchTimer);
+    m_events->deleteTimer(m_clipboardFetchTimer);
+  }
   for (auto clipboard : m_clipboard) {
     delete clipboard;
   }
@@ -399,6 +407,7 @@ void XWindowsScreen::resetOptions()
 {
   m_xtestIsXineramaUnaware = true;
   m_preserveFocus = false;
+  m_fetchClipboards = true;
 }
 
 void XWindowsScreen::setOptions(const OptionsList &options)
@@ -410,6 +419,9 @@ void XWindowsScreen::setOptions(const OptionsList &options)
     } else if (options[i] == kOptionScreenPreserveFocus) {
       m_preserveFocus = (options[i + 1] != 0);
       LOG((CLOG_DEBUG1 "preserve focus: %s", m_preserveFocus ? "true" : "false"));
+    } else if (options[i] == kOptionClipboardSharing) {
+      m_fetchClipboards = (options[i + 1] != 0);
+      LOG((CLOG_DEBUG1 "fetch clipboards: %s", m_fetchClipboards ? "true" : "false"));
     }
   }
 }
@@ -1249,15 +1261,20 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
     if (id != kClipboardEnd) {
       m_clipboard[id]->lost(xevent->xselectionclear.time);
       sendClipboardEvent(EventTypes::ClipboardGrabbed, id);
+      fetchClipboard(id, xevent->xselectionclear.time);
       return;
     }
   } break;
 
   case SelectionNotify:
-    // notification of selection transferred.  we shouldn't
-    // get this here because we handle them in the selection
-    // retrieval methods.  we'll just delete the property
-    // with the data (satisfying the usual ICCCM protocol).
+    // notification of selection transferred for a clipboard fetch
+    if (processClipboardFetch(xevent)) {
+      return;
+    }
+
+    // otherwise it's for a conversion we've given up on.  we'll
+    // just delete the property with the data (satisfying the usual
+    // ICCCM protocol).
     if (xevent->xselection.property != None) {
       XDeleteProperty(m_display, xevent->xselection.requestor, xevent->xselection.property);
     }
@@ -1280,6 +1297,11 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
     if (xevent->xproperty.state == PropertyDelete) {
       processClipboardRequest(xevent->xproperty.window, xevent->xproperty.time, xevent->xproperty.atom);
     }
+
+    // new value may be part of a clipboard fetch
+    else if (processClipboardFetch(xevent)) {
+      return;
+    }
     break;
 
   case DestroyNotify:
@@ -1631,6 +1653,62 @@ void XWindowsScreen::destroyClipboardRequest(Window requestor) const
   }
 }
 
+void XWindowsScreen::fetchClipboard(ClipboardID id, Time time)
+{
+  if (!m_fetchClipboards) {
+    return;
+  }
+
+  // the new owner is asked for the data now, the replies come in as
+  // events, so the data is ready by the time it's needed and the
+  // input handled meanwhile isn't held up by a slow owner
+  m_clipboard[id]->fetch(time);
+  if (m_clipboard[id]->isFetching() && m_clipboardFetchTimer == nullptr) {
+    m_clipboardFetchTimer = m_events->newTimer(s_clipboardFetchCheck, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_clipboardFetchTimer, [this](const auto &) {
+      handleClipboardFetchTimer();
+    });
+  }
+}
+
+bool XWindowsScreen::processClipboardFetch(const XEvent *xevent)
+{
+  for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+    XWindowsClipboard *clipboard = m_clipboard[id];
+    if (clipboard == nullptr || !clipboard->processFetchEvent(xevent)) {
+      continue;
+    }
+
+    // tell the receiver once all the data is in
+    if (!clipboard->isFetching()) {
+      sendClipboardEvent(EventTypes::ClipboardChanged, id);
+    }
+    return true;
+  }
+  return false;
+}
+
+void XWindowsScreen::handleClipboardFetchTimer()
+{
+  bool fetching = false;
+  for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+    XWindowsClipboard *clipboard = m_clipboard[id];
+    if (clipboard == nullptr) {
+      continue;
+    }
+    if (clipboard->checkFetchTimeout()) {
+      sendClipboardEvent(EventTypes::ClipboardChanged, id);
+    }
+    fetching = fetching || clipboard->isFetching();
+  }
+
+  if (!fetching) {
+    m_events->removeHandler(EventTypes::Timer, m_clipboardFetchTimer);
+    m_events->deleteTimer(m_clipboardFetchTimer);
+    m_clipboardFetchTimer = nullptr;
+  }
+}
+
 void XWindowsScreen::onError()
 {
   // prevent further access to the X display
@@ -103,6 +103,16 @@ private:
   // terminate a selection request
   void destroyClipboardRequest(Window window) const;
 
+  // start reading a clipboard we've lost to another owner
+  void fetchClipboard(ClipboardID id, Time time);
+
+  // continue reading clipboards.  returns true iff the event was
+  // part of a clipboard fetch.
+  bool processClipboardFetch(const XEvent *xevent);
+
+  // give up on clipboard fetches the owner has stopped responding to
+  void handleClipboardFetchTimer();
+
   // X I/O error handler
   void onError();
   static int ioErrorHandler(Display *);
@@ -210,6 +220,8 @@ private:
   // clipboards
   XWindowsClipboard *m_clipboard[kClipboardEnd];
   uint32_t m_sequenceNumber = 0;
+  bool m_fetchClipboards = true;
+  EventQueueTimer *m_clipboardFetchTimer = nullptr;
 
   // screen saver stuff
   XWindowsScreenSaver *m_screensaver = nullptr;
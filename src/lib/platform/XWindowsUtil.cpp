@@ -13,6 +13,8 @@
 #include "mt/Thread.h"
 
 #include <X11/Xatom.h>
+#include <array>
+#include <bit>
 #define XK_APL
 #define XK_ARABIC
 #define XK_ARMENIAN
@@ -69,7 +71,9 @@ struct codepair
 {
   KeySym keysym;
   uint32_t ucs4;
-} s_keymap[] = {
+};
+
+static constexpr codepair s_keymap[] = {
     {XK_Aogonek, 0x0104},      /* LATIN CAPITAL LETTER A WITH OGONEK */
     {XK_breve, 0x02d8},        /* BREVE */
     {XK_Lstroke, 0x0141},      /* LATIN CAPITAL LETTER L WITH STROKE */
@@ -939,6 +943,34 @@ struct codepair
     {XK_dead_ogonek, 0x0328},      /* COMBINING OGONEK */
     {XK_dead_tilde, 0x0303}        /* COMBINING TILDE */
 };
+
+// s_keymap as an open addressing table built when compiling, so finding
+// a keysym takes a probe or two and there's nothing to build at startup.
+// keysyms fit in 32 bits and NoSymbol marks an empty slot.
+struct KeySymSlot
+{
+  uint32_t keysym;
+  uint32_t ucs4;
+};
+
+static constexpr size_t kKeySymSlots = std::bit_ceil(2 * std::size(s_keymap));
+
+static constexpr size_t getKeySymSlot(KeySym keysym)
+{
+  return static_cast<size_t>((static_cast<uint32_t>(keysym) * 0x9e3779b9u) >> (32 - std::countr_zero(kKeySymSlots)));
+}
+
+static constexpr auto s_keySymToUCS4 = [] {
+  std::array<KeySymSlot, kKeySymSlots> slots{};
+  for (const auto &[keysym, ucs4] : s_keymap) {
+    auto i = getKeySymSlot(keysym);
+    while (slots[i].keysym != NoSymbol && slots[i].keysym != keysym) {
+      i = (i + 1) & (kKeySymSlots - 1);
+    }
+    slots[i] = {static_cast<uint32_t>(keysym), ucs4};
+  }
+  return slots;
+}();
 /* XXX -- map these too
 XK_Cyrillic_GHE_bar
 XK_Cyrillic_ZHE_descender
@@ -1501,8 +1533,6 @@ static const KeySym s_map1008FF[] = {
 // XWindowsUtil
 //
 
-XWindowsUtil::KeySymMap XWindowsUtil::s_keySymToUCS4;
-
 bool XWindowsUtil::getWindowProperty(
     Display *display, Window window, Atom property, std::string *data, Atom *type, int32_t *format, bool deleteProperty
 )
@@ -1668,8 +1698,6 @@ Time XWindowsUtil::getCurrentTime(Display *display, Window window)
 
 KeyID XWindowsUtil::mapKeySymToKeyID(KeySym k)
 {
-  initKeyMaps();
-
   switch (k & 0xffffff00) {
   case 0x0000:
     // Latin-1
@@ -1746,8 +1774,10 @@ KeyID XWindowsUtil::mapKeySymToKeyID(KeySym k)
 
   default: {
     // lookup character in table
-    if (KeySymMap::const_iterator index = s_keySymToUCS4.find(k); index != s_keySymToUCS4.end()) {
-      return static_cast<KeyID>(index->second);
+    for (auto i = getKeySymSlot(k); s_keySymToUCS4[i].keysym != NoSymbol; i = (i + 1) & (kKeySymSlots - 1)) {
+      if (s_keySymToUCS4[i].keysym == k) {
+        return static_cast<KeyID>(s_keySymToUCS4[i].ucs4);
+      }
     }
 
     // unknown character
@@ -1882,15 +1912,6 @@ Bool XWindowsUtil::propertyNotifyPredicate(Display *, XEvent *xevent, XPointer a
              : False;
 }
 
-void XWindowsUtil::initKeyMaps()
-{
-  if (s_keySymToUCS4.empty()) {
-    for (size_t i = 0; i < std::size(s_keymap); ++i) {
-      s_keySymToUCS4[s_keymap[i].keysym] = s_keymap[i].ucs4;
-    }
-  }
-}
-
 //
 // XWindowsUtil::ErrorLock
 //
@@ -9,7 +9,6 @@
 
 #include "base/EventTypes.h"
 
-#include <map>
 #include <string>
 #include <vector>
 
@@ -166,11 +165,4 @@ private:
   };
 
   static Bool propertyNotifyPredicate(Display *, XEvent *xevent, XPointer arg);
-
-  static void initKeyMaps();
-
-private:
-  using KeySymMap = std::map<KeySym, uint32_t>;
-
-  static KeySymMap s_keySymToUCS4;
 };
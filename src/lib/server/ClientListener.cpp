@@ -149,7 +149,8 @@ void ClientListener::handleClientAccepted(IDataSocket *socket)
   LOG((CLOG_NOTE "accepted client connection"));
 
   // filter socket messages, including a packetizing filter
-  deskflow::IStream *stream = new PacketStreamFilter(m_events, socket, false);
+  auto *stream = new PacketStreamFilter(m_events, socket, false);
+  stream->capture(deskflow::ProtocolCapture::Peer::Client);
   assert(m_server != nullptr);
 
   // create proxy for unknown client
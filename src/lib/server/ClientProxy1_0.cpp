@@ -10,6 +10,7 @@
 
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "common/CoreStatus.h"
 #include "deskflow/ProtocolUtil.h"
 #include "deskflow/XDeskflow.h"
 #include "io/IStream.h"
@@ -186,6 +187,7 @@ bool ClientProxy1_0::parseMessage(const uint8_t *code)
 void ClientProxy1_0::handleDisconnect()
 {
   LOG((CLOG_NOTE "client \"%s\" has disconnected", getName().c_str()));
+  deskflow::CoreStatusChannel::send(deskflow::CoreStatus::Type::ClientDisconnected, QString::fromStdString(getName()));
   disconnect();
 }
 
@@ -0,0 +1,25 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "server/ClientProxy1_9.h"
+
+//! Proxy for client implementing protocol version 1.10
+/*!
+Sends clipboard images as PNG where the clipboard has one, rather than
+as a bitmap, and resumes interrupted file transfers.
+*/
+class ClientProxy1_10 : public ClientProxy1_9
+{
+public:
+  ClientProxy1_10(const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events);
+  ~ClientProxy1_10() override = default;
+
+protected:
+  // ClientProxy1_6 overrides
+  bool supportsPNGClipboard() const override;
+};
@@ -12,7 +12,7 @@
 #include "io/IStream.h"
 #include "server/Server.h"
 
-#include <sstream>
+#include <cstring>
 
 //
 // ClientProxy1_5
@@ -20,19 +20,31 @@
 
 ClientProxy1_5::ClientProxy1_5(const std::string &name, deskflow::IStream *stream, Server *server, IEventQueue *events)
     : ClientProxy1_4(name, stream, server, events),
-      m_events(events)
+      m_events(events),
+      m_fileTransfer(std::make_unique<deskflow::FileTransfer>(getStream(), events, name))
 {
-  // do nothing
+  // files from clients are only saved if the user turned it on
+  m_fileTransfer->setReceiving(server->isReceivingFiles());
 }
 
 void ClientProxy1_5::sendDragInfo(uint32_t fileCount, const char *info, size_t size)
 {
-  // do nothing
+  // info is the paths of the files, each followed by a null
+  std::vector<std::string> paths;
+  for (std::size_t start = 0; start < size && paths.size() < fileCount;) {
+    const auto length = strnlen(info + start, size - start);
+    paths.emplace_back(info + start, length);
+    start += length + 1;
+  }
+
+  LOG((CLOG_DEBUG "send %d file(s) to \"%s\"", paths.size(), getName().c_str()));
+  m_fileTransfer->sendFiles(paths);
 }
 
 void ClientProxy1_5::fileChunkSending(uint8_t mark, char *data, size_t dataSize)
 {
-  // do nothing
+  const std::string chunk(data, dataSize);
+  ProtocolUtil::writef(getStream(), kMsgDFileTransfer, mark, &chunk);
 }
 
 bool ClientProxy1_5::parseMessage(const uint8_t *code)
@@ -48,12 +60,17 @@ bool ClientProxy1_5::parseMessage(const uint8_t *code)
   return true;
 }
 
-void ClientProxy1_5::fileChunkReceived() const
+void ClientProxy1_5::enableFileResume()
+{
+  m_fileTransfer->setResumable(true);
+}
+
+void ClientProxy1_5::fileChunkReceived()
 {
-  // do nothing
+  m_fileTransfer->chunkReceived();
 }
 
-void ClientProxy1_5::dragInfoReceived() const
+void ClientProxy1_5::dragInfoReceived()
 {
-  // do nothing
+  m_fileTransfer->dragInfoReceived();
 }
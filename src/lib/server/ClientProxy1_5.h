@@ -6,9 +6,10 @@
 
 #pragma once
 
+#include "deskflow/FileTransfer.h"
 #include "server/ClientProxy1_4.h"
 
-#include <vector>
+#include <memory>
 
 class Server;
 class IEventQueue;
@@ -28,9 +29,14 @@ public:
   void sendDragInfo(uint32_t fileCount, const char *info, size_t size) override;
   void fileChunkSending(uint8_t mark, char *data, size_t dataSize) override;
   bool parseMessage(const uint8_t *code) override;
-  void fileChunkReceived() const;
-  void dragInfoReceived() const;
+  void fileChunkReceived();
+  void dragInfoReceived();
+
+protected:
+  //! Resume interrupted file transfers, for protocol 1.10 and later
+  void enableFileResume();
 
 private:
   IEventQueue *m_events;
+  std::unique_ptr<deskflow::FileTransfer> m_fileTransfer;
 };
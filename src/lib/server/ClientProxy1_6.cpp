@@ -21,9 +21,7 @@ ClientProxy1_6::ClientProxy1_6(const std::string &name, deskflow::IStream *strea
     : ClientProxy1_5(name, stream, server, events),
       m_events(events)
 {
-  m_events->addHandler(EventTypes::ClipboardSending, this, [this](const auto &e) {
-    ClipboardChunk::send(getStream(), e.getDataObject());
-  });
+  // do nothing
 }
 
 void ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard *clipboard)
@@ -34,12 +32,14 @@ void ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard *clipboard)
     m_clipboard[id].m_dirty = false;
     Clipboard::copy(&m_clipboard[id].m_clipboard, clipboard);
 
-    std::string data = m_clipboard[id].m_clipboard.marshall();
+    // the server encodes its own clipboard once for all clients
+    const auto packets = getServer()->getClipboardPackets(id, clipboard, supportsPNGClipboard());
 
-    size_t size = data.size();
     LOG((CLOG_DEBUG "sending clipboard %d to \"%s\"", id, getName().c_str()));
-
-    StreamChunker::sendClipboard(data, size, id, 0, m_events, this);
+    for (const auto &packet : packets) {
+      getStream()->writePacket(packet);
+    }
+    LOG((CLOG_DEBUG "sent clipboard in %d messages", packets.size()));
   }
 }
 
@@ -21,6 +21,13 @@ public:
   void setClipboard(ClipboardID id, const IClipboard *clipboard) override;
   bool recvClipboard() override;
 
+protected:
+  //! Returns true if the client understands \c IClipboard::kPNG
+  virtual bool supportsPNGClipboard() const
+  {
+    return false;
+  }
+
 private:
   IEventQueue *m_events;
 };
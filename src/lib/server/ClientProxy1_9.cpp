@@ -0,0 +1,148 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "server/ClientProxy1_9.h"
+
+#include "base/InputTrace.h"
+#include "base/Log.h"
+#include "deskflow/ProtocolUtil.h"
+
+#include <cstring>
+
+using deskflow::InputTrace;
+
+//
+// ClientProxy1_9
+//
+
+ClientProxy1_9::ClientProxy1_9(
+    const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events
+)
+    : ClientProxy1_8(name, adoptedStream, server, events)
+{
+  // do nothing
+}
+
+void ClientProxy1_9::keyDown(KeyID key, KeyModifierMask mask, KeyButton button, const std::string &language)
+{
+  sendInputTrace();
+  ClientProxy1_8::keyDown(key, mask, button, language);
+}
+
+void ClientProxy1_9::keyRepeat(
+    KeyID key, KeyModifierMask mask, int32_t count, KeyButton button, const std::string &language
+)
+{
+  sendInputTrace();
+  ClientProxy1_8::keyRepeat(key, mask, count, button, language);
+}
+
+void ClientProxy1_9::keyUp(KeyID key, KeyModifierMask mask, KeyButton button)
+{
+  sendInputTrace();
+  ClientProxy1_8::keyUp(key, mask, button);
+}
+
+void ClientProxy1_9::mouseDown(ButtonID button)
+{
+  sendInputTrace();
+  ClientProxy1_8::mouseDown(button);
+}
+
+void ClientProxy1_9::mouseUp(ButtonID button)
+{
+  sendInputTrace();
+  ClientProxy1_8::mouseUp(button);
+}
+
+void ClientProxy1_9::mouseMove(int32_t xAbs, int32_t yAbs)
+{
+  sendInputTrace();
+  ClientProxy1_8::mouseMove(xAbs, yAbs);
+}
+
+void ClientProxy1_9::mouseRelativeMove(int32_t xRel, int32_t yRel)
+{
+  sendInputTrace();
+  ClientProxy1_8::mouseRelativeMove(xRel, yRel);
+}
+
+void ClientProxy1_9::mouseWheel(int32_t xDelta, int32_t yDelta)
+{
+  sendInputTrace();
+  ClientProxy1_8::mouseWheel(xDelta, yDelta);
+}
+
+void ClientProxy1_9::keepAlive()
+{
+  const auto now = static_cast<uint32_t>(InputTrace::now());
+  ProtocolUtil::writef(getStream(), kMsgCKeepAliveSync, now, m_clockOffset);
+}
+
+bool ClientProxy1_9::parseMessage(const uint8_t *code)
+{
+  if (memcmp(code, kMsgCKeepAlive, 4) == 0) {
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint32_t replied = 0;
+    ProtocolUtil::readf(getStream(), kMsgCKeepAliveSyncReply + 4, &sent, &received, &replied);
+    updateClockOffset(sent, received, replied, static_cast<uint32_t>(InputTrace::now()));
+
+    // reset alarm
+    resetHeartbeatTimer();
+    return true;
+  }
+  return ClientProxy1_8::parseMessage(code);
+}
+
+void ClientProxy1_9::sendInputTrace() const
+{
+  if (!InputTrace::isEnabled()) {
+    return;
+  }
+
+  using Stage = InputTrace::Stage;
+  InputTrace::stamp(Stage::Write);
+  const auto &stamps = InputTrace::current();
+  ProtocolUtil::writef(
+      getStream(), kMsgDInputTrace, static_cast<uint32_t>(stamps[Stage::Capture]),
+      static_cast<uint32_t>(stamps[Stage::Dispatch]), static_cast<uint32_t>(stamps[Stage::Server]),
+      static_cast<uint32_t>(stamps[Stage::Write])
+  );
+}
+
+void ClientProxy1_9::updateClockOffset(uint32_t sent, uint32_t received, uint32_t replied, uint32_t now)
+{
+  // times wrap at 2^32 on both clocks so only differences are meaningful
+  const auto roundTrip = static_cast<int32_t>((now - sent) - (replied - received));
+  if (roundTrip < 0) {
+    LOG((CLOG_DEBUG1 "ignoring bad keep alive times from \"%s\"", getName().c_str()));
+    return;
+  }
+
+  // the offset is midway between the outbound and inbound estimates
+  const uint32_t outbound = received - sent;
+  const uint32_t inbound = replied - now;
+  const auto offset = outbound + static_cast<uint32_t>(static_cast<int32_t>(inbound - outbound) / 2);
+
+  m_clockSamples[m_nextClockSample] = {static_cast<uint32_t>(roundTrip), offset};
+  m_nextClockSample = (m_nextClockSample + 1) % m_clockSamples.size();
+
+  // queueing delays only make a round trip longer, so the recent sample
+  // with the shortest round trip gives the most accurate offset
+  const auto *best = &m_clockSamples[0];
+  for (const auto &sample : m_clockSamples) {
+    if (sample.m_roundTrip < best->m_roundTrip) {
+      best = &sample;
+    }
+  }
+  m_clockOffset = best->m_offset;
+
+  LOG(
+      (CLOG_DEBUG2 "clock sync with \"%s\" round trip=%dus offset=%d", getName().c_str(), roundTrip,
+       static_cast<int32_t>(m_clockOffset))
+  );
+}
@@ -0,0 +1,52 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "server/ClientProxy1_8.h"
+
+#include <array>
+
+//! Proxy for client implementing protocol version 1.9
+/*!
+Adds clock synchronization to keep alives and, when input latency
+tracing is enabled, sends a trace message before each input message.
+*/
+class ClientProxy1_9 : public ClientProxy1_8
+{
+public:
+  ClientProxy1_9(const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events);
+  ~ClientProxy1_9() override = default;
+
+  // IClient overrides
+  void keyDown(KeyID, KeyModifierMask, KeyButton, const std::string &) override;
+  void keyRepeat(KeyID, KeyModifierMask, int32_t count, KeyButton, const std::string &) override;
+  void keyUp(KeyID, KeyModifierMask, KeyButton) override;
+  void mouseDown(ButtonID) override;
+  void mouseUp(ButtonID) override;
+  void mouseMove(int32_t xAbs, int32_t yAbs) override;
+  void mouseRelativeMove(int32_t xRel, int32_t yRel) override;
+  void mouseWheel(int32_t xDelta, int32_t yDelta) override;
+  void keepAlive() override;
+
+protected:
+  // ClientProxy overrides
+  bool parseMessage(const uint8_t *code) override;
+
+private:
+  struct ClockSample
+  {
+    uint32_t m_roundTrip = UINT32_MAX;
+    uint32_t m_offset = 0;
+  };
+
+  void sendInputTrace() const;
+  void updateClockOffset(uint32_t sent, uint32_t received, uint32_t replied, uint32_t now);
+
+  std::array<ClockSample, 8> m_clockSamples;
+  std::size_t m_nextClockSample = 0;
+  uint32_t m_clockOffset = 0;
+};
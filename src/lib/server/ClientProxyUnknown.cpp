@@ -18,6 +18,7 @@
 #include "io/XIO.h"
 #include "server/ClientProxy1_0.h"
 #include "server/ClientProxy1_1.h"
+#include "server/ClientProxy1_10.h"
 #include "server/ClientProxy1_2.h"
 #include "server/ClientProxy1_3.h"
 #include "server/ClientProxy1_4.h"
@@ -25,6 +26,7 @@
 #include "server/ClientProxy1_6.h"
 #include "server/ClientProxy1_7.h"
 #include "server/ClientProxy1_8.h"
+#include "server/ClientProxy1_9.h"
 #include "server/Server.h"
 
 #include <iterator>
@@ -182,6 +184,14 @@ void ClientProxyUnknown::initProxy(const std::string &name, int major, int minor
       m_proxy = new ClientProxy1_8(name, m_stream, m_server, m_events);
       break;
 
+    case 9:
+      m_proxy = new ClientProxy1_9(name, m_stream, m_server, m_events);
+      break;
+
+    case 10:
+      m_proxy = new ClientProxy1_10(name, m_stream, m_server, m_events);
+      break;
+
     default:
       break;
     }
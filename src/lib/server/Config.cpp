@@ -15,9 +15,11 @@
 #include "net/XSocket.h"
 #include "server/Server.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <istream>
 #include <ostream>
+#include <ranges>
 
 using namespace deskflow::string;
 
@@ -546,6 +548,48 @@ bool Config::operator!=(const Config &x) const
   return !operator==(x);
 }
 
+Config::Changes Config::diff(const Config &config) const
+{
+  Changes changes;
+
+  // compare the screens in both, then look for new ones
+  for (const auto &[name, cell] : m_map) {
+    const auto index = config.m_map.find(name);
+    if (index == config.m_map.end()) {
+      changes.m_removedScreens.insert(name);
+      continue;
+    }
+    if (!cell.hasSameLinks(index->second)) {
+      changes.m_relinkedScreens.insert(index->first);
+    }
+    if (cell.m_options != index->second.m_options) {
+      changes.m_optionScreens.insert(index->first);
+    }
+  }
+  for (const auto &[name, cell] : config.m_map) {
+    if (!m_map.contains(name)) {
+      changes.m_addedScreens.insert(name);
+    }
+  }
+
+  // the name map has the canonical names as well as the aliases, so
+  // skip those.  aliases are compared ignoring case, like screen names.
+  const auto aliases = [](const NameMap &names) {
+    return names | std::views::filter([](const auto &name) { return !CaselessCmp::equal(name.first, name.second); });
+  };
+  changes.m_aliases = !std::ranges::equal(
+      aliases(m_nameToCanonicalName), aliases(config.m_nameToCanonicalName),
+      [](const auto &a, const auto &b) {
+        return CaselessCmp::equal(a.first, b.first) && CaselessCmp::equal(a.second, b.second);
+      }
+  );
+
+  changes.m_globalOptions = m_globalOptions != config.m_globalOptions;
+  changes.m_filterRules = m_inputFilter != config.m_inputFilter;
+  changes.m_address = m_deskflowAddress != config.m_deskflowAddress;
+  return changes;
+}
+
 void Config::read(ConfigReadContext &context)
 {
   Config tmp(m_events);
@@ -569,6 +613,21 @@ InputFilter *Config::getInputFilter()
   return &m_inputFilter;
 }
 
+void Config::apply(const Config &config, const Changes &changes)
+{
+  m_map = config.m_map;
+  m_nameToCanonicalName = config.m_nameToCanonicalName;
+  m_deskflowAddress = config.m_deskflowAddress;
+  m_globalOptions = config.m_globalOptions;
+  m_hasLockToScreenAction = config.m_hasLockToScreenAction;
+
+  // assigning the filter disables and enables every rule on the primary
+  // screen, which registers all of its hot keys again
+  if (changes.m_filterRules) {
+    m_inputFilter = config.m_inputFilter;
+  }
+}
+
 std::string Config::formatInterval(const Interval &x)
 {
   if (x.first == 0.0f && x.second == 1.0f) {
@@ -1325,6 +1384,21 @@ std::string Config::getOptionValue(OptionID id, OptionValue value)
   return "";
 }
 
+//
+// Config::Changes
+//
+
+bool Config::Changes::hasLayoutChanges() const
+{
+  return !m_removedScreens.empty() || !m_addedScreens.empty() || !m_relinkedScreens.empty();
+}
+
+bool Config::Changes::isEmpty() const
+{
+  return !hasLayoutChanges() && m_optionScreens.empty() && !m_aliases && !m_globalOptions && !m_filterRules &&
+         !m_address;
+}
+
 //
 // Config::Name
 //
@@ -1534,14 +1608,8 @@ bool Config::Cell::getLink(Direction side, float position, const CellEdge *&src,
   return false;
 }
 
-bool Config::Cell::operator==(const Cell &x) const
+bool Config::Cell::hasSameLinks(const Cell &x) const
 {
-  // compare options
-  if (m_options != x.m_options) {
-    return false;
-  }
-
-  // compare links
   if (m_neighbors.size() != x.m_neighbors.size()) {
     return false;
   }
@@ -1566,6 +1634,17 @@ bool Config::Cell::operator==(const Cell &x) const
   return true;
 }
 
+bool Config::Cell::operator==(const Cell &x) const
+{
+  // compare options
+  if (m_options != x.m_options) {
+    return false;
+  }
+
+  // compare links
+  return hasSameLinks(x);
+}
+
 bool Config::Cell::operator!=(const Cell &x) const
 {
   return !operator==(x);
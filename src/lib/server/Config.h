@@ -54,6 +54,33 @@ class Config
 public:
   using ScreenOptions = std::map<OptionID, OptionValue>;
   using Interval = std::pair<float, float>;
+  using ScreenSet = std::set<std::string, deskflow::string::CaselessCmp>;
+
+  //! Configuration changes
+  /*!
+  What differs between two configurations, as returned by diff().
+  Screens are named as in the configuration that has them.
+  */
+  struct Changes
+  {
+    ScreenSet m_removedScreens;   //!< Screens only in the old configuration
+    ScreenSet m_addedScreens;     //!< Screens only in the new configuration
+    ScreenSet m_relinkedScreens;  //!< Screens in both whose links differ
+    ScreenSet m_optionScreens;    //!< Screens in both whose options differ
+    bool m_aliases = false;       //!< Aliases differ
+    bool m_globalOptions = false; //!< Options in the options section differ
+    bool m_filterRules = false;   //!< Hot key rules differ
+    bool m_address = false;       //!< Listen addresses differ
+
+    //! Test for a changed screen layout
+    /*!
+    Returns true if screens were added, removed or relinked.
+    */
+    bool hasLayoutChanges() const;
+
+    //! Test for no changes
+    bool isEmpty() const;
+  };
 
   class CellEdge
   {
@@ -124,6 +151,8 @@ private:
 
     bool getLink(Direction side, float position, const CellEdge *&src, const CellEdge *&dst) const;
 
+    bool hasSameLinks(const Cell &) const;
+
     bool operator==(const Cell &) const;
     bool operator!=(const Cell &) const;
 
@@ -334,6 +363,15 @@ public:
   */
   virtual InputFilter *getInputFilter();
 
+  //! Apply configuration changes
+  /*!
+  Makes this configuration equal to \c config, where \c changes is
+  what diff() returned for it.  The input filter is only assigned if
+  its rules changed, so hot keys it has registered with the primary
+  screen stay registered otherwise.
+  */
+  void apply(const Config &config, const Changes &changes);
+
   //@}
   //! @name accessors
   //@{
@@ -425,6 +463,14 @@ public:
   //! Compare configurations
   bool operator!=(const Config &) const;
 
+  //! Find configuration changes
+  /*!
+  Returns what differs between this configuration and \c config, so
+  a running server can change only the screens and options affected.
+  The configurations are equal iff the result isEmpty().
+  */
+  Changes diff(const Config &config) const;
+
   //! Read configuration
   /*!
   Reads a configuration from a context.  Throws XConfigRead on error
@@ -15,11 +15,60 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <optional>
+
+// modifiers that cannot be combined with a mouse button
+static const KeyModifierMask s_ignoreButtonMask =
+    KeyModifierAltGr | KeyModifierCapsLock | KeyModifierNumLock | KeyModifierScrollLock;
+
+static uint64_t getButtonMatchValue(ButtonID button, KeyModifierMask mask)
+{
+  return (static_cast<uint64_t>(button) << 32) | mask;
+}
+
+// match values are never more than 40 bits, leaving the top byte for the
+// kind
+static uint64_t packMatchKey(const InputFilter::MatchKey &key)
+{
+  return (static_cast<uint64_t>(key.m_kind) << 56) | key.m_value;
+}
+
+// returns nothing for events only conditions that match any event can
+// match, like keystrokes
+static std::optional<InputFilter::MatchKey> getEventMatchKey(const Event &event)
+{
+  using Kind = InputFilter::MatchKind;
+  switch (event.getType()) {
+    using enum EventTypes;
+  case PrimaryScreenHotkeyDown:
+  case PrimaryScreenHotkeyUp:
+    return InputFilter::MatchKey{Kind::HotKey, static_cast<IPlatformScreen::HotKeyInfo *>(event.getData())->m_id};
+
+  case PrimaryScreenButtonDown:
+  case PrimaryScreenButtonUp: {
+    const auto *info = static_cast<IPlatformScreen::ButtonInfo *>(event.getData());
+    return InputFilter::MatchKey{
+        Kind::MouseButton, getButtonMatchValue(info->m_button, info->m_mask & ~s_ignoreButtonMask)
+    };
+  }
+
+  case ServerConnected:
+    return InputFilter::MatchKey{Kind::ScreenConnected};
+
+  default:
+    return std::nullopt;
+  }
+}
 
 // -----------------------------------------------------------------------------
 // Input Filter Condition Classes
 // -----------------------------------------------------------------------------
 
+InputFilter::MatchKey InputFilter::Condition::getMatchKey() const
+{
+  return {};
+}
+
 void InputFilter::Condition::enablePrimary(PrimaryClient *)
 {
   // do nothing
@@ -88,6 +137,11 @@ InputFilter::FilterStatus InputFilter::KeystrokeCondition::match(const Event &ev
   return status;
 }
 
+InputFilter::MatchKey InputFilter::KeystrokeCondition::getMatchKey() const
+{
+  return {MatchKind::HotKey, m_id};
+}
+
 void InputFilter::KeystrokeCondition::enablePrimary(PrimaryClient *primary)
 {
   m_id = primary->registerHotKey(m_key, m_mask);
@@ -141,9 +195,6 @@ std::string InputFilter::MouseButtonCondition::format() const
 
 InputFilter::FilterStatus InputFilter::MouseButtonCondition::match(const Event &event)
 {
-  static const KeyModifierMask s_ignoreMask =
-      KeyModifierAltGr | KeyModifierCapsLock | KeyModifierNumLock | KeyModifierScrollLock;
-
   FilterStatus status;
 
   using enum FilterStatus;
@@ -159,13 +210,18 @@ InputFilter::FilterStatus InputFilter::MouseButtonCondition::match(const Event &
   // check if it's the right button and modifiers.  ignore modifiers
   // that cannot be combined with a mouse button.
   if (const auto *minfo = static_cast<IPlatformScreen::ButtonInfo *>(event.getData());
-      minfo->m_button != m_button || (minfo->m_mask & ~s_ignoreMask) != m_mask) {
+      minfo->m_button != m_button || (minfo->m_mask & ~s_ignoreButtonMask) != m_mask) {
     return NoMatch;
   }
 
   return status;
 }
 
+InputFilter::MatchKey InputFilter::MouseButtonCondition::getMatchKey() const
+{
+  return {MatchKind::MouseButton, getButtonMatchValue(m_button, m_mask)};
+}
+
 InputFilter::ScreenConnectedCondition::ScreenConnectedCondition(IEventQueue *events, const std::string &screen)
     : m_screen(screen),
       m_events(events)
@@ -195,6 +251,11 @@ InputFilter::FilterStatus InputFilter::ScreenConnectedCondition::match(const Eve
   return FilterStatus::NoMatch;
 }
 
+InputFilter::MatchKey InputFilter::ScreenConnectedCondition::getMatchKey() const
+{
+  return {MatchKind::ScreenConnected};
+}
+
 // -----------------------------------------------------------------------------
 // Input Filter Action Classes
 // -----------------------------------------------------------------------------
@@ -667,9 +728,12 @@ bool InputFilter::Rule::handleEvent(const Event &event)
     break;
   }
 
-  // perform actions
+  // perform actions.  only format them when they'll be logged.
+  const bool logActions = CLOG->getFilter() >= LogLevel::Debug1;
   for (auto action : *actions) {
-    LOG((CLOG_DEBUG1 "hotkey: %s", action->format().c_str()));
+    if (logActions) {
+      LOG((CLOG_DEBUG1 "hotkey: %s", action->format().c_str()));
+    }
     action->perform(event);
   }
 
@@ -758,6 +822,7 @@ InputFilter &InputFilter::operator=(const InputFilter &x)
     setPrimaryClient(nullptr);
 
     m_ruleList = x.m_ruleList;
+    m_ruleIndexValid = false;
 
     setPrimaryClient(oldClient);
   }
@@ -770,6 +835,7 @@ void InputFilter::addFilterRule(const Rule &rule)
   if (m_primaryClient != nullptr) {
     m_ruleList.back().enable(m_primaryClient);
   }
+  m_ruleIndexValid = false;
 }
 
 void InputFilter::removeFilterRule(uint32_t index)
@@ -778,10 +844,13 @@ void InputFilter::removeFilterRule(uint32_t index)
     m_ruleList[index].disable(m_primaryClient);
   }
   m_ruleList.erase(m_ruleList.begin() + index);
+  m_ruleIndexValid = false;
 }
 
 InputFilter::Rule &InputFilter::getRule(uint32_t index)
 {
+  // the caller may change the rule
+  m_ruleIndexValid = false;
   return m_ruleList[index];
 }
 
@@ -833,6 +902,9 @@ void InputFilter::setPrimaryClient(PrimaryClient *client)
       rule->enable(m_primaryClient);
     }
   }
+
+  // hotkey ids change with the primary client
+  m_ruleIndexValid = false;
 }
 
 std::string InputFilter::format(const std::string_view &linePrefix) const
@@ -886,9 +958,29 @@ void InputFilter::handleEvent(const Event &event)
       event.getFlags() | Event::EventFlags::DontFreeData | Event::EventFlags::DeliverImmediately
   );
 
-  // let each rule try to match the event until one does
-  for (auto rule = m_ruleList.begin(); rule != m_ruleList.end(); ++rule) {
-    if (rule->handleEvent(myEvent)) {
+  if (!m_ruleIndexValid) {
+    buildRuleIndex();
+  }
+
+  // let each rule that could match the event try, in rule order, until
+  // one does.  most events, like keystrokes, have no rules to try.
+  static const RuleIndexList s_noRules;
+  const RuleIndexList *keyedRules = &s_noRules;
+  if (const auto key = getEventMatchKey(event); key) {
+    if (auto i = m_ruleIndex.find(packMatchKey(*key)); i != m_ruleIndex.end()) {
+      keyedRules = &i->second;
+    }
+  }
+  auto keyed = keyedRules->begin();
+  auto any = m_anyRules.begin();
+  while (keyed != keyedRules->end() || any != m_anyRules.end()) {
+    uint32_t index;
+    if (any == m_anyRules.end() || (keyed != keyedRules->end() && *keyed < *any)) {
+      index = *keyed++;
+    } else {
+      index = *any++;
+    }
+    if (m_ruleList[index].handleEvent(myEvent)) {
       // handled
       return;
     }
@@ -897,3 +989,23 @@ void InputFilter::handleEvent(const Event &event)
   // not handled so pass through
   m_events->addEvent(myEvent);
 }
+
+void InputFilter::buildRuleIndex()
+{
+  m_ruleIndex.clear();
+  m_anyRules.clear();
+  for (uint32_t i = 0; i < m_ruleList.size(); ++i) {
+    // a rule without a condition never matches
+    const Condition *condition = m_ruleList[i].getCondition();
+    if (condition == nullptr) {
+      continue;
+    }
+
+    if (const auto key = condition->getMatchKey(); key.m_kind == MatchKind::Any) {
+      m_anyRules.push_back(i);
+    } else {
+      m_ruleIndex[packMatchKey(key)].push_back(i);
+    }
+  }
+  m_ruleIndexValid = true;
+}
@@ -15,6 +15,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 class PrimaryClient;
 class Event;
@@ -33,6 +34,27 @@ public:
     Deactivate
   };
 
+  //! Kinds of event a condition can match
+  enum class MatchKind
+  {
+    Any,
+    HotKey,
+    MouseButton,
+    ScreenConnected
+  };
+
+  //! Events a condition can match
+  /*!
+  Rules are indexed by the key of their condition so each event is only
+  offered to the rules that could match it.  The value tells apart events
+  of the same kind, such as the id of a hotkey.
+  */
+  struct MatchKey
+  {
+    MatchKind m_kind = MatchKind::Any;
+    uint64_t m_value = 0;
+  };
+
   class Condition
   {
   public:
@@ -44,6 +66,13 @@ public:
 
     virtual FilterStatus match(const Event &) = 0;
 
+    //! Get the key of the events match() can accept
+    /*!
+    The default key offers every event to the condition.  A hotkey key
+    may change when the primary client is enabled or disabled.
+    */
+    virtual MatchKey getMatchKey() const;
+
     virtual void enablePrimary(PrimaryClient *);
     virtual void disablePrimary(PrimaryClient *);
   };
@@ -63,6 +92,7 @@ public:
     Condition *clone() const override;
     std::string format() const override;
     FilterStatus match(const Event &) override;
+    MatchKey getMatchKey() const override;
     void enablePrimary(PrimaryClient *) override;
     void disablePrimary(PrimaryClient *) override;
 
@@ -88,6 +118,7 @@ public:
     Condition *clone() const override;
     std::string format() const override;
     FilterStatus match(const Event &) override;
+    MatchKey getMatchKey() const override;
 
   private:
     ButtonID m_button;
@@ -106,6 +137,7 @@ public:
     Condition *clone() const override;
     std::string format() const override;
     FilterStatus match(const Event &) override;
+    MatchKey getMatchKey() const override;
 
   private:
     std::string m_screen;
@@ -390,8 +422,20 @@ private:
   // event handling
   void handleEvent(const Event &);
 
+  // index the rules by the events they can match
+  void buildRuleIndex();
+
 private:
+  using RuleIndexList = std::vector<uint32_t>;
+
   RuleList m_ruleList;
   PrimaryClient *m_primaryClient = nullptr;
   IEventQueue *m_events;
+
+  // indices of rules by match key and of rules that can match any
+  // event, each in rule order.  rebuilt on the next event after the
+  // rules change.
+  std::unordered_map<uint64_t, RuleIndexList> m_ruleIndex;
+  RuleIndexList m_anyRules;
+  bool m_ruleIndexValid = false;
 };
@@ -10,8 +10,10 @@
 
 #include "arch/Arch.h"
 #include "base/IEventQueue.h"
+#include "base/InputTrace.h"
 #include "base/Log.h"
 #include "base/TMethodJob.h"
+#include "common/CoreStatus.h"
 #include "deskflow/AppUtil.h"
 #include "deskflow/IPlatformScreen.h"
 #include "deskflow/OptionTypes.h"
@@ -206,10 +208,7 @@ bool Server::setConfig(const ServerConfig &config)
   // configured a LockCursorToScreenAction then we don't add
   // ScrollLock as a hotkey.
   if (!m_disableLockToScreen && !m_config->hasLockToScreenAction()) {
-    IPlatformScreen::KeyInfo *key = IPlatformScreen::KeyInfo::alloc(kKeyScrollLock, 0, 0, 0);
-    InputFilter::Rule rule(new InputFilter::KeystrokeCondition(m_events, key));
-    rule.adoptAction(new InputFilter::LockCursorToScreenAction(m_events), true);
-    m_inputFilter->addFilterRule(rule);
+    addLockToScreenRule(m_inputFilter);
   }
 
   // tell primary screen about reconfiguration
@@ -224,6 +223,68 @@ bool Server::setConfig(const ServerConfig &config)
   return true;
 }
 
+bool Server::applyConfig(const ServerConfig &config)
+{
+  assert(&config != m_config);
+
+  // refuse configuration if it doesn't include the primary screen
+  if (!config.isScreen(m_primaryClient->getName())) {
+    return false;
+  }
+
+  // the running input filter has the ScrollLock hot key setConfig()
+  // added so add it to the new configuration before comparing them.
+  // like processOptions(), keep the current setting if the new
+  // configuration doesn't have one.
+  ServerConfig newConfig(config);
+  bool disableLockToScreen = m_disableLockToScreen;
+  if (const auto *options = newConfig.getOptions(""); options != nullptr) {
+    if (const auto index = options->find(kOptionDisableLockToScreen); index != options->end()) {
+      disableLockToScreen = (index->second != 0);
+    }
+  }
+  if (!disableLockToScreen && !newConfig.hasLockToScreenAction()) {
+    addLockToScreenRule(newConfig.getInputFilter());
+  }
+
+  const auto changes = m_config->diff(newConfig);
+  if (changes.isEmpty()) {
+    LOG((CLOG_DEBUG "configuration unchanged"));
+    return true;
+  }
+  LOG(
+      (CLOG_DEBUG "configuration changes: %d screens added, %d removed, %d relinked, %d with new options%s%s",
+       changes.m_addedScreens.size(), changes.m_removedScreens.size(), changes.m_relinkedScreens.size(),
+       changes.m_optionScreens.size(), changes.m_globalOptions ? ", new global options" : "",
+       changes.m_filterRules ? ", new hotkeys" : "")
+  );
+
+  // close clients that are connected but being dropped from the
+  // configuration.
+  closeClients(newConfig);
+
+  // cut over
+  m_config->apply(newConfig, changes);
+  if (changes.m_globalOptions) {
+    processOptions();
+  }
+
+  // tell primary screen about reconfiguration
+  if (changes.hasLayoutChanges()) {
+    m_primaryClient->reconfigure(getActivePrimarySides());
+  }
+
+  // tell (connected) clients about their options if they changed.
+  // global options are sent to every client.
+  for (const auto &[name, client] : m_clients) {
+    if (changes.m_globalOptions || changes.m_optionScreens.contains(name)) {
+      sendOptions(client);
+    }
+  }
+
+  return true;
+}
+
 void Server::adoptClient(BaseClientProxy *client)
 {
   assert(client != nullptr);
@@ -236,6 +297,9 @@ void Server::adoptClient(BaseClientProxy *client)
   // name must be in our configuration
   if (!m_config->isScreen(client->getName())) {
     LOG((CLOG_WARN "unrecognised client name \"%s\", check server config", client->getName().c_str()));
+    deskflow::CoreStatusChannel::send(
+        deskflow::CoreStatus::Type::ClientUnrecognised, QString::fromStdString(client->getName())
+    );
     closeClient(client, kMsgEUnknown);
     return;
   }
@@ -248,6 +312,9 @@ void Server::adoptClient(BaseClientProxy *client)
     return;
   }
   LOG((CLOG_NOTE "client \"%s\" has connected", getName(client).c_str()));
+  deskflow::CoreStatusChannel::send(
+      deskflow::CoreStatus::Type::ClientConnected, QString::fromStdString(getName(client))
+  );
 
   // send configuration options to client
   sendOptions(client);
@@ -297,6 +364,11 @@ void Server::getClients(std::vector<std::string> &list) const
   }
 }
 
+bool Server::isReceivingFiles() const
+{
+  return m_args.m_receiveFiles;
+}
+
 std::string Server::getName(const BaseClientProxy *client) const
 {
   std::string name = m_config->getCanonicalName(client->getName());
@@ -1058,6 +1130,14 @@ void Server::sendOptions(BaseClientProxy *client) const
   client->setOptions(optionsList);
 }
 
+void Server::addLockToScreenRule(InputFilter *filter) const
+{
+  IPlatformScreen::KeyInfo *key = IPlatformScreen::KeyInfo::alloc(kKeyScrollLock, 0, 0, 0);
+  InputFilter::Rule rule(new InputFilter::KeystrokeCondition(m_events, key));
+  rule.adoptAction(new InputFilter::LockCursorToScreenAction(m_events), true);
+  filter->addFilterRule(rule);
+}
+
 void Server::processOptions()
 {
   const Config::ScreenOptions *options = m_config->getOptions("");
@@ -1190,6 +1270,7 @@ void Server::handleClipboardGrabbed(const Event &event, BaseClientProxy *grabber
     clipboard.m_clipboard.close();
   }
   clipboard.m_clipboardData = clipboard.m_clipboard.marshall();
+  clipboard.m_clipboardPackets = {};
 
   // tell all other screens to take ownership of clipboard.  tell the
   // grabber that it's clipboard isn't dirty.
@@ -1431,6 +1512,7 @@ void Server::onClipboardChanged(const BaseClientProxy *sender, ClipboardID id, u
   // got new data
   LOG((CLOG_INFO "screen \"%s\" updated clipboard %d", clipboard.m_clipboardOwner.c_str(), id));
   clipboard.m_clipboardData = data;
+  clipboard.m_clipboardPackets = {};
 
   // tell all clients except the sender that the clipboard is dirty
   for (ClientList::const_iterator index = m_clients.begin(); index != m_clients.end(); ++index) {
@@ -1442,6 +1524,21 @@ void Server::onClipboardChanged(const BaseClientProxy *sender, ClipboardID id, u
   m_active->setClipboard(id, &clipboard.m_clipboard);
 }
 
+std::vector<deskflow::SharedPacket>
+Server::getClipboardPackets(ClipboardID id, const IClipboard *clipboard, bool withPNG)
+{
+  ClipboardInfo &info = m_clipboards[id];
+  if (clipboard != &info.m_clipboard) {
+    return StreamChunker::encodeClipboard(IClipboard::marshall(clipboard, withPNG), id, 0);
+  }
+
+  auto &packets = info.m_clipboardPackets[withPNG ? 1 : 0];
+  if (packets.empty()) {
+    packets = StreamChunker::encodeClipboard(IClipboard::marshall(clipboard, withPNG), id, 0);
+  }
+  return packets;
+}
+
 void Server::onScreensaver(bool activated)
 {
   LOG((CLOG_DEBUG "onScreenSaver %s", activated ? "activated" : "deactivated"));
@@ -1497,6 +1594,7 @@ void Server::onScreensaver(bool activated)
 
 void Server::onKeyDown(KeyID id, KeyModifierMask mask, KeyButton button, const std::string &lang, const char *screens)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG1 "onKeyDown id=%d mask=0x%04x button=0x%04x lang=%s", id, mask, button, lang.c_str()));
   assert(m_active != nullptr);
 
@@ -1520,6 +1618,7 @@ void Server::onKeyDown(KeyID id, KeyModifierMask mask, KeyButton button, const s
 
 void Server::onKeyUp(KeyID id, KeyModifierMask mask, KeyButton button, const char *screens)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG1 "onKeyUp id=%d mask=0x%04x button=0x%04x", id, mask, button));
   assert(m_active != nullptr);
 
@@ -1543,6 +1642,7 @@ void Server::onKeyUp(KeyID id, KeyModifierMask mask, KeyButton button, const cha
 
 void Server::onKeyRepeat(KeyID id, KeyModifierMask mask, int32_t count, KeyButton button, const std::string &lang)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG(
       (CLOG_DEBUG1 "onKeyRepeat id=%d mask=0x%04x count=%d button=0x%04x lang=\"%s\"", id, mask, count, button,
        lang.c_str())
@@ -1555,6 +1655,7 @@ void Server::onKeyRepeat(KeyID id, KeyModifierMask mask, int32_t count, KeyButto
 
 void Server::onMouseDown(ButtonID id)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG1 "onMouseDown id=%d", id));
   assert(m_active != nullptr);
 
@@ -1564,6 +1665,7 @@ void Server::onMouseDown(ButtonID id)
 
 void Server::onMouseUp(ButtonID id)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG1 "onMouseUp id=%d", id));
   assert(m_active != nullptr);
 
@@ -1573,6 +1675,7 @@ void Server::onMouseUp(ButtonID id)
 
 bool Server::onMouseMovePrimary(int32_t x, int32_t y)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG4 "onMouseMovePrimary %d,%d", x, y));
 
   // mouse move on primary (server's) screen
@@ -1670,6 +1773,7 @@ bool Server::onMouseMovePrimary(int32_t x, int32_t y)
 
 void Server::onMouseMoveSecondary(int32_t dx, int32_t dy)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG2 "onMouseMoveSecondary initial %+d,%+d", dx, dy));
   if (const char *envVal = std::getenv("DESKFLOW_MOUSE_ADJUSTMENT"); envVal) {
     try {
@@ -1844,6 +1948,7 @@ void Server::onMouseMoveSecondary(int32_t dx, int32_t dy)
 
 void Server::onMouseWheel(int32_t xDelta, int32_t yDelta)
 {
+  deskflow::InputTrace::stamp(deskflow::InputTrace::Stage::Server);
   LOG((CLOG_DEBUG1 "onMouseWheel %+d,%+d", xDelta, yDelta));
   assert(m_active != nullptr);
 
@@ -18,8 +18,10 @@
 #include "deskflow/MouseTypes.h"
 #include "deskflow/OptionTypes.h"
 #include "deskflow/ServerArgs.h"
+#include "io/SharedPacket.h"
 #include "server/Config.h"
 
+#include <array>
 #include <map>
 #include <memory>
 #include <set>
@@ -142,6 +144,19 @@ public:
   */
   bool setConfig(const ServerConfig &);
 
+  //! Apply a changed configuration
+  /*!
+  Change the server's configuration to \c config, a configuration
+  separate from the current one, such as the configuration file read
+  again.  Only what differs is applied: clients no longer in the
+  configuration are disconnected, clients whose options changed are
+  sent them again and hot keys are only registered again if the rules
+  changed, so other clients stay connected undisturbed.  Returns true
+  iff the new configuration was accepted (it must include the server's
+  name).
+  */
+  bool applyConfig(const ServerConfig &config);
+
   //! Add a client
   /*!
   Adds \p client to the server.  The client is adopted and will be
@@ -164,6 +179,16 @@ public:
     m_clientListener = p;
   }
 
+  //! Get clipboard messages
+  /*!
+  Returns the messages that send \p clipboard as clipboard \p id, with
+  images as PNG if \p withPNG.  When \p clipboard is the server's copy of
+  clipboard \p id they're encoded the first time they're asked for after
+  the clipboard changes and shared by every client sent them, otherwise
+  they're encoded each time.
+  */
+  std::vector<deskflow::SharedPacket> getClipboardPackets(ClipboardID id, const IClipboard *clipboard, bool withPNG);
+
   //@}
   //! @name accessors
   //@{
@@ -186,6 +211,12 @@ public:
   */
   void getClients(std::vector<std::string> &list) const;
 
+  //! Test if receiving files
+  /*!
+  Returns true iff files dragged from clients are saved.
+  */
+  bool isReceivingFiles() const;
+
   //@}
 
 private:
@@ -289,6 +320,9 @@ private:
   // process options from configuration
   void processOptions();
 
+  // add the ScrollLock hot key to lock the cursor to the screen
+  void addLockToScreenRule(InputFilter *filter) const;
+
   // event handlers
   void handleShapeChanged(BaseClientProxy *client);
   void handleClipboardGrabbed(const Event &event, BaseClientProxy *client);
@@ -355,6 +389,10 @@ private:
     std::string m_clipboardData;
     std::string m_clipboardOwner;
     uint32_t m_clipboardSeqNum = 0;
+
+    // messages sending the clipboard, with a bitmap then with a PNG.
+    // cleared whenever the clipboard changes.
+    std::array<std::vector<deskflow::SharedPacket>, 2> m_clipboardPackets;
   };
 
   // used in hello message sent to the client
@@ -0,0 +1,97 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LatencyHistogramTests.h"
+
+#include "base/LatencyHistogram.h"
+
+using deskflow::LatencyHistogram;
+
+void LatencyHistogramTests::empty()
+{
+  LatencyHistogram histogram;
+
+  QCOMPARE(histogram.count(), 0);
+  QCOMPARE(histogram.min(), 0);
+  QCOMPARE(histogram.max(), 0);
+  QCOMPARE(histogram.mean(), 0.0);
+  QCOMPARE(histogram.percentile(50.0), 0);
+}
+
+void LatencyHistogramTests::exactSmallValues()
+{
+  LatencyHistogram histogram;
+  for (std::uint64_t i = 0; i < 16; ++i) {
+    histogram.record(i);
+  }
+
+  QCOMPARE(histogram.count(), 16);
+  QCOMPARE(histogram.min(), 0);
+  QCOMPARE(histogram.max(), 15);
+  QCOMPARE(histogram.mean(), 7.5);
+  QCOMPARE(histogram.percentile(50.0), 7);
+  QCOMPARE(histogram.percentile(100.0), 15);
+}
+
+void LatencyHistogramTests::bucketBounds()
+{
+  QCOMPARE(LatencyHistogram::bucketFor(15), 15);
+  QCOMPARE(LatencyHistogram::bucketFor(16), 16);
+  QCOMPARE(LatencyHistogram::bucketFor(31), 31);
+  QCOMPARE(LatencyHistogram::bucketFor(32), 32);
+  QCOMPARE(LatencyHistogram::bucketFor(33), 32);
+  QCOMPARE(LatencyHistogram::bucketUpperBound(32), 33);
+  QCOMPARE(LatencyHistogram::bucketFor(0xffffffffu), LatencyHistogram::kBuckets - 1);
+
+  // every value falls at or below the upper bound of its bucket, within 1/16
+  for (std::uint64_t us : {17ull, 100ull, 1000ull, 12345ull, 999999ull, 123456789ull}) {
+    const auto upper = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketFor(us));
+    QVERIFY(upper >= us);
+    QVERIFY(upper - us <= us / 16);
+  }
+}
+
+void LatencyHistogramTests::percentiles()
+{
+  LatencyHistogram histogram;
+  for (std::uint64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i * 10);
+  }
+
+  QCOMPARE(histogram.count(), 1000);
+  QCOMPARE(histogram.min(), 10);
+  QCOMPARE(histogram.max(), 10000);
+
+  const auto p50 = histogram.percentile(50.0);
+  QVERIFY(p50 >= 5000 && p50 <= 5000 + 5000 / 16);
+
+  const auto p99 = histogram.percentile(99.0);
+  QVERIFY(p99 >= 9900 && p99 <= 10000);
+
+  QCOMPARE(histogram.percentile(100.0), 10000);
+}
+
+void LatencyHistogramTests::clampsLargeValues()
+{
+  LatencyHistogram histogram;
+  histogram.record(0x1ffffffffull);
+
+  QCOMPARE(histogram.max(), 0xffffffffull);
+  QCOMPARE(histogram.percentile(50.0), 0xffffffffull);
+}
+
+void LatencyHistogramTests::clear()
+{
+  LatencyHistogram histogram;
+  histogram.record(42);
+  histogram.clear();
+
+  QCOMPARE(histogram.count(), 0);
+  QCOMPARE(histogram.max(), 0);
+  QCOMPARE(histogram.percentile(99.0), 0);
+}
+
+QTEST_MAIN(LatencyHistogramTests)
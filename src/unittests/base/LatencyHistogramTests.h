@@ -0,0 +1,19 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class LatencyHistogramTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void empty();
+  void exactSmallValues();
+  void bucketBounds();
+  void percentiles();
+  void clampsLargeValues();
+  void clear();
+};
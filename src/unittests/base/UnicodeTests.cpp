@@ -56,4 +56,67 @@ void UnicodeTests::UCS2ToUTF8()
   QCOMPARE(result, std::string("hello", 5)); // mixed-platform expected result
 }
 
+void UnicodeTests::UTF8ToUTF16_longText()
+{
+  // long enough to be converted in blocks, with a character that isn't ascii part way through a block
+  const auto utf8 = std::string(100, 'a') + "\xc3\xa9" + std::string(40, 'b');
+
+  bool errors;
+  const auto result = Unicode::UTF8ToUTF16(utf8, &errors);
+
+  std::u16string expected = std::u16string(100, u'a') + u'\u00e9' + std::u16string(40, u'b');
+  QVERIFY(!errors);
+  QCOMPARE(result, std::string(reinterpret_cast<const char *>(expected.data()), expected.size() * 2));
+  QCOMPARE(Unicode::UTF16ToUTF8(result), utf8);
+}
+
+void UnicodeTests::UTF8ToUTF16_invalid()
+{
+  const auto utf8 = std::string(20, 'a') + "\xff" + std::string(20, 'b');
+
+  bool errors;
+  const auto result = Unicode::UTF8ToUTF16(utf8, &errors);
+
+  // decoding errors are replaced but not reported
+  std::u16string expected = std::u16string(20, u'a') + u'\ufffd' + std::u16string(20, u'b');
+  QVERIFY(!errors);
+  QCOMPARE(result, std::string(reinterpret_cast<const char *>(expected.data()), expected.size() * 2));
+}
+
+void UnicodeTests::UTF16ToUTF8_byteSwapped()
+{
+  std::string utf16("\xfe\xff", 2);
+  for (int i = 0; i < 40; ++i) {
+    utf16.append(std::string("\0x", 2));
+  }
+
+  bool errors;
+  const auto result = Unicode::UTF16ToUTF8(utf16, &errors);
+
+  QVERIFY(!errors);
+  QCOMPARE(result, std::string(40, 'x'));
+}
+
+void UnicodeTests::UTF32ToUTF8_outOfRange()
+{
+  std::u32string utf32 = std::u32string(40, U'a') + static_cast<char32_t>(0x00110000) + U'b';
+
+  bool errors;
+  const auto result = Unicode::UTF32ToUTF8(
+      std::string(reinterpret_cast<const char *>(utf32.data()), utf32.size() * 4), &errors
+  );
+
+  QVERIFY(errors);
+  QCOMPARE(result, std::string(40, 'a') + "\xef\xbf\xbd" + "b");
+}
+
+void UnicodeTests::isUTF8_longText()
+{
+  const auto text = std::string(100, 'a');
+
+  QVERIFY(Unicode::isUTF8(text));
+  QVERIFY(Unicode::isUTF8(text + "\xe6\x97\xa5" + text));
+  QVERIFY(!Unicode::isUTF8(text + "\xe6\x97" + text));
+}
+
 QTEST_MAIN(UnicodeTests)
@@ -17,6 +17,11 @@ private Q_SLOTS:
   void UTF16ToUTF8();
   void UCS2ToUTF8_kUCS2();
   void UCS2ToUTF8();
+  void UTF8ToUTF16_longText();
+  void UTF8ToUTF16_invalid();
+  void UTF16ToUTF8_byteSwapped();
+  void UTF32ToUTF8_outOfRange();
+  void isUTF8_longText();
 
 private:
   Arch m_arch;
@@ -0,0 +1,121 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "CoreStatusTests.h"
+
+using deskflow::CoreStatus;
+using deskflow::CoreStatusChannel;
+using deskflow::CoreStatusReader;
+
+void CoreStatusTests::roundTrip()
+{
+  const CoreStatus sent{CoreStatus::Type::PeerFingerprint, 7, QStringLiteral("café"), QByteArray("\x00\x01\xff", 3)};
+
+  CoreStatusReader reader;
+  reader.append(sent.encode());
+  const auto received = reader.next();
+
+  QVERIFY(received.has_value());
+  QVERIFY(received->m_type == CoreStatus::Type::PeerFingerprint);
+  QCOMPARE(received->m_code, 7u);
+  QCOMPARE(received->m_text, sent.m_text);
+  QCOMPARE(received->m_data, sent.m_data);
+  QVERIFY(!reader.next().has_value());
+  QVERIFY(!reader.isCorrupt());
+}
+
+void CoreStatusTests::partialFrame()
+{
+  const auto frame = CoreStatus{CoreStatus::Type::ClientConnected, 0, QStringLiteral("stub")}.encode();
+
+  CoreStatusReader reader;
+  for (qsizetype i = 0; i < frame.size() - 1; ++i) {
+    reader.append(frame.mid(i, 1));
+    QVERIFY(!reader.next().has_value());
+  }
+  reader.append(frame.right(1));
+
+  const auto received = reader.next();
+  QVERIFY(received.has_value());
+  QCOMPARE(received->m_text, QStringLiteral("stub"));
+}
+
+void CoreStatusTests::severalFrames()
+{
+  CoreStatusReader reader;
+  reader.append(
+      CoreStatus{CoreStatus::Type::Hello, CoreStatus::kVersion}.encode() +
+      CoreStatus{CoreStatus::Type::Listening}.encode()
+  );
+
+  const auto first = reader.next();
+  const auto second = reader.next();
+
+  QVERIFY(first.has_value());
+  QVERIFY(first->m_type == CoreStatus::Type::Hello);
+  QCOMPARE(first->m_code, CoreStatus::kVersion);
+  QVERIFY(second.has_value());
+  QVERIFY(second->m_type == CoreStatus::Type::Listening);
+  QVERIFY(!reader.next().has_value());
+}
+
+void CoreStatusTests::unknownType()
+{
+  // a newer core may send types this reader doesn't know, they're passed on to be ignored
+  CoreStatus future{CoreStatus::Type::Listening, 0, QStringLiteral("stub")};
+  auto frame = future.encode();
+  frame[4] = static_cast<char>(200);
+
+  CoreStatusReader reader;
+  reader.append(frame + CoreStatus{CoreStatus::Type::Connected}.encode());
+
+  const auto unknown = reader.next();
+  const auto known = reader.next();
+
+  QVERIFY(unknown.has_value());
+  QCOMPARE(static_cast<int>(unknown->m_type), 200);
+  QVERIFY(known.has_value());
+  QVERIFY(known->m_type == CoreStatus::Type::Connected);
+}
+
+void CoreStatusTests::oversizedFrame()
+{
+  CoreStatusReader reader;
+  reader.append(QByteArray("\xff\xff\xff\x7f", 4));
+
+  QVERIFY(!reader.next().has_value());
+  QVERIFY(reader.isCorrupt());
+
+  reader.append(CoreStatus{CoreStatus::Type::Connected}.encode());
+  QVERIFY(!reader.next().has_value());
+}
+
+void CoreStatusTests::badFieldSize()
+{
+  auto frame = CoreStatus{CoreStatus::Type::ClientConnected, 0, QStringLiteral("stub")}.encode();
+
+  // claim a longer text than the frame holds
+  frame[9] = static_cast<char>(100);
+
+  CoreStatusReader reader;
+  reader.append(frame);
+
+  QVERIFY(!reader.next().has_value());
+  QVERIFY(reader.isCorrupt());
+}
+
+void CoreStatusTests::channelOff()
+{
+  QVERIFY(!CoreStatusChannel::isEnabled());
+
+  // sending without a channel does nothing
+  CoreStatusChannel::send(CoreStatus::Type::Connected);
+  CoreStatusChannel::stop();
+
+  QVERIFY(!CoreStatusChannel::isEnabled());
+}
+
+QTEST_MAIN(CoreStatusTests)
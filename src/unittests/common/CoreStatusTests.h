@@ -0,0 +1,22 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "common/CoreStatus.h"
+
+#include <QTest>
+
+class CoreStatusTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void roundTrip();
+  void partialFrame();
+  void severalFrames();
+  void unknownType();
+  void oversizedFrame();
+  void badFieldSize();
+  void channelOff();
+};
@@ -424,4 +424,65 @@ void ArgParserTests::generic_noHook()
   QCOMPARE(i, 1);
 }
 
+void ArgParserTests::generic_latencyTrace()
+{
+  int i = 1;
+  const int argc = 2;
+  const char *kLatencyTraceCmd[argc] = {"stub", "--latency-trace"};
+
+  QVERIFY(m_parser.parseGenericArgs(argc, kLatencyTraceCmd, i));
+
+  QVERIFY(m_parser.argsBase().m_latencyTrace);
+  QCOMPARE(i, 1);
+}
+
+void ArgParserTests::generic_receiveFiles()
+{
+  int i = 1;
+  const int argc = 2;
+  const char *kReceiveFilesCmd[argc] = {"stub", "--receive-files"};
+
+  QVERIFY(!m_parser.argsBase().m_receiveFiles);
+  QVERIFY(m_parser.parseGenericArgs(argc, kReceiveFilesCmd, i));
+
+  QVERIFY(m_parser.argsBase().m_receiveFiles);
+  QCOMPARE(i, 1);
+}
+
+void ArgParserTests::generic_traceEvents()
+{
+  int i = 1;
+  const int argc = 3;
+  const char *kTraceEventsCmd[argc] = {"stub", "--trace-events", "trace.json"};
+
+  QVERIFY(m_parser.parseGenericArgs(argc, kTraceEventsCmd, i));
+
+  QCOMPARE(m_parser.argsBase().m_traceFile, "trace.json");
+  QCOMPARE(i, 2);
+}
+
+void ArgParserTests::generic_captureProtocol()
+{
+  int i = 1;
+  const int argc = 3;
+  const char *kCaptureProtocolCmd[argc] = {"stub", "--capture-protocol", "session.dfcap"};
+
+  QVERIFY(m_parser.parseGenericArgs(argc, kCaptureProtocolCmd, i));
+
+  QCOMPARE(m_parser.argsBase().m_protocolCaptureFile, "session.dfcap");
+  QCOMPARE(i, 2);
+}
+
+void ArgParserTests::generic_statusChannel()
+{
+  int i = 1;
+  const int argc = 3;
+  const char *kStatusChannelCmd[argc] = {"stub", "--status-channel", "deskflow-status-1"};
+
+  QVERIFY(m_parser.parseGenericArgs(argc, kStatusChannelCmd, i));
+
+  QCOMPARE(m_parser.argsBase().m_statusChannel, "deskflow-status-1");
+  QCOMPARE(i, 2);
+}
+
 QTEST_MAIN(ArgParserTests)
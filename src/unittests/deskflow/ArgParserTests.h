@@ -44,6 +44,11 @@ private Q_SLOTS:
   void generic_restart();
   void generic_unknown();
   void generic_noHook();
+  void generic_latencyTrace();
+  void generic_receiveFiles();
+  void generic_traceEvents();
+  void generic_captureProtocol();
+  void generic_statusChannel();
 
 private:
   Arch m_arch;
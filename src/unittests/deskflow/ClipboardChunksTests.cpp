@@ -7,8 +7,56 @@
 
 #include "ClipboardChunksTests.h"
 
+#include "base/String.h"
 #include "deskflow/ClipboardChunk.h"
 #include "deskflow/ProtocolTypes.h"
+#include "deskflow/StreamChunker.h"
+
+namespace {
+
+uint32_t decode32(const uint8_t *data)
+{
+  return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+}
+
+// checks each packet is a DCLP message with the right framing and marks,
+// and that together they carry \p data
+void checkClipboard(
+    const std::vector<deskflow::SharedPacket> &packets, const std::string &data, ClipboardID id, uint32_t sequence
+)
+{
+  std::string received;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const auto &packet = packets[i];
+    const auto *payload = packet.getPayload();
+    const auto size = decode32(payload + 10);
+    uint8_t mark = ChunkType::DataChunk;
+    if (i == 0) {
+      mark = ChunkType::DataStart;
+    } else if (i == packets.size() - 1) {
+      mark = ChunkType::DataEnd;
+    }
+
+    QCOMPARE(decode32(packet.getData()), packet.getPayloadSize());
+    QCOMPARE(std::string(reinterpret_cast<const char *>(payload), 4), std::string("DCLP"));
+    QCOMPARE(payload[4], id);
+    QCOMPARE(decode32(payload + 5), sequence);
+    QCOMPARE(payload[9], mark);
+    QCOMPARE(packet.getPayloadSize(), 14 + size);
+
+    const std::string chunk(reinterpret_cast<const char *>(payload) + 14, size);
+    if (mark == ChunkType::DataStart) {
+      QCOMPARE(chunk, deskflow::string::sizeTypeToString(data.size()));
+    } else if (mark == ChunkType::DataChunk) {
+      received.append(chunk);
+    } else {
+      QVERIFY(chunk.empty());
+    }
+  }
+  QCOMPARE(received, data);
+}
+
+} // namespace
 
 void ClipboardChunksTests::startFormatData()
 {
@@ -66,4 +114,23 @@ void ClipboardChunksTests::endFormatData()
   delete chunk;
 }
 
+void ClipboardChunksTests::encodeClipboard()
+{
+  const std::string data(512 * 1024 + 10, 'x');
+  const auto packets = StreamChunker::encodeClipboard(data, 1, 2);
+
+  // start, a full chunk, the rest and end
+  QCOMPARE(packets.size(), 4);
+  checkClipboard(packets, data, 1, 2);
+}
+
+void ClipboardChunksTests::encodeEmptyClipboard()
+{
+  const auto packets = StreamChunker::encodeClipboard("", 0, 0);
+
+  // start, one empty chunk and end
+  QCOMPARE(packets.size(), 3);
+  checkClipboard(packets, "", 0, 0);
+}
+
 QTEST_MAIN(ClipboardChunksTests)
@@ -14,4 +14,6 @@ private Q_SLOTS:
   void startFormatData();
   void formatDataChunk();
   void endFormatData();
+  void encodeClipboard();
+  void encodeEmptyClipboard();
 };
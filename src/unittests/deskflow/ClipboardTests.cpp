@@ -9,6 +9,7 @@
 #include "ClipboardTests.h"
 
 #include "deskflow/Clipboard.h"
+#include "deskflow/ClipboardImage.h"
 
 void ClipboardTests::initTestCase()
 {
@@ -229,4 +230,109 @@ void ClipboardTests::equalClipboards()
   clipboard2.close();
 }
 
+void ClipboardTests::imageRoundTrip()
+{
+  const auto bitmap = makeBitmap(33, 17);
+
+  const auto png = ClipboardImage::bitmapToPNG(bitmap);
+  QVERIFY(ClipboardImage::isPNG(png));
+  QVERIFY(png.size() < bitmap.size());
+
+  QCOMPARE(ClipboardImage::pngToBitmap(png), bitmap);
+  QVERIFY(ClipboardImage::pngToBitmap(png.substr(0, png.size() / 2)).empty());
+  QVERIFY(ClipboardImage::pngToBitmap(bitmap).empty());
+}
+
+void ClipboardTests::imageAlphaRoundTrip()
+{
+  const auto bitmap = makeBitmap(19, 7, 32);
+
+  const auto png = ClipboardImage::bitmapToPNG(bitmap);
+  QVERIFY(ClipboardImage::isPNG(png));
+
+  QCOMPARE(ClipboardImage::pngToBitmap(png), bitmap);
+}
+
+void ClipboardTests::imageInflateLimit()
+{
+  auto png = ClipboardImage::bitmapToPNG(makeBitmap(64, 64));
+
+  // claim the image is 1x1, so its data inflates to far more than that
+  const std::string oneByOne("\0\0\0\1\0\0\0\1", 8);
+  png.replace(16, oneByOne.size(), oneByOne);
+
+  QVERIFY(ClipboardImage::pngToBitmap(png).empty());
+}
+
+void ClipboardTests::marshalImageForPeer()
+{
+  const auto bitmap = makeBitmap(8, 8);
+  const auto png = ClipboardImage::bitmapToPNG(bitmap);
+
+  Clipboard clipboard;
+  clipboard.open(0);
+  clipboard.add(IClipboard::kBitmap, bitmap);
+  clipboard.add(IClipboard::kPNG, png);
+  clipboard.close();
+
+  Clipboard received;
+  received.unmarshall(IClipboard::marshall(&clipboard, true), 0);
+  received.open(0);
+  QVERIFY(!received.has(IClipboard::kBitmap));
+  QCOMPARE(received.get(IClipboard::kPNG), png);
+  received.close();
+}
+
+void ClipboardTests::marshalImageForOldPeer()
+{
+  const auto bitmap = makeBitmap(8, 8);
+
+  Clipboard clipboard;
+  clipboard.open(0);
+  clipboard.add(IClipboard::kPNG, ClipboardImage::bitmapToPNG(bitmap));
+  clipboard.close();
+
+  Clipboard received;
+  received.unmarshall(IClipboard::marshall(&clipboard, false), 0);
+  received.open(0);
+  QVERIFY(!received.has(IClipboard::kPNG));
+  QCOMPARE(received.get(IClipboard::kBitmap), bitmap);
+  received.close();
+}
+
+std::string ClipboardTests::makeBitmap(int32_t width, int32_t height, uint16_t bitCount)
+{
+  // 24 or 32 bpp BI_RGB, as the info header and rows padded to 4 bytes
+  const auto bpp = bitCount / 8;
+  const auto stride = (width * bpp + 3) & ~3;
+  std::string bitmap(40 + stride * height, '\0');
+  auto *data = reinterpret_cast<uint8_t *>(bitmap.data());
+  const auto writeLE = [data](int offset, uint32_t value, int size) {
+    for (int i = 0; i < size; ++i) {
+      data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+  };
+  writeLE(0, 40, 4);
+  writeLE(4, width, 4);
+  writeLE(8, height, 4);
+  writeLE(12, 1, 2);
+  writeLE(14, bitCount, 2);
+  writeLE(20, stride * height, 4);
+  writeLE(24, 2834, 4);
+  writeLE(28, 2834, 4);
+
+  for (int32_t y = 0; y < height; ++y) {
+    for (int32_t x = 0; x < width; ++x) {
+      auto *pixel = data + 40 + y * stride + x * bpp;
+      pixel[0] = static_cast<uint8_t>(x * 7);
+      pixel[1] = static_cast<uint8_t>(y * 11);
+      pixel[2] = static_cast<uint8_t>((x ^ y) * 5);
+      if (bpp == 4) {
+        pixel[3] = static_cast<uint8_t>(x * 13 + y);
+      }
+    }
+  }
+  return bitmap;
+}
+
 QTEST_MAIN(ClipboardTests)
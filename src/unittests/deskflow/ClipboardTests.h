@@ -24,8 +24,15 @@ private Q_SLOTS:
   void unMarshalText285();
   void unMarshalTextAndHtml();
   void equalClipboards();
+  void imageRoundTrip();
+  void imageAlphaRoundTrip();
+  void imageInflateLimit();
+  void marshalImageForPeer();
+  void marshalImageForOldPeer();
 
 private:
+  static std::string makeBitmap(int32_t width, int32_t height, uint16_t bitCount = 24);
+
   const std::string kTestString1 = "deskflow rocks";
   const std::string kTestString2 = "String 020";
   Arch m_arch;
@@ -0,0 +1,338 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "FileTransferTests.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/FileTransfer.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/BufferStream.h"
+
+#include <QFile>
+
+#include <cstring>
+
+using namespace deskflow;
+
+namespace {
+
+std::string makeData(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>((i * 7919) >> 3);
+  }
+  return data;
+}
+
+QString writeFile(const QString &path, const std::string &data)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return {};
+  }
+  file.write(data.data(), static_cast<qint64>(data.size()));
+  return path;
+}
+
+std::string readFile(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+  return file.readAll().toStdString();
+}
+
+// reads the next kMsgDFileTransfer message, returns false if there is none
+bool readMessage(BufferStream &stream, uint8_t &mark, std::string &data)
+{
+  char code[4];
+  if (stream.getSize() == 0 || stream.read(code, 4) != 4 || std::memcmp(code, kMsgDFileTransfer, 4) != 0) {
+    return false;
+  }
+  return ProtocolUtil::readf(&stream, kMsgDFileTransfer + 4, &mark, &data);
+}
+
+// passes messages from the sender to the receiver until none are left,
+// returning the state after the last one
+TransferState deliver(BufferStream &stream, BufferStream &replies, FileReceiver &receiver)
+{
+  auto state = TransferState::Error;
+  uint8_t mark = 0;
+  std::string data;
+  while (readMessage(stream, mark, data)) {
+    state = receiver.receive(&replies, mark, data);
+  }
+  return state;
+}
+
+// passes the receiver's reply to the sender
+bool resume(BufferStream &replies, FileSender &sender)
+{
+  uint8_t mark = 0;
+  std::string data;
+  if (!readMessage(replies, mark, data) || mark != ChunkType::DataResume || data.size() != 8) {
+    return false;
+  }
+
+  uint64_t offset = 0;
+  for (const auto c : data) {
+    offset = (offset << 8) | static_cast<uint8_t>(c);
+  }
+  sender.resume(offset);
+  return true;
+}
+
+} // namespace
+
+void FileTransferTests::initTestCase()
+{
+  m_arch.init();
+  m_log.setFilter(LogLevel::Debug2);
+
+  QVERIFY(m_dir.isValid());
+}
+
+void FileTransferTests::transfersFile()
+{
+  const auto data = makeData(1024 * 1024 + 123);
+  const auto source = writeFile(m_dir.filePath(QStringLiteral("source.bin")), data);
+  const auto directory = m_dir.filePath(QStringLiteral("transfersFile"));
+  BufferStream stream;
+  BufferStream replies;
+
+  FileSender sender(source);
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("source.bin"), true);
+  QVERIFY(sender.start(&stream));
+  QCOMPARE(deliver(stream, replies, receiver), TransferState::Started);
+  QVERIFY(resume(replies, sender));
+  QCOMPARE(sender.offset(), uint64_t{0});
+
+  while (!sender.isDone()) {
+    QVERIFY(sender.send(&stream, 256 * 1024));
+    const auto state = deliver(stream, replies, receiver);
+    QVERIFY(state == TransferState::InProgress || state == TransferState::Finished);
+  }
+
+  QCOMPARE(receiver.path(), QDir(directory).filePath(QStringLiteral("source.bin")));
+  QVERIFY(readFile(receiver.path()) == data);
+  QVERIFY(!QFile::exists(QDir(directory).filePath(QStringLiteral(".source.bin.peer.part"))));
+}
+
+void FileTransferTests::transfersEmptyFile()
+{
+  const auto source = writeFile(m_dir.filePath(QStringLiteral("empty.txt")), {});
+  const auto directory = m_dir.filePath(QStringLiteral("transfersEmptyFile"));
+  BufferStream stream;
+  BufferStream replies;
+
+  FileSender sender(source);
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("empty.txt"), true);
+  QVERIFY(sender.start(&stream));
+  QCOMPARE(deliver(stream, replies, receiver), TransferState::Started);
+  QVERIFY(resume(replies, sender));
+  QVERIFY(sender.send(&stream, 256 * 1024));
+  QVERIFY(sender.isDone());
+  QCOMPARE(deliver(stream, replies, receiver), TransferState::Finished);
+  QCOMPARE(QFileInfo(receiver.path()).size(), qint64{0});
+}
+
+void FileTransferTests::resumesAfterDisconnect()
+{
+  const auto data = makeData(600 * 1024);
+  const auto source = writeFile(m_dir.filePath(QStringLiteral("resumed.bin")), data);
+  const auto directory = m_dir.filePath(QStringLiteral("resumesAfterDisconnect"));
+
+  {
+    BufferStream stream;
+    BufferStream replies;
+    FileSender sender(source);
+    FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("resumed.bin"), true);
+    QVERIFY(sender.start(&stream));
+    deliver(stream, replies, receiver);
+    QVERIFY(resume(replies, sender));
+    QVERIFY(sender.send(&stream, 256 * 1024));
+    QCOMPARE(deliver(stream, replies, receiver), TransferState::InProgress);
+    QCOMPARE(receiver.offset(), uint64_t{256 * 1024});
+  }
+
+  BufferStream stream;
+  BufferStream replies;
+  FileSender sender(source);
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("resumed.bin"), true);
+  QVERIFY(sender.start(&stream));
+  deliver(stream, replies, receiver);
+  QVERIFY(resume(replies, sender));
+  QCOMPARE(sender.offset(), uint64_t{256 * 1024});
+
+  while (!sender.isDone()) {
+    QVERIFY(sender.send(&stream, 256 * 1024));
+    deliver(stream, replies, receiver);
+  }
+
+  QVERIFY(!receiver.path().isEmpty());
+  QVERIFY(readFile(receiver.path()) == data);
+}
+
+void FileTransferTests::keepsPartialFilePerPeer()
+{
+  const auto data = makeData(600 * 1024);
+  const auto source = writeFile(m_dir.filePath(QStringLiteral("shared.bin")), data);
+  const auto directory = m_dir.filePath(QStringLiteral("keepsPartialFilePerPeer"));
+
+  {
+    BufferStream stream;
+    BufferStream replies;
+    FileSender sender(source);
+    FileReceiver receiver(directory, QStringLiteral("laptop"), QStringLiteral("shared.bin"), true);
+    QVERIFY(sender.start(&stream));
+    deliver(stream, replies, receiver);
+    QVERIFY(resume(replies, sender));
+    QVERIFY(sender.send(&stream, 256 * 1024));
+    QCOMPARE(deliver(stream, replies, receiver), TransferState::InProgress);
+  }
+
+  // another peer sending a file with the same name starts its own
+  BufferStream stream;
+  BufferStream replies;
+  FileSender sender(source);
+  FileReceiver receiver(directory, QStringLiteral("desktop"), QStringLiteral("shared.bin"), true);
+  QVERIFY(sender.start(&stream));
+  deliver(stream, replies, receiver);
+  QVERIFY(resume(replies, sender));
+  QCOMPARE(sender.offset(), uint64_t{0});
+  QVERIFY(QFile::exists(QDir(directory).filePath(QStringLiteral(".shared.bin.laptop.part"))));
+  QVERIFY(QFile::exists(QDir(directory).filePath(QStringLiteral(".shared.bin.desktop.part"))));
+}
+
+void FileTransferTests::keepsExistingFile()
+{
+  const auto directory = m_dir.filePath(QStringLiteral("keepsExistingFile"));
+  QVERIFY(QDir().mkpath(directory));
+  writeFile(QDir(directory).filePath(QStringLiteral("notes.txt")), "old");
+  const auto source = writeFile(m_dir.filePath(QStringLiteral("notes.txt")), "new");
+  BufferStream stream;
+  BufferStream replies;
+
+  FileSender sender(source);
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("notes.txt"), true);
+  QVERIFY(sender.start(&stream));
+  deliver(stream, replies, receiver);
+  QVERIFY(resume(replies, sender));
+  QVERIFY(sender.send(&stream, 256 * 1024));
+  QCOMPARE(deliver(stream, replies, receiver), TransferState::Finished);
+
+  QCOMPARE(receiver.path(), QDir(directory).filePath(QStringLiteral("notes (1).txt")));
+  QVERIFY(readFile(receiver.path()) == "new");
+  QVERIFY(readFile(QDir(directory).filePath(QStringLiteral("notes.txt"))) == "old");
+}
+
+void FileTransferTests::rejectsExtraData()
+{
+  BufferStream replies;
+  const auto directory = m_dir.filePath(QStringLiteral("rejectsExtraData"));
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("short.bin"), true);
+
+  const std::string size("\0\0\0\0\0\0\0\4", 8);
+  QCOMPARE(receiver.receive(&replies, ChunkType::DataStart, size), TransferState::Started);
+  QCOMPARE(receiver.receive(&replies, ChunkType::DataChunk, "too long"), TransferState::Error);
+  QCOMPARE(receiver.receive(&replies, ChunkType::DataEnd, {}), TransferState::Error);
+  QVERIFY(receiver.path().isEmpty());
+}
+
+void FileTransferTests::rejectsFileTooLarge()
+{
+  const auto directory = m_dir.filePath(QStringLiteral("rejectsFileTooLarge"));
+  BufferStream replies;
+
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("large.bin"), true);
+  const std::string size("\x40\0\0\0\0\0\0\0", 8);
+  QCOMPARE(receiver.receive(&replies, ChunkType::DataStart, size), TransferState::Error);
+  QCOMPARE(replies.getSize(), uint32_t{0});
+  QVERIFY(!QFile::exists(QDir(directory).filePath(QStringLiteral(".large.bin.peer.part"))));
+}
+
+void FileTransferTests::restartsWithoutResume()
+{
+  const auto data = makeData(300 * 1024);
+  const auto source = writeFile(m_dir.filePath(QStringLiteral("restarted.bin")), data);
+  const auto directory = m_dir.filePath(QStringLiteral("restartsWithoutResume"));
+
+  {
+    BufferStream stream;
+    BufferStream replies;
+    FileSender sender(source);
+    FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("restarted.bin"), true);
+    QVERIFY(sender.start(&stream));
+    deliver(stream, replies, receiver);
+    QVERIFY(resume(replies, sender));
+    QVERIFY(sender.send(&stream, 128 * 1024));
+    QCOMPARE(deliver(stream, replies, receiver), TransferState::InProgress);
+  }
+
+  // a peer that can't resume gets no reply and sends the whole file again
+  BufferStream stream;
+  BufferStream replies;
+  FileSender sender(source);
+  FileReceiver receiver(directory, QStringLiteral("peer"), QStringLiteral("restarted.bin"), false);
+  QVERIFY(sender.start(&stream));
+  QCOMPARE(deliver(stream, replies, receiver), TransferState::Started);
+  QCOMPARE(replies.getSize(), uint32_t{0});
+  QCOMPARE(receiver.offset(), uint64_t{0});
+
+  sender.resume(0);
+  while (!sender.isDone()) {
+    QVERIFY(sender.send(&stream, 128 * 1024));
+    deliver(stream, replies, receiver);
+  }
+
+  QVERIFY(readFile(receiver.path()) == data);
+}
+
+void FileTransferTests::ignoresUnannouncedFile()
+{
+  const auto directory = m_dir.filePath(QStringLiteral("ignoresUnannouncedFile"));
+  EventQueue events;
+  BufferStream stream;
+  FileTransfer transfer(&stream, &events, "peer", directory);
+  transfer.setResumable(true);
+  transfer.setReceiving(true);
+
+  const std::string size("\0\0\0\0\0\0\0\4", 8);
+  ProtocolUtil::writef(&stream, kMsgDFileTransfer, ChunkType::DataStart, &size);
+  char code[4];
+  QCOMPARE(stream.read(code, 4), uint32_t{4});
+  transfer.chunkReceived();
+
+  QCOMPARE(stream.getSize(), uint32_t{0});
+  QVERIFY(!QDir(directory).exists());
+}
+
+void FileTransferTests::ignoresFilesWhenNotReceiving()
+{
+  const auto directory = m_dir.filePath(QStringLiteral("ignoresFilesWhenNotReceiving"));
+  EventQueue events;
+  BufferStream stream;
+  FileTransfer transfer(&stream, &events, "peer", directory);
+  transfer.setResumable(true);
+
+  const std::string info("notes.txt\0", 10);
+  ProtocolUtil::writef(&stream, kMsgDDragInfo, 1, &info);
+  const std::string size("\0\0\0\0\0\0\0\4", 8);
+  ProtocolUtil::writef(&stream, kMsgDFileTransfer, ChunkType::DataStart, &size);
+
+  char code[4];
+  QCOMPARE(stream.read(code, 4), uint32_t{4});
+  transfer.dragInfoReceived();
+  QCOMPARE(stream.read(code, 4), uint32_t{4});
+  transfer.chunkReceived();
+
+  QCOMPARE(stream.getSize(), uint32_t{0});
+  QVERIFY(!QDir(directory).exists());
+}
+
+QTEST_MAIN(FileTransferTests)
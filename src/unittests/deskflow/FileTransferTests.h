@@ -0,0 +1,33 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class FileTransferTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void transfersFile();
+  void transfersEmptyFile();
+  void resumesAfterDisconnect();
+  void keepsPartialFilePerPeer();
+  void keepsExistingFile();
+  void rejectsExtraData();
+  void rejectsFileTooLarge();
+  void restartsWithoutResume();
+  void ignoresUnannouncedFile();
+  void ignoresFilesWhenNotReceiving();
+
+private:
+  Arch m_arch;
+  Log m_log;
+  QTemporaryDir m_dir;
+};
@@ -183,4 +183,139 @@ void KeyMapTests::mapkey()
   QVERIFY(result == nullptr);
 }
 
+void KeyMapTests::mapKey_remembered()
+{
+  KeyMap keyMap{};
+  KeyMap::KeyItem shift;
+  shift.m_id = kKeyShift_L;
+  shift.m_button = 1;
+  shift.m_generates = KeyModifierShift;
+  keyMap.addKeyEntry(shift);
+  KeyMap::KeyItem keyItem;
+  keyItem.m_id = 'A';
+  keyItem.m_button = 2;
+  keyItem.m_required = KeyModifierShift;
+  keyItem.m_sensitive = KeyModifierShift;
+  keyMap.addKeyEntry(keyItem);
+  keyMap.finish();
+
+  KeyMap::Keystrokes first;
+  KeyMap::ModifierToKeys firstModifiers{};
+  KeyModifierMask firstState{};
+  auto result = keyMap.mapKey(first, 'A', 0, firstModifiers, firstState, 0, false, "en");
+  QVERIFY(result != nullptr);
+  QCOMPARE(result->m_button, static_cast<KeyButton>(2));
+
+  KeyMap::Keystrokes second;
+  KeyMap::ModifierToKeys secondModifiers{};
+  KeyModifierMask secondState{};
+  QCOMPARE(keyMap.mapKey(second, 'A', 0, secondModifiers, secondState, 0, false, "en"), result);
+  QCOMPARE(second.size(), first.size());
+  for (size_t i = 0; i < first.size(); ++i) {
+    QCOMPARE(second[i].m_type, first[i].m_type);
+    QCOMPARE(second[i].m_data.m_button.m_button, first[i].m_data.m_button.m_button);
+    QCOMPARE(second[i].m_data.m_button.m_press, first[i].m_data.m_button.m_press);
+  }
+  QCOMPARE(secondState, firstState);
+  QCOMPARE(secondModifiers.size(), firstModifiers.size());
+}
+
+void KeyMapTests::mapKey_forgottenAfterFinish()
+{
+  KeyMap keyMap{};
+  KeyMap::KeyItem shift;
+  shift.m_id = kKeyShift_L;
+  shift.m_button = 1;
+  shift.m_generates = KeyModifierShift;
+  keyMap.addKeyEntry(shift);
+  KeyMap::KeyItem keyItem;
+  keyItem.m_id = 'a';
+  keyItem.m_button = 2;
+  keyItem.m_required = KeyModifierShift;
+  keyItem.m_sensitive = KeyModifierShift;
+  keyMap.addKeyEntry(keyItem);
+  keyMap.finish();
+
+  KeyMap::Keystrokes strokes;
+  KeyMap::ModifierToKeys activeModifiers{};
+  KeyModifierMask currentState{};
+  auto result = keyMap.mapKey(strokes, 'a', 0, activeModifiers, currentState, 0, false, "en");
+  QVERIFY(result != nullptr);
+  QCOMPARE(result->m_button, static_cast<KeyButton>(2));
+
+  // a key that needs no shift is a better match once the map is finished
+  keyItem.m_button = 3;
+  keyItem.m_required = 0;
+  keyItem.m_sensitive = 0;
+  keyMap.addKeyEntry(keyItem);
+  keyMap.finish();
+
+  strokes.clear();
+  activeModifiers.clear();
+  currentState = 0;
+  result = keyMap.mapKey(strokes, 'a', 0, activeModifiers, currentState, 0, false, "en");
+  QVERIFY(result != nullptr);
+  QCOMPARE(result->m_button, static_cast<KeyButton>(3));
+}
+
+void KeyMapTests::marshall_roundTrip()
+{
+  KeyMap keyMap{};
+  KeyMap::KeyItem shift;
+  shift.m_id = kKeyShift_L;
+  shift.m_button = 1;
+  shift.m_generates = KeyModifierShift;
+  keyMap.addKeyEntry(shift);
+  KeyMap::KeyItem keyItem;
+  keyItem.m_id = 'a';
+  keyItem.m_button = 2;
+  keyItem.m_sensitive = KeyModifierShift;
+  keyMap.addKeyEntry(keyItem);
+  keyItem.m_id = 'A';
+  keyItem.m_required = KeyModifierShift;
+  keyMap.addKeyEntry(keyItem);
+  keyMap.addHalfDuplexButton(3);
+  keyMap.addHalfDuplexModifier(kKeyCapsLock);
+  keyMap.finish();
+
+  const auto data = keyMap.marshall();
+  KeyMap restored{};
+  QVERIFY(restored.unmarshall(data));
+  QCOMPARE(restored.marshall(), data);
+  QCOMPARE(restored.getNumGroups(), keyMap.getNumGroups());
+  QVERIFY(restored.isHalfDuplex(kKeyCapsLock, 0));
+  QVERIFY(restored.isHalfDuplex(kKeyNone, 3));
+
+  KeyMap::Keystrokes strokes;
+  KeyMap::ModifierToKeys activeModifiers{};
+  KeyModifierMask currentState{};
+  auto result = restored.mapKey(strokes, 'A', 0, activeModifiers, currentState, 0, false, "en");
+  QVERIFY(result != nullptr);
+  QCOMPARE(result->m_button, static_cast<KeyButton>(2));
+
+  KeyMap::Keystrokes expected;
+  KeyMap::ModifierToKeys expectedModifiers{};
+  KeyModifierMask expectedState{};
+  keyMap.mapKey(expected, 'A', 0, expectedModifiers, expectedState, 0, false, "en");
+  QCOMPARE(strokes.size(), expected.size());
+  QCOMPARE(currentState, expectedState);
+}
+
+void KeyMapTests::unmarshall_damaged()
+{
+  KeyMap keyMap{};
+  KeyMap::KeyItem keyItem;
+  keyItem.m_id = 'a';
+  keyItem.m_button = 2;
+  keyMap.addKeyEntry(keyItem);
+  keyMap.finish();
+  const auto data = keyMap.marshall();
+
+  KeyMap restored{};
+  QVERIFY(!restored.unmarshall({}));
+  QVERIFY(!restored.unmarshall(std::string_view(data).substr(0, data.size() - 1)));
+  QVERIFY(!restored.unmarshall(data + '\0'));
+  QCOMPARE(restored.marshall(), KeyMap{}.marshall());
+}
+
 QTEST_MAIN(KeyMapTests)
@@ -21,6 +21,10 @@ private Q_SLOTS:
   void findBestKey_noRequiredDown_cannotMatch();
   void isCommand();
   void mapkey();
+  void mapKey_remembered();
+  void mapKey_forgottenAfterFinish();
+  void marshall_roundTrip();
+  void unmarshall_damaged();
 
 private:
   Arch m_arch;
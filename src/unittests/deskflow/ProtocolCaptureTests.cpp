@@ -0,0 +1,131 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ProtocolCaptureTests.h"
+
+#include "deskflow/ProtocolCapture.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <string>
+
+using deskflow::ProtocolCapture;
+using deskflow::ProtocolCaptureReader;
+using Peer = ProtocolCapture::Peer;
+using RecordType = ProtocolCapture::RecordType;
+
+void ProtocolCaptureTests::disabledByDefault()
+{
+  QVERIFY(!ProtocolCapture::isEnabled());
+  QCOMPARE(ProtocolCapture::openStream(Peer::Server), 0);
+}
+
+void ProtocolCaptureTests::roundTrip()
+{
+  QTemporaryDir dir;
+  const auto filename = dir.filePath("capture.dfcap").toStdString();
+
+  QVERIFY(ProtocolCapture::start(filename));
+  const auto server = ProtocolCapture::openStream(Peer::Server);
+  const auto client = ProtocolCapture::openStream(Peer::Client);
+  ProtocolCapture::record(server, RecordType::Input, "CINN", 4);
+  ProtocolCapture::record(client, RecordType::Output, "QINF", 4);
+  ProtocolCapture::record(server, RecordType::Output, "CNOP", 4);
+  ProtocolCapture::closeStream(server);
+  ProtocolCapture::stop();
+
+  // nothing is recorded once stopped
+  ProtocolCapture::record(client, RecordType::Input, "DINF", 4);
+
+  ProtocolCaptureReader reader;
+  QVERIFY(reader.open(filename));
+  QVERIFY(!reader.isTruncated());
+  QCOMPARE(reader.records().size(), 6);
+  QCOMPARE(reader.streams(), std::vector<std::uint16_t>({server, client}));
+  QCOMPARE(reader.peer(server), Peer::Server);
+  QCOMPARE(reader.peer(client), Peer::Client);
+
+  const auto records = reader.records(server);
+  QCOMPARE(records.size(), 4);
+  QCOMPARE(records[0].m_type, RecordType::Open);
+  QCOMPARE(records[1].m_type, RecordType::Input);
+  QCOMPARE(std::string(reinterpret_cast<const char *>(records[1].m_data), records[1].m_size), "CINN");
+  QCOMPARE(records[2].m_type, RecordType::Output);
+  QCOMPARE(std::string(reinterpret_cast<const char *>(records[2].m_data), records[2].m_size), "CNOP");
+  QCOMPARE(records[3].m_type, RecordType::Close);
+  QCOMPARE(records[3].m_size, 0);
+
+  for (std::size_t i = 1; i < records.size(); ++i) {
+    QVERIFY(records[i].m_time >= records[i - 1].m_time);
+  }
+}
+
+void ProtocolCaptureTests::payloadAlignment()
+{
+  QTemporaryDir dir;
+  const auto filename = dir.filePath("capture.dfcap").toStdString();
+
+  QVERIFY(ProtocolCapture::start(filename));
+  const auto stream = ProtocolCapture::openStream(Peer::Server);
+  for (std::uint32_t size = 0; size < 20; ++size) {
+    const std::string payload(size, static_cast<char>('a' + size));
+    ProtocolCapture::record(stream, RecordType::Input, payload.data(), size);
+  }
+  ProtocolCapture::stop();
+
+  ProtocolCaptureReader reader;
+  QVERIFY(reader.open(filename));
+  const auto records = reader.records(stream);
+  QCOMPARE(records.size(), 21);
+  for (std::uint32_t size = 0; size < 20; ++size) {
+    const auto &record = records[size + 1];
+    QCOMPARE(record.m_size, size);
+    QCOMPARE(reinterpret_cast<std::uintptr_t>(record.m_data) % ProtocolCapture::kAlignment, 0);
+    QCOMPARE(
+        std::string(reinterpret_cast<const char *>(record.m_data), record.m_size),
+        std::string(size, static_cast<char>('a' + size))
+    );
+  }
+}
+
+void ProtocolCaptureTests::truncated()
+{
+  QTemporaryDir dir;
+  const auto filename = dir.filePath("capture.dfcap").toStdString();
+
+  QVERIFY(ProtocolCapture::start(filename));
+  const auto stream = ProtocolCapture::openStream(Peer::Client);
+  ProtocolCapture::record(stream, RecordType::Input, "DINF", 4);
+  ProtocolCapture::record(stream, RecordType::Input, "DCLP", 4);
+  ProtocolCapture::stop();
+
+  // cut the last payload short, as a crash would
+  QFile file(QString::fromStdString(filename));
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.resize(file.size() - 6));
+  file.close();
+
+  ProtocolCaptureReader reader;
+  QVERIFY(reader.open(filename));
+  QVERIFY(reader.isTruncated());
+  QCOMPARE(reader.records().size(), 2);
+  QCOMPARE(reader.records()[1].m_size, 4);
+}
+
+void ProtocolCaptureTests::notCapture()
+{
+  const std::string text = "Deskflow is not a capture file";
+
+  ProtocolCaptureReader reader;
+  QVERIFY(!reader.parse(reinterpret_cast<const std::uint8_t *>(text.data()), text.size()));
+  QVERIFY(!reader.error().empty());
+  QVERIFY(reader.records().empty());
+
+  QVERIFY(!reader.open("missing.dfcap"));
+}
+
+QTEST_MAIN(ProtocolCaptureTests)
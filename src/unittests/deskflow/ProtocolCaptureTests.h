@@ -0,0 +1,18 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class ProtocolCaptureTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void disabledByDefault();
+  void roundTrip();
+  void payloadAlignment();
+  void truncated();
+  void notCapture();
+};
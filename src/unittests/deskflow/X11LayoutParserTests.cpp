@@ -9,8 +9,13 @@
 
 #include "deskflow/unix/X11LayoutsParser.h"
 
+#include <QStandardPaths>
+
 void X11LayoutParserTests::initTestCase()
 {
+  // keep the parsed layout cache out of the user's cache directory
+  QStandardPaths::setTestModeEnabled(true);
+
   QDir dir;
   QVERIFY(dir.mkpath(kTestDir));
 
@@ -82,4 +87,23 @@ void X11LayoutParserTests::convertLayouts()
   QCOMPARE(X11LayoutsParser::convertLayotToISO(kTestFutureFile.toStdString(), "us", true), "");
 }
 
+void X11LayoutParserTests::cachedLayouts()
+{
+  QFile evdevFile(kTestCacheFile);
+  QVERIFY(evdevFile.open(QIODevice::WriteOnly));
+  evdevFile.write(kCorrectEvContents.toUtf8());
+  evdevFile.close();
+
+  // the first call parses the file and the second reads the cache
+  QCOMPARE(X11LayoutsParser::convertLayotToISO(kTestCacheFile.toStdString(), "ru", true), "ru");
+  QCOMPARE(X11LayoutsParser::convertLayotToISO(kTestCacheFile.toStdString(), "ru", true), "ru");
+
+  // a changed file is parsed again
+  QVERIFY(evdevFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  evdevFile.write(kFutureEvContents.toUtf8());
+  evdevFile.close();
+  QCOMPARE(X11LayoutsParser::convertLayotToISO(kTestCacheFile.toStdString(), "ru", true), "");
+  QCOMPARE(X11LayoutsParser::convertLayotToISO(kTestCacheFile.toStdString(), "futureLangName", true), "");
+}
+
 QTEST_MAIN(X11LayoutParserTests)
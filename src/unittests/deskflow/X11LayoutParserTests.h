@@ -16,6 +16,7 @@ private Q_SLOTS:
   void initTestCase();
   void xmlParse();
   void convertLayouts();
+  void cachedLayouts();
 
 private:
   Arch m_arch;
@@ -26,6 +27,7 @@ private:
   const QString kTestBadFile1 = "tmp/test/evdevBad1.xml";
   const QString kTestBadFile2 = "tmp/test/evdevBad2.xml";
   const QString kTestBadFile3 = "tmp/test/evdevBad3.xml";
+  const QString kTestCacheFile = "tmp/test/evdevCached.xml";
 
   const QString kCorrectEvContents = QStringLiteral(
       "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
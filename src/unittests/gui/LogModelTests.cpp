@@ -0,0 +1,125 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LogModelTests.h"
+
+#include "gui/LogModel.h"
+
+#include <QSignalSpy>
+
+using namespace deskflow::gui;
+using Level = LogModel::Level;
+
+void LogModelTests::parseLevel()
+{
+  QCOMPARE(LogModel::parseLevel("[2026-01-01T00:00:00] ERROR: failed", Level::Info), Level::Error);
+  QCOMPARE(LogModel::parseLevel("[2026-01-01T00:00:00] WARNING: odd", Level::Info), Level::Warning);
+  QCOMPARE(LogModel::parseLevel("[2026-01-01T00:00:00] DEBUG1: detail", Level::Info), Level::Debug1);
+  QCOMPARE(LogModel::parseLevel("[2026-01-01T00:00:00] DEBUG5: detail", Level::Info), Level::Debug2);
+  QCOMPARE(LogModel::parseLevel("[2026-01-01T00:00:00] CRITICAL: gui", Level::Info), Level::Error);
+  QCOMPARE(LogModel::parseLevel("\tsrc/lib/base/Log.cpp:123", Level::Warning), Level::Warning);
+  QCOMPARE(LogModel::parseLevel("[2026-01-01T00:00:00] not a level: text", Level::Note), Level::Note);
+}
+
+void LogModelTests::batchesLines()
+{
+  LogModel model;
+  QSignalSpy spy(&model, &LogModel::rowsInserted);
+  QVERIFY(spy.isValid());
+
+  model.appendLine("[time] INFO: one");
+  model.appendLine("[time] INFO: two");
+  model.appendLine("[time] INFO: three");
+  QCOMPARE(model.rowCount(), 0);
+
+  QVERIFY(spy.wait(LogModel::kFlushInterval * 10));
+  QCOMPARE(spy.count(), 1);
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.text(2), "[time] INFO: three");
+}
+
+void LogModelTests::dropsOldest()
+{
+  LogModel model(nullptr, 3);
+
+  for (int i = 0; i < 5; i++) {
+    model.appendLine(QStringLiteral("[time] INFO: %1").arg(i));
+    model.flush();
+  }
+
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.text(0), "[time] INFO: 2");
+  QCOMPARE(model.text(2), "[time] INFO: 4");
+  QCOMPARE(model.data(model.index(1)).toString(), "[time] INFO: 3");
+}
+
+void LogModelTests::batchLargerThanCapacity()
+{
+  LogModel model(nullptr, 2);
+  model.appendLine("[time] INFO: old");
+  model.flush();
+
+  for (int i = 0; i < 4; i++) {
+    model.appendLine(QStringLiteral("[time] INFO: %1").arg(i));
+  }
+  model.flush();
+
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.text(0), "[time] INFO: 2");
+  QCOMPARE(model.text(1), "[time] INFO: 3");
+}
+
+void LogModelTests::setCapacity()
+{
+  LogModel model(nullptr, 4);
+  for (int i = 0; i < 6; i++) {
+    model.appendLine(QStringLiteral("[time] INFO: %1").arg(i));
+  }
+  model.flush();
+
+  model.setCapacity(2);
+  QCOMPARE(model.capacity(), 2);
+  QCOMPARE(model.rowCount(), 2);
+  QCOMPARE(model.text(0), "[time] INFO: 4");
+  QCOMPARE(model.text(1), "[time] INFO: 5");
+
+  model.setCapacity(8);
+  model.appendLine("[time] INFO: 6");
+  model.flush();
+  QCOMPARE(model.rowCount(), 3);
+  QCOMPARE(model.text(2), "[time] INFO: 6");
+}
+
+void LogModelTests::filter()
+{
+  LogModel model;
+  LogFilterModel filter;
+  filter.setSourceModel(&model);
+
+  model.appendLine("[time] ERROR: connection failed");
+  model.appendLine("\tsrc/lib/net/Socket.cpp:10");
+  model.appendLine("[time] INFO: connected to server");
+  model.appendLine("[time] DEBUG: sending keep alive");
+  model.flush();
+  QCOMPARE(filter.rowCount(), 4);
+
+  filter.setMaxLevel(Level::Info);
+  QCOMPARE(filter.rowCount(), 3);
+
+  filter.setMaxLevel(Level::Error);
+  QCOMPARE(filter.rowCount(), 2);
+  QCOMPARE(filter.index(1, 0).data().toString(), "\tsrc/lib/net/Socket.cpp:10");
+
+  filter.setMaxLevel(Level::Debug2);
+  filter.setText("CONNECT");
+  QCOMPARE(filter.rowCount(), 2);
+
+  model.appendLine("[time] NOTE: reconnecting");
+  model.flush();
+  QCOMPARE(filter.rowCount(), 3);
+}
+
+QTEST_MAIN(LogModelTests)
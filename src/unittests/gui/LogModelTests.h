@@ -0,0 +1,20 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class LogModelTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  // Test are run in order top to bottom
+  void parseLevel();
+  void batchesLines();
+  void dropsOldest();
+  void batchLargerThanCapacity();
+  void setCapacity();
+  void filter();
+};
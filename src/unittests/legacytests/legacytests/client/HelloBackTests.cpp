@@ -226,3 +226,39 @@ TEST(HelloBackTests, handleHello_synergyProtocolCompat_wroteHelloBack)
 
   helloBack.handleHello(&stream, clientName);
 }
+
+// If the client is protocol version 1.9 and the server is 1.8, the client
+// should downgrade and remember the version for the rest of the session.
+TEST(HelloBackTests, handleHello_synergyProtocolCompat_negotiatedVersion)
+{
+  auto deps = std::make_shared<NiceMock<MockDeps>>();
+  HelloBack helloBack(deps, 1, 9);
+  NiceMock<MockStream> stream;
+  const std::string clientName = "test client";
+
+  setupMockHelloRead(stream, "Synergy", 1, 8);
+
+  setupMockHelloBackWrite(stream, "Synergy", 1, 8, "test client");
+
+  helloBack.handleHello(&stream, clientName);
+
+  EXPECT_EQ(8, helloBack.negotiatedMinorVersion());
+}
+
+// If the client is protocol version 1.10 and the server is 1.9, the client
+// should downgrade so that clipboard images are sent as bitmaps.
+TEST(HelloBackTests, handleHello_synergyProtocolCompat_downgradeFromLatest)
+{
+  auto deps = std::make_shared<NiceMock<MockDeps>>();
+  HelloBack helloBack(deps, 1, 10);
+  NiceMock<MockStream> stream;
+  const std::string clientName = "test client";
+
+  setupMockHelloRead(stream, "Synergy", 1, 9);
+
+  setupMockHelloBackWrite(stream, "Synergy", 1, 9, "test client");
+
+  helloBack.handleHello(&stream, clientName);
+
+  EXPECT_EQ(9, helloBack.negotiatedMinorVersion());
+}
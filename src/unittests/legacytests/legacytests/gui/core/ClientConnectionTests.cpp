@@ -122,3 +122,28 @@ TEST_F(ClientConnectionTests, handleLogLine_otherMessage_shouldNotShowError)
 
   clientConnection.handleLogLine("hello world");
 }
+
+TEST_F(ClientConnectionTests, handleStatus_nameInUse_showAlreadyConnectedError)
+{
+  ClientConnection clientConnection(nullptr, m_pDeps);
+
+  const QString serverName = "test server";
+  Settings::setValue(Settings::Client::RemoteHost, serverName);
+
+  EXPECT_CALL(*m_pDeps, showError(_, AlreadyConnected, serverName)).Times(1);
+
+  using enum deskflow::CoreStatus::Refusal;
+  clientConnection.handleStatus({deskflow::CoreStatus::Type::ConnectRefused, static_cast<uint32_t>(NameInUse)});
+  clientConnection.handleStatus({deskflow::CoreStatus::Type::ConnectFailed});
+}
+
+TEST_F(ClientConnectionTests, handleStatus_nameUnknown_shouldNotShowError)
+{
+  ClientConnection clientConnection(nullptr, m_pDeps);
+
+  EXPECT_CALL(*m_pDeps, showError(_, _, _)).Times(0);
+
+  using enum deskflow::CoreStatus::Refusal;
+  clientConnection.handleStatus({deskflow::CoreStatus::Type::ConnectRefused, static_cast<uint32_t>(NameUnknown)});
+  clientConnection.handleStatus({deskflow::CoreStatus::Type::ConnectFailed});
+}
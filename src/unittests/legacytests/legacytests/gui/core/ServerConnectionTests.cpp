@@ -78,3 +78,23 @@ TEST_F(ServerConnectionTests, handleLogLine_screenExists_shouldNotShowPrompt)
 
   serverConnection.handleLogLine(R"(unrecognised client name "test client")");
 }
+
+TEST_F(ServerConnectionTests, handleStatus_unrecognisedClient_shouldShowPrompt)
+{
+  ServerConnection serverConnection(nullptr, m_serverConfig, m_pDeps);
+
+  EXPECT_CALL(*m_pDeps, showNewClientPrompt(_, QString("test client"), _))
+      .WillOnce(testing::Return(messages::NewClientPromptResult::Ignore));
+
+  serverConnection.handleStatus({deskflow::CoreStatus::Type::ClientUnrecognised, 0, "test client"});
+}
+
+TEST_F(ServerConnectionTests, handleStatus_connectedClient_shouldNotShowPrompt)
+{
+  ServerConnection serverConnection(nullptr, m_serverConfig, m_pDeps);
+  serverConnection.handleStatus({deskflow::CoreStatus::Type::ClientConnected, 0, "test client"});
+
+  EXPECT_CALL(*m_pDeps, showNewClientPrompt(_, _, _)).Times(0);
+
+  serverConnection.handleStatus({deskflow::CoreStatus::Type::ClientUnrecognised, 0, "test client"});
+}
@@ -0,0 +1,97 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "HandshakePoolTests.h"
+
+#include "net/HandshakePool.h"
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+void HandshakePoolTests::runsTasks()
+{
+  HandshakePool pool(2);
+  QCOMPARE(pool.threads(), std::size_t{2});
+
+  const int owner = 0;
+  std::atomic_int ran = 0;
+  std::latch done(100);
+  for (int i = 0; i < 100; ++i) {
+    pool.add(&owner, [&ran, &done] {
+      ++ran;
+      done.count_down();
+    });
+  }
+
+  done.wait();
+  QCOMPARE(ran.load(), 100);
+}
+
+void HandshakePoolTests::cancelDropsQueued()
+{
+  HandshakePool pool(1);
+  const int busy = 0;
+  const int owner = 0;
+  std::latch started(1);
+  std::latch release(1);
+  std::atomic_int ran = 0;
+
+  // keep the only worker busy so the owner's tasks stay queued
+  pool.add(&busy, [&started, &release] {
+    started.count_down();
+    release.wait();
+  });
+  pool.add(&owner, [&ran] { ++ran; });
+  pool.add(&owner, [&ran] { ++ran; });
+
+  started.wait();
+  pool.cancel(&owner);
+  release.count_down();
+  pool.cancel(&busy);
+
+  QCOMPARE(ran.load(), 0);
+}
+
+void HandshakePoolTests::cancelWaitsForRunning()
+{
+  HandshakePool pool(1);
+  const int owner = 0;
+  std::latch started(1);
+  std::atomic_bool finished = false;
+
+  pool.add(&owner, [&started, &finished] {
+    started.count_down();
+    std::this_thread::sleep_for(50ms);
+    finished = true;
+  });
+
+  started.wait();
+  pool.cancel(&owner);
+  QVERIFY(finished);
+}
+
+void HandshakePoolTests::cancelFromOwnTask()
+{
+  HandshakePool pool(1);
+  const int owner = 0;
+  std::latch done(1);
+  std::atomic_bool cancelled = false;
+
+  pool.add(&owner, [&pool, &owner, &done, &cancelled] {
+    pool.cancel(&owner);
+    cancelled = true;
+    done.count_down();
+  });
+
+  done.wait();
+  QVERIFY(cancelled);
+}
+
+QTEST_MAIN(HandshakePoolTests)
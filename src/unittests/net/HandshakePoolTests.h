@@ -0,0 +1,17 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class HandshakePoolTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void runsTasks();
+  void cancelDropsQueued();
+  void cancelWaitsForRunning();
+  void cancelFromOwnTask();
+};
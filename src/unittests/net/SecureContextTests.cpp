@@ -0,0 +1,145 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "SecureContextTests.h"
+
+#include "net/SecureContext.h"
+#include "net/SecureUtils.h"
+
+#include <filesystem>
+#include <openssl/ssl.h>
+
+namespace {
+
+// handshake over an in-memory pipe, returns true if the session was resumed
+bool connect(const SecureContext &client, const SecureContext &server, bool trust)
+{
+  auto *clientSsl = SSL_new(client.context());
+  auto *serverSsl = SSL_new(server.context());
+  BIO *clientBio = nullptr;
+  BIO *serverBio = nullptr;
+  BIO_new_bio_pair(&clientBio, 0, &serverBio, 0);
+  SSL_set_bio(clientSsl, clientBio, clientBio);
+  SSL_set_bio(serverSsl, serverBio, serverBio);
+  SSL_set_connect_state(clientSsl);
+  SSL_set_accept_state(serverSsl);
+  client.resumeSession(clientSsl);
+
+  int clientResult = 0;
+  int serverResult = 0;
+  for (int i = 0; i < 10 && (clientResult != 1 || serverResult != 1); ++i) {
+    clientResult = SSL_do_handshake(clientSsl);
+    serverResult = SSL_do_handshake(serverSsl);
+  }
+
+  if (trust) {
+    // the tls 1.3 tickets arrive after the handshake
+    client.trustSession(clientSsl);
+    char byte;
+    SSL_read(clientSsl, &byte, sizeof(byte));
+  }
+
+  const bool resumed = SSL_session_reused(serverSsl) == 1;
+  SSL_shutdown(clientSsl);
+  SSL_shutdown(serverSsl);
+  SSL_free(clientSsl);
+  SSL_free(serverSsl);
+  return resumed;
+}
+
+} // namespace
+
+void SecureContextTests::initTestCase()
+{
+  m_arch.init();
+  m_log.setFilter(LogLevel::Debug2);
+
+  QVERIFY(m_dir.isValid());
+  m_certificate = m_dir.filePath("deskflow.pem").toStdString();
+  deskflow::generatePemSelfSignedCert(m_certificate, 2048);
+}
+
+void SecureContextTests::loadsCertificate()
+{
+  SecureContext context(true, SecurityLevel::Encrypted, m_certificate, false);
+
+  QVERIFY(context.context() != nullptr);
+  QVERIFY(context.isLoaded());
+  QVERIFY(!context.isModified());
+}
+
+void SecureContextTests::missingCertificate()
+{
+  const auto missing = m_dir.filePath("missing.pem").toStdString();
+  auto context = SecureContext::update(nullptr, true, SecurityLevel::Encrypted, missing, false);
+  QVERIFY(!context->isLoaded());
+
+  // a failed load is not reused, the file may appear later
+  QVERIFY(SecureContext::update(context, true, SecurityLevel::Encrypted, missing, false) != context);
+}
+
+void SecureContextTests::reusedWhenUnchanged()
+{
+  auto context = SecureContext::update(nullptr, false, SecurityLevel::PeerAuth, m_certificate, false);
+  QVERIFY(context->isLoaded());
+
+  QCOMPARE(SecureContext::update(context, false, SecurityLevel::PeerAuth, m_certificate, false), context);
+
+  // a changed kernel tls setting needs a new context
+  QVERIFY(SecureContext::update(context, false, SecurityLevel::PeerAuth, m_certificate, true) != context);
+}
+
+void SecureContextTests::reloadedWhenModified()
+{
+  const auto certificate = m_dir.filePath("reload.pem").toStdString();
+  deskflow::generatePemSelfSignedCert(certificate, 2048);
+  auto context = SecureContext::update(nullptr, true, SecurityLevel::Encrypted, certificate, false);
+  QVERIFY(context->isLoaded());
+
+  // push the time forward, the new file may be written within the same tick
+  deskflow::generatePemSelfSignedCert(certificate, 2048);
+  const auto path = std::filesystem::path(certificate);
+  std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+  QVERIFY(context->isModified());
+
+  auto reloaded = SecureContext::update(context, true, SecurityLevel::Encrypted, certificate, false);
+  QVERIFY(reloaded != context);
+  QVERIFY(reloaded->isLoaded());
+  QVERIFY(!reloaded->isModified());
+
+  // the old context stays usable for sockets that still hold it
+  QVERIFY(context->context() != nullptr);
+}
+
+void SecureContextTests::separateRoles()
+{
+  auto server = SecureContext::update(nullptr, true, SecurityLevel::Encrypted, m_certificate, false);
+  auto client = SecureContext::update(server, false, SecurityLevel::Encrypted, m_certificate, false);
+  QVERIFY(client != server);
+  QVERIFY(!client->isServer());
+
+  auto peerAuth = SecureContext::update(client, false, SecurityLevel::PeerAuth, m_certificate, false);
+  QVERIFY(peerAuth != client);
+  QCOMPARE(peerAuth->securityLevel(), SecurityLevel::PeerAuth);
+}
+
+void SecureContextTests::resumesTrustedSession()
+{
+  SecureContext server(true, SecurityLevel::PeerAuth, m_certificate, false);
+  SecureContext client(false, SecurityLevel::PeerAuth, m_certificate, false);
+
+  // nothing is saved until the server is trusted
+  QVERIFY(!connect(client, server, false));
+  QVERIFY(!connect(client, server, true));
+
+  QVERIFY(connect(client, server, true));
+  QVERIFY(connect(client, server, true));
+
+  client.forgetSession();
+  QVERIFY(!connect(client, server, false));
+}
+
+QTEST_MAIN(SecureContextTests)
@@ -0,0 +1,30 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class SecureContextTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void loadsCertificate();
+  void missingCertificate();
+  void reusedWhenUnchanged();
+  void reloadedWhenModified();
+  void separateRoles();
+  void resumesTrustedSession();
+
+private:
+  Arch m_arch;
+  Log m_log;
+  QTemporaryDir m_dir;
+  std::string m_certificate;
+};
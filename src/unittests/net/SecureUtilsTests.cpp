@@ -9,6 +9,8 @@
 
 #include "net/SecureUtils.h"
 
+#include <QTemporaryDir>
+
 using namespace deskflow;
 
 void SecureUtilsTests::checkHex()
@@ -46,4 +48,36 @@ void SecureUtilsTests::checkArt()
   );
 }
 
+void SecureUtilsTests::keyTypeStrings()
+{
+  for (const auto keyType : {KeyType::RSA, KeyType::ECDSA, KeyType::Ed25519}) {
+    QCOMPARE(keyTypeFromString(keyTypeToString(keyType)), keyType);
+  }
+
+  QCOMPARE(keyTypeFromString(QStringLiteral("ECDSA")), KeyType::ECDSA);
+  QCOMPARE(keyTypeFromString(QStringLiteral("dsa")), KeyType::RSA);
+  QCOMPARE(keyTypeFromString(QString()), KeyType::RSA);
+}
+
+void SecureUtilsTests::generateKeyTypes()
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+
+  const auto rsa = dir.filePath(QStringLiteral("rsa.pem")).toStdString();
+  generatePemSelfSignedCert(rsa, 2048, KeyType::RSA);
+  QCOMPARE(getCertKeyType(rsa), KeyType::RSA);
+  QCOMPARE(getCertLength(rsa), 2048);
+
+  const auto ecdsa = dir.filePath(QStringLiteral("ecdsa.pem")).toStdString();
+  generatePemSelfSignedCert(ecdsa, 2048, KeyType::ECDSA);
+  QCOMPARE(getCertKeyType(ecdsa), KeyType::ECDSA);
+  QCOMPARE(getCertLength(ecdsa), 256);
+
+  const auto ed25519 = dir.filePath(QStringLiteral("ed25519.pem")).toStdString();
+  generatePemSelfSignedCert(ed25519, 2048, KeyType::Ed25519);
+  QCOMPARE(getCertKeyType(ed25519), KeyType::Ed25519);
+  QVERIFY(!pemFileCertFingerprint(ed25519, Fingerprint::Type::SHA256).data.isEmpty());
+}
+
 QTEST_MAIN(SecureUtilsTests)
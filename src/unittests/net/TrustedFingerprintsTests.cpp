@@ -0,0 +1,102 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "TrustedFingerprintsTests.h"
+
+#include "net/FingerprintDatabase.h"
+#include "net/TrustedFingerprints.h"
+
+#include <QFile>
+
+namespace {
+
+Fingerprint sha256(char fill)
+{
+  return {Fingerprint::Type::SHA256, QByteArray(32, fill)};
+}
+
+void writeDatabase(const QString &path, const QList<Fingerprint> &fingerprints)
+{
+  FingerprintDatabase db;
+  for (const auto &fingerprint : fingerprints) {
+    db.addTrusted(fingerprint);
+  }
+  QVERIFY(db.write(path));
+}
+
+} // namespace
+
+void TrustedFingerprintsTests::initTestCase()
+{
+  m_arch.init();
+  m_log.setFilter(LogLevel::Debug2);
+
+  QVERIFY(m_dir.isValid());
+}
+
+void TrustedFingerprintsTests::trusted()
+{
+  const auto path = m_dir.filePath("trusted.txt");
+  writeDatabase(path, {sha256('\x01'), sha256('\x02')});
+
+  TrustedFingerprints trusted(path);
+  QVERIFY(trusted.isTrusted(sha256('\x01')));
+  QVERIFY(trusted.isTrusted(sha256('\x02')));
+  QVERIFY(!trusted.isTrusted(sha256('\x03')));
+  QVERIFY(trusted.exists());
+  QCOMPARE(trusted.count(), 2);
+}
+
+void TrustedFingerprintsTests::sha1NotTrusted()
+{
+  const auto path = m_dir.filePath("sha1.txt");
+  const Fingerprint sha1 = {Fingerprint::Type::SHA1, QByteArray(20, '\x01')};
+  writeDatabase(path, {sha1});
+
+  // the file isn't empty, but peers are only checked by sha256
+  TrustedFingerprints trusted(path);
+  QVERIFY(!trusted.isTrusted(sha1));
+  QCOMPARE(trusted.count(), 1);
+}
+
+void TrustedFingerprintsTests::missingFile()
+{
+  TrustedFingerprints trusted(m_dir.filePath("missing.txt"));
+  QVERIFY(!trusted.isTrusted(sha256('\x01')));
+  QVERIFY(!trusted.exists());
+  QCOMPARE(trusted.count(), 0);
+}
+
+void TrustedFingerprintsTests::reloadedWhenModified()
+{
+  const auto path = m_dir.filePath("modified.txt");
+  writeDatabase(path, {sha256('\x01')});
+
+  TrustedFingerprints trusted(path);
+  QVERIFY(trusted.isTrusted(sha256('\x01')));
+  QVERIFY(!trusted.isTrusted(sha256('\x02')));
+
+  writeDatabase(path, {sha256('\x02'), sha256('\x03')});
+  QVERIFY(!trusted.isTrusted(sha256('\x01')));
+  QVERIFY(trusted.isTrusted(sha256('\x02')));
+  QCOMPARE(trusted.count(), 2);
+
+  QVERIFY(QFile::remove(path));
+  QVERIFY(!trusted.isTrusted(sha256('\x02')));
+  QVERIFY(!trusted.exists());
+}
+
+void TrustedFingerprintsTests::sharedPerFile()
+{
+  const auto first = m_dir.filePath("first.txt");
+  const auto second = m_dir.filePath("second.txt");
+
+  QCOMPARE(&TrustedFingerprints::forFile(first), &TrustedFingerprints::forFile(first));
+  QVERIFY(&TrustedFingerprints::forFile(first) != &TrustedFingerprints::forFile(second));
+  QCOMPARE(TrustedFingerprints::forFile(second).path(), second);
+}
+
+QTEST_MAIN(TrustedFingerprintsTests)
@@ -10,9 +10,13 @@
 
 #include "platform/XWindowsClipboard.h"
 
+#include <X11/Xatom.h>
+
 class TestXWindowsClipboard : public XWindowsClipboard
 {
 public:
+  using XWindowsClipboard::CICCCMGetClipboard;
+
   class TestCICCCMGetClipboard : public CICCCMGetClipboard
   {
   public:
@@ -69,6 +73,43 @@ void XWindowsClipboardTests::singleFormat()
   QCOMPARE(clipboard.get(XWindowsClipboard::kText), m_testString2);
 }
 
+void XWindowsClipboardTests::requestConcurrently()
+{
+  // nothing owns this selection, so the server refuses each conversion
+  const Atom selection = XInternAtom(m_display, "DESKFLOW_TEST_SELECTION", False);
+  const Atom utf8 = XInternAtom(m_display, "UTF8_STRING", False);
+
+  TestXWindowsClipboard::CICCCMGetClipboard textGetter(
+      m_window, CurrentTime, XInternAtom(m_display, "DESKFLOW_TEST_TEXT", False)
+  );
+  TestXWindowsClipboard::CICCCMGetClipboard utf8Getter(
+      m_window, CurrentTime, XInternAtom(m_display, "DESKFLOW_TEST_UTF8", False)
+  );
+
+  Atom textTarget;
+  Atom utf8Target;
+  std::string textData;
+  std::string utf8Data;
+  XSelectInput(m_display, m_window, PropertyChangeMask);
+  textGetter.request(m_display, selection, XA_STRING, &textTarget, &textData);
+  utf8Getter.request(m_display, selection, utf8, &utf8Target, &utf8Data);
+  XSync(m_display, False);
+
+  // each reply must only be taken by the getter that asked for it
+  XEvent xevent;
+  while (!textGetter.isDone() || !utf8Getter.isDone()) {
+    XNextEvent(m_display, &xevent);
+    const bool forText = textGetter.processEvent(m_display, &xevent);
+    const bool forUtf8 = utf8Getter.processEvent(m_display, &xevent);
+    QVERIFY(!(forText && forUtf8));
+  }
+
+  QVERIFY(!textGetter.failed());
+  QVERIFY(!utf8Getter.failed());
+  QCOMPARE(textTarget, None);
+  QCOMPARE(utf8Target, None);
+}
+
 XWindowsClipboard &XWindowsClipboardTests::getClipboard()
 {
   return *m_clipboard;
@@ -24,6 +24,7 @@ private Q_SLOTS:
   void cleanupTestCase();
   void open();
   void singleFormat();
+  void requestConcurrently();
 #endif
 private:
   Arch m_arch;
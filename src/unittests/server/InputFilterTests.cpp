@@ -0,0 +1,193 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "InputFilterTests.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/Screen.h"
+#include "platform/HeadlessScreen.h"
+#include "server/InputFilter.h"
+#include "server/PrimaryClient.h"
+
+#include <cstdlib>
+#include <vector>
+
+using deskflow::HeadlessScreen;
+
+namespace {
+
+// ids of the actions performed, in order
+std::vector<int> s_performed;
+
+class RecordAction : public InputFilter::Action
+{
+public:
+  explicit RecordAction(int id) : m_id(id)
+  {
+    // do nothing
+  }
+
+  Action *clone() const override
+  {
+    return new RecordAction(m_id);
+  }
+
+  std::string format() const override
+  {
+    return "record(" + std::to_string(m_id) + ")";
+  }
+
+  void perform(const Event &) override
+  {
+    s_performed.push_back(m_id);
+  }
+
+private:
+  int m_id;
+};
+
+// matches any mouse button press, without a key to index it by
+class AnyButtonCondition : public InputFilter::Condition
+{
+public:
+  Condition *clone() const override
+  {
+    return new AnyButtonCondition;
+  }
+
+  std::string format() const override
+  {
+    return "anyButton";
+  }
+
+  InputFilter::FilterStatus match(const Event &event) override
+  {
+    if (event.getType() == EventTypes::PrimaryScreenButtonDown) {
+      return InputFilter::FilterStatus::Activate;
+    }
+    return InputFilter::FilterStatus::NoMatch;
+  }
+};
+
+// a primary screen with input passed through the filter
+struct Primary
+{
+  EventQueue m_events;
+  HeadlessScreen m_platformScreen{true, &m_events};
+  deskflow::Screen m_screen{&m_platformScreen, &m_events};
+  PrimaryClient m_client{"primary", &m_screen};
+  InputFilter m_filter{&m_events};
+
+  void addRule(InputFilter::Condition *condition, int id)
+  {
+    InputFilter::Rule rule(condition);
+    rule.adoptAction(new RecordAction(id), true);
+    m_filter.addFilterRule(rule);
+  }
+
+  void send(EventTypes type, void *data)
+  {
+    m_events.dispatchEvent(Event(type, m_client.getEventTarget(), data, Event::EventFlags::DontFreeData));
+    free(data);
+  }
+
+  void pressButton(ButtonID button, KeyModifierMask mask = 0)
+  {
+    send(EventTypes::PrimaryScreenButtonDown, IPlatformScreen::ButtonInfo::alloc(button, mask));
+  }
+
+  void pressHotKey(uint32_t id)
+  {
+    send(EventTypes::PrimaryScreenHotkeyDown, IPlatformScreen::HotKeyInfo::alloc(id));
+  }
+};
+
+} // namespace
+
+void InputFilterTests::initTestCase()
+{
+  m_arch.init();
+  m_log.setFilter(LogLevel::Debug2);
+}
+
+void InputFilterTests::init()
+{
+  s_performed.clear();
+}
+
+void InputFilterTests::firstMatchingRuleWins()
+{
+  Primary primary;
+  primary.addRule(new InputFilter::MouseButtonCondition(&primary.m_events, 2, 0), 0);
+  primary.addRule(new AnyButtonCondition, 1);
+  primary.addRule(new InputFilter::MouseButtonCondition(&primary.m_events, 1, 0), 2);
+  primary.addRule(new InputFilter::MouseButtonCondition(&primary.m_events, 2, 0), 3);
+  primary.m_filter.setPrimaryClient(&primary.m_client);
+
+  // the rule that matches any button comes before the one for button 1
+  primary.pressButton(1);
+  QCOMPARE(s_performed, std::vector<int>{1});
+
+  primary.pressButton(2);
+  QCOMPARE(s_performed, (std::vector<int>{1, 0}));
+}
+
+void InputFilterTests::rebuildsAfterRulesChange()
+{
+  Primary primary;
+  primary.m_filter.setPrimaryClient(&primary.m_client);
+
+  primary.pressButton(1);
+  QVERIFY(s_performed.empty());
+
+  primary.addRule(new InputFilter::MouseButtonCondition(&primary.m_events, 1, 0), 0);
+  primary.addRule(new InputFilter::MouseButtonCondition(&primary.m_events, 2, 0), 1);
+  primary.pressButton(1);
+  primary.pressButton(2);
+  QCOMPARE(s_performed, (std::vector<int>{0, 1}));
+
+  // the rule for button 2 moves to the front
+  primary.m_filter.removeFilterRule(0);
+  primary.pressButton(1);
+  primary.pressButton(2);
+  QCOMPARE(s_performed, (std::vector<int>{0, 1, 1}));
+}
+
+void InputFilterTests::rebuildsAfterPrimaryClientChange()
+{
+  Primary primary;
+  primary.addRule(new InputFilter::KeystrokeCondition(&primary.m_events, 'a', KeyModifierControl), 0);
+  primary.m_filter.setPrimaryClient(&primary.m_client);
+
+  const auto id = static_cast<uint32_t>(primary.m_filter.getRule(0).getCondition()->getMatchKey().m_value);
+  primary.pressHotKey(id);
+  QCOMPARE(s_performed, std::vector<int>{0});
+
+  // the headless screen gives the hotkey a new id when it's registered again
+  primary.m_filter.setPrimaryClient(nullptr);
+  primary.m_filter.setPrimaryClient(&primary.m_client);
+  primary.pressHotKey(id);
+  QCOMPARE(s_performed, std::vector<int>{0});
+
+  primary.pressHotKey(id + 1);
+  QCOMPARE(s_performed, (std::vector<int>{0, 0}));
+}
+
+void InputFilterTests::buttonIgnoresLockModifiers()
+{
+  Primary primary;
+  primary.addRule(new InputFilter::MouseButtonCondition(&primary.m_events, 1, KeyModifierControl), 0);
+  primary.m_filter.setPrimaryClient(&primary.m_client);
+
+  primary.pressButton(1, KeyModifierControl | KeyModifierCapsLock | KeyModifierNumLock | KeyModifierScrollLock);
+  QCOMPARE(s_performed, std::vector<int>{0});
+
+  primary.pressButton(1, KeyModifierControl | KeyModifierShift);
+  primary.pressButton(1, KeyModifierCapsLock);
+  QCOMPARE(s_performed, std::vector<int>{0});
+}
+
+QTEST_MAIN(InputFilterTests)
@@ -0,0 +1,26 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class InputFilterTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void init();
+  void firstMatchingRuleWins();
+  void rebuildsAfterRulesChange();
+  void rebuildsAfterPrimaryClientChange();
+  void buttonIgnoresLockModifiers();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
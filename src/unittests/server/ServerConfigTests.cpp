@@ -161,4 +161,121 @@ void ServerConfigTests::equalityCheck_diff_neighbours3()
   QVERIFY(a != b);
 }
 
+void ServerConfigTests::diff_equal()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  QVERIFY(a.addScreen("screenA"));
+  QVERIFY(a.addScreen("screenB"));
+  QVERIFY(a.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+  QVERIFY(a.addOption("screenB", kOptionClipboardSharing, 0));
+  QVERIFY(b.addScreen("SCREENA"));
+  QVERIFY(b.addScreen("screenB"));
+  QVERIFY(b.connect("SCREENA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+  QVERIFY(b.addOption("screenB", kOptionClipboardSharing, 0));
+
+  QVERIFY(a.diff(b).isEmpty());
+  QVERIFY(b.diff(a).isEmpty());
+}
+
+void ServerConfigTests::diff_screens()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  QVERIFY(a.addScreen("screenA"));
+  QVERIFY(a.addScreen("screenB"));
+  QVERIFY(b.addScreen("screenA"));
+  QVERIFY(b.addScreen("screenC"));
+
+  const auto changes = a.diff(b);
+  QCOMPARE(changes.m_removedScreens, Config::ScreenSet{"screenB"});
+  QCOMPARE(changes.m_addedScreens, Config::ScreenSet{"screenC"});
+  QVERIFY(changes.m_relinkedScreens.empty());
+  QVERIFY(changes.m_optionScreens.empty());
+  QVERIFY(!changes.m_aliases);
+  QVERIFY(changes.hasLayoutChanges());
+}
+
+void ServerConfigTests::diff_neighbours()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  QVERIFY(a.addScreen("screenA"));
+  QVERIFY(a.addScreen("screenB"));
+  QVERIFY(a.addScreen("screenC"));
+  QVERIFY(a.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+  QVERIFY(a.connect("screenC", Direction::Left, 0.0f, 1.0f, "screenA", 0.0f, 1.0f));
+  QVERIFY(b.addScreen("screenA"));
+  QVERIFY(b.addScreen("screenB"));
+  QVERIFY(b.addScreen("screenC"));
+  QVERIFY(b.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenC", 0.0f, 1.0f));
+  QVERIFY(b.connect("screenC", Direction::Left, 0.0f, 1.0f, "screenA", 0.0f, 1.0f));
+
+  const auto changes = a.diff(b);
+  QCOMPARE(changes.m_relinkedScreens, Config::ScreenSet{"screenA"});
+  QVERIFY(changes.m_removedScreens.empty());
+  QVERIFY(changes.m_addedScreens.empty());
+  QVERIFY(changes.m_optionScreens.empty());
+  QVERIFY(!changes.m_aliases);
+  QVERIFY(changes.hasLayoutChanges());
+}
+
+void ServerConfigTests::diff_options()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  QVERIFY(a.addScreen("screenA"));
+  QVERIFY(a.addScreen("screenB"));
+  QVERIFY(a.addOption("screenB", kOptionClipboardSharing, 0));
+  QVERIFY(b.addScreen("screenA"));
+  QVERIFY(b.addScreen("screenB"));
+  QVERIFY(b.addOption("screenB", kOptionClipboardSharing, 1));
+
+  auto changes = a.diff(b);
+  QCOMPARE(changes.m_optionScreens, Config::ScreenSet{"screenB"});
+  QVERIFY(!changes.m_globalOptions);
+  QVERIFY(!changes.hasLayoutChanges());
+
+  QVERIFY(b.addOption(std::string(), kOptionScreenSwitchDelay, 250));
+  changes = a.diff(b);
+  QVERIFY(changes.m_globalOptions);
+
+  QVERIFY(b.addAlias("screenA", "aliasA"));
+  changes = a.diff(b);
+  QVERIFY(changes.m_aliases);
+}
+
+void ServerConfigTests::diff_filters()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  QVERIFY(a.addScreen("screenA"));
+  QVERIFY(b.addScreen("screenA"));
+  b.getInputFilter()->addFilterRule(InputFilter::Rule{new OnlySystemFilter()});
+
+  const auto changes = a.diff(b);
+  QVERIFY(changes.m_filterRules);
+  QVERIFY(!changes.hasLayoutChanges());
+  QVERIFY(!changes.isEmpty());
+}
+
+void ServerConfigTests::apply()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  QVERIFY(a.addScreen("screenA"));
+  QVERIFY(a.addScreen("screenB"));
+  QVERIFY(a.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+  a.getInputFilter()->addFilterRule(InputFilter::Rule{new OnlySystemFilter()});
+  QVERIFY(b.addScreen("screenA"));
+  QVERIFY(b.addScreen("screenC"));
+  QVERIFY(b.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenC", 0.0f, 1.0f));
+  QVERIFY(b.addOption("screenC", kOptionClipboardSharing, 0));
+  b.getInputFilter()->addFilterRule(InputFilter::Rule{new OnlySystemFilter()});
+
+  a.apply(b, a.diff(b));
+  QVERIFY(a == b);
+  QVERIFY(a.diff(b).isEmpty());
+}
+
 QTEST_MAIN(ServerConfigTests)
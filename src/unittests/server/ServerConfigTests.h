@@ -18,4 +18,10 @@ private Q_SLOTS:
   void equalityCheck_diff_neighbours1();
   void equalityCheck_diff_neighbours2();
   void equalityCheck_diff_neighbours3();
+  void diff_equal();
+  void diff_screens();
+  void diff_neighbours();
+  void diff_options();
+  void diff_filters();
+  void apply();
 };